@@ -63,6 +63,21 @@ using namespace LLAvatarAppearanceDefines;
 const std::string AVATAR_DEFAULT_CHAR = "avatar";
 const LLColor4 DUMMY_COLOR = LLColor4(0.5,0.5,0.5,1.0);
 
+//-----------------------------------------------------------------------------
+// parse_definition_file()
+// Avatar definition files are parsed on every startup; keep a binary copy of
+// the parsed tree in the cache and reuse it while the source is unchanged.
+//-----------------------------------------------------------------------------
+static BOOL parse_definition_file(LLXmlTree& xml_tree, const std::string& filename)
+{
+    if (gDirUtilp->getCacheDir().empty())
+    {
+        return xml_tree.parseFile(filename, FALSE);
+    }
+    std::string cache_path = gDirUtilp->getExpandedFilename(LL_PATH_CACHE, gDirUtilp->getBaseFileName(filename) + ".bin");
+    return xml_tree.parseFileCached(filename, cache_path, FALSE);
+}
+
 /*********************************************************************************
  **                                                                             **
  ** Begin private LLAvatarAppearance Support classes
@@ -361,8 +376,9 @@ void LLAvatarAppearance::initClass(const std::string& avatar_file_name_arg, cons
     {
         avatar_file_name = gDirUtilp->getExpandedFilename(LL_PATH_CHARACTER,AVATAR_DEFAULT_CHAR + "_lad.xml");
     }
+    LLTimer load_timer;
     LLXmlTree xml_tree;
-    BOOL success = xml_tree.parseFile( avatar_file_name, FALSE );
+    BOOL success = parse_definition_file( xml_tree, avatar_file_name );
     if (!success)
     {
         LL_ERRS() << "Problem reading avatar configuration file:" << avatar_file_name << LL_ENDL;
@@ -465,6 +481,7 @@ void LLAvatarAppearance::initClass(const std::string& avatar_file_name_arg, cons
     {
         LL_ERRS() << "Error parsing skeleton node in avatar XML file: " << skeleton_path << LL_ENDL;
     }
+    LL_INFOS("Avatar") << "Loaded avatar definitions in " << load_timer.getElapsedTimeF32() * 1000.f << " ms" << LL_ENDL;
 }
 
 void LLAvatarAppearance::cleanupClass()
@@ -609,7 +626,7 @@ BOOL LLAvatarAppearance::parseSkeletonFile(const std::string& filename, LLXmlTre
     //-------------------------------------------------------------------------
     // parse the file
     //-------------------------------------------------------------------------
-    BOOL parsesuccess = skeleton_xml_tree.parseFile( filename, FALSE );
+    BOOL parsesuccess = parse_definition_file( skeleton_xml_tree, filename );
 
     if (!parsesuccess)
     {
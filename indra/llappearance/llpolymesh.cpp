@@ -267,6 +267,34 @@ BOOL LLPolyMeshSharedData::allocateJointNames( U32 numJointNames )
         return TRUE;
 }
 
+//--------------------------------------------------------------------
+// LLPolyMeshFileData::load()
+//--------------------------------------------------------------------
+BOOL LLPolyMeshFileData::load(const std::string& filename)
+{
+        mData.clear();
+        mOffset = 0;
+
+        LLFILE* fp = LLFile::fopen(filename, "rb");                     /*Flawfinder: ignore*/
+        if (!fp)
+        {
+                return FALSE;
+        }
+
+        fseek(fp, 0, SEEK_END);
+        long size = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+
+        BOOL success = size > 0;
+        if (success)
+        {
+                mData.resize(size);
+                success = fread(&mData[0], 1, size, fp) == (size_t)size;
+        }
+        fclose(fp);
+        return success;
+}
+
 //--------------------------------------------------------------------
 // LLPolyMeshSharedData::loadMesh()
 //--------------------------------------------------------------------
@@ -280,8 +308,8 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 LL_ERRS() << "Filename is Empty!" << LL_ENDL;
                 return FALSE;
         }
-        LLFILE* fp = LLFile::fopen(fileName, "rb");                     /*Flawfinder: ignore*/
-        if (!fp)
+        LLPolyMeshFileData file;
+        if (!file.load(fileName))
         {
                 LL_ERRS() << "can't open: " << fileName << LL_ENDL;
                 return FALSE;
@@ -291,7 +319,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
         // Read a chunk
         //-------------------------------------------------------------------------
         char header[128];               /*Flawfinder: ignore*/
-        if (fread(header, sizeof(char), 128, fp) != 128)
+        if (file.read(header, sizeof(char), 128) != 128)
         {
                 LL_WARNS() << "Short read" << LL_ENDL;
         }
@@ -307,13 +335,13 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 //----------------------------------------------------------------
                 // File Header (seek past it)
                 //----------------------------------------------------------------
-                fseek(fp, 24, SEEK_SET);
+                file.seek(24);
 
                 //----------------------------------------------------------------
                 // HasWeights
                 //----------------------------------------------------------------
                 U8 hasWeights;
-                size_t numRead = fread(&hasWeights, sizeof(U8), 1, fp);
+                size_t numRead = file.read(&hasWeights, sizeof(U8), 1);
                 if (numRead != 1)
                 {
                         LL_ERRS() << "can't read HasWeights flag from " << fileName << LL_ENDL;
@@ -328,7 +356,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 // HasDetailTexCoords
                 //----------------------------------------------------------------
                 U8 hasDetailTexCoords;
-                numRead = fread(&hasDetailTexCoords, sizeof(U8), 1, fp);
+                numRead = file.read(&hasDetailTexCoords, sizeof(U8), 1);
                 if (numRead != 1)
                 {
                         LL_ERRS() << "can't read HasDetailTexCoords flag from " << fileName << LL_ENDL;
@@ -339,7 +367,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 // Position
                 //----------------------------------------------------------------
                 LLVector3 position;
-                numRead = fread(position.mV, sizeof(float), 3, fp);
+                numRead = file.read(position.mV, sizeof(float), 3);
                 llendianswizzle(position.mV, sizeof(float), 3);
                 if (numRead != 3)
                 {
@@ -352,7 +380,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 // Rotation
                 //----------------------------------------------------------------
                 LLVector3 rotationAngles;
-                numRead = fread(rotationAngles.mV, sizeof(float), 3, fp);
+                numRead = file.read(rotationAngles.mV, sizeof(float), 3);
                 llendianswizzle(rotationAngles.mV, sizeof(float), 3);
                 if (numRead != 3)
                 {
@@ -361,7 +389,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 }
 
                 U8 rotationOrder;
-                numRead = fread(&rotationOrder, sizeof(U8), 1, fp);
+                numRead = file.read(&rotationOrder, sizeof(U8), 1);
 
                 if (numRead != 1)
                 {
@@ -380,7 +408,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 // Scale
                 //----------------------------------------------------------------
                 LLVector3 scale;
-                numRead = fread(scale.mV, sizeof(float), 3, fp);
+                numRead = file.read(scale.mV, sizeof(float), 3);
                 llendianswizzle(scale.mV, sizeof(float), 3);
                 if (numRead != 3)
                 {
@@ -401,7 +429,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 //----------------------------------------------------------------
                 if (!isLOD())
                 {
-                        numRead = fread(&numVertices, sizeof(U16), 1, fp);
+                        numRead = file.read(&numVertices, sizeof(U16), 1);
                         llendianswizzle(&numVertices, sizeof(U16), 1);
                         if (numRead != 1)
                         {
@@ -416,7 +444,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                             //----------------------------------------------------------------
                             // Coords
                             //----------------------------------------------------------------
-                            numRead = fread(&mBaseCoords[i], sizeof(float), 3, fp);
+                            numRead = file.read(&mBaseCoords[i], sizeof(float), 3);
                             llendianswizzle(&mBaseCoords[i], sizeof(float), 3);
                             if (numRead != 3)
                             {
@@ -430,7 +458,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                             //----------------------------------------------------------------
                             // Normals
                             //----------------------------------------------------------------
-                            numRead = fread(&mBaseNormals[i], sizeof(float), 3, fp);
+                            numRead = file.read(&mBaseNormals[i], sizeof(float), 3);
                             llendianswizzle(&mBaseNormals[i], sizeof(float), 3);
                             if (numRead != 3)
                             {
@@ -444,7 +472,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                             //----------------------------------------------------------------
                             // Binormals
                             //----------------------------------------------------------------
-                            numRead = fread(&mBaseBinormals[i], sizeof(float), 3, fp);
+                            numRead = file.read(&mBaseBinormals[i], sizeof(float), 3);
                             llendianswizzle(&mBaseBinormals[i], sizeof(float), 3);
                             if (numRead != 3)
                             {
@@ -456,7 +484,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                         //----------------------------------------------------------------
                         // TexCoords
                         //----------------------------------------------------------------
-                        numRead = fread(mTexCoords, 2*sizeof(float), numVertices, fp);
+                        numRead = file.read(mTexCoords, 2*sizeof(float), numVertices);
                         llendianswizzle(mTexCoords, sizeof(float), 2*numVertices);
                         if (numRead != numVertices)
                         {
@@ -469,7 +497,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                         //----------------------------------------------------------------
                         if (mHasDetailTexCoords)
                         {
-                                numRead = fread(mDetailTexCoords, 2*sizeof(float), numVertices, fp);
+                                numRead = file.read(mDetailTexCoords, 2*sizeof(float), numVertices);
                                 llendianswizzle(mDetailTexCoords, sizeof(float), 2*numVertices);
                                 if (numRead != numVertices)
                                 {
@@ -483,7 +511,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                         //----------------------------------------------------------------
                         if (mHasWeights)
                         {
-                                numRead = fread(mWeights, sizeof(float), numVertices, fp);
+                                numRead = file.read(mWeights, sizeof(float), numVertices);
                                 llendianswizzle(mWeights, sizeof(float), numVertices);
                                 if (numRead != numVertices)
                                 {
@@ -497,7 +525,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 // NumFaces
                 //----------------------------------------------------------------
                 U16 numFaces;
-                numRead = fread(&numFaces, sizeof(U16), 1, fp);
+                numRead = file.read(&numFaces, sizeof(U16), 1);
                 llendianswizzle(&numFaces, sizeof(U16), 1);
                 if (numRead != 1)
                 {
@@ -515,7 +543,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 for (i = 0; i < numFaces; i++)
                 {
                         S16 face[3];
-                        numRead = fread(face, sizeof(U16), 3, fp);
+                        numRead = file.read(face, sizeof(U16), 3);
                         llendianswizzle(face, sizeof(U16), 3);
                         if (numRead != 3)
                         {
@@ -572,7 +600,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                         U16 numSkinJoints = 0;
                         if ( mHasWeights )
                         {
-                                numRead = fread(&numSkinJoints, sizeof(U16), 1, fp);
+                                numRead = file.read(&numSkinJoints, sizeof(U16), 1);
                                 llendianswizzle(&numSkinJoints, sizeof(U16), 1);
                                 if (numRead != 1)
                                 {
@@ -588,7 +616,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                         for (i=0; i < numSkinJoints; i++)
                         {
                                 char jointName[64+1];
-                                numRead = fread(jointName, sizeof(jointName)-1, 1, fp);
+                                numRead = file.read(jointName, sizeof(jointName)-1, 1);
                                 jointName[sizeof(jointName)-1] = '\0'; // ensure nul-termination
                                 if (numRead != 1)
                                 {
@@ -605,7 +633,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                         //-------------------------------------------------------------------------
                         char morphName[64+1];
                         morphName[sizeof(morphName)-1] = '\0'; // ensure nul-termination
-                        while(fread(morphName, sizeof(char), 64, fp) == 64)
+                        while(file.read(morphName, sizeof(char), 64) == 64)
                         {
                                 if (!strcmp(morphName, "End Morphs"))
                                 {
@@ -615,7 +643,7 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                                 std::string morph_name(morphName);
                                 LLPolyMorphData* morph_data = new LLPolyMorphData(morph_name);
 
-                                BOOL result = morph_data->loadBinary(fp, this);
+                                BOOL result = morph_data->loadBinary(file, this);
 
                                 if (!result)
                                 {
@@ -680,19 +708,19 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                         }
 
                         S32 numRemaps;
-                        if (fread(&numRemaps, sizeof(S32), 1, fp) == 1)
+                        if (file.read(&numRemaps, sizeof(S32), 1) == 1)
                         {
                                 llendianswizzle(&numRemaps, sizeof(S32), 1);
                                 for (S32 i = 0; i < numRemaps; i++)
                                 {
                                         S32 remapSrc;
                                         S32 remapDst;
-                                        if (fread(&remapSrc, sizeof(S32), 1, fp) != 1)
+                                        if (file.read(&remapSrc, sizeof(S32), 1) != 1)
                                         {
                                                 LL_ERRS() << "can't read source vertex in vertex remap data" << LL_ENDL;
                                                 break;
                                         }
-                                        if (fread(&remapDst, sizeof(S32), 1, fp) != 1)
+                                        if (file.read(&remapDst, sizeof(S32), 1) != 1)
                                         {
                                                 LL_ERRS() << "can't read destination vertex in vertex remap data" << LL_ENDL;
                                                 break;
@@ -718,8 +746,6 @@ BOOL LLPolyMeshSharedData::loadMesh( const std::string& fileName )
                 allocateJointNames(1);
         }
 
-        fclose( fp );
-
         return status;
 }
 
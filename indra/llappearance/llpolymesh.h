@@ -53,6 +53,37 @@ typedef S32 LLPolyFace[3];
 
 //struct PrimitiveGroup;
 
+//-----------------------------------------------------------------------------
+// LLPolyMeshFileData
+// The contents of a .llm file, read into memory in one go.  read() behaves
+// like fread() so the loaders walk the buffer the way they walked the file.
+//-----------------------------------------------------------------------------
+class LLPolyMeshFileData
+{
+public:
+    LLPolyMeshFileData() : mOffset(0) {}
+
+    BOOL    load(const std::string& filename);
+
+    size_t  read(void* dst, size_t size, size_t count)
+    {
+        size_t available = size ? llmin(count, (mData.size() - mOffset) / size) : 0;
+        if (available)
+        {
+            memcpy(dst, &mData[mOffset], available * size);
+            mOffset += available * size;
+        }
+        return available;
+    }
+
+    void    seek(size_t offset)     { mOffset = llmin(offset, mData.size()); }
+    size_t  remaining() const       { return mData.size() - mOffset; }
+
+private:
+    std::vector<U8> mData;
+    size_t          mOffset;
+};
+
 //-----------------------------------------------------------------------------
 // LLPolyMesh
 // A polyhedra consisting of any number of triangles and quads.
@@ -104,12 +104,12 @@ LLPolyMorphData::~LLPolyMorphData()
 //-----------------------------------------------------------------------------
 // loadBinary()
 //-----------------------------------------------------------------------------
-BOOL LLPolyMorphData::loadBinary(LLFILE *fp, LLPolyMeshSharedData *mesh)
+BOOL LLPolyMorphData::loadBinary(LLPolyMeshFileData& file, LLPolyMeshSharedData *mesh)
 {
     S32 numVertices;
     S32 numRead;
 
-    numRead = fread(&numVertices, sizeof(S32), 1, fp);
+    numRead = file.read(&numVertices, sizeof(S32), 1);
     llendianswizzle(&numVertices, sizeof(S32), 1);
     if (numRead != 1)
     {
@@ -117,6 +117,14 @@ BOOL LLPolyMorphData::loadBinary(LLFILE *fp, LLPolyMeshSharedData *mesh)
         return FALSE;
     }
 
+    // index, coords, normal, binormal and uv per vertex
+    const size_t VERTEX_RECORD_SIZE = sizeof(U32) + 11 * sizeof(F32);
+    if (numVertices < 0 || (size_t)numVertices > file.remaining() / VERTEX_RECORD_SIZE)
+    {
+        LL_WARNS() << "Bad number of morph target vertices: " << numVertices << LL_ENDL;
+        return FALSE;
+    }
+
     //-------------------------------------------------------------------------
     // free any existing data
     //-------------------------------------------------------------------------
@@ -146,7 +154,7 @@ BOOL LLPolyMorphData::loadBinary(LLFILE *fp, LLPolyMeshSharedData *mesh)
     //-------------------------------------------------------------------------
     for(S32 v = 0; v < numVertices; v++)
     {
-        numRead = fread(&mVertexIndices[v], sizeof(U32), 1, fp);
+        numRead = file.read(&mVertexIndices[v], sizeof(U32), 1);
         llendianswizzle(&mVertexIndices[v], sizeof(U32), 1);
         if (numRead != 1)
         {
@@ -162,7 +170,7 @@ BOOL LLPolyMorphData::loadBinary(LLFILE *fp, LLPolyMeshSharedData *mesh)
         }
 
 
-        numRead = fread(&mCoords[v], sizeof(F32), 3, fp);
+        numRead = file.read(&mCoords[v], sizeof(F32), 3);
         llendianswizzle(&mCoords[v], sizeof(F32), 3);
         if (numRead != 3)
         {
@@ -182,7 +190,7 @@ BOOL LLPolyMorphData::loadBinary(LLFILE *fp, LLPolyMeshSharedData *mesh)
             mMaxDistortion = magnitude;
         }
 
-        numRead = fread(&mNormals[v], sizeof(F32), 3, fp);
+        numRead = file.read(&mNormals[v], sizeof(F32), 3);
         llendianswizzle(&mNormals[v], sizeof(F32), 3);
         if (numRead != 3)
         {
@@ -190,7 +198,7 @@ BOOL LLPolyMorphData::loadBinary(LLFILE *fp, LLPolyMeshSharedData *mesh)
             return FALSE;
         }
 
-        numRead = fread(&mBinormals[v], sizeof(F32), 3, fp);
+        numRead = file.read(&mBinormals[v], sizeof(F32), 3);
         llendianswizzle(&mBinormals[v], sizeof(F32), 3);
         if (numRead != 3)
         {
@@ -199,7 +207,7 @@ BOOL LLPolyMorphData::loadBinary(LLFILE *fp, LLPolyMeshSharedData *mesh)
         }
 
 
-        numRead = fread(&mTexCoords[v].mV, sizeof(F32), 2, fp);
+        numRead = file.read(&mTexCoords[v].mV, sizeof(F32), 2);
         llendianswizzle(&mTexCoords[v].mV, sizeof(F32), 2);
         if (numRead != 2)
         {
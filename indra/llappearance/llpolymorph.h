@@ -33,6 +33,7 @@
 #include "llviewervisualparam.h"
 
 class LLAvatarJointCollisionVolume;
+class LLPolyMeshFileData;
 class LLPolyMeshSharedData;
 class LLVector2;
 class LLAvatarJointCollisionVolume;
@@ -49,7 +50,7 @@ public:
     ~LLPolyMorphData();
     LLPolyMorphData(const LLPolyMorphData &rhs);
 
-    BOOL            loadBinary(LLFILE* fp, LLPolyMeshSharedData *mesh);
+    BOOL            loadBinary(LLPolyMeshFileData& file, LLPolyMeshSharedData *mesh);
     const std::string& getName() { return mName; }
 
 public:
@@ -27,23 +27,283 @@
 #include "linden_common.h"
 #include "llallocator.h"
 
-//
-// stub implementations for when tcmalloc is disabled
-//
+#include "llcallstack.h"
+#include "llfile.h"
+#include "llmutex.h"
+#include "lltrace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    const S32 MAX_SAMPLE_FRAMES = 16;
+
+    struct SiteKey
+    {
+        const LLTrace::MemStatHandle* mCategory;
+        std::vector<void*> mFrames;
+
+        bool operator<(const SiteKey& other) const
+        {
+            if (mCategory != other.mCategory)
+            {
+                return std::less<const LLTrace::MemStatHandle*>()(mCategory, other.mCategory);
+            }
+            return mFrames < other.mFrames;
+        }
+    };
+
+    struct SiteStats
+    {
+        SiteStats() : mLiveCount(0), mTotalCount(0), mLiveBytes(0), mTotalBytes(0), mEstimatedLiveBytes(0.0) {}
+        U32 mLiveCount, mTotalCount;
+        U64 mLiveBytes, mTotalBytes;
+        F64 mEstimatedLiveBytes;
+    };
+
+    typedef std::map<SiteKey, SiteStats> site_map_t;
+
+    struct LiveSample
+    {
+        site_map_t::iterator mSite;
+        size_t mSize;
+        F64 mEstimatedSize;
+    };
+
+    struct SampleTable
+    {
+        LLMutex mMutex;
+        site_map_t mSites;
+        std::unordered_map<void*, LiveSample> mLive;
+    };
+
+    SampleTable& sample_table()
+    {
+        // Never destroyed: frees keep arriving during static destruction.
+        static SampleTable* sTable = new SampleTable;
+        return *sTable;
+    }
+
+    std::atomic<size_t> sSampleInterval(LLAllocator::DEFAULT_SAMPLE_INTERVAL);
+    // bumped by setSampleInterval() so every thread re-arms its countdown
+    std::atomic<U32> sIntervalGeneration(1);
+
+    thread_local S64 tBytesUntilSample = 0;
+    thread_local U32 tCountdownGeneration = 0;
+    // set while this thread is inside the sampler, so that allocations
+    // made by the sampler itself are not sampled
+    thread_local bool tInSampler = false;
+    thread_local LLTrace::MemStatHandle* tCategory = NULL;
+
+    // Distance to the next sample, exponentially distributed around the
+    // sample interval.  This is what pprof's heap_v2 unsampling assumes.
+    S64 next_sample_distance()
+    {
+        thread_local U64 state = 0;
+        if (!state)
+        {
+            state = 0x9e3779b97f4a7c15ULL ^ (U64)(uintptr_t)&state;
+        }
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        // uniform in (0, 1]
+        F64 u = (F64)((state >> 11) + 1) / (F64)(1ULL << 53);
+        return (S64)(-log(u) * (F64)sSampleInterval.load(std::memory_order_relaxed)) + 1;
+    }
+
+    // Expected number of bytes one sample of this size stands for.
+    F64 estimated_size(size_t size)
+    {
+        F64 interval = (F64)sSampleInterval.load(std::memory_order_relaxed);
+        F64 probability = 1.0 - exp(-(F64)size / interval);
+        return probability > 0.0 ? (F64)size / probability : (F64)size;
+    }
+
+    void unlink_sample(const LiveSample& sample)
+    {
+        SiteStats& site = sample.mSite->second;
+        site.mLiveCount--;
+        site.mLiveBytes -= sample.mSize;
+        site.mEstimatedLiveBytes = llmax(site.mEstimatedLiveBytes - sample.mEstimatedSize, 0.0);
+    }
+}
+
+std::atomic<bool> LLAllocator::sProfiling(false);
+std::atomic<U32> LLAllocator::sLiveSamples(0);
+
+// static
+LLTrace::MemStatHandle* LLAllocator::swapCategory(LLTrace::MemStatHandle* category)
+{
+    LLTrace::MemStatHandle* previous = tCategory;
+    tCategory = category;
+    return previous;
+}
 
 void LLAllocator::setProfilingEnabled(bool should_enable)
 {
+    sProfiling = should_enable;
+    if (!should_enable)
+    {
+        SampleTable& table = sample_table();
+        LLMutexLock lock(&table.mMutex);
+        table.mLive.clear();
+        table.mSites.clear();
+        sLiveSamples = 0;
+    }
 }
 
 // static
 bool LLAllocator::isProfiling()
 {
-    return false;
+    return sProfiling.load(std::memory_order_relaxed);
+}
+
+// static
+void LLAllocator::setSampleInterval(size_t bytes)
+{
+    sSampleInterval = llmax(bytes, (size_t)1);
+    sIntervalGeneration++;
+}
+
+// static
+size_t LLAllocator::getSampleInterval()
+{
+    return sSampleInterval.load(std::memory_order_relaxed);
+}
+
+// static
+void LLAllocator::countAlloc(void* ptr, size_t size)
+{
+    if (tInSampler)
+    {
+        return;
+    }
+    const U32 generation = sIntervalGeneration.load(std::memory_order_relaxed);
+    if (tCountdownGeneration != generation)
+    {
+        // first allocation on this thread, or the interval changed
+        tBytesUntilSample = next_sample_distance();
+        tCountdownGeneration = generation;
+    }
+    tBytesUntilSample -= (S64)size;
+    if (tBytesUntilSample > 0)
+    {
+        return;
+    }
+
+    tInSampler = true;
+    tBytesUntilSample = next_sample_distance();
+
+    SiteKey key;
+    key.mCategory = tCategory;
+    void* frames[MAX_SAMPLE_FRAMES];
+    // skip this function so the innermost frame is the allocating call
+    S32 count = LLCallStack::captureFrames(frames, MAX_SAMPLE_FRAMES, 1);
+    key.mFrames.assign(frames, frames + count);
+
+    SampleTable& table = sample_table();
+    {
+        LLMutexLock lock(&table.mMutex);
+        // profiling may have been switched off since the caller checked
+        if (sProfiling.load(std::memory_order_relaxed))
+        {
+            site_map_t::iterator site = table.mSites.insert(std::make_pair(key, SiteStats())).first;
+            LiveSample sample = { site, size, estimated_size(size) };
+
+            std::pair<std::unordered_map<void*, LiveSample>::iterator, bool> inserted = table.mLive.insert(std::make_pair(ptr, sample));
+            if (!inserted.second)
+            {
+                // the old block was released through an unhooked path
+                unlink_sample(inserted.first->second);
+                inserted.first->second = sample;
+            }
+            else
+            {
+                sLiveSamples++;
+            }
+
+            SiteStats& stats = site->second;
+            stats.mLiveCount++;
+            stats.mTotalCount++;
+            stats.mLiveBytes += size;
+            stats.mTotalBytes += size;
+            stats.mEstimatedLiveBytes += sample.mEstimatedSize;
+        }
+    }
+    tInSampler = false;
+}
+
+// static
+void LLAllocator::removeSample(void* ptr)
+{
+    if (tInSampler)
+    {
+        return;
+    }
+    tInSampler = true;
+    SampleTable& table = sample_table();
+    {
+        LLMutexLock lock(&table.mMutex);
+        std::unordered_map<void*, LiveSample>::iterator it = table.mLive.find(ptr);
+        if (it != table.mLive.end())
+        {
+            unlink_sample(it->second);
+            table.mLive.erase(it);
+            sLiveSamples--;
+        }
+    }
+    tInSampler = false;
 }
 
 std::string LLAllocator::getRawProfile()
 {
-    return std::string();
+    std::ostringstream out;
+    {
+        SampleTable& table = sample_table();
+        LLMutexLock lock(&table.mMutex);
+
+        U64 live_count = 0, live_bytes = 0, total_count = 0, total_bytes = 0;
+        for (site_map_t::const_iterator it = table.mSites.begin(); it != table.mSites.end(); ++it)
+        {
+            live_count += it->second.mLiveCount;
+            live_bytes += it->second.mLiveBytes;
+            total_count += it->second.mTotalCount;
+            total_bytes += it->second.mTotalBytes;
+        }
+
+        // gperftools legacy heap profile; heap_v2 tells pprof how to scale
+        // the sampled counts back up
+        out << "heap profile: " << live_count << ": " << live_bytes
+            << " [" << total_count << ": " << total_bytes << "] @ heap_v2/" << getSampleInterval() << "\n";
+
+        for (site_map_t::const_iterator it = table.mSites.begin(); it != table.mSites.end(); ++it)
+        {
+            const SiteStats& stats = it->second;
+            out << stats.mLiveCount << ": " << stats.mLiveBytes
+                << " [" << stats.mTotalCount << ": " << stats.mTotalBytes << "] @";
+            for (std::vector<void*>::const_iterator frame = it->first.mFrames.begin(); frame != it->first.mFrames.end(); ++frame)
+            {
+                out << " 0x" << std::hex << (U64)(uintptr_t)*frame << std::dec;
+            }
+            out << "\n";
+        }
+    }
+
+#if LL_LINUX
+    // lets pprof map addresses back to the executable and shared libraries
+    llifstream maps("/proc/self/maps");
+    if (maps.is_open())
+    {
+        out << "\nMAPPED_LIBRARIES:\n" << maps.rdbuf();
+    }
+#endif
+    return out.str();
 }
 
 LLAllocatorHeapProfile const & LLAllocator::getProfile()
@@ -56,3 +316,63 @@ LLAllocatorHeapProfile const & LLAllocator::getProfile()
     mProf.parse(prof_text);
     return mProf;
 }
+
+bool LLAllocator::dumpProfile(const std::string& filename)
+{
+    llofstream out(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+    if (!out.is_open())
+    {
+        LL_WARNS("Memory") << "Unable to write heap profile to " << filename << LL_ENDL;
+        return false;
+    }
+    out << getRawProfile();
+    out.close();
+    LL_INFOS("Memory") << "Wrote heap profile to " << filename << LL_ENDL;
+    return true;
+}
+
+// static
+LLAllocator::category_usage_t LLAllocator::getCategoryUsage()
+{
+    typedef std::map<const LLTrace::MemStatHandle*, CategoryUsage> usage_by_handle_t;
+    usage_by_handle_t by_handle;
+    {
+        SampleTable& table = sample_table();
+        LLMutexLock lock(&table.mMutex);
+        for (site_map_t::const_iterator it = table.mSites.begin(); it != table.mSites.end(); ++it)
+        {
+            CategoryUsage& usage = by_handle[it->first.mCategory];
+            usage.mSampledCount += it->second.mLiveCount;
+            usage.mSampledBytes += it->second.mLiveBytes;
+            usage.mEstimatedBytes += (U64)it->second.mEstimatedLiveBytes;
+        }
+    }
+
+    category_usage_t usage;
+    for (usage_by_handle_t::const_iterator it = by_handle.begin(); it != by_handle.end(); ++it)
+    {
+        CategoryUsage& entry = usage[it->first ? it->first->getName() : std::string("untracked")];
+        entry.mSampledCount += it->second.mSampledCount;
+        entry.mSampledBytes += it->second.mSampledBytes;
+        entry.mEstimatedBytes += it->second.mEstimatedBytes;
+    }
+    return usage;
+}
+
+// static
+void LLAllocator::logCategoryUsage()
+{
+    category_usage_t usage = getCategoryUsage();
+
+    typedef std::pair<std::string, CategoryUsage> entry_t;
+    std::vector<entry_t> sorted(usage.begin(), usage.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const entry_t& a, const entry_t& b) { return a.second.mEstimatedBytes > b.second.mEstimatedBytes; });
+
+    LL_INFOS("Memory") << "Sampled live heap by category (interval " << getSampleInterval() << " bytes):" << LL_ENDL;
+    for (std::vector<entry_t>::const_iterator it = sorted.begin(); it != sorted.end(); ++it)
+    {
+        LL_INFOS("Memory") << "  " << it->first << ": ~" << (it->second.mEstimatedBytes / 1024) << " KB ("
+                           << it->second.mSampledCount << " samples, " << it->second.mSampledBytes << " bytes)" << LL_ENDL;
+    }
+}
@@ -27,23 +27,119 @@
 #ifndef LL_LLALLOCATOR_H
 #define LL_LLALLOCATOR_H
 
+#include <atomic>
+#include <map>
 #include <string>
 
 #include "llallocator_heap_profile.h"
 
+namespace LLTrace
+{
+    class MemStatHandle;
+}
+
+// Built-in sampling heap profiler.
+//
+// While profiling is enabled, roughly one allocation per sample interval
+// bytes passing through the LL_PROFILE_ALLOC hooks in llmemory.h is
+// recorded, together with a short call stack and the LLTrace memory
+// category active on the allocating thread.  Sampled allocations stay in
+// the profile until they are freed, so the result shows which call sites
+// and categories are holding memory right now.  Profiles are written in
+// the gperftools legacy heap format and load directly into pprof.
 class LL_COMMON_API LLAllocator {
     friend class LLMemoryView;
 
 public:
+    static const size_t DEFAULT_SAMPLE_INTERVAL = 512 * 1024;
+
+    struct CategoryUsage
+    {
+        CategoryUsage() : mSampledCount(0), mSampledBytes(0), mEstimatedBytes(0) {}
+        U32 mSampledCount;
+        U64 mSampledBytes;
+        // live bytes scaled up by the sampling probability
+        U64 mEstimatedBytes;
+    };
+    typedef std::map<std::string, CategoryUsage> category_usage_t;
+
+    // Tags allocations made on this thread with an LLTrace memory category
+    // for as long as the scope lives.  Costs a relaxed load while idle.
+    class ScopedCategory
+    {
+    public:
+        ScopedCategory(LLTrace::MemStatHandle& category)
+        :   mPrevious(NULL),
+            mActive(isProfiling())
+        {
+            if (mActive)
+            {
+                mPrevious = swapCategory(&category);
+            }
+        }
+
+        ~ScopedCategory()
+        {
+            if (mActive)
+            {
+                swapCategory(mPrevious);
+            }
+        }
+
+    private:
+        LLTrace::MemStatHandle* mPrevious;
+        bool mActive;
+    };
+
+    // Disabling the profiler discards every sample taken so far.
     void setProfilingEnabled(bool should_enable);
 
     static bool isProfiling();
 
+    // Mean number of allocated bytes between two samples.  Every thread
+    // draws a new distance to its next sample at its next allocation.
+    static void setSampleInterval(size_t bytes);
+    static size_t getSampleInterval();
+
     LLAllocatorHeapProfile const & getProfile();
 
+    // Writes the current profile for pprof; returns false if the file
+    // could not be written.
+    bool dumpProfile(const std::string& filename);
+
+    // Live sampled memory per LLTrace memory category.  Allocations made
+    // outside any ScopedCategory are reported as "untracked".
+    static category_usage_t getCategoryUsage();
+    static void logCategoryUsage();
+
+    // Allocation hooks.  Both are a single relaxed load while idle.
+    static void noteAlloc(void* ptr, size_t size)
+    {
+        if (ptr && sProfiling.load(std::memory_order_relaxed))
+        {
+            countAlloc(ptr, size);
+        }
+    }
+
+    static void noteFree(void* ptr)
+    {
+        if (ptr && sLiveSamples.load(std::memory_order_relaxed))
+        {
+            removeSample(ptr);
+        }
+    }
+
 private:
     std::string getRawProfile();
 
+    static void countAlloc(void* ptr, size_t size);
+    static void removeSample(void* ptr);
+    // sets this thread's category, returning the previous one
+    static LLTrace::MemStatHandle* swapCategory(LLTrace::MemStatHandle* category);
+
+    static std::atomic<bool> sProfiling;
+    static std::atomic<U32> sLiveSamples;
+
 private:
     LLAllocatorHeapProfile mProf;
 };
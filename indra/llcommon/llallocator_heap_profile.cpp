@@ -128,9 +128,12 @@ void LLAllocatorHeapProfile::parse(std::string const & prof_text)
         
         for(; j != line_elems.end(); ++j)
         {
-            if(!j->empty())
+            // markers are decimal or 0x-prefixed hex; anything else is a
+            // header annotation such as "heap_v2/524288"
+            if(!j->empty() && isdigit(*j->begin()))
             {
-                U32 marker = boost::lexical_cast<U32>(*j);
+                std::string marker_text(j->begin(), j->end());
+                stack_marker marker = strtoull(marker_text.c_str(), NULL, 0);
                 current_line.mTrace.push_back(marker);
             }
         }
@@ -149,7 +152,7 @@ void LLAllocatorHeapProfile::dump(std::ostream & out) const
         stack_trace::const_iterator j;
         for(j = i->mTrace.begin(); j != i->mTrace.end(); ++j)
         {
-            out << ' ' << *j;
+            out << " 0x" << std::hex << *j << std::dec;
         }
         out << '\n';
     }
@@ -36,7 +36,8 @@
 class LLAllocatorHeapProfile
 {
 public:
-    typedef int stack_marker;
+    // return address, or an opaque frame id in older Windows profiles
+    typedef U64 stack_marker;
 
     typedef std::vector<stack_marker> stack_trace;
 
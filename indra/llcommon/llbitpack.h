@@ -29,6 +29,8 @@
 
 #include "llerror.h"
 
+#include <string.h>
+
 const U32 MAX_DATA_BITS = 8;
 
 
@@ -138,29 +140,34 @@ public:
         return mBufferSize;
     }
 
+    // Unpacks total_dsize bits into successive bytes of total_retval, eight
+    // bits per byte and any remainder in the low bits of the last byte.
+    // Bits are gathered into a 64-bit accumulator a byte at a time and
+    // handed out a field at a time, and no byte is read before the old
+    // bit-serial reader would have read it.
     U32 bitUnpack(U8 *total_retval, U32 total_dsize)
     {
-        U32 dsize;
-        U8  *retval;
+        if (!mLoadSize)
+        {
+            // byte aligned, so whole bytes come straight from the buffer
+            U32 bytes = total_dsize / MAX_DATA_BITS;
+            memcpy(total_retval, mBuffer + mBufferSize, bytes);
+            mBufferSize += bytes;
+            total_retval += bytes;
+            total_dsize -= bytes * MAX_DATA_BITS;
+        }
 
+        // the low 'avail' bits of 'bits' are the next ones to read
+        U64 bits = mLoad >> (MAX_DATA_BITS - mLoadSize);
+        U32 avail = mLoadSize;
         while (total_dsize > 0)
         {
-            if (total_dsize > MAX_DATA_BITS)
+            U32 dsize = total_dsize > MAX_DATA_BITS ? MAX_DATA_BITS : total_dsize;
+            total_dsize -= dsize;
+            if (avail < dsize)
             {
-                dsize = MAX_DATA_BITS;
-                total_dsize -= MAX_DATA_BITS;
-            }
-            else
-            {
-                dsize = total_dsize;
-                total_dsize = 0;
-            }
-
-            retval = total_retval++;
-            *retval = 0x00;
-            while (dsize > 0) 
-            {
-                if (mLoadSize == 0) 
+                U32 needed = dsize + total_dsize;
+                while (avail < needed && avail <= 64 - MAX_DATA_BITS)
                 {
 #ifdef _DEBUG
                     if (mBufferSize > mMaxSize)
@@ -169,16 +176,15 @@ public:
                         LL_ERRS() << mBufferSize << " > " << mMaxSize << LL_ENDL;
                     }
 #endif
-                    mLoad = *(mBuffer + mBufferSize++);
-                    mLoadSize = MAX_DATA_BITS;
+                    bits = (bits << MAX_DATA_BITS) | *(mBuffer + mBufferSize++);
+                    avail += MAX_DATA_BITS;
                 }
-                *retval <<= 1;
-                *retval |= (mLoad >> (MAX_DATA_BITS - 1));
-                mLoadSize--;
-                mLoad <<= 1;
-                dsize--;
             }
+            avail -= dsize;
+            *total_retval++ = (U8)((bits >> avail) & ((1 << dsize) - 1));
         }
+        mLoad = (U8)(bits << (MAX_DATA_BITS - avail));
+        mLoadSize = avail;
         return mBufferSize;
     }
 
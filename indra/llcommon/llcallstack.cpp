@@ -31,6 +31,10 @@
 #include "StackWalker.h"
 #include "llthreadlocalstorage.h"
 
+#if LL_LINUX || LL_DARWIN
+#include <execinfo.h>
+#endif
+
 #if LL_WINDOWS
 class LLCallStackImpl: public StackWalker
 {
@@ -89,6 +93,33 @@ LLCallStack::LLCallStack(S32 skip_count, bool verbose):
     s_impl->getStack(m_strings, m_skipCount, m_verbose);
 }
 
+// static
+S32 LLCallStack::captureFrames(void** frames, S32 max_frames, S32 skip_count)
+{
+    if (!frames || max_frames <= 0)
+    {
+        return 0;
+    }
+#if LL_WINDOWS
+    // +1 skips this function
+    return CaptureStackBackTrace(skip_count + 1, max_frames, frames, NULL);
+#elif LL_LINUX || LL_DARWIN
+    const S32 MAX_RAW_FRAMES = 64;
+    void* raw[MAX_RAW_FRAMES];
+    S32 skip = llmax(skip_count, 0) + 1;
+    S32 count = backtrace(raw, llmin(max_frames + skip, MAX_RAW_FRAMES));
+    count = llmax(count - skip, 0);
+    count = llmin(count, max_frames);
+    for (S32 i = 0; i < count; ++i)
+    {
+        frames[i] = raw[i + skip];
+    }
+    return count;
+#else
+    return 0;
+#endif
+}
+
 bool LLCallStack::contains(const std::string& str)
 {
     for (std::vector<std::string>::const_iterator it = m_strings.begin();
@@ -35,6 +35,11 @@ public:
     std::vector<std::string> m_strings;
     bool m_verbose;
     bool contains(const std::string& str);
+
+    // Raw return addresses of the calling thread, without symbol lookup.
+    // Cheap enough for hot paths such as allocation sampling; returns the
+    // number of frames written to frames.
+    static S32 captureFrames(void** frames, S32 max_frames, S32 skip_count=0);
 private:
     static LLCallStackImpl *s_impl;
     S32 m_skipCount;
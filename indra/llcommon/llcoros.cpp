@@ -35,7 +35,9 @@
 // STL headers
 // std headers
 #include <atomic>
+#include <mutex>
 #include <stdexcept>
+#include <vector>
 // external library headers
 #include <boost/bind.hpp>
 #include <boost/fiber/fiber.hpp>
@@ -117,6 +119,160 @@ std::string LLCoros::getStatus()
 {
     return get_CoroData("getStatus()").mStatus;
 }
+/*****************************************************************************
+*   Stack pool
+*****************************************************************************/
+// Guarded stacks from finished coroutines, kept for the next launch().
+// Mapping a stack plus guard page and unmapping it again costs several
+// syscalls and a run of page faults per coroutine, and the viewer
+// launches short-lived coroutines by the hundreds.
+class LLCoros::StackPool
+{
+public:
+    typedef boost::context::stack_context stack_t;
+
+    StackPool(size_t max_pooled):
+        mMaxPooled(max_pooled),
+        mHits(0),
+        mMisses(0),
+        mInUse(0),
+        mHighWater(0)
+    {}
+
+    ~StackPool()
+    {
+        for (const Entry& entry : mStacks)
+        {
+            release(entry);
+        }
+    }
+
+    stack_t allocate(size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            bumpInUse();
+            // Only reuse stacks of the size asked for: setStackSize()
+            // may have changed it since they were pooled.
+            while (! mStacks.empty())
+            {
+                Entry entry(mStacks.back());
+                mStacks.pop_back();
+                if (entry.mSize == size)
+                {
+                    ++mHits;
+                    return entry.mStack;
+                }
+                release(entry);
+            }
+            ++mMisses;
+        }
+        // Map outside the lock
+        try
+        {
+            return boost::fibers::protected_fixedsize_stack(size).allocate();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mInUse;
+            throw;
+        }
+    }
+
+    void deallocate(stack_t& stack, size_t size)
+    {
+        Entry entry{ stack, size };
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mInUse;
+            if (mStacks.size() < mMaxPooled)
+            {
+                mStacks.push_back(entry);
+                return;
+            }
+        }
+        release(entry);
+    }
+
+    void setMaxPooled(size_t max_pooled)
+    {
+        std::vector<Entry> excess;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mMaxPooled = max_pooled;
+            while (mStacks.size() > mMaxPooled)
+            {
+                excess.push_back(mStacks.back());
+                mStacks.pop_back();
+            }
+        }
+        for (const Entry& entry : excess)
+        {
+            release(entry);
+        }
+    }
+
+    StackStats getStats() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return { mHits, mMisses, U32(mStacks.size()), mInUse, mHighWater };
+    }
+
+private:
+    struct Entry
+    {
+        stack_t mStack;
+        size_t  mSize;              // as requested, not as mapped
+    };
+
+    void bumpInUse()
+    {
+        if (++mInUse > mHighWater)
+        {
+            mHighWater = mInUse;
+        }
+    }
+
+    static void release(Entry entry)
+    {
+        boost::fibers::protected_fixedsize_stack(entry.mSize).deallocate(entry.mStack);
+    }
+
+    mutable std::mutex mMutex;
+    std::vector<Entry> mStacks;
+    size_t mMaxPooled;
+    U64 mHits;
+    U64 mMisses;
+    U32 mInUse;
+    U32 mHighWater;
+};
+
+// StackAllocator handed to each fiber. Fibers copy it into their own
+// control block and call deallocate() on that copy when they finish.
+class LLCoros::PooledStack
+{
+public:
+    PooledStack(const std::shared_ptr<StackPool>& pool, size_t size):
+        mPool(pool),
+        mSize(size)
+    {}
+
+    boost::context::stack_context allocate()
+    {
+        return mPool->allocate(mSize);
+    }
+
+    void deallocate(boost::context::stack_context& stack) BOOST_NOEXCEPT_OR_NOTHROW
+    {
+        mPool->deallocate(stack, mSize);
+    }
+
+private:
+    std::shared_ptr<StackPool> mPool;
+    size_t mSize;
+};
+
 LLCoros::LLCoros():
     // MAINT-2724: default coroutine stack size too small on Windows.
     // Previously we used
@@ -127,6 +283,8 @@ LLCoros::LLCoros():
 #else
     mStackSize(256*1024),
 #endif
+    // Enough for a burst of name lookups or HTTP calls
+    mStackPool(std::make_shared<StackPool>(16)),
     // mCurrent does NOT own the current CoroData instance -- it simply
     // points to it. So initialize it with a no-op deleter.
     mCurrent{ [](CoroData*){} }
@@ -236,10 +394,25 @@ void LLCoros::setStackSize(S32 stacksize)
     mStackSize = stacksize;
 }
 
+void LLCoros::setStackPoolSize(U32 size)
+{
+    LL_DEBUGS("LLCoros") << "Setting coroutine stack pool size to " << size << LL_ENDL;
+    mStackPool->setMaxPooled(size);
+}
+
+LLCoros::StackStats LLCoros::getStackStats() const
+{
+    return mStackPool->getStats();
+}
+
 void LLCoros::printActiveCoroutines(const std::string& when)
 {
     LL_INFOS("LLCoros") << "Number of active coroutines " << when
                         << ": " << CoroData::instanceCount() << LL_ENDL;
+    StackStats stacks(getStackStats());
+    LL_INFOS("LLCoros") << "Coroutine stacks: " << stacks.mInUse << " in use, "
+                        << stacks.mPooled << " pooled, high water " << stacks.mHighWater
+                        << ", pool hits " << stacks.mHits << " misses " << stacks.mMisses << LL_ENDL;
     if (CoroData::instanceCount() > 0)
     {
         LL_INFOS("LLCoros") << "-------------- List of active coroutines ------------";
@@ -265,12 +438,14 @@ std::string LLCoros::launch(const std::string& prefix, const callable_t& callabl
     // protected_fixedsize_stack sets a guard page past the end of the new
     // stack so that stack underflow will result in an access violation
     // instead of weird, subtle, possibly undiagnosed memory stomps.
+    // PooledStack hands out such stacks, reusing those of coroutines
+    // that have finished.
 
     try
     {
         boost::fibers::fiber newCoro(boost::fibers::launch::dispatch,
             std::allocator_arg,
-            boost::fibers::protected_fixedsize_stack(mStackSize),
+            PooledStack(mStackPool, mStackSize),
             [this, &name, &callable]() { toplevel(name, callable); });
 
         // You have two choices with a fiber instance: you can join() it or you
@@ -39,6 +39,7 @@
 #include <boost/function.hpp>
 #include <string>
 #include <exception>
+#include <memory>
 #include <queue>
 
 // e.g. #include LLCOROS_MUTEX_HEADER
@@ -186,6 +187,25 @@ public:
      */
     void setStackSize(S32 stacksize);
 
+    /**
+     * Stacks of finished coroutines are kept, guard page and all, for
+     * reuse by later launch() calls instead of being unmapped. This
+     * caps how many are kept; 0 disables pooling. Excess stacks are
+     * released immediately.
+     */
+    void setStackPoolSize(U32 size);
+
+    /// Stack pool counters, for diagnostics and benchmarks
+    struct StackStats
+    {
+        U64 mHits;          // launches served from the pool
+        U64 mMisses;        // launches that had to map a new stack
+        U32 mPooled;        // stacks waiting in the pool
+        U32 mInUse;         // stacks held by live coroutines
+        U32 mHighWater;     // most stacks in use at once
+    };
+    StackStats getStackStats() const;
+
     /// diagnostic
     void printActiveCoroutines(const std::string& when=std::string());
 
@@ -331,6 +351,12 @@ private:
 
     S32 mStackSize;
 
+    // Shared with every stack allocator handed to a fiber, so stacks
+    // released after we're gone are still freed properly.
+    class StackPool;
+    class PooledStack;
+    std::shared_ptr<StackPool> mStackPool;
+
     // coroutine-local storage, as it were: one per coro we track
     struct CoroData: public LLInstanceTracker<CoroData, std::string>
     {
@@ -40,11 +40,13 @@
 #include <sstream>
 #include <algorithm>
 // std headers
+#include <atomic>
 #include <typeinfo>
 #include <cmath>
 #include <cctype>
 // external library headers
 #include <boost/range/iterator_range.hpp>
+#include <boost/container/small_vector.hpp>
 #if LL_WINDOWS
 #pragma warning (push)
 #pragma warning (disable : 4701) // compiler thinks might use uninitialized var, but no
@@ -58,6 +60,7 @@
 #include "llerror.h"
 #include "llsdutil.h"
 #include "llexception.h"
+#include "llmutex.h"
 #if LL_MSVC
 #pragma warning (disable : 4702)
 #endif
@@ -270,6 +273,266 @@ LLEventPumps::~LLEventPumps()
     reset();
 }
 
+/*****************************************************************************
+*   LLEventPump::ListenerList
+*****************************************************************************/
+// mSignal still owns each listener's connection, so LLBoundListener, Blocker
+// and LLEventTrackable behave as they always have. But listen_impl() connects
+// a stand-in to mSignal rather than the caller's listener. boost::signals2
+// destroys that stand-in as soon as its connection is disconnected, however
+// that happens, and the stand-in's destructor marks our own copy of the
+// listener dead. post() then walks an immutable snapshot of those copies in
+// mSignal's float order without going through the signal's locks, its
+// invocation state or its slot_call_iterator.
+// As with a signals2 slot, a dead listener (and whatever it captured) is
+// destroyed right away, or as soon as the last call to it already under way
+// returns -- not when the list next drops the dead entries.
+class LLEventPump::ListenerList
+{
+public:
+    struct Entry
+    {
+        Entry(float order, const LLEventListener& listener):
+            mOrder(order),
+            mListener(listener),
+            mTracked(! listener.tracked_objects().empty()),
+            mState(0),
+            mReleased(false)
+        {}
+
+        bool live() const { return ! (mState & DEAD); }
+
+        void kill()
+        {
+            if (mState.fetch_or(DEAD) == 0)
+            {
+                release();
+            }
+        }
+
+        // Bracket each call: enter() returns false if the entry is dead.
+        bool enter()
+        {
+            if (mState.fetch_add(CALL) & DEAD)
+            {
+                leave();
+                return false;
+            }
+            return true;
+        }
+
+        void leave()
+        {
+            if (mState.fetch_sub(CALL) == (CALL | DEAD))
+            {
+                release();
+            }
+        }
+
+        const float mOrder;
+        // only valid between enter() and leave()
+        boost::optional<LLEventListener> mListener;
+        // only tracked slots need lock() around the call
+        const bool mTracked;
+        LLBoundListener mConnection;
+
+    private:
+        void release()
+        {
+            if (! mReleased.exchange(true))
+            {
+                mListener.reset();
+            }
+        }
+
+        // DEAD, plus CALL times the number of calls in progress
+        enum : U32 { DEAD = 1, CALL = 2 };
+        std::atomic<U32> mState;
+        std::atomic<bool> mReleased;
+    };
+
+    class CallScope
+    {
+    public:
+        CallScope(Entry& entry): mEntry(entry), mEntered(entry.enter()) {}
+        ~CallScope() { if (mEntered) mEntry.leave(); }
+        explicit operator bool() const { return mEntered; }
+
+    private:
+        Entry& mEntry;
+        const bool mEntered;
+    };
+    typedef std::shared_ptr<Entry> EntryPtr;
+    // Most pumps have only a handful of listeners.
+    typedef boost::container::small_vector<EntryPtr, 8> Snapshot;
+
+    // What we actually connect to mSignal. It is never called; it exists to
+    // be destroyed when the connection goes away.
+    class Proxy
+    {
+    public:
+        Proxy(const std::shared_ptr<ListenerList>& list, const EntryPtr& entry):
+            mToken(std::make_shared<Token>(list, entry))
+        {}
+
+        bool operator()(const LLSD&) const { return false; }
+
+    private:
+        struct Token
+        {
+            Token(const std::shared_ptr<ListenerList>& list, const EntryPtr& entry):
+                mList(list),
+                mEntry(entry)
+            {}
+
+            ~Token()
+            {
+                EntryPtr entry(mEntry.lock());
+                if (entry)
+                {
+                    entry->kill();
+                }
+                std::shared_ptr<ListenerList> list(mList.lock());
+                if (list)
+                {
+                    list->mDirty = true;
+                }
+            }
+
+            std::weak_ptr<ListenerList> mList;
+            std::weak_ptr<Entry> mEntry;
+        };
+        std::shared_ptr<Token> mToken;
+    };
+
+    ListenerList():
+        mSnapshot(std::make_shared<Snapshot>()),
+        mDirty(false)
+    {}
+
+    void add(const EntryPtr& entry)
+    {
+        LLMutexLock lock(&mMutex);
+        // same place mSignal puts it: after every entry in the same group
+        mEntries.insert(std::upper_bound(mEntries.begin(), mEntries.end(), entry,
+                                         [](const EntryPtr& a, const EntryPtr& b)
+                                         { return a->mOrder < b->mOrder; }),
+                        entry);
+        publish();
+    }
+
+    void clear()
+    {
+        LLMutexLock lock(&mMutex);
+        for (const EntryPtr& entry : mEntries)
+        {
+            entry->kill();
+        }
+        mEntries.clear();
+        publish();
+    }
+
+    std::shared_ptr<const Snapshot> snapshot()
+    {
+        if (mDirty)
+        {
+            // somebody disconnected: drop the dead entries
+            LLMutexLock lock(&mMutex);
+            publish();
+        }
+        return std::atomic_load(&mSnapshot);
+    }
+
+    // Same semantics as LLStopWhenHandled over mSignal.
+    static bool dispatch(const Snapshot& snapshot, const LLSD& event)
+    {
+        for (const EntryPtr& entry : snapshot)
+        {
+            // An earlier listener may have disconnected or blocked this one.
+            if (! entry->live() || (Blocker::any() && entry->mConnection.blocked()))
+            {
+                continue;
+            }
+            // keeps the listener alive until the call returns, even if it
+            // disconnects itself or another thread disconnects it meanwhile
+            CallScope call(*entry);
+            if (! call)
+            {
+                continue;
+            }
+            try
+            {
+                if (! entry->mTracked)
+                {
+                    if (entry->mListener->slot_function()(event))
+                    {
+                        return true;
+                    }
+                }
+                else if (! entry->mListener->expired())
+                {
+                    // operator() holds the tracked objects across the call
+                    if ((*entry->mListener)(event))
+                    {
+                        return true;
+                    }
+                }
+            }
+            catch (const boost::signals2::expired_slot&)
+            {
+                // tracked object went away after the expired() check: what
+                // mSignal would have done is skip it
+            }
+            catch (const LLContinueError&)
+            {
+                LOG_UNHANDLED_EXCEPTION("LLEventPump");
+            }
+        }
+        return false;
+    }
+
+private:
+    // caller must hold mMutex
+    void publish()
+    {
+        mDirty = false;
+        mEntries.erase(std::remove_if(mEntries.begin(), mEntries.end(),
+                                      [](const EntryPtr& entry){ return ! entry->live(); }),
+                       mEntries.end());
+        std::shared_ptr<const Snapshot> snapshot(
+            std::make_shared<Snapshot>(mEntries.begin(), mEntries.end()));
+        std::atomic_store(&mSnapshot, snapshot);
+    }
+
+    LLMutex mMutex;
+    // sorted by mOrder, guarded by mMutex
+    std::vector<EntryPtr> mEntries;
+    std::shared_ptr<const Snapshot> mSnapshot;
+    std::atomic<bool> mDirty;
+};
+
+/*****************************************************************************
+*   LLEventPump::Blocker
+*****************************************************************************/
+std::atomic<S32> LLEventPump::Blocker::sCount(0);
+
+LLEventPump::Blocker::Blocker(const LLBoundListener& conn, bool initially_blocked):
+    boost::signals2::shared_connection_block(conn, initially_blocked)
+{
+    ++sCount;
+}
+
+LLEventPump::Blocker::Blocker(const Blocker& other):
+    boost::signals2::shared_connection_block(other)
+{
+    ++sCount;
+}
+
+LLEventPump::Blocker::~Blocker()
+{
+    --sCount;
+}
+
 /*****************************************************************************
 *   LLEventPump
 *****************************************************************************/
@@ -285,6 +548,7 @@ LLEventPump::LLEventPump(const std::string& name, bool tweak):
     mRegistry(LLEventPumps::instance().getHandle()),
     mName(mRegistry.get()->registerNew(*this, name, tweak)),
     mSignal(std::make_shared<LLStandardSignal>()),
+    mListeners(std::make_shared<ListenerList>()),
     mEnabled(true)
 {}
 
@@ -317,6 +581,7 @@ void LLEventPump::clear()
     // Destroy the original LLStandardSignal instance, replacing it with a
     // whole new one.
     mSignal = std::make_shared<LLStandardSignal>();
+    mListeners->clear();
     mConnections.clear();
 }
 
@@ -334,6 +599,7 @@ void LLEventPump::reset()
     mConnections.clear();
 
     mSignal.reset();
+    mListeners->clear();
     //mDeps.clear();
 }
 
@@ -494,8 +760,15 @@ LLBoundListener LLEventPump::listen_impl(const std::string& name, const LLEventL
         nodePosition = newNode;
     }
     // Now that newNode has a value that places it appropriately in mSignal,
-    // connect it.
-    LLBoundListener bound = mSignal->connect(nodePosition, listener);
+    // connect it. mSignal gets a stand-in that carries the listener's
+    // tracked objects, so connected() still goes false when they expire;
+    // mListeners gets the listener itself.
+    ListenerList::EntryPtr entry(std::make_shared<ListenerList::Entry>(nodePosition, listener));
+    LLEventListener proxy = ListenerList::Proxy(mListeners, entry);
+    proxy.track(listener);
+    LLBoundListener bound = mSignal->connect(nodePosition, proxy);
+    entry->mConnection = bound;
+    mListeners->add(entry);
     
     if (!name.empty())
     {   // note that we are not tracking anonymous listeners here either.
@@ -542,21 +815,21 @@ bool LLEventStream::post(const LLSD& event)
         return false;
     }
     // NOTE NOTE NOTE: Any new access to member data beyond this point should
-    // cause us to move our LLStandardSignal object to a pimpl class along
-    // with said member data. Then the local shared_ptr will preserve both.
-
-    // DEV-43463: capture a local copy of mSignal. We've turned up a
-    // cross-coroutine scenario (described in the Jira) in which this post()
-    // call could end up destroying 'this', the LLEventPump subclass instance
-    // containing mSignal, during the call through *mSignal. So -- capture a
-    // *stack* instance of the shared_ptr, ensuring that our heap
-    // LLStandardSignal object will live at least until post() returns, even
-    // if 'this' gets destroyed during the call.
-    std::shared_ptr<LLStandardSignal> signal(mSignal);
+    // cause us to move it into ListenerList::Snapshot. Then the local
+    // shared_ptr will preserve it.
+
+    // DEV-43463: capture a local copy of the listener snapshot. We've turned
+    // up a cross-coroutine scenario (described in the Jira) in which this
+    // post() call could end up destroying 'this', the LLEventPump subclass
+    // instance containing mListeners, during a listener call. So -- capture a
+    // *stack* instance of the shared_ptr, ensuring that the snapshot and the
+    // listeners it holds will live at least until post() returns, even if
+    // 'this' gets destroyed during the call.
+    std::shared_ptr<const ListenerList::Snapshot> snapshot(mListeners->snapshot());
     // Let caller know if any one listener handled the event. This is mostly
     // useful when using LLEventStream as a listener for an upstream
     // LLEventPump.
-    return (*signal)(event);
+    return ListenerList::dispatch(*snapshot, event);
 }
 
 /*****************************************************************************
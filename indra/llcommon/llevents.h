@@ -32,6 +32,7 @@
 #if ! defined(LL_LLEVENTS_H)
 #define LL_LLEVENTS_H
 
+#include <atomic>
 #include <string>
 #include <map>
 #include <set>
@@ -530,8 +531,24 @@ public:
      *     // code that needs the connection blocked
      * } // unblock the connection again
      * @endcode
+     * Use this rather than a bare boost::signals2::shared_connection_block:
+     * post() only checks for blocked listeners while some Blocker exists.
      */
-    typedef boost::signals2::shared_connection_block Blocker;
+    class LL_COMMON_API Blocker: public boost::signals2::shared_connection_block
+    {
+    public:
+        Blocker(const LLBoundListener& conn=LLBoundListener(), bool initially_blocked=true);
+        Blocker(const Blocker& other);
+        ~Blocker();
+        Blocker& operator=(const Blocker&) = default;
+
+        /// While no Blocker exists anywhere, post() need not ask each
+        /// listener's connection whether it's blocked.
+        static bool any() { return sCount.load(std::memory_order_relaxed) > 0; }
+
+    private:
+        static std::atomic<S32> sCount;
+    };
     /// Unregister a listener by name. Prefer this to
     /// <tt>getListener(name).disconnect()</tt> because stopListening() also
     /// forgets this name.
@@ -570,8 +587,13 @@ protected:
                                         const NameList& after,
                                         const NameList& before);
     
-    /// implement the dispatching
+    /// owns the connection for every listener: LLBoundListener, Blocker and
+    /// LLEventTrackable all operate on mSignal
     std::shared_ptr<LLStandardSignal> mSignal;
+    /// implement the dispatching: priority-ordered snapshot of the listeners
+    /// connected to mSignal, which post() walks without locking
+    class ListenerList;
+    std::shared_ptr<ListenerList> mListeners;
 
     /// valve open?
     bool mEnabled;
@@ -594,8 +616,8 @@ protected:
 *   LLEventStream
 *****************************************************************************/
 /**
- * LLEventStream is a thin wrapper around LLStandardSignal. Posting an
- * event immediately calls all registered listeners.
+ * LLEventStream is a thin wrapper around LLEventPump's listener list.
+ * Posting an event immediately calls all registered listeners.
  */
 class LL_COMMON_API LLEventStream: public LLEventPump
 {
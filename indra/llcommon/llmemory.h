@@ -27,6 +27,7 @@
 #define LLMEMORY_H
 
 #include "linden_common.h"
+#include "llallocator.h"
 #include "llunits.h"
 #include "stdtypes.h"
 #if !LL_WINDOWS
@@ -152,6 +153,7 @@ public:                                     \
         void* ret = aligned;
     #endif
         LL_PROFILE_ALLOC(ret, size);
+        LLAllocator::noteAlloc(ret, size);
         return ret;
     }
 
@@ -159,6 +161,7 @@ public:                                     \
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
         LL_PROFILE_FREE(ptr);
+        LLAllocator::noteFree(ptr);
     #if defined(LL_WINDOWS)
         (_aligned_free)(ptr);
     #else
@@ -185,6 +188,7 @@ inline void* ll_aligned_malloc_16(size_t size) // returned hunk MUST be freed wi
         return nullptr;
 #endif
     LL_PROFILE_ALLOC(ret, size);
+    LLAllocator::noteAlloc(ret, size);
     return ret;
 }
 
@@ -192,6 +196,7 @@ inline void ll_aligned_free_16(void *p)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
     LL_PROFILE_FREE(p);
+    LLAllocator::noteFree(p);
 #if defined(LL_WINDOWS)
     _aligned_free(p);
 #elif defined(LL_DARWIN)
@@ -206,9 +211,13 @@ inline void* ll_aligned_realloc_16(void* ptr, size_t size, size_t old_size) // r
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
     LL_PROFILE_FREE(ptr);
 #if defined(LL_WINDOWS)
+    LLAllocator::noteFree(ptr);
     void* ret = _aligned_realloc(ptr, size, 16);
+    LLAllocator::noteAlloc(ret, size);
 #elif defined(LL_DARWIN)
+    LLAllocator::noteFree(ptr);
     void* ret = realloc(ptr,size); // default osx malloc is 16 byte aligned.
+    LLAllocator::noteAlloc(ret, size);
 #else
     //FIXME: memcpy is SLOW
     void* ret = ll_aligned_malloc_16(size);
@@ -239,6 +248,7 @@ inline void* ll_aligned_malloc_32(size_t size) // returned hunk MUST be freed wi
         return nullptr;
 #endif
     LL_PROFILE_ALLOC(ret, size);
+    LLAllocator::noteAlloc(ret, size);
     return ret;
 }
 
@@ -246,6 +256,7 @@ inline void ll_aligned_free_32(void *p)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
     LL_PROFILE_FREE(p);
+    LLAllocator::noteFree(p);
 #if defined(LL_WINDOWS)
     _aligned_free(p);
 #elif defined(LL_DARWIN)
@@ -265,6 +276,7 @@ LL_FORCE_INLINE void* ll_aligned_malloc(size_t size)
     {
         ret = malloc(size);
         LL_PROFILE_ALLOC(ret, size);
+        LLAllocator::noteAlloc(ret, size);
     }
     else if (ALIGNMENT == 16)
     {
@@ -288,6 +300,7 @@ LL_FORCE_INLINE void ll_aligned_free(void* ptr)
     if (ALIGNMENT == LL_DEFAULT_HEAP_ALIGN)
     {
         LL_PROFILE_FREE(ptr);
+        LLAllocator::noteFree(ptr);
         free(ptr);
     }
     else if (ALIGNMENT == 16)
@@ -773,6 +773,46 @@ std::string llsd_matches(const LLSD& prototype, const LLSD& data, const std::str
     return match_types(prototype.type(), TypeVector(), data.type(), pfx);
 }
 
+size_t llsd_footprint(const LLSD& sd)
+{
+    // rough per-allocation costs: a refcounted LLSD::Impl, and a std::map node
+    // holding a key and an LLSD
+    const size_t IMPL_BYTES = 32;
+    const size_t MAP_NODE_BYTES = 32 + sizeof(std::string) + sizeof(LLSD);
+
+    size_t bytes = 0;
+    switch (sd.type())
+    {
+    case LLSD::TypeUndefined:
+        break;
+    case LLSD::TypeString:
+    case LLSD::TypeURI:
+        bytes += IMPL_BYTES + sd.asStringRef().capacity();
+        break;
+    case LLSD::TypeBinary:
+        bytes += IMPL_BYTES + sd.asBinary().capacity();
+        break;
+    case LLSD::TypeMap:
+        bytes += IMPL_BYTES;
+        for (LLSD::map_const_iterator it = sd.beginMap(); it != sd.endMap(); ++it)
+        {
+            bytes += MAP_NODE_BYTES + it->first.capacity() + llsd_footprint(it->second);
+        }
+        break;
+    case LLSD::TypeArray:
+        bytes += IMPL_BYTES + sd.size() * sizeof(LLSD);
+        for (LLSD::array_const_iterator it = sd.beginArray(); it != sd.endArray(); ++it)
+        {
+            bytes += llsd_footprint(*it);
+        }
+        break;
+    default:
+        bytes += IMPL_BYTES;
+        break;
+    }
+    return bytes;
+}
+
 bool llsd_equals(const LLSD& lhs, const LLSD& rhs, int bits)
 {
     LL_PROFILE_ZONE_SCOPED
@@ -143,6 +143,11 @@ LL_COMMON_API std::string llsd_matches(const LLSD& prototype, const LLSD& data,
 /// equality rather than bitwise equality, pass @a bits as for
 /// is_approx_equal_fraction().
 LL_COMMON_API bool llsd_equals(const LLSD& lhs, const LLSD& rhs, int bits=-1);
+/// Approximate heap bytes held by an LLSD tree, for memory accounting of
+/// caches that keep LLSD around.  Counts one allocation per non-undefined
+/// value plus string, binary, map and array storage.
+LL_COMMON_API size_t llsd_footprint(const LLSD& sd);
+
 /// If you don't care about LLSD::Real equality
 inline bool operator==(const LLSD& lhs, const LLSD& rhs)
 {
@@ -35,6 +35,57 @@ namespace LLTrace
 
 MemStatHandle gTraceMemStat("LLTrace");
 
+// static
+U32 MemStatHandle::get_live_counter_slot()
+{
+    static std::atomic<U32> sNextSlot(0);
+    static thread_local U32 sSlot = sNextSlot++ % NUM_LIVE_COUNTERS;
+    return sSlot;
+}
+
+S64 MemStatHandle::getLiveBytes() const
+{
+    S64 bytes = 0;
+    for (S32 i = 0; i < NUM_LIVE_COUNTERS; ++i)
+    {
+        bytes += mLiveCounters[i].mBytes.load(std::memory_order_relaxed);
+    }
+    return bytes;
+}
+
+S64 MemStatHandle::getLiveCount() const
+{
+    S64 count = 0;
+    for (S32 i = 0; i < NUM_LIVE_COUNTERS; ++i)
+    {
+        count += mLiveCounters[i].mCount.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void log_mem_stats()
+{
+    typedef std::pair<S64, const MemStatHandle*> entry_t;
+    std::vector<entry_t> entries;
+    for (auto& stat : StatType<MemAccumulator>::instance_snapshot())
+    {
+        const MemStatHandle* handle = dynamic_cast<const MemStatHandle*>(&stat);
+        if (handle)
+        {
+            entries.push_back(entry_t(handle->getLiveBytes(), handle));
+        }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const entry_t& a, const entry_t& b) { return a.first > b.first; });
+
+    LL_INFOS("Memory") << "Tracked memory by category:" << LL_ENDL;
+    for (const entry_t& entry : entries)
+    {
+        LL_INFOS("Memory") << "  " << entry.second->getName() << ": " << (entry.first / 1024) << " KB in "
+                           << entry.second->getLiveCount() << " objects" << LL_ENDL;
+    }
+}
+
 StatBase::StatBase( const char* name, const char* description ) 
 :   mName(name),
     mDescription(description ? description : "")
@@ -38,6 +38,8 @@
 #include "llpointer.h"
 #include "llunits.h"
 
+#include <atomic>
+
 #define LL_TRACE_ENABLED 1
 
 namespace LLTrace
@@ -263,6 +265,36 @@ public:
         LL_PROFILE_ZONE_SCOPED_CATEGORY_STATS;
         return static_cast<StatType<MemAccumulator::DeallocationFacet>&>(*(StatType<MemAccumulator>*)this);
     }
+
+    // Live bytes and object count summed over all threads.  Unlike the
+    // recorded values these need no thread recorder and are current at
+    // any moment, so they stay correct when memory is claimed on one
+    // thread and released on another.
+    S64 getLiveBytes() const;
+    S64 getLiveCount() const;
+
+    void addLive(S64 bytes, S64 count)
+    {
+        LiveCounter& counter = mLiveCounters[get_live_counter_slot()];
+        counter.mBytes.fetch_add(bytes, std::memory_order_relaxed);
+        counter.mCount.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+    static U32 get_live_counter_slot();
+
+    // Each thread updates one of these, so concurrent claims from different
+    // threads rarely touch the same cache line.  No constructor on purpose:
+    // stat handles are statics, so the counters are zeroed before any other
+    // static initializer can claim memory against them.
+    enum { NUM_LIVE_COUNTERS = 16 };
+    struct LiveCounter
+    {
+        std::atomic<S64> mBytes;
+        std::atomic<S64> mCount;
+        char mPad[64 - 2 * sizeof(std::atomic<S64>)];
+    };
+    LiveCounter mLiveCounters[NUM_LIVE_COUNTERS];
 };
 
 
@@ -342,6 +374,24 @@ struct MeasureMem<U32, IS_MEM_TRACKABLE, IS_BYTES>
     }
 };
 
+template<typename IS_MEM_TRACKABLE, typename IS_BYTES>
+struct MeasureMem<unsigned long, IS_MEM_TRACKABLE, IS_BYTES>
+{
+    static size_t measureFootprint(unsigned long value)
+    {
+        return value;
+    }
+};
+
+template<typename IS_MEM_TRACKABLE, typename IS_BYTES>
+struct MeasureMem<unsigned long long, IS_MEM_TRACKABLE, IS_BYTES>
+{
+    static size_t measureFootprint(unsigned long long value)
+    {
+        return (size_t)value;
+    }
+};
+
 template<typename T, typename IS_MEM_TRACKABLE, typename IS_BYTES>
 struct MeasureMem<std::basic_string<T>, IS_MEM_TRACKABLE, IS_BYTES>
 {
@@ -353,16 +403,40 @@ struct MeasureMem<std::basic_string<T>, IS_MEM_TRACKABLE, IS_BYTES>
 };
 
 
+inline void record_mem_delta(MemStatHandle& measurement, S64 delta)
+{
+#if LL_TRACE_ENABLED
+    // Only a thread with its own recorder records the delta.  Elsewhere
+    // (worker threads, say) getCurrentAccumulator() would hand out the shared
+    // default buffer, which is not safe to write from several threads; the
+    // atomic live counters already have the change.
+    MemAccumulator* accumulator_storage = LLThreadLocalSingletonPointer<MemAccumulator>::getInstance();
+    if (!accumulator_storage)
+    {
+        return;
+    }
+    MemAccumulator& accumulator = accumulator_storage[measurement.getIndex()];
+    accumulator.mSize.sample(accumulator.mSize.hasValue() ? accumulator.mSize.getLastValue() + (F64)delta : (F64)delta);
+    if (delta > 0)
+    {
+        accumulator.mAllocations.record((F64)delta);
+    }
+    else
+    {
+        accumulator.mDeallocations.add((F64)-delta);
+    }
+#endif
+}
+
 template<typename T>
 inline void claim_alloc(MemStatHandle& measurement, const T& value)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_STATS;
 #if LL_TRACE_ENABLED
-    S32 size = MeasureMem<T>::measureFootprint(value);
+    S64 size = MeasureMem<T>::measureFootprint(value);
     if(size == 0) return;
-    MemAccumulator& accumulator = measurement.getCurrentAccumulator();
-    accumulator.mSize.sample(accumulator.mSize.hasValue() ? accumulator.mSize.getLastValue() + (F64)size : (F64)size);
-    accumulator.mAllocations.record(size);
+    measurement.addLive(size, 1);
+    record_mem_delta(measurement, size);
 #endif
 }
 
@@ -371,14 +445,73 @@ inline void disclaim_alloc(MemStatHandle& measurement, const T& value)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_STATS;
 #if LL_TRACE_ENABLED
-    S32 size = MeasureMem<T>::measureFootprint(value);
+    S64 size = MeasureMem<T>::measureFootprint(value);
     if(size == 0) return;
-    MemAccumulator& accumulator = measurement.getCurrentAccumulator();
-    accumulator.mSize.sample(accumulator.mSize.hasValue() ? accumulator.mSize.getLastValue() - (F64)size : -(F64)size);
-    accumulator.mDeallocations.add(size);
+    measurement.addLive(-size, -1);
+    record_mem_delta(measurement, -size);
 #endif
 }
 
+// The claim one object holds on a memory stat, for objects whose buffers
+// grow and shrink over their lifetime.  Counts as one object for as long as
+// it exists; setBytes() moves the claimed size, and whatever is still
+// claimed is released on destruction.  A copy is a new object with nothing
+// claimed yet, and assignment leaves the claim alone.  Containers can use
+// setCount() to report how many entries the footprint covers.
+class MemFootprint
+{
+public:
+    MemFootprint(MemStatHandle& measurement)
+    :   mMeasurement(&measurement),
+        mBytes(0),
+        mCount(1)
+    {
+        mMeasurement->addLive(0, mCount);
+    }
+
+    MemFootprint(const MemFootprint& other)
+    :   mMeasurement(other.mMeasurement),
+        mBytes(0),
+        mCount(1)
+    {
+        mMeasurement->addLive(0, mCount);
+    }
+
+    ~MemFootprint()
+    {
+        setBytes(0);
+        mMeasurement->addLive(0, -mCount);
+    }
+
+    MemFootprint& operator=(const MemFootprint&) { return *this; }
+
+    void setBytes(size_t bytes)
+    {
+        S64 delta = (S64)bytes - (S64)mBytes;
+        if (delta)
+        {
+            mBytes = bytes;
+            mMeasurement->addLive(delta, 0);
+            record_mem_delta(*mMeasurement, delta);
+        }
+    }
+
+    void setCount(S64 count)
+    {
+        mMeasurement->addLive(0, count - mCount);
+        mCount = count;
+    }
+
+    size_t getBytes() const { return mBytes; }
+
+private:
+    MemStatHandle*  mMeasurement;
+    size_t          mBytes;
+    S64             mCount;
+};
+
+// Writes live bytes and object counts of every memory stat to the log.
+LL_COMMON_API void log_mem_stats();
 }
 
 #endif // LL_LLTRACE_H
@@ -33,6 +33,36 @@
 #include "../test/lltut.h"
 
 
+namespace
+{
+    // The bit at a time reader LLBitPack::bitUnpack() used to be.
+    U32 reference_unpack(const U8* buffer, U32& buffer_pos, U8& load, U32& load_size,
+                         U8* total_retval, U32 total_dsize)
+    {
+        while (total_dsize > 0)
+        {
+            U32 dsize = total_dsize > MAX_DATA_BITS ? MAX_DATA_BITS : total_dsize;
+            total_dsize -= dsize;
+            U8* retval = total_retval++;
+            *retval = 0x00;
+            while (dsize > 0)
+            {
+                if (load_size == 0)
+                {
+                    load = buffer[buffer_pos++];
+                    load_size = MAX_DATA_BITS;
+                }
+                *retval <<= 1;
+                *retval |= (load >> (MAX_DATA_BITS - 1));
+                load_size--;
+                load <<= 1;
+                dsize--;
+            }
+        }
+        return buffer_pos;
+    }
+}
+
 namespace tut
 {
     struct bit_pack
@@ -115,4 +145,44 @@ namespace tut
         bitunpack.bitUnpack((U8*) &res, sizeof(res)*8);
         ensure("U32->bitPack->bitUnpack->U32 should be equal", num == res); 
     }
+
+    // unpacking random field widths matches the bit-serial reader
+    template<> template<>
+    void bit_pack_object_t::test<4>()
+    {
+        U8 packbuffer[1024];
+        U8 unpacked[64];
+        U8 expected[64];
+        srand(4711);
+        for (S32 i = 0; i < (S32)sizeof(packbuffer); ++i)
+        {
+            packbuffer[i] = (U8)rand();
+        }
+
+        for (S32 round = 0; round < 20; ++round)
+        {
+            LLBitPack bitunpack(packbuffer, sizeof(packbuffer));
+            U32 buffer_pos = 0;
+            U8 load = 0;
+            U32 load_size = 0;
+            U32 bits_left = sizeof(packbuffer) * 8;
+            while (bits_left)
+            {
+                // mostly terrain-style odd widths, sometimes whole words
+                U32 dsize = (rand() % 4) ? rand() % 33 + 1 : (rand() % 8 + 1) * 32;
+                if (dsize > bits_left)
+                {
+                    dsize = bits_left;
+                }
+                bits_left -= dsize;
+
+                U32 pos = bitunpack.bitUnpack(unpacked, dsize);
+                U32 expected_pos = reference_unpack(packbuffer, buffer_pos, load, load_size, expected, dsize);
+                ensure_equals("buffer position", pos, expected_pos);
+                ensure_equals("bits held", bitunpack.mLoadSize, load_size);
+                ensure_equals("held bits", bitunpack.mLoad, load);
+                ensure_memory_matches("unpacked fields", unpacked, (dsize + 7) / 8, expected, (dsize + 7) / 8);
+            }
+        }
+    }
 }
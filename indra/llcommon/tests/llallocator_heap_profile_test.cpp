@@ -41,6 +41,7 @@ namespace tut
         static char const * const sample_lin_profile;
 
         static char const * const crash_testcase;
+        static char const * const sample_v2_profile;
     };
     typedef test_group<llallocator_heap_profile_data> factory;
     typedef factory::object object;
@@ -98,6 +99,21 @@ namespace tut
         ensure("emtpy on error", prof.mLines.empty());
     }
 
+    template<> template<>
+    void object::test<4>()
+    {
+        // sampled profile written by LLAllocator
+        prof.parse(sample_v2_profile);
+
+        ensure_equals("count lines", prof.mLines.size(), 3);
+        ensure_equals("header live bytes", prof.mLines[0].mLiveSize, 12288ULL);
+        ensure_equals("header has no markers", prof.mLines[0].mTrace.size(), 0);
+        ensure_equals("count markers", prof.mLines[1].mTrace.size(), 3);
+        ensure_equals("hex marker", prof.mLines[1].mTrace[0], 0x7f3a12345678ULL);
+        ensure_equals("live count", prof.mLines[2].mLiveCount, 0U);
+        ensure_equals("total bytes", prof.mLines[2].mTotalSize, 512ULL);
+    }
+
 char const * const llallocator_heap_profile_data::sample_win_profile =
 "heap profile: 2131854: 2245710106 [14069198: 4295177308] @\n"
 "308592: 1073398388 [966564: 1280998739] @\n"
@@ -141,4 +157,11 @@ char const * const llallocator_heap_profile_data::crash_testcase =
 "7c420000-7c4a7000 r-xp 00000000 00:00 0           C:\\WINDOWS\\WinSxS\\x86_Microsoft.VC80.CRT_1fc8b3b9a1e18e3b_8.0.50727.1433_x-ww_5cf844d2\\MSVCP80.dll\n"
 "78130000-781cb000 r-xp 00000000 00:00 0           C:\\WINDOWS\\WinSxS\\x86_Microsoft.VC80.CRT_1fc8b3b9a1e18e3b_8.0.50727.1433_x-ww_5cf844d2\\MSVCR80.dll\n";
 
+char const * const llallocator_heap_profile_data::sample_v2_profile =
+"heap profile: 3: 12288 [4: 12800] @ heap_v2/524288\n"
+"3: 12288 [3: 12288] @ 0x7f3a12345678 0x7f3a12340000 0x55d0c0ffee00\n"
+"0: 0 [1: 512] @ 0x55d0c0ffee10\n"
+"\n"
+"MAPPED_LIBRARIES:\n"
+"55d0c0000000-55d0c1000000 r-xp 00000000 08:01 1234 /opt/firestorm/bin/do-not-directly-run-firestorm-bin\n";
 }
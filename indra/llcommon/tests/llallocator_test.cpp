@@ -26,13 +26,24 @@
  * $/LicenseInfo$
  */
 
+#include "linden_common.h"
 #include "../llallocator.h"
+#include "../llmemory.h"
+#include "../lltrace.h"
 #include "../test/lltut.h"
 
+static LLTrace::MemStatHandle sTestMemStat("llallocator_test");
+
 namespace tut
 {
     struct llallocator_data
     {
+        ~llallocator_data()
+        {
+            llallocator.setProfilingEnabled(false);
+            LLAllocator::setSampleInterval(LLAllocator::DEFAULT_SAMPLE_INTERVAL);
+        }
+
         LLAllocator llallocator;
     };
     typedef test_group<llallocator_data> factory;
@@ -52,29 +63,105 @@ namespace tut
         ensure("Profiler disable", !llallocator.isProfiling());
     }
 
-#if LL_USE_TCMALLOC
     template<> template<>
     void object::test<2>()
     {
         llallocator.setProfilingEnabled(true);
         ensure("Profiler enable", llallocator.isProfiling());
+
+        LLAllocator::setSampleInterval(4096);
+        ensure_equals("sample interval", LLAllocator::getSampleInterval(), 4096U);
+        LLAllocator::setSampleInterval(0);
+        ensure_equals("sample interval clamped", LLAllocator::getSampleInterval(), 1U);
     }
 
     template <> template <>
     void object::test<3>()
     {
+        // an interval of one byte samples every allocation
+        LLAllocator::setSampleInterval(1);
         llallocator.setProfilingEnabled(true);
 
-        char * test_alloc = new char[1024];
+        void* blocks[3];
+        for (S32 i = 0; i < 3; ++i)
+        {
+            blocks[i] = ll_aligned_malloc_16(4096);
+        }
+
+        const LLAllocatorHeapProfile& prof = llallocator.getProfile();
+        ensure("profile has a header", !prof.mLines.empty());
+        ensure("live samples", prof.mLines[0].mLiveCount >= 3);
+        ensure("live bytes", prof.mLines[0].mLiveSize >= 3 * 4096);
+
+        for (S32 i = 0; i < 3; ++i)
+        {
+            ll_aligned_free_16(blocks[i]);
+        }
 
         llallocator.getProfile();
+        ensure_equals("nothing live after free", prof.mLines[0].mLiveCount, 0U);
+        ensure("totals kept after free", prof.mLines[0].mTotalSize >= 3 * 4096);
+    }
+
+    template <> template <>
+    void object::test<4>()
+    {
+        LLAllocator::setSampleInterval(1);
+        llallocator.setProfilingEnabled(true);
+
+        void* block = NULL;
+        {
+            LLAllocator::ScopedCategory category(sTestMemStat);
+            block = ll_aligned_malloc_16(1000);
+        }
+        void* untracked = ll_aligned_malloc_16(200);
+
+        LLAllocator::category_usage_t usage = LLAllocator::getCategoryUsage();
+        ensure_equals("category samples", usage["llallocator_test"].mSampledCount, 1U);
+        ensure_equals("category bytes", usage["llallocator_test"].mSampledBytes, 1000ULL);
+        ensure_equals("untracked bytes", usage["untracked"].mSampledBytes, 200ULL);
+
+        ll_aligned_free_16(block);
+        ll_aligned_free_16(untracked);
 
-        delete [] test_alloc;
+        usage = LLAllocator::getCategoryUsage();
+        ensure_equals("category released", usage["llallocator_test"].mSampledBytes, 0ULL);
+    }
+
+    template <> template <>
+    void object::test<5>()
+    {
+        // disabling drops samples, and frees of dropped samples are harmless
+        LLAllocator::setSampleInterval(1);
+        llallocator.setProfilingEnabled(true);
+        void* block = ll_aligned_malloc_16(64);
+        llallocator.setProfilingEnabled(false);
+        ll_aligned_free_16(block);
+
+        const LLAllocatorHeapProfile& prof = llallocator.getProfile();
+        ensure("header only", prof.mLines.size() == 1);
+        ensure_equals("no samples", prof.mLines[0].mTotalCount, 0U);
+    }
+
+    template <> template <>
+    void object::test<6>()
+    {
+        // a new interval applies from the next allocation, not once the
+        // countdown drawn for the old one runs out
+        LLAllocator::setSampleInterval(1 << 30);
+        llallocator.setProfilingEnabled(true);
+        void* first = ll_aligned_malloc_16(64);
+        LLAllocator::setSampleInterval(1);
+        void* second = NULL;
+        {
+            LLAllocator::ScopedCategory category(sTestMemStat);
+            second = ll_aligned_malloc_16(64);
+        }
 
-        llallocator.getProfile();        
+        LLAllocator::category_usage_t usage = LLAllocator::getCategoryUsage();
+        ensure_equals("sampled at the new interval", usage["llallocator_test"].mSampledCount, 1U);
 
-        // *NOTE - this test isn't ensuring anything right now other than no
-        // exceptions are thrown.
+        ll_aligned_free_16(first);
+        ll_aligned_free_16(second);
     }
-#endif // LL_USE_TCMALLOC
 };
@@ -0,0 +1,158 @@
+/** 
+ * @file llcoros_test.cpp
+ * @brief Test for LLCoros stack pooling, plus a launch benchmark
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llcoros.h"
+// other Linden headers
+#include "../test/lltut.h"
+#include "../test/benchmark.h"
+#include "../test/lltestapp.h"
+#include "lleventcoro.h"
+#include "llevents.h"
+#include "lltimer.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llcoros_data
+    {
+        LLTestApp testApp;
+
+        ~llcoros_data()
+        {
+            // leave the default in place for the next test
+            LLCoros::instance().setStackPoolSize(16);
+        }
+
+        // Let the fiber scheduler clean up finished coroutines, which
+        // is when their stacks are handed back.
+        void settle(U32 in_use)
+        {
+            for (int i(0); i < 100 && LLCoros::instance().getStackStats().mInUse > in_use; ++i)
+            {
+                llcoro::suspend();
+            }
+        }
+
+        // Launch and finish 'count' coroutines that do nothing,
+        // returning elapsed seconds.
+        F64 launchTrivial(U32 count)
+        {
+            const U32 in_use(LLCoros::instance().getStackStats().mInUse);
+            F64 start(LLTimer::getTotalSeconds());
+            for (U32 i(0); i < count; ++i)
+            {
+                LLCoros::instance().launch("trivial", [](){});
+                llcoro::suspend();
+            }
+            settle(in_use);
+            return LLTimer::getTotalSeconds() - start;
+        }
+    };
+    typedef test_group<llcoros_data> llcoros_group;
+    typedef llcoros_group::object object;
+    llcoros_group llcorosgrp("llcoros");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("finished coroutine stacks are reused");
+        LLCoros& coros(LLCoros::instance());
+        coros.setStackPoolSize(4);
+        const LLCoros::StackStats before(coros.getStackStats());
+
+        launchTrivial(10);
+
+        const LLCoros::StackStats after(coros.getStackStats());
+        ensure_equals("all stacks handed back", after.mInUse, before.mInUse);
+        ensure("stacks reused", after.mHits - before.mHits >= 8);
+        ensure("pool bounded", after.mPooled <= 4);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("stack pool stays within its bound");
+        LLCoros& coros(LLCoros::instance());
+        coros.setStackPoolSize(4);
+        const LLCoros::StackStats before(coros.getStackStats());
+
+        // Ten coroutines alive at once
+        int woken(0);
+        for (int i(0); i < 10; ++i)
+        {
+            coros.launch("waiter", [&woken]()
+            {
+                llcoro::suspendUntilEventOn("llcoros_test");
+                ++woken;
+            });
+        }
+        const LLCoros::StackStats busy(coros.getStackStats());
+        ensure_equals("ten stacks in use", busy.mInUse, before.mInUse + 10);
+        ensure("high water counts them", busy.mHighWater >= before.mInUse + 10);
+
+        LLEventPumps::instance().obtain("llcoros_test").post(LLSD());
+        settle(before.mInUse);
+        ensure_equals("all woke", woken, 10);
+
+        const LLCoros::StackStats after(coros.getStackStats());
+        ensure_equals("all stacks handed back", after.mInUse, before.mInUse);
+        ensure_equals("only four kept", after.mPooled, U32(4));
+
+        coros.setStackPoolSize(1);
+        ensure_equals("shrinking releases the excess", coros.getStackStats().mPooled, U32(1));
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("benchmark 100k trivial coroutines");
+        skip_unless_benchmarking();
+        static const U32 COUNT(100000);
+        LLCoros& coros(LLCoros::instance());
+
+        coros.setStackPoolSize(0);
+        const F64 unpooled(launchTrivial(COUNT));
+
+        coros.setStackPoolSize(16);
+        const LLCoros::StackStats before(coros.getStackStats());
+        const F64 pooled(launchTrivial(COUNT));
+        const LLCoros::StackStats after(coros.getStackStats());
+
+        LL_INFOS("Benchmark") << COUNT << " coroutines: "
+                              << unpooled << "s unpooled, " << pooled << "s pooled ("
+                              << (after.mHits - before.mHits) << " hits, "
+                              << (after.mMisses - before.mMisses) << " misses)" << LL_ENDL;
+
+        ensure("nearly every launch reused a stack",
+               after.mHits - before.mHits >= COUNT - 16);
+    }
+} // namespace tut
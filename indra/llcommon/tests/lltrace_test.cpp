@@ -28,10 +28,13 @@
 #include "linden_common.h"
 
 #include "lltrace.h"
+#include "llsdutil.h"
 #include "lltracethreadrecorder.h"
 #include "lltracerecording.h"
 #include "../test/lltut.h"
 
+#include <thread>
+
 namespace LLUnits
 {
     // using powers of 2 to allow strict floating point equality
@@ -68,6 +71,9 @@ namespace tut
     static SampleStatHandle<F32Milligrams> sCaffeineLevelStat("caffeinelevel", "Coffee buzz quotient");
     static EventStatHandle<S32Ounces> sOuncesPerCup("cupsize", "Large, huge, or ginormous");
 
+    static MemStatHandle sMugMemStat("mugs");
+    static MemStatHandle sSaucerMemStat("saucers");
+
     static F32 sCaffeineLevel(0.f);
     const F32Milligrams sCaffeinePerOz(18.f);
 
@@ -139,4 +145,82 @@ namespace tut
                 && after_3pm.getMax(sCaffeineLevelStat) == sCaffeinePerOz * ((S32Ounces)S32TallCup(1) + (S32Ounces)S32GrandeCup(3) + (S32Ounces)S32VentiCup(1)).value());
     }
 
+    // memory accounting returns to zero after teardown
+    template<> template<>
+    void trace_object_t::test<2>()
+    {
+        ensure_equals("no bytes claimed at start", sMugMemStat.getLiveBytes(), 0);
+        ensure_equals("no objects claimed at start", sMugMemStat.getLiveCount(), 0);
+
+        claim_alloc(sMugMemStat, (size_t)1000);
+        claim_alloc(sMugMemStat, (size_t)24);
+        ensure_equals("claimed bytes are live", sMugMemStat.getLiveBytes(), 1024);
+        ensure_equals("each claim is one object", sMugMemStat.getLiveCount(), 2);
+        disclaim_alloc(sMugMemStat, (size_t)24);
+        disclaim_alloc(sMugMemStat, (size_t)1000);
+        ensure_equals("disclaimed bytes are released", sMugMemStat.getLiveBytes(), 0);
+        ensure_equals("disclaimed objects are released", sMugMemStat.getLiveCount(), 0);
+
+        {
+            MemFootprint footprint(sMugMemStat);
+            footprint.setBytes(4096);
+            footprint.setBytes(512);
+            MemFootprint copy(footprint);
+            copy.setBytes(256);
+            ensure_equals("footprints track their current size", sMugMemStat.getLiveBytes(), 768);
+            ensure_equals("a copy is a separate object", sMugMemStat.getLiveCount(), 2);
+
+            MemFootprint table(sMugMemStat);
+            table.setCount(10);
+            table.setBytes(100);
+            ensure_equals("containers report their entry count", sMugMemStat.getLiveCount(), 12);
+        }
+        ensure_equals("destroyed footprints release their bytes", sMugMemStat.getLiveBytes(), 0);
+        ensure_equals("destroyed footprints release their objects", sMugMemStat.getLiveCount(), 0);
+
+        LLSD sd;
+        sd["name"] = std::string(100, 'x');
+        sd["list"].append(1);
+        sd["list"].append(2);
+        ensure("llsd footprint covers string payload", llsd_footprint(sd) > 100);
+        ensure("llsd footprint grows with content", llsd_footprint(sd) > llsd_footprint(sd["list"]));
+    }
+
+    // claims from threads without a recorder only touch the atomic counters
+    template<> template<>
+    void trace_object_t::test<3>()
+    {
+        const MemAccumulator& shared = (*AccumulatorBuffer<MemAccumulator>::getDefaultBuffer())[sSaucerMemStat.getIndex()];
+        const S32 shared_samples = shared.mSize.getSampleCount();
+
+        const S32 THREADS = 4;
+        std::vector<std::thread> threads;
+        for (S32 i = 0; i < THREADS; ++i)
+        {
+            threads.emplace_back([]()
+                {
+                    for (S32 n = 0; n < 10000; ++n)
+                    {
+                        claim_alloc(sSaucerMemStat, (size_t)64);
+                        disclaim_alloc(sSaucerMemStat, (size_t)64);
+                    }
+                    claim_alloc(sSaucerMemStat, (size_t)16);
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        ensure_equals("claims from every thread are live", sSaucerMemStat.getLiveBytes(), THREADS * 16);
+        ensure_equals("objects from every thread are live", sSaucerMemStat.getLiveCount(), THREADS);
+        ensure_equals("the shared default buffer is left alone", shared.mSize.getSampleCount(), shared_samples);
+
+        for (S32 i = 0; i < THREADS; ++i)
+        {
+            disclaim_alloc(sSaucerMemStat, (size_t)16);
+        }
+        ensure_equals("all released", sSaucerMemStat.getLiveBytes(), 0);
+        ensure_equals("no objects left", sSaucerMemStat.getLiveCount(), 0);
+    }
 }
@@ -0,0 +1,211 @@
+/** 
+ * @file _httpconcurrency.cpp
+ * @brief Adaptive in-flight request limit for a policy class
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "_httpconcurrency.h"
+
+#include "linden_common.h"
+
+
+namespace
+{
+
+// Fewest completions that make up a window, however small the limit.
+const int MIN_WINDOW_SAMPLES = 4;
+
+// Window latency above baseline * this counts as queueing.
+const F64 LATENCY_TOLERANCE = 1.5;
+
+// Fraction of the previous window's throughput that still
+// justifies growing the limit.
+const F64 THROUGHPUT_TOLERANCE = 0.95;
+
+// Multiplicative decreases for latency growth and for throttling.
+const F64 LATENCY_DECREASE = 0.9;
+const F64 THROTTLE_DECREASE = 0.5;
+
+// How quickly the baseline follows latency upward (it follows
+// downward immediately).  Only windows with a single request in
+// flight are trusted for this, anything more may be measuring
+// our own queueing.  Lets the baseline recover after a route
+// change once the limit has been driven down to one.
+const F64 BASELINE_DRIFT = 0.1;
+
+}  // end anonymous namespace
+
+
+namespace LLCore
+{
+
+
+HttpConcurrencyLimit::HttpConcurrencyLimit()
+    : mLimit(0),
+      mCeiling(0),
+      mSlowStart(true),
+      mWindowStart(0),
+      mWindowSamples(0),
+      mWindowLatencySum(0.0),
+      mWindowBytes(0),
+      mWindowMaxInflight(0),
+      mWindowBackedOff(false),
+      mWindowLatency(0.0),
+      mBaselineLatency(0.0),
+      mThroughput(0.0),
+      mIncreases(0U),
+      mDecreases(0U)
+{}
+
+
+void HttpConcurrencyLimit::setBounds(int initial, int ceiling)
+{
+    mCeiling = llmax(1, ceiling);
+    if (mLimit <= 0)
+    {
+        mLimit = llclamp(initial, 1, mCeiling);
+    }
+    else
+    {
+        mLimit = llmin(mLimit, mCeiling);
+    }
+}
+
+
+void HttpConcurrencyLimit::reset()
+{
+    *this = HttpConcurrencyLimit();
+}
+
+
+bool HttpConcurrencyLimit::sample(HttpTime now, HttpTime latency, size_t bytes, int inflight, bool throttled)
+{
+    if (mLimit <= 0)
+    {
+        // No bounds yet
+        return false;
+    }
+
+    if (! mWindowStart)
+    {
+        startWindow(now > latency ? now - latency : 0);
+    }
+
+    if (throttled)
+    {
+        // Server pushback.  Not a useful latency or throughput
+        // sample, just back off once for this window.
+        if (mWindowBackedOff)
+        {
+            return false;
+        }
+        const int limit(llmax(1, int(mLimit * THROTTLE_DECREASE)));
+        if (limit < mLimit)
+        {
+            ++mDecreases;
+        }
+        mLimit = limit;
+        mSlowStart = false;
+        mWindowBackedOff = true;
+        return true;
+    }
+
+    ++mWindowSamples;
+    mWindowLatencySum += F64(latency);
+    mWindowBytes += bytes;
+    mWindowMaxInflight = llmax(mWindowMaxInflight, inflight);
+
+    if (mWindowSamples < llmax(mLimit, MIN_WINDOW_SAMPLES))
+    {
+        return false;
+    }
+
+    closeWindow(now);
+    return true;
+}
+
+
+void HttpConcurrencyLimit::closeWindow(HttpTime now)
+{
+    const F64 latency(mWindowLatencySum / F64(mWindowSamples));
+    const F64 elapsed(F64(now > mWindowStart ? now - mWindowStart : HttpTime(1)) / 1.0e6);
+    const F64 throughput(F64(mWindowBytes) / elapsed);
+    const bool saturated(mWindowMaxInflight >= mLimit);
+
+    if (! mWindowBackedOff)
+    {
+        if (mBaselineLatency > 0.0 && latency > mBaselineLatency * LATENCY_TOLERANCE)
+        {
+            // Requests are queueing, give some back
+            const int limit(llmax(1, llmin(mLimit - 1, int(mLimit * LATENCY_DECREASE))));
+            if (limit < mLimit)
+            {
+                ++mDecreases;
+            }
+            mLimit = limit;
+            mSlowStart = false;
+        }
+        else if (saturated && mLimit < mCeiling)
+        {
+            if (mSlowStart)
+            {
+                // Until the first sign of trouble, grow quickly
+                mLimit = llmin(mCeiling, mLimit * 2);
+                ++mIncreases;
+            }
+            else if (throughput >= mThroughput * THROUGHPUT_TOLERANCE)
+            {
+                ++mLimit;
+                ++mIncreases;
+            }
+        }
+    }
+
+    if (mBaselineLatency <= 0.0 || latency < mBaselineLatency)
+    {
+        mBaselineLatency = latency;
+    }
+    else if (mWindowMaxInflight <= 1)
+    {
+        mBaselineLatency += (latency - mBaselineLatency) * BASELINE_DRIFT;
+    }
+    mWindowLatency = latency;
+    mThroughput = throughput;
+
+    startWindow(now);
+}
+
+
+void HttpConcurrencyLimit::startWindow(HttpTime now)
+{
+    mWindowStart = now;
+    mWindowSamples = 0;
+    mWindowLatencySum = 0.0;
+    mWindowBytes = 0;
+    mWindowMaxInflight = 0;
+    mWindowBackedOff = false;
+}
+
+
+}  // end namespace LLCore
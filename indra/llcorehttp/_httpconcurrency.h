@@ -0,0 +1,154 @@
+/** 
+ * @file _httpconcurrency.h
+ * @brief Adaptive in-flight request limit for a policy class
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef _LLCORE_HTTP_CONCURRENCY_H_
+#define _LLCORE_HTTP_CONCURRENCY_H_
+
+
+#include "httpcommon.h"
+
+
+namespace LLCore
+{
+
+/// Adaptive in-flight limit for a single policy class.
+///
+/// Completed requests are gathered into windows of roughly one
+/// limit's worth of samples.  At the end of each window the limit
+/// is adjusted:
+///
+/// - Latency gradient.  The lowest window latency seen serves
+///   as the baseline.  If the window's
+///   latency has risen well above it, requests are queueing
+///   somewhere (link, CDN, server) and the limit shrinks by 10%.
+/// - Additive increase.  If the limit was actually reached during
+///   the window and throughput improved, the limit grows by one.
+///   Until the first decrease it doubles instead (slow start) so
+///   a fast link reaches its ceiling quickly.
+///
+/// Throttling responses (503, 429, timeouts) cut the limit in half
+/// immediately, at most once per window, so a burst of failures
+/// doesn't collapse it to one.
+///
+/// The limit never exceeds the ceiling, the static limit the
+/// class would otherwise use.
+///
+/// Threading:  Single-threaded, worker thread only.
+class HttpConcurrencyLimit
+{
+public:
+    HttpConcurrencyLimit();
+
+    /// Set the range the limit may move in.  The first call
+    /// (or the first after reset()) also sets the starting
+    /// limit to 'initial', later calls only clamp it.
+    void setBounds(int initial, int ceiling);
+
+    /// Forget all history.  Next setBounds() restarts the limit.
+    void reset();
+
+    /// Feed one completed request.
+    ///
+    /// @param now          Completion time (microseconds)
+    /// @param latency      Time to the first response byte, or the
+    ///                     time active if there was no response
+    ///                     (microseconds)
+    /// @param bytes        Response body size
+    /// @param inflight     Requests active in the class when this
+    ///                     one completed, including itself
+    /// @param throttled    Server asked us to back off
+    ///
+    /// @return             True if the limit or window state changed
+    ///                     and is worth reporting.
+    bool sample(HttpTime now, HttpTime latency, size_t bytes, int inflight, bool throttled);
+
+    int getLimit() const
+        {
+            return mLimit;
+        }
+
+    int getCeiling() const
+        {
+            return mCeiling;
+        }
+
+    /// Latency of the last window and the slow baseline, in
+    /// microseconds.
+    F64 getWindowLatency() const
+        {
+            return mWindowLatency;
+        }
+
+    F64 getBaselineLatency() const
+        {
+            return mBaselineLatency;
+        }
+
+    /// Bytes per second over the last window.
+    F64 getThroughput() const
+        {
+            return mThroughput;
+        }
+
+    U32 getIncreases() const
+        {
+            return mIncreases;
+        }
+
+    U32 getDecreases() const
+        {
+            return mDecreases;
+        }
+
+protected:
+    void closeWindow(HttpTime now);
+    void startWindow(HttpTime now);
+
+protected:
+    int             mLimit;
+    int             mCeiling;
+    bool            mSlowStart;
+
+    // Current window
+    HttpTime        mWindowStart;
+    int             mWindowSamples;
+    F64             mWindowLatencySum;
+    U64             mWindowBytes;
+    int             mWindowMaxInflight;
+    bool            mWindowBackedOff;
+
+    // History
+    F64             mWindowLatency;
+    F64             mBaselineLatency;
+    F64             mThroughput;
+    U32             mIncreases;
+    U32             mDecreases;
+};  // end class HttpConcurrencyLimit
+
+}  // end namespace LLCore
+
+#endif  // _LLCORE_HTTP_CONCURRENCY_H_
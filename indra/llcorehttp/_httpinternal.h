@@ -153,6 +153,15 @@ const int HTTP_CONNECTION_LIMIT_MAX = 256;
 const long HTTP_PIPELINING_DEFAULT = 0L;
 const long HTTP_PIPELINING_MAX = 20L;
 
+// HTTP/2 stream limits.  Servers commonly advertise 100-250
+// concurrent streams per connection; stay at or below that.
+const long HTTP_HTTP2_STREAMS_DEFAULT = 0L;
+const long HTTP_HTTP2_STREAMS_MAX = 100L;
+
+// Adaptive concurrency starts here and slow-starts up to
+// the class's static limit.
+const int HTTP_CONCURRENCY_INITIAL = 2;
+
 // Miscellaneous defaults
 const bool HTTP_USE_RETRY_AFTER_DEFAULT = true;
 const long HTTP_THROTTLE_RATE_DEFAULT = 0L;
@@ -378,6 +378,22 @@ bool HttpLibcurl::completeRequest(CURLM * multi_handle, CURL * handle, CURLcode
                     {
                         LL_WARNS(LOG_CORE) << "CURL error:" << ccode << " Attempting to get content type." << LL_ENDL;
                     }
+
+                    // Protocol actually negotiated, lets policy tell
+                    // multiplexed classes from ones that fell back to 1.1.
+                    long http_version(CURL_HTTP_VERSION_NONE);
+                    if (CURLE_OK == curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &http_version))
+                    {
+                        op->mReplyHttpVersion = http_version;
+                    }
+                    // Time to first byte, for the concurrency limit.  Unlike
+                    // total time it doesn't grow with the size of the body.
+                    double first_byte(0.0);
+                    if (CURLE_OK == curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME, &first_byte)
+                        && first_byte > 0.0)
+                    {
+                        op->mReplyFirstByte = HttpTime(first_byte * 1000000.0);
+                    }
                     op->mStatus = HttpStatus(http_status);
                 }
                 else
@@ -530,7 +546,28 @@ void HttpLibcurl::policyUpdated(int policy_class)
         policy.stallPolicy(policy_class, false);
         mDirtyPolicy[policy_class] = false;
 
-        if (options.mPipelining > 1)
+        if (options.mHttp2Streams > 0)
+        {
+            // HTTP/2 multiplexing.  libcurl keeps the per-host connection
+            // count low and runs up to mHttp2Streams requests on each
+            // connection.  Hosts that negotiate HTTP/1.1 instead are
+            // simply held to the connection limits.
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_PIPELINING,
+                                     long(CURLPIPE_MULTIPLEX));
+#if LIBCURL_VERSION_NUM >= 0x074300
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_CONCURRENT_STREAMS,
+                                     long(options.mHttp2Streams));
+#endif
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_HOST_CONNECTIONS,
+                                     long(options.mPerHostConnectionLimit));
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                                     long(options.mConnectionLimit));
+        }
+        else if (options.mPipelining > 1)
         {
             // We'll try to do pipelining on this multihandle
             check_curl_multi_setopt(multi_handle,
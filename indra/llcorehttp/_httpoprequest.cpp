@@ -46,6 +46,7 @@
 
 #include "llhttpconstants.h"
 #include "llproxy.h"
+#include "lltimer.h"
 
 #include "httpstats.h"
 
@@ -143,13 +144,18 @@ HttpOpRequest::HttpOpRequest()
       mCurlTemp(NULL),
       mCurlTempLen(0),
       mReplyBody(NULL),
+      mReplyBodyMode(BODY_UNDECIDED),
+      mReplyStreamed(0),
       mReplyOffset(0),
       mReplyLength(0),
       mReplyFullLength(0),
       mReplyHeaders(),
+      mReplyHttpVersion(CURL_HTTP_VERSION_NONE),
+      mReplyFirstByte(HttpTime(0)),
       mPolicyRetries(0),
       mPolicy503Retries(0),
       mPolicyRetryAt(HttpTime(0)),
+      mPolicyActiveAt(HttpTime(0)),
       mPolicyRetryLimit(HTTP_RETRY_COUNT_DEFAULT),
       mPolicyMinRetryBackoff(HttpTime(HTTP_RETRY_BACKOFF_MIN_DEFAULT)),
       mPolicyMaxRetryBackoff(HttpTime(HTTP_RETRY_BACKOFF_MAX_DEFAULT)),
@@ -208,6 +214,7 @@ void HttpOpRequest::stageFromRequest(HttpService * service)
 void HttpOpRequest::stageFromReady(HttpService * service)
 {
     HttpOpRequest::ptr_t self(boost::dynamic_pointer_cast<HttpOpRequest>(shared_from_this()));
+    mPolicyActiveAt = totalTime();
     service->getTransport().addOp(self);        // transfers refcount
 }
 
@@ -221,7 +228,10 @@ void HttpOpRequest::stageFromActive(HttpService * service)
         // (and there may not be due to protocol violations,
         // HEAD requests, etc., see BUG-2295) Verify that what it
         // says is consistent with the received data.
-        if (mReplyBody && mReplyBody->size() && mReplyLength != mReplyBody->size())
+        const size_t received(BODY_STREAM == mReplyBodyMode
+                              ? mReplyStreamed
+                              : (mReplyBody ? mReplyBody->size() : 0));
+        if (received && mReplyLength != received)
         {
             // Not as expected, fail the request
             mStatus = HttpStatus(HttpStatus::LLCORE, HE_INV_CONTENT_RANGE_HDR);
@@ -243,6 +253,12 @@ void HttpOpRequest::stageFromActive(HttpService * service)
     delete [] mCurlTemp;
     mCurlTemp = NULL;
     mCurlTempLen = 0;
+
+    if (BODY_STREAM == mReplyBodyMode && mReqBodyConsumer)
+    {
+        mReqBodyConsumer->onBodyComplete(mStatus);
+    }
+    mReqBodyConsumer.reset();
     
     addAsReply();
 }
@@ -294,6 +310,12 @@ HttpStatus HttpOpRequest::cancel()
 {
     mStatus = HttpStatus(HttpStatus::LLCORE, HE_OP_CANCELED);
 
+    if (BODY_STREAM == mReplyBodyMode && mReqBodyConsumer)
+    {
+        mReqBodyConsumer->onBodyComplete(mStatus);
+    }
+    mReqBodyConsumer.reset();
+
     addAsReply();
 
     return HttpStatus();
@@ -452,6 +474,10 @@ void HttpOpRequest::setupCommon(HttpRequest::policy_t policy_id,
 
         mPolicyMinRetryBackoff = llclamp(options->getMinBackoff(), HttpTime(0), HTTP_RETRY_BACKOFF_MAX);
         mPolicyMaxRetryBackoff = llclamp(options->getMaxBackoff(), mPolicyMinRetryBackoff, HTTP_RETRY_BACKOFF_MAX);
+
+        // Hold our own reference so the consumer outlives changes
+        // the caller makes to a shared options instance.
+        mReqBodyConsumer = options->getBodyConsumer();
     }
 }
 
@@ -481,11 +507,15 @@ HttpStatus HttpOpRequest::prepareRequest(HttpService * service)
         mReplyBody->release();
         mReplyBody = NULL;
     }
+    mReplyBodyMode = BODY_UNDECIDED;
+    mReplyStreamed = 0;
     mReplyOffset = 0;
     mReplyLength = 0;
     mReplyFullLength = 0;
     mReplyHeaders.reset();
     mReplyConType.clear();
+    mReplyHttpVersion = CURL_HTTP_VERSION_NONE;
+    mReplyFirstByte = HttpTime(0);
     
     // *FIXME:  better error handling later
     HttpStatus status;
@@ -719,7 +749,16 @@ HttpStatus HttpOpRequest::prepareRequest(HttpService * service)
     {
         xfer_timeout = timeout;
     }
-    if (cpolicy.mPipelining > 1L)
+    if (cpolicy.mHttp2Streams > 0L)
+    {
+        // Ask for h2 via ALPN on https URLs, plain HTTP/1.1 otherwise
+        // or when the server declines.  PIPEWAIT has the request wait
+        // for an in-progress connection to the host to learn whether
+        // it can multiplex rather than opening a new socket of its own.
+        check_curl_easy_setopt(mCurlHandle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        check_curl_easy_setopt(mCurlHandle, CURLOPT_PIPEWAIT, 1L);
+    }
+    else if (cpolicy.mPipelining > 1L)
     {
         // Pipelining affects both connection and transfer timeout values.
         // Requests that are added to a pipeling immediately have completed
@@ -790,6 +829,24 @@ size_t HttpOpRequest::writeCallback(void * data, size_t size, size_t nmemb, void
 {
     HttpOpRequest::ptr_t op(HttpOpRequest::fromHandle<HttpOpRequest>(userdata));
 
+    if (BODY_UNDECIDED == op->mReplyBodyMode)
+    {
+        op->mReplyBodyMode = op->startBodyStream() ? BODY_STREAM : BODY_BUFFER;
+    }
+
+    if (BODY_STREAM == op->mReplyBodyMode)
+    {
+        const size_t req_size(size * nmemb);
+        if (! op->mReqBodyConsumer->onBodyData(static_cast<const char *>(data), req_size))
+        {
+            // Anything other than req_size aborts with CURLE_WRITE_ERROR
+            return 0;
+        }
+        op->mReplyStreamed += req_size;
+        HTTPStats::instance().recordDataDown(req_size);
+        return req_size;
+    }
+
     if (! op->mReplyBody)
     {
         op->mReplyBody = new BufferArray();
@@ -800,6 +857,29 @@ size_t HttpOpRequest::writeCallback(void * data, size_t size, size_t nmemb, void
     return write_size;
 }
 
+
+bool HttpOpRequest::startBodyStream()
+{
+    if (! mReqBodyConsumer || ! mCurlHandle)
+    {
+        return false;
+    }
+
+    // Error bodies stay buffered so handlers see them as before
+    long http_status(0);
+    curl_easy_getinfo(mCurlHandle, CURLINFO_RESPONSE_CODE, &http_status);
+    if (http_status < 200 || http_status > 299)
+    {
+        return false;
+    }
+
+    curl_off_t content_length(-1);
+    curl_easy_getinfo(mCurlHandle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &content_length);
+
+    mReqBodyConsumer->onBodyStart(int(http_status), S64(content_length));
+    return true;
+}
+
         
 size_t HttpOpRequest::readCallback(void * data, size_t size, size_t nmemb, void * userdata)
 {
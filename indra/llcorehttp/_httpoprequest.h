@@ -41,6 +41,7 @@
 #include "_httpoperation.h"
 #include "_refcounted.h"
 
+#include "httpbodyconsumer.h"
 #include "httpheaders.h"
 #include "httpoptions.h"
 
@@ -191,6 +192,13 @@ protected:
 
     static int debugCallback(CURL *, curl_infotype info, char * buffer, size_t len, void * userdata);
 
+    // Decide on the first body chunk of a transfer whether it
+    // goes to the body consumer or into mReplyBody.
+    //
+    // Threading:  called by worker thread
+    //
+    bool startBodyStream();
+
 protected:
     unsigned int        mProcFlags;
     static const unsigned int   PF_SCAN_RANGE_HEADER = 0x00000001U;
@@ -199,6 +207,13 @@ protected:
 
     HttpRequest::policyCallback_t   mCallbackSSLVerify;
 
+    enum EBodyMode
+    {
+        BODY_UNDECIDED,
+        BODY_BUFFER,
+        BODY_STREAM
+    };
+
 public:
     // Request data
     EMethod             mReqMethod;
@@ -208,6 +223,7 @@ public:
     size_t              mReqLength;
     HttpHeaders::ptr_t  mReqHeaders;
     HttpOptions::ptr_t  mReqOptions;
+    HttpBodyConsumer::ptr_t mReqBodyConsumer;
 
     // Transport data
     bool                mCurlActive;
@@ -221,17 +237,22 @@ public:
     // Result data
     HttpStatus          mStatus;
     BufferArray *       mReplyBody;
+    EBodyMode           mReplyBodyMode;
+    size_t              mReplyStreamed;         // Bytes handed to mReqBodyConsumer
     off_t               mReplyOffset;
     size_t              mReplyLength;
     size_t              mReplyFullLength;
     HttpHeaders::ptr_t  mReplyHeaders;
     std::string         mReplyConType;
     int                 mReplyRetryAfter;
+    long                mReplyHttpVersion;      // CURL_HTTP_VERSION_* negotiated
+    HttpTime            mReplyFirstByte;        // Active to first response byte (mcs), 0 if unknown
     std::string mXLLURL; // <FS:ND/> If we get a x-ll-url header, save it here, even if mReplyHeaders is not filled.
     // Policy data
     int                 mPolicyRetries;
     int                 mPolicy503Retries;
     HttpTime            mPolicyRetryAt;
+    HttpTime            mPolicyActiveAt;        // When last handed to transport
     int                 mPolicyRetryLimit;
     HttpTime            mPolicyMinRetryBackoff; // initial delay between retries (mcs)
     HttpTime            mPolicyMaxRetryBackoff;
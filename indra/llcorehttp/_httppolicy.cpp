@@ -32,9 +32,11 @@
 #include "_httpservice.h"
 #include "_httplibcurl.h"
 #include "_httppolicyclass.h"
+#include "_httpconcurrency.h"
 
 #include "lltimer.h"
 #include "httpstats.h"
+#include "bufferarray.h"
 
 namespace
 {
@@ -60,8 +62,14 @@ public:
         : mThrottleEnd(0),
           mThrottleLeft(0L),
           mRequestCount(0L),
-          mStallStaging(false)
+          mStallStaging(false),
+          mMultiplexing(false)
         {}
+
+    /// Feed a completed request to the adaptive limit and
+    /// publish the result when it moves.
+    void sampleConcurrency(HttpRequest::policy_t policy_class, const HttpOpRequest::ptr_t & op, int inflight);
+
     
     HttpReadyQueue      mReadyQueue;
     HttpRetryQueue      mRetryQueue;
@@ -71,9 +79,46 @@ public:
     long                mThrottleLeft;
     long                mRequestCount;
     bool                mStallStaging;
+    bool                mMultiplexing;          // Last reply in class arrived over HTTP/2
+    HttpConcurrencyLimit mConcurrency;
 };
 
 
+void HttpPolicy::ClassState::sampleConcurrency(HttpRequest::policy_t policy_class,
+                                               const HttpOpRequest::ptr_t & op,
+                                               int inflight)
+{
+    static const HttpStatus error_503(503);
+    static const HttpStatus error_429(429);
+    static const HttpStatus error_timeout(HttpStatus::EXT_CURL_EASY, CURLE_OPERATION_TIMEDOUT);
+
+    const HttpTime now(totalTime());
+    // Time to first byte when libcurl has it, so large bodies don't
+    // look like queueing.  Failures without a response fall back to
+    // the whole time active.
+    const HttpTime latency(op->mReplyFirstByte
+                           ? op->mReplyFirstByte
+                           : (now > op->mPolicyActiveAt ? now - op->mPolicyActiveAt : HttpTime(0)));
+    const size_t bytes(op->mReplyBody ? op->mReplyBody->size() : op->mReplyStreamed);
+    const bool throttled(op->mStatus == error_503
+                         || op->mStatus == error_429
+                         || op->mStatus == error_timeout);
+
+    if (mConcurrency.sample(now, latency, bytes, inflight, throttled))
+    {
+        HTTPStats::ConcurrencyState stats;
+        stats.mLimit = mConcurrency.getLimit();
+        stats.mCeiling = mConcurrency.getCeiling();
+        stats.mWindowLatencyMs = mConcurrency.getWindowLatency() / 1000.0;
+        stats.mBaselineLatencyMs = mConcurrency.getBaselineLatency() / 1000.0;
+        stats.mThroughput = mConcurrency.getThroughput();
+        stats.mIncreases = mConcurrency.getIncreases();
+        stats.mDecreases = mConcurrency.getDecreases();
+        HTTPStats::instance().recordConcurrency(policy_class, stats);
+    }
+}
+
+
 HttpPolicy::HttpPolicy(HttpService * service)
     : mService(service)
 {
@@ -248,10 +293,31 @@ HttpService::ELoopSpeed HttpPolicy::processReadyQueue()
         }
 
         int active(transport.getActiveCountInClass(policy_class));
-        int active_limit(state.mOptions.mPipelining > 1L
-                         ? (state.mOptions.mPerHostConnectionLimit
-                            * state.mOptions.mPipelining)
-                         : state.mOptions.mConnectionLimit);
+        int active_limit(state.mOptions.mConnectionLimit);
+        if (state.mOptions.mHttp2Streams > 0L)
+        {
+            // Requests are streams, not connections, once the host has
+            // shown it speaks h2.  Until then (or after a fallback to
+            // 1.1) schedule as if each request needs its own connection.
+            if (state.mMultiplexing)
+            {
+                active_limit = state.mOptions.mPerHostConnectionLimit * state.mOptions.mHttp2Streams;
+            }
+        }
+        else if (state.mOptions.mPipelining > 1L)
+        {
+            active_limit = state.mOptions.mPerHostConnectionLimit * state.mOptions.mPipelining;
+        }
+        if (state.mOptions.mAdaptiveConcurrency)
+        {
+            // Static limit is now just the ceiling
+            state.mConcurrency.setBounds(HTTP_CONCURRENCY_INITIAL, active_limit);
+            active_limit = state.mConcurrency.getLimit();
+        }
+        else if (state.mConcurrency.getLimit())
+        {
+            state.mConcurrency.reset();
+        }
         int needed(active_limit - active);      // Expect negatives here
 
         if (needed > 0)
@@ -404,6 +470,14 @@ bool HttpPolicy::cancel(HttpHandle handle)
 
 bool HttpPolicy::stageAfterCompletion(const HttpOpRequest::ptr_t &op)
 {
+    ClassState & state(*mClasses[op->mReqPolicy]);
+    if (state.mOptions.mAdaptiveConcurrency)
+    {
+        // Transport has already dropped this op from its active count
+        const int inflight(mService->getTransport().getActiveCountInClass(op->mReqPolicy) + 1);
+        state.sampleConcurrency(op->mReqPolicy, op, inflight);
+    }
+
     // Retry or finalize
     if (! op->mStatus)
     {
@@ -444,6 +518,13 @@ bool HttpPolicy::stageAfterCompletion(const HttpOpRequest::ptr_t &op)
                             << LL_ENDL;
     }
 
+    if (op->mReplyHttpVersion != CURL_HTTP_VERSION_NONE)
+    {
+        state.mMultiplexing = (state.mOptions.mHttp2Streams > 0L
+                               && op->mReplyHttpVersion >= CURL_HTTP_VERSION_2_0);
+        HTTPStats::instance().recordHTTPVersion(op->mReplyHttpVersion);
+    }
+
     op->stageFromActive(mService);
 
     HTTPStats::instance().recordResultCode(op->mStatus.getType());
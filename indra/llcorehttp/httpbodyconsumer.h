@@ -0,0 +1,99 @@
+/** 
+ * @file httpbodyconsumer.h
+ * @brief Interface for receiving HTTP response bodies as they arrive
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef _LLCORE_HTTP_BODY_CONSUMER_H_
+#define _LLCORE_HTTP_BODY_CONSUMER_H_
+
+
+#include "httpcommon.h"
+
+
+namespace LLCore
+{
+
+
+/// HttpBodyConsumer lets a caller take a response body as it
+/// arrives instead of having it accumulated in a BufferArray
+/// and handed over on completion.  Attach an instance to a
+/// request with @see HttpOptions::setBodyConsumer().  Useful
+/// for feeding an incremental parser or writing straight to
+/// the cache so large bodies are never fully buffered.
+///
+/// Only successful (2xx) bodies are streamed.  Error bodies are
+/// buffered as before and delivered in the HttpResponse so the
+/// existing error handling keeps working.  When a body has been
+/// streamed the response delivered to the HttpHandler carries
+/// no body.
+///
+/// Threading:  All methods are invoked on the worker thread.
+/// Implementations must synchronize any state they share with
+/// the application thread.  The handler's onCompleted() runs
+/// after onBodyComplete() so it may safely pick up results.
+///
+/// Allocation:  Refcounted via shared pointer.  As HttpOptions
+/// instances are commonly shared across requests, options that
+/// carry a consumer should be used for one request at a time.
+///
+class HttpBodyConsumer
+{
+public:
+    typedef boost::shared_ptr<HttpBodyConsumer> ptr_t;
+
+    virtual ~HttpBodyConsumer()
+    { }
+
+    /// Invoked before the first chunk of a successful body.  Also
+    /// invoked again if the request is retried after a partial
+    /// transfer, in which case any data consumed so far must be
+    /// discarded.
+    ///
+    /// @param  http_status     HTTP status code of the response.
+    /// @param  content_length  Expected body length or -1 if the
+    ///                         server did not say.
+    ///
+    virtual void onBodyStart(int http_status, S64 content_length)
+    { }
+
+    /// Invoked for each chunk received from libcurl.
+    ///
+    /// @return                 False to abort the transfer.  The
+    ///                         request then fails with a libcurl
+    ///                         write error.
+    ///
+    virtual bool onBodyData(const char * data, size_t len) = 0;
+
+    /// Invoked once the streamed transfer has ended, successfully
+    /// or not, before the reply is queued for the handler.
+    virtual void onBodyComplete(const HttpStatus & status)
+    { }
+
+};  // end class HttpBodyConsumer
+
+
+}   // end namespace LLCore
+
+#endif  // _LLCORE_HTTP_BODY_CONSUMER_H_
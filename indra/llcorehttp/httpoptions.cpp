@@ -48,7 +48,8 @@ HttpOptions::HttpOptions() :
     mVerifyHost(false),
     mDNSCacheTimeout(-1L),
     mNoBody(false),
-    mLastModified(0) // <FS:Ansariel> GetIfModified request
+    mLastModified(0), // <FS:Ansariel> GetIfModified request
+    mBodyConsumer()
 {}
 
 
@@ -142,4 +143,9 @@ void HttpOptions::setLastModified(long last_modified)
 }
 // </FS:Ansariel>
 
+void HttpOptions::setBodyConsumer(const HttpBodyConsumer::ptr_t & consumer)
+{
+    mBodyConsumer = consumer;
+}
+
 }   // end namespace LLCore
@@ -29,6 +29,7 @@
 
 
 #include "httpcommon.h"
+#include "httpbodyconsumer.h"
 #include "_refcounted.h"
 
 
@@ -192,7 +193,16 @@ public:
         return mLastModified;
     }
     // </FS:Ansariel>
-    
+
+    /// Stream successful response bodies to this consumer
+    /// instead of buffering them.  See HttpBodyConsumer.
+    /// Default:  none
+    void                setBodyConsumer(const HttpBodyConsumer::ptr_t & consumer);
+    const HttpBodyConsumer::ptr_t & getBodyConsumer() const
+    {
+        return mBodyConsumer;
+    }
+
 protected:
     bool                mWantHeaders;
     int                 mTracing;
@@ -211,6 +221,8 @@ protected:
     static bool         sDefaultVerifyPeer;
 
     long                mLastModified; // <FS:Ansariel> GetIfModified request
+
+    HttpBodyConsumer::ptr_t mBodyConsumer;
 }; // end class HttpOptions
 
 
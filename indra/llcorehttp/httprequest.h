@@ -233,6 +233,33 @@ public:
         /// Global only
         PO_SSL_VERIFY_CALLBACK,
 
+        /// Long value that, when positive, requests HTTP/2 for this
+        /// class and lets libcurl multiplex up to this many concurrent
+        /// streams over each connection.  PO_PER_HOST_CONNECTION_LIMIT
+        /// then caps the number of connections opened to a host and
+        /// PO_CONNECTION_LIMIT the total, so a value of 32 with a
+        /// per-host limit of 2 allows 64 requests in flight to a
+        /// CDN on just two sockets.  Servers that don't negotiate h2
+        /// (including all cleartext URLs) are served over HTTP/1.1
+        /// and the class falls back to connection-limited scheduling
+        /// until an h2 reply is seen again.  Takes precedence over
+        /// PO_PIPELINING_DEPTH.  A value of zero, the default,
+        /// disables multiplexing.
+        ///
+        /// Per-class only
+        PO_HTTP2_STREAMS,
+
+        /// Long value that, when non-zero, lets the class adjust its
+        /// own in-flight request limit.  It starts small, grows while
+        /// throughput improves and shrinks when latency climbs or the
+        /// server answers 503/429.  The limit otherwise in effect
+        /// (connection limit, pipelining or HTTP/2 streams) becomes
+        /// the ceiling.  Current state is reported by HTTPStats.
+        /// A value of zero, the default, keeps the static limit.
+        ///
+        /// Per-class only
+        PO_ADAPTIVE_CONCURRENCY,
+
         PO_LAST  // Always at end
     };
 
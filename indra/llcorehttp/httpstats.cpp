@@ -27,6 +27,9 @@
 #include "httpstats.h"
 #include "llerror.h"
 
+#include <curl/curl.h>
+#include <iomanip>
+
 namespace LLCore
 {
 HTTPStats::HTTPStats()
@@ -42,6 +45,10 @@ HTTPStats::~HTTPStats()
 void HTTPStats::resetStats()
 {
     mResutCodes.clear();
+    mHTTPVersions.clear();
+
+    LLMutexLock lock(&mConcurrencyMutex);
+    mConcurrency.clear();
     mDataDown.reset();
     mDataUp.reset();
     mRequests = 0;
@@ -61,6 +68,40 @@ void HTTPStats::recordResultCode(S32 code)
 
 }
 
+void HTTPStats::recordHTTPVersion(long version)
+{
+    ++mHTTPVersions[version];
+}
+
+HTTPStats::ConcurrencyState::ConcurrencyState()
+    : mLimit(0),
+      mCeiling(0),
+      mWindowLatencyMs(0.0),
+      mBaselineLatencyMs(0.0),
+      mThroughput(0.0),
+      mIncreases(0),
+      mDecreases(0)
+{
+}
+
+void HTTPStats::recordConcurrency(S32 policy_class, const ConcurrencyState & state)
+{
+    LLMutexLock lock(&mConcurrencyMutex);
+    mConcurrency[policy_class] = state;
+}
+
+bool HTTPStats::getConcurrency(S32 policy_class, ConcurrencyState & state) const
+{
+    LLMutexLock lock(&mConcurrencyMutex);
+    std::map<S32, ConcurrencyState>::const_iterator it(mConcurrency.find(policy_class));
+    if (it == mConcurrency.end())
+    {
+        return false;
+    }
+    state = (*it).second;
+    return true;
+}
+
 namespace
 {
     std::string byte_count_converter(F32 bytes)
@@ -101,6 +142,37 @@ void HTTPStats::dumpStats()
         out << (*it).first << " " << (*it).second << std::endl;
     }
 
+    out << std::endl;
+    out << "Protocol Versions:" << std::endl << "--- -----" << std::endl;
+
+    for (std::map<long, S32>::iterator it = mHTTPVersions.begin(); it != mHTTPVersions.end(); ++it)
+    {
+        const char * name("?");
+        switch ((*it).first)
+        {
+        case CURL_HTTP_VERSION_1_0: name = "1.0"; break;
+        case CURL_HTTP_VERSION_1_1: name = "1.1"; break;
+        case CURL_HTTP_VERSION_2_0: name = "2"; break;
+        }
+        out << name << " " << (*it).second << std::endl;
+    }
+
+    LLMutexLock lock(&mConcurrencyMutex);
+    if (! mConcurrency.empty())
+    {
+        out << std::endl;
+        out << "Adaptive Concurrency:" << std::endl << "class limit/ceiling latency(ms) baseline(ms) rate up/down" << std::endl;
+        for (std::map<S32, ConcurrencyState>::const_iterator it = mConcurrency.begin(); it != mConcurrency.end(); ++it)
+        {
+            const ConcurrencyState & state((*it).second);
+            out << (*it).first << " " << state.mLimit << "/" << state.mCeiling
+                << " " << std::setprecision(4) << state.mWindowLatencyMs
+                << " " << state.mBaselineLatencyMs
+                << " " << byte_count_converter(state.mThroughput) << "/s"
+                << " " << state.mIncreases << "/" << state.mDecreases << std::endl;
+        }
+    }
+
     LL_WARNS("HTTPCore") << out.str() << LL_ENDL;
 }
 
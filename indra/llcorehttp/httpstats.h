@@ -32,6 +32,7 @@
 #include "llstatsaccumulator.h"
 #include "llsingleton.h"
 #include "llsd.h"
+#include "llmutex.h"
 
 namespace LLCore
 {
@@ -59,6 +60,31 @@ namespace LLCore
 
         void    recordResultCode(S32 code);
 
+        /// Count completions by negotiated protocol
+        /// (CURL_HTTP_VERSION_* value).
+        void    recordHTTPVersion(long version);
+
+        /// Snapshot of a policy class's adaptive concurrency
+        /// controller, updated by the worker thread each time
+        /// the controller adjusts.
+        struct ConcurrencyState
+        {
+            ConcurrencyState();
+
+            S32     mLimit;
+            S32     mCeiling;
+            F64     mWindowLatencyMs;
+            F64     mBaselineLatencyMs;
+            F64     mThroughput;        // bytes per second
+            U32     mIncreases;
+            U32     mDecreases;
+        };
+
+        void    recordConcurrency(S32 policy_class, const ConcurrencyState & state);
+
+        /// @return         False if the class has never reported.
+        bool    getConcurrency(S32 policy_class, ConcurrencyState & state) const;
+
         void    dumpStats();
     private:
         StatsAccumulator mDataDown;
@@ -67,6 +93,10 @@ namespace LLCore
         S32              mRequests;
 
         std::map<S32, S32> mResutCodes;
+        std::map<long, S32> mHTTPVersions;
+
+        mutable LLMutex  mConcurrencyMutex;
+        std::map<S32, ConcurrencyState> mConcurrency;
     };
 
 
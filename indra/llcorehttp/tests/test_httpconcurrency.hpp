@@ -0,0 +1,176 @@
+/** 
+ * @file test_httpconcurrency.hpp
+ * @brief unit tests for the LLCore::HttpConcurrencyLimit class
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef TEST_LLCORE_HTTP_CONCURRENCY_H_
+#define TEST_LLCORE_HTTP_CONCURRENCY_H_
+
+#include "_httpconcurrency.h"
+
+#include "../test/lltut.h"
+
+
+using namespace LLCore;
+
+
+namespace tut
+{
+
+struct HttpConcurrencyTestData
+{
+    HttpConcurrencyTestData()
+        : mNow(HttpTime(1000000)),
+          mMaxLimit(0)
+        {}
+
+    // Simulated link.  Every round, 'limit' requests of 'size'
+    // bytes share 'bandwidth' bytes/sec after a fixed 'rtt' (uS)
+    // and all complete together.  Zero bandwidth is unconstrained.
+    void simulate(HttpConcurrencyLimit & limit, int rounds,
+                  HttpTime rtt, size_t size, F64 bandwidth)
+        {
+            for (int round(0); round < rounds; ++round)
+            {
+                const int inflight(limit.getLimit());
+                HttpTime latency(rtt);
+                if (bandwidth > 0.0)
+                {
+                    latency += HttpTime(F64(inflight) * F64(size) * 1.0e6 / bandwidth);
+                }
+                mNow += latency;
+                for (int i(0); i < inflight; ++i)
+                {
+                    limit.sample(mNow, latency, size, inflight, false);
+                }
+                mMaxLimit = llmax(mMaxLimit, limit.getLimit());
+            }
+        }
+
+    HttpTime    mNow;
+    int         mMaxLimit;
+};
+
+typedef test_group<HttpConcurrencyTestData> HttpConcurrencyTestGroupType;
+typedef HttpConcurrencyTestGroupType::object HttpConcurrencyTestObjectType;
+HttpConcurrencyTestGroupType HttpConcurrencyTestGroup("HttpConcurrency Tests");
+
+template <> template <>
+void HttpConcurrencyTestObjectType::test<1>()
+{
+    set_test_name("HttpConcurrencyLimit bounds");
+
+    HttpConcurrencyLimit limit;
+    ensure_equals("No limit before bounds", limit.getLimit(), 0);
+    ensure("Samples ignored before bounds", ! limit.sample(mNow, 1000, 100, 1, false));
+
+    limit.setBounds(2, 32);
+    ensure_equals("Starts at initial", limit.getLimit(), 2);
+    ensure_equals("Ceiling set", limit.getCeiling(), 32);
+
+    limit.setBounds(8, 32);
+    ensure_equals("Later bounds don't restart", limit.getLimit(), 2);
+
+    limit.setBounds(8, 1);
+    ensure_equals("Lower ceiling clamps", limit.getLimit(), 1);
+
+    limit.reset();
+    limit.setBounds(0, 0);
+    ensure_equals("Never below one", limit.getLimit(), 1);
+}
+
+template <> template <>
+void HttpConcurrencyTestObjectType::test<2>()
+{
+    set_test_name("HttpConcurrencyLimit grows to ceiling on a fast link");
+
+    HttpConcurrencyLimit limit;
+    limit.setBounds(2, 32);
+
+    simulate(limit, 10, HttpTime(50000), 65536, 0.0);
+    ensure_equals("Reached ceiling", limit.getLimit(), 32);
+    ensure_equals("Never beyond ceiling", mMaxLimit, 32);
+    ensure_equals("No decreases", limit.getDecreases(), U32(0));
+
+    simulate(limit, 50, HttpTime(50000), 65536, 0.0);
+    ensure_equals("Stays at ceiling", limit.getLimit(), 32);
+}
+
+template <> template <>
+void HttpConcurrencyTestObjectType::test<3>()
+{
+    set_test_name("HttpConcurrencyLimit backs off on a congested link");
+
+    // 64KB objects, 50mS RTT, 2.5MB/s.  A couple of requests fill
+    // the pipe, more just queue and add latency.
+    HttpConcurrencyLimit limit;
+    limit.setBounds(2, 32);
+
+    simulate(limit, 200, HttpTime(50000), 65536, 2.5 * 1024 * 1024);
+    ensure("Backed off", limit.getDecreases() > 0);
+    ensure("Settled well under ceiling", limit.getLimit() <= 8);
+    ensure("Still using the link", limit.getLimit() >= 2);
+    ensure("Never beyond ceiling", mMaxLimit <= 32);
+    ensure("Latency tracked", limit.getBaselineLatency() >= 50000.0);
+}
+
+template <> template <>
+void HttpConcurrencyTestObjectType::test<4>()
+{
+    set_test_name("HttpConcurrencyLimit halves on throttling once per window");
+
+    HttpConcurrencyLimit limit;
+    limit.setBounds(2, 32);
+    simulate(limit, 10, HttpTime(50000), 65536, 0.0);
+    ensure_equals("Reached ceiling", limit.getLimit(), 32);
+
+    mNow += 1000;
+    ensure("Throttle reported", limit.sample(mNow, 1000, 0, 32, true));
+    ensure_equals("Halved on 503", limit.getLimit(), 16);
+    limit.sample(mNow, 1000, 0, 32, true);
+    ensure_equals("Only once per window", limit.getLimit(), 16);
+
+    // Finish the window
+    simulate(limit, 1, HttpTime(50000), 65536, 0.0);
+    limit.sample(mNow, 1000, 0, 16, true);
+    ensure_equals("Halved again in next window", limit.getLimit(), 8);
+
+    for (int i(0); i < 10; ++i)
+    {
+        simulate(limit, 1, HttpTime(50000), 65536, 0.0);
+        limit.sample(mNow, 1000, 0, limit.getLimit(), true);
+    }
+    ensure_equals("Floor of one", limit.getLimit(), 1);
+
+    // Recovers, additively now that slow start is over
+    const U32 increases(limit.getIncreases());
+    simulate(limit, 20, HttpTime(50000), 65536, 0.0);
+    ensure("Grows again", limit.getLimit() > 1);
+    ensure("Additive growth", limit.getLimit() <= 1 + int(limit.getIncreases() - increases));
+}
+
+}  // end namespace tut
+
+#endif  // TEST_LLCORE_HTTP_CONCURRENCY_H_
@@ -32,6 +32,7 @@
 #include "httpheaders.h"
 #include "httpresponse.h"
 #include "httpoptions.h"
+#include "httpstats.h"
 #include "_httpservice.h"
 #include "_httprequestqueue.h"
 
@@ -185,6 +186,83 @@ public:
     regex_container_t mHeadersDisallowed;
 };
 
+// Records what the streaming body interface delivered.  Runs on
+// the worker thread; the test only reads it after the handler has
+// been called, which happens after onBodyComplete().
+class TestBodyConsumer : public LLCore::HttpBodyConsumer
+{
+public:
+    TestBodyConsumer()
+        : mStarts(0),
+          mChunks(0),
+          mBytes(0),
+          mContentLength(-1),
+          mHttpStatus(0),
+          mCompletes(0),
+          mPatternOk(true)
+        {}
+
+    virtual void onBodyStart(int http_status, S64 content_length)
+        {
+            ++mStarts;
+            mHttpStatus = http_status;
+            mContentLength = content_length;
+            mChunks = 0;
+            mBytes = 0;
+            mPatternOk = true;
+        }
+
+    virtual bool onBodyData(const char * data, size_t len)
+        {
+            // Server sends byte i as (i % 251)
+            for (size_t i(0); i < len; ++i)
+            {
+                if (U8(data[i]) != U8((mBytes + i) % 251))
+                {
+                    mPatternOk = false;
+                    break;
+                }
+            }
+            ++mChunks;
+            mBytes += len;
+            return true;
+        }
+
+    virtual void onBodyComplete(const HttpStatus & status)
+        {
+            ++mCompletes;
+            mFinalStatus = status;
+        }
+
+    int mStarts;
+    int mChunks;
+    size_t mBytes;
+    S64 mContentLength;
+    int mHttpStatus;
+    int mCompletes;
+    bool mPatternOk;
+    HttpStatus mFinalStatus;
+};
+
+class BodyCheckHandler : public TestHandler2
+{
+public:
+    BodyCheckHandler(HttpRequestTestData * state,
+                     const std::string & name)
+        : TestHandler2(state, name),
+          mBodySize(0)
+        {}
+
+    virtual void onCompleted(HttpHandle handle, HttpResponse * response)
+        {
+            BufferArray * body(response ? response->getBody() : NULL);
+            mBodySize = body ? body->size() : 0;
+            TestHandler2::onCompleted(handle, response);
+        }
+
+    size_t mBodySize;
+};
+
 typedef test_group<HttpRequestTestData> HttpRequestTestGroupType;
 typedef HttpRequestTestGroupType::object HttpRequestTestObjectType;
 HttpRequestTestGroupType HttpRequestTestGroup("HttpRequest Tests");
@@ -3056,6 +3134,354 @@ void HttpRequestTestObjectType::test<23>()
 }
 
 
+template <> template <>
+void HttpRequestTestObjectType::test<24>()
+{
+    ScopedCurlInit ready;
+
+    set_test_name("HttpRequest GET streamed to a body consumer");
+
+    // Handler can be stack-allocated *if* there are no dangling
+    // references to it after completion of this method.
+    BodyCheckHandler handler(this, "handler");
+    LLCore::HttpHandler::ptr_t handlerp(&handler, NoOpDeletor);
+    std::string url_base(get_base_url() + "/dribble/");
+    mHandlerCalls = 0;
+
+    HttpRequest * req = NULL;
+    HttpOptions::ptr_t opts;
+    boost::shared_ptr<TestBodyConsumer> consumer(new TestBodyConsumer());
+
+    try
+    {
+        // Get singletons created
+        HttpRequest::createService();
+
+        // Start threading early so that thread memory is invariant
+        // over the test.
+        HttpRequest::startThread();
+
+        // create a new ref counted object with an implicit reference
+        req = new HttpRequest();
+
+        opts = HttpOptions::ptr_t(new HttpOptions());
+        opts->setBodyConsumer(consumer);
+
+        // Issue a GET whose body trickles in
+        mStatus = HttpStatus(200);
+        HttpHandle handle = req->requestGet(HttpRequest::DEFAULT_POLICY_ID,
+                                            0U,
+                                            url_base,
+                                            opts,
+                                            HttpHeaders::ptr_t(),
+                                            handlerp);
+        ensure("Valid handle returned for streamed request", handle != LLCORE_HTTP_HANDLE_INVALID);
+
+        // Run the notification pump.
+        int count(0);
+        int limit(LOOP_COUNT_LONG);
+        while (count++ < limit && mHandlerCalls < 1)
+        {
+            req->update(1000000);
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Request executed in reasonable time", count < limit);
+        ensure("One handler invocation for request", mHandlerCalls == 1);
+
+        ensure_equals("Body started once", consumer->mStarts, 1);
+        ensure_equals("Body completed once", consumer->mCompletes, 1);
+        ensure_equals("Consumer saw HTTP status", consumer->mHttpStatus, 200);
+        ensure("Consumer saw successful completion", bool(consumer->mFinalStatus));
+        ensure_equals("Content length reported", consumer->mContentLength, S64(256 * 1024));
+        ensure_equals("Whole body streamed", consumer->mBytes, size_t(256 * 1024));
+        ensure("Body arrived over several chunks", consumer->mChunks > 1);
+        ensure("Body content intact", consumer->mPatternOk);
+        ensure_equals("Streamed body not buffered in response", handler.mBodySize, size_t(0));
+
+        // Okay, request a shutdown of the servicing thread
+        mStatus = HttpStatus();
+        handle = req->requestStopThread(handlerp);
+        ensure("Valid handle returned for second request", handle != LLCORE_HTTP_HANDLE_INVALID);
+
+        // Run the notification pump again
+        count = 0;
+        limit = LOOP_COUNT_LONG;
+        while (count++ < limit && mHandlerCalls < 2)
+        {
+            req->update(1000000);
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Second request executed in reasonable time", count < limit);
+        ensure("Second handler invocation", mHandlerCalls == 2);
+
+        // See that we actually shutdown the thread
+        count = 0;
+        limit = LOOP_COUNT_SHORT;
+        while (count++ < limit && ! HttpService::isStopped())
+        {
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Thread actually stopped running", HttpService::isStopped());
+
+        // release options
+        opts.reset();
+
+        // release the request object
+        delete req;
+        req = NULL;
+
+        // Shut down service
+        HttpRequest::destroyService();
+    }
+    catch (...)
+    {
+        stop_thread(req);
+        opts.reset();
+        delete req;
+        HttpRequest::destroyService();
+        throw;
+    }
+}
+
+
+template <> template <>
+void HttpRequestTestObjectType::test<25>()
+{
+    ScopedCurlInit ready;
+
+    set_test_name("HttpRequest GET on an HTTP/2 class falls back to HTTP/1.1");
+
+    // Handler can be stack-allocated *if* there are no dangling
+    // references to it after completion of this method.
+    TestHandler2 handler(this, "handler");
+    LLCore::HttpHandler::ptr_t handlerp(&handler, NoOpDeletor);
+    std::string url_base(get_base_url());
+    mHandlerCalls = 0;
+
+    HttpRequest * req = NULL;
+
+    try
+    {
+        // Get singletons created
+        HttpRequest::createService();
+
+        // Multiplexed class.  Stream count is clamped and the
+        // option is refused globally.
+        HttpRequest::policy_t h2_class(HttpRequest::createPolicyClass());
+        long streams(0);
+        HttpStatus status = HttpRequest::setStaticPolicyOption(HttpRequest::PO_HTTP2_STREAMS,
+                                                               h2_class,
+                                                               1000L,
+                                                               &streams);
+        ensure("HTTP/2 streams accepted on a class", bool(status));
+        ensure_equals("HTTP/2 streams clamped", streams, 100L);
+        status = HttpRequest::setStaticPolicyOption(HttpRequest::PO_HTTP2_STREAMS,
+                                                    HttpRequest::GLOBAL_POLICY_ID,
+                                                    8L,
+                                                    NULL);
+        ensure("HTTP/2 streams refused globally", ! status);
+        HttpRequest::setStaticPolicyOption(HttpRequest::PO_HTTP2_STREAMS, h2_class, 16L, NULL);
+        HttpRequest::setStaticPolicyOption(HttpRequest::PO_CONNECTION_LIMIT, h2_class, 2L, NULL);
+        HttpRequest::setStaticPolicyOption(HttpRequest::PO_PER_HOST_CONNECTION_LIMIT, h2_class, 2L, NULL);
+
+        // Start threading early so that thread memory is invariant
+        // over the test.
+        HttpRequest::startThread();
+
+        // create a new ref counted object with an implicit reference
+        req = new HttpRequest();
+
+        // The peer is a cleartext HTTP/1.1 server so h2 is never
+        // negotiated.  More requests than connections must all still
+        // complete on the fallback path.
+        static const int request_count(6);
+        mStatus = HttpStatus(200);
+        for (int i(0); i < request_count; ++i)
+        {
+            HttpHandle handle = req->requestGet(h2_class,
+                                                0U,
+                                                url_base,
+                                                HttpOptions::ptr_t(),
+                                                HttpHeaders::ptr_t(),
+                                                handlerp);
+            ensure("Valid handle returned for get request", handle != LLCORE_HTTP_HANDLE_INVALID);
+        }
+
+        // Run the notification pump.
+        int count(0);
+        int limit(LOOP_COUNT_LONG);
+        while (count++ < limit && mHandlerCalls < request_count)
+        {
+            req->update(1000000);
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Requests executed in reasonable time", count < limit);
+        ensure_equals("One handler invocation per request", mHandlerCalls, request_count);
+
+        // Okay, request a shutdown of the servicing thread
+        mStatus = HttpStatus();
+        HttpHandle handle = req->requestStopThread(handlerp);
+        ensure("Valid handle returned for stop request", handle != LLCORE_HTTP_HANDLE_INVALID);
+
+        // Run the notification pump again
+        count = 0;
+        limit = LOOP_COUNT_LONG;
+        while (count++ < limit && mHandlerCalls < request_count + 1)
+        {
+            req->update(1000000);
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Stop request executed in reasonable time", count < limit);
+        ensure_equals("Stop handler invocation", mHandlerCalls, request_count + 1);
+
+        // See that we actually shutdown the thread
+        count = 0;
+        limit = LOOP_COUNT_SHORT;
+        while (count++ < limit && ! HttpService::isStopped())
+        {
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Thread actually stopped running", HttpService::isStopped());
+
+        // release the request object
+        delete req;
+        req = NULL;
+
+        // Shut down service
+        HttpRequest::destroyService();
+    }
+    catch (...)
+    {
+        stop_thread(req);
+        delete req;
+        HttpRequest::destroyService();
+        throw;
+    }
+}
+
+
+template <> template <>
+void HttpRequestTestObjectType::test<26>()
+{
+    ScopedCurlInit ready;
+
+    set_test_name("HttpRequest adaptive concurrency against a congested peer");
+
+    // Handler can be stack-allocated *if* there are no dangling
+    // references to it after completion of this method.
+    TestHandler2 handler(this, "handler");
+    LLCore::HttpHandler::ptr_t handlerp(&handler, NoOpDeletor);
+
+    // 1MB/s shared by all requests, every fifth request refused
+    // with a 503 and retried.
+    std::string url_base(get_base_url() + "/sim/rate/1048576/err/5/");
+    mHandlerCalls = 0;
+
+    HttpRequest * req = NULL;
+    HttpOptions::ptr_t opts;
+
+    try
+    {
+        // Get singletons created
+        HttpRequest::createService();
+
+        HttpRequest::policy_t sim_class(HttpRequest::createPolicyClass());
+        HttpRequest::setStaticPolicyOption(HttpRequest::PO_CONNECTION_LIMIT, sim_class, 8L, NULL);
+        HttpRequest::setStaticPolicyOption(HttpRequest::PO_PER_HOST_CONNECTION_LIMIT, sim_class, 8L, NULL);
+        HttpStatus status = HttpRequest::setStaticPolicyOption(HttpRequest::PO_ADAPTIVE_CONCURRENCY,
+                                                               sim_class,
+                                                               1L,
+                                                               NULL);
+        ensure("Adaptive concurrency accepted on a class", bool(status));
+
+        // Start threading early so that thread memory is invariant
+        // over the test.
+        HttpRequest::startThread();
+
+        // create a new ref counted object with an implicit reference
+        req = new HttpRequest();
+
+        opts = HttpOptions::ptr_t(new HttpOptions());
+        opts->setRetries(5);
+        opts->setMinBackoff(50000);
+        opts->setMaxBackoff(200000);
+
+        static const int request_count(24);
+        mStatus = HttpStatus(200);
+        for (int i(0); i < request_count; ++i)
+        {
+            HttpHandle handle = req->requestGet(sim_class,
+                                                0U,
+                                                url_base,
+                                                opts,
+                                                HttpHeaders::ptr_t(),
+                                                handlerp);
+            ensure("Valid handle returned for get request", handle != LLCORE_HTTP_HANDLE_INVALID);
+        }
+
+        // Run the notification pump.
+        int count(0);
+        int limit(LOOP_COUNT_LONG);
+        while (count++ < limit && mHandlerCalls < request_count)
+        {
+            req->update(1000000);
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Requests executed in reasonable time", count < limit);
+        ensure_equals("Every request succeeded eventually", mHandlerCalls, request_count);
+
+        HTTPStats::ConcurrencyState state;
+        ensure("Controller state reported", HTTPStats::instance().getConcurrency(sim_class, state));
+        ensure_equals("Static limit is the ceiling", state.mCeiling, 8);
+        ensure("Limit within bounds", state.mLimit >= 1 && state.mLimit <= 8);
+        ensure("Backed off on injected 503s", state.mDecreases > 0);
+
+        // Okay, request a shutdown of the servicing thread
+        mStatus = HttpStatus();
+        HttpHandle handle = req->requestStopThread(handlerp);
+        ensure("Valid handle returned for stop request", handle != LLCORE_HTTP_HANDLE_INVALID);
+
+        // Run the notification pump again
+        count = 0;
+        limit = LOOP_COUNT_LONG;
+        while (count++ < limit && mHandlerCalls < request_count + 1)
+        {
+            req->update(1000000);
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Stop request executed in reasonable time", count < limit);
+        ensure_equals("Stop handler invocation", mHandlerCalls, request_count + 1);
+
+        // See that we actually shutdown the thread
+        count = 0;
+        limit = LOOP_COUNT_SHORT;
+        while (count++ < limit && ! HttpService::isStopped())
+        {
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Thread actually stopped running", HttpService::isStopped());
+
+        // release options
+        opts.reset();
+
+        // release the request object
+        delete req;
+        req = NULL;
+
+        // Shut down service
+        HttpRequest::destroyService();
+    }
+    catch (...)
+    {
+        stop_thread(req);
+        opts.reset();
+        delete req;
+        HttpRequest::destroyService();
+        throw;
+    }
+}
+
+
 }  // end namespace tut
 
 namespace
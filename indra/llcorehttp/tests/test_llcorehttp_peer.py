@@ -68,6 +68,14 @@ class TestHTTPRequestHandler(BaseHTTPRequestHandler):
                            "Content-Range: bytes 0-75/2983",
                            "Content-Length: 76"
     -- '/bug2295/inv_cont_range/0/'  Generates HE_INVALID_CONTENT_RANGE error in llcorehttp.
+    - '/dribble/'       200 response with a 256KB binary body written
+                        in 4KB pieces with short pauses in between
+    - '/sim/'           200 response with a 32KB body paced to a
+                        bandwidth shared by all requests (the server
+                        answers one at a time), a stand-in for a
+                        congested link
+    -- '/sim/rate/<n>/'     Bytes per second, default 1MB/s
+    -- '/sim/err/<n>/'      Every nth '/sim/' request gets a 503
     - '/503/'           Generate 503 responses with various kinds
                         of 'retry-after' headers
     -- '/503/0/'            "Retry-After: 2"   
@@ -83,6 +91,9 @@ class TestHTTPRequestHandler(BaseHTTPRequestHandler):
     """
     ignore_exceptions = (Exception,)
 
+    # Requests seen on '/sim/', for error injection
+    sim_count = 0
+
     def read(self):
         # The following logic is adapted from the library module
         # SimpleXMLRPCServer.py.
@@ -220,6 +231,43 @@ class TestHTTPRequestHandler(BaseHTTPRequestHandler):
             self.end_headers()
             if body:
                 self.wfile.write(body.encode("utf-8"))
+        elif "/dribble/" in self.path:
+            # Large body arriving slowly, so the client sees it over
+            # many write callbacks rather than in one piece.
+            size = 256 * 1024
+            chunk = 4096
+            body = bytes(i % 251 for i in range(size))
+            self.send_response(200)
+            self.send_header("Content-type", "application/octet-stream")
+            self.send_header("Content-Length", str(size))
+            self.end_headers()
+            if withdata:
+                for pos in range(0, size, chunk):
+                    self.wfile.write(body[pos:pos + chunk])
+                    self.wfile.flush()
+                    time.sleep(0.002)
+        elif "/sim/" in self.path:
+            TestHTTPRequestHandler.sim_count += 1
+            rate = self.path_value("rate", 1024 * 1024)
+            err = self.path_value("err", 0)
+            if err and TestHTTPRequestHandler.sim_count % err == 0:
+                self.send_response(503)
+                self.send_header("Content-type", "text/plain")
+                self.send_header("Content-Length", "0")
+                self.end_headers()
+                return
+            size = 32 * 1024
+            chunk = 4096
+            self.send_response(200)
+            self.send_header("Content-type", "application/octet-stream")
+            self.send_header("Content-Length", str(size))
+            self.end_headers()
+            if withdata:
+                piece = b"x" * chunk
+                for pos in range(0, size, chunk):
+                    self.wfile.write(piece)
+                    self.wfile.flush()
+                    time.sleep(float(chunk) / rate)
         elif "fail" not in self.path:
             data = data.copy()          # we're going to modify
             # Ensure there's a "reply" key in data, even if there wasn't before
@@ -252,6 +300,14 @@ class TestHTTPRequestHandler(BaseHTTPRequestHandler):
                 self.reflect_headers()
             self.end_headers()
 
+    def path_value(self, name, default):
+        # Integer following '/<name>/' in the path, if any
+        fragments = self.path.split("/")
+        try:
+            return int(fragments[fragments.index(name) + 1])
+        except (ValueError, IndexError):
+            return default
+
     def reflect_headers(self):
         for (name, val) in self.headers.items():
             # print("Header: %s %s" % (name, val), file=sys.stderr)
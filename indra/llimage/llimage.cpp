@@ -38,6 +38,7 @@
 #include "llimagejpeg.h"
 #include "llimagepng.h"
 #include "llimagedxt.h"
+#include "llallocator.h"
 #include "llmemory.h"
 
 #include <boost/preprocessor.hpp>
@@ -625,9 +626,12 @@ void LLImage::setLastError(const std::string& message)
 // <FS:ND> Report amount of failed buffer allocations
 U32 LLImageBase::sAllocationErrors;
 
+LLTrace::MemStatHandle LLImageBase::sMemStat("LLImage");
+
 LLImageBase::LLImageBase()
 :   mData(NULL),
     mDataSize(0),
+    mMemFootprint(sMemStat),
     mWidth(0),
     mHeight(0),
     mComponents(0),
@@ -678,6 +682,7 @@ void LLImageBase::deleteData()
     ll_aligned_free_16(mData);
     mDataSize = 0;
     mData = NULL;
+    mMemFootprint.setBytes(0);
 }
 
 // virtual
@@ -714,6 +719,7 @@ U8* LLImageBase::allocateData(S32 size)
     if (!mBadBufferAllocation && (!mData || size != mDataSize))
     {
         deleteData(); // virtual
+        LLAllocator::ScopedCategory category(sMemStat);
         mData = (U8*)ll_aligned_malloc_16(size);
         if (!mData)
         {
@@ -734,6 +740,7 @@ U8* LLImageBase::allocateData(S32 size)
         addAllocationError();
     }
     mDataSize = size;
+    mMemFootprint.setBytes(mData ? size : 0);
 
     return mData;
 }
@@ -741,6 +748,7 @@ U8* LLImageBase::allocateData(S32 size)
 // virtual
 U8* LLImageBase::reallocateData(S32 size)
 {
+    LLAllocator::ScopedCategory category(sMemStat);
     U8 *new_datap = (U8*)ll_aligned_malloc_16(size);
     if (!new_datap)
     {
@@ -755,6 +763,7 @@ U8* LLImageBase::reallocateData(S32 size)
     }
     mData = new_datap;
     mDataSize = size;
+    mMemFootprint.setBytes(size);
     mBadBufferAllocation = false;
     return mData;
 }
@@ -1487,6 +1496,7 @@ bool LLImageRaw::scale( S32 new_width, S32 new_height, bool scale_image_data )
 
         if (new_data_size > 0)
         {
+            LLAllocator::ScopedCategory category(sMemStat);
             U8 *new_data = (U8*)ll_aligned_malloc_16(new_data_size); 
             if(NULL == new_data) 
             {
@@ -2304,6 +2314,7 @@ void LLImageBase::setDataAndSize(U8 *data, S32 size)
     ll_assert_aligned(data, 16);
     mData = data; 
     mDataSize = size; 
+    mMemFootprint.setBytes(data ? llmax(size, 0) : 0);
 }   
 
 //static
@@ -160,11 +160,12 @@ public:
 
     static EImageCodec getCodecFromExtension(const std::string& exten);
 
-    //static LLTrace::MemStatHandle sMemStat;
+    static LLTrace::MemStatHandle sMemStat;
 
 private:
     U8 *mData;
     S32 mDataSize;
+    LLTrace::MemFootprint mMemFootprint;
 
     U16 mWidth;
     U16 mHeight;
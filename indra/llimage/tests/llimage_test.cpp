@@ -0,0 +1,116 @@
+/** 
+ * @file llimage_test.cpp
+ * @brief Tests for LLImageRaw memory accounting.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llimage.h"
+#include "lltrace.h"
+
+#include "../test/lltut.h"
+
+namespace
+{
+    LLTrace::MemStatHandle& mem_stat(const std::string& name)
+    {
+        LLTrace::StatType<LLTrace::MemAccumulator>::ptr_t stat = LLTrace::StatType<LLTrace::MemAccumulator>::getInstance(name);
+        tut::ensure(name + " memory stat is registered", bool(stat));
+        return static_cast<LLTrace::MemStatHandle&>(*stat);
+    }
+}
+
+namespace tut
+{
+    struct llimage_data
+    {
+        llimage_data()
+        {
+            LLImage::initClass();
+        }
+
+        ~llimage_data()
+        {
+            LLImage::cleanupClass();
+        }
+    };
+    typedef test_group<llimage_data> llimage_group;
+    typedef llimage_group::object llimage_object;
+    tut::llimage_group llimage_test("LLImage");
+
+    template<> template<>
+    void llimage_object::test<1>()
+    {
+        set_test_name("LLImageRaw memory returns to zero after teardown");
+
+        LLTrace::MemStatHandle& images = mem_stat("LLImage");
+        ensure_equals("no image bytes at start", images.getLiveBytes(), 0);
+        ensure_equals("no images at start", images.getLiveCount(), 0);
+
+        LLPointer<LLImageRaw> raw = new LLImageRaw(64, 64, 4);
+        ensure_equals("new image is claimed", images.getLiveBytes(), 64 * 64 * 4);
+        ensure_equals("one image", images.getLiveCount(), 1);
+
+        raw->resize(128, 128, 3);
+        ensure_equals("resize reclaims", images.getLiveBytes(), 128 * 128 * 3);
+
+        raw->scale(32, 32);
+        ensure_equals("scaling the image data reclaims", images.getLiveBytes(), 32 * 32 * 3);
+
+        raw->scale(48, 40, false);
+        ensure_equals("scaling the canvas reclaims", images.getLiveBytes(), 48 * 40 * 3);
+
+        LLPointer<LLImageRaw> copy = new LLImageRaw(raw->getData(), raw->getWidth(), raw->getHeight(), raw->getComponents());
+        ensure_equals("a copy claims its own buffer", images.getLiveBytes(), 2 * 48 * 40 * 3);
+        ensure_equals("two images", images.getLiveCount(), 2);
+
+        copy->deleteData();
+        ensure_equals("deleted data is released", images.getLiveBytes(), 48 * 40 * 3);
+
+        copy = NULL;
+        raw = NULL;
+        ensure_equals("no image bytes after teardown", images.getLiveBytes(), 0);
+        ensure_equals("no images after teardown", images.getLiveCount(), 0);
+    }
+
+    template<> template<>
+    void llimage_object::test<2>()
+    {
+        set_test_name("LLImageRaw scaled copies keep the accounting");
+
+        LLTrace::MemStatHandle& images = mem_stat("LLImage");
+        {
+            LLPointer<LLImageRaw> raw = new LLImageRaw(200, 100, 4);
+            raw->clear(0x80, 0x80, 0x80, 0xff);
+            LLPointer<LLImageRaw> scaled = raw->scaled(64, 64);
+            ensure("scaled copy made", scaled.notNull());
+            ensure_equals("both images claimed", images.getLiveBytes(), 200 * 100 * 4 + 64 * 64 * 4);
+            raw->contractToPowerOfTwo();
+            ensure_equals("contracting reclaims", images.getLiveBytes(), 128 * 64 * 4 + 64 * 64 * 4);
+        }
+        ensure_equals("no image bytes left", images.getLiveBytes(), 0);
+        ensure_equals("no images left", images.getLiveCount(), 0);
+    }
+}
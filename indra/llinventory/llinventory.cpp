@@ -66,6 +66,8 @@ static const std::string INV_FOLDER_ID_LABEL_WS("category_id");
 
 const LLUUID MAGIC_ID("3c115e51-04f4-523c-9fa6-98aff1034730");  
 
+static LLTrace::MemStatHandle sInventoryObjectMemStat("LLInventoryObject");
+
 ///----------------------------------------------------------------------------
 /// Class LLInventoryObject
 ///----------------------------------------------------------------------------
@@ -78,15 +80,19 @@ LLInventoryObject::LLInventoryObject(const LLUUID& uuid,
     mParentUUID(parent_uuid),
     mType(type),
     mName(name),
-    mCreationDate(0)
+    mCreationDate(0),
+    mMemFootprint(sInventoryObjectMemStat)
 {
     correctInventoryName(mName);
+    mMemFootprint.setBytes(sizeof(LLInventoryObject));
 }
 
 LLInventoryObject::LLInventoryObject() 
 :   mType(LLAssetType::AT_NONE),
-    mCreationDate(0)
+    mCreationDate(0),
+    mMemFootprint(sInventoryObjectMemStat)
 {
+    mMemFootprint.setBytes(sizeof(LLInventoryObject));
 }
 
 LLInventoryObject::~LLInventoryObject()
@@ -306,6 +312,7 @@ LLInventoryItem::LLInventoryItem(const LLUUID& uuid,
     LLStringUtil::replaceChar(mDescription, '|', ' ');
 
     mPermissions.initMasks(inv_type);
+    mMemFootprint.setBytes(sizeof(LLInventoryItem));
 }
 
 LLInventoryItem::LLInventoryItem() :
@@ -318,12 +325,14 @@ LLInventoryItem::LLInventoryItem() :
     mFlags(0)
 {
     mCreationDate = 0;
+    mMemFootprint.setBytes(sizeof(LLInventoryItem));
 }
 
 LLInventoryItem::LLInventoryItem(const LLInventoryItem* other) :
     LLInventoryObject()
 {
     copyItem(other);
+    mMemFootprint.setBytes(sizeof(LLInventoryItem));
 }
 
 LLInventoryItem::~LLInventoryItem()
@@ -1190,18 +1199,21 @@ LLInventoryCategory::LLInventoryCategory(const LLUUID& uuid,
     LLInventoryObject(uuid, parent_uuid, LLAssetType::AT_CATEGORY, name),
     mPreferredType(preferred_type)
 {
+    mMemFootprint.setBytes(sizeof(LLInventoryCategory));
 }
 
 LLInventoryCategory::LLInventoryCategory() :
     mPreferredType(LLFolderType::FT_NONE)
 {
     mType = LLAssetType::AT_CATEGORY;
+    mMemFootprint.setBytes(sizeof(LLInventoryCategory));
 }
 
 LLInventoryCategory::LLInventoryCategory(const LLInventoryCategory* other) :
     LLInventoryObject()
 {
     copyCategory(other);
+    mMemFootprint.setBytes(sizeof(LLInventoryCategory));
 }
 
 LLInventoryCategory::~LLInventoryCategory()
@@ -24,6 +24,7 @@
  */
 
 #include "linden_common.h"
+#include "llallocator.h"
 #include "llmemory.h"
 #include "llmath.h"
 
@@ -4082,11 +4083,32 @@ void LLVolume::generateSilhouetteVertices(std::vector<LLVector3> &vertices,
     }
 }
 
+//barycentric interpolation of a per vertex attribute at a line segment hit
+static LLVector4a interpolate_at_hit(const LLVector4a* attrib, const U16* idx, F32 a, F32 b)
+{
+    LLVector4a v1, v2, v3;
+    v1 = attrib[idx[0]];
+    v1.mul(1.f-a-b);
+
+    v2 = attrib[idx[1]];
+    v2.mul(a);
+
+    v3 = attrib[idx[2]];
+    v3.mul(b);
+
+    v1.add(v2);
+    v1.add(v3);
+    return v1;
+}
+
 S32 LLVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a& end, 
                                    S32 face,
                                    LLVector4a* intersection,LLVector2* tex_coord, LLVector4a* normal, LLVector4a* tangent_out)
 {
     S32 hit_face = -1;
+    U16 hit_index[3] = { 0, 0, 0 };
+    F32 hit_a = 0.f;
+    F32 hit_b = 0.f;
     
     S32 start_face;
     S32 end_face;
@@ -4122,11 +4144,6 @@ S32 LLVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a& en
 
         if (LLLineSegmentBoxIntersect(start, end, box_center, box_size))
         {
-            if (tangent_out != NULL) // if the caller wants tangents, we may need to generate them
-            {
-                genTangents(i);
-            }
-
             if (isUnique())
             { //don't bother with an octree for flexi volumes
                 U32 tri_count = face.mNumIndices/3;
@@ -4191,25 +4208,11 @@ S32 LLVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a& en
                                 *normal     = n1; 
                             }
 
-                            if (tangent_out != NULL)
-                            {
-                                LLVector4a* tangents = face.mTangents;
-                                
-                                LLVector4a t1,t2,t3;
-                                t1 = tangents[idx0];
-                                t1.mul(1.f-a-b);
-                                
-                                t2 = tangents[idx1];
-                                t2.mul(a);
-                                
-                                t3 = tangents[idx2];
-                                t3.mul(b);
-
-                                t1.add(t2);
-                                t1.add(t3);
-                                
-                                *tangent_out = t1; 
-                            }
+                            hit_index[0] = idx0;
+                            hit_index[1] = idx1;
+                            hit_index[2] = idx2;
+                            hit_a = a;
+                            hit_b = b;
                         }
                     }
                 }
@@ -4221,16 +4224,32 @@ S32 LLVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a& en
                     face.createOctree();
                 }
             
-                LLOctreeTriangleRayIntersect intersect(start, dir, &face, &closest_t, intersection, tex_coord, normal, tangent_out);
+                LLOctreeTriangleRayIntersect intersect(start, dir, &face, &closest_t, intersection, tex_coord, normal, NULL);
                 intersect.traverse(face.getOctree());
                 if (intersect.mHitFace)
                 {
                     hit_face = i;
+                    hit_index[0] = intersect.mHitIndex[0];
+                    hit_index[1] = intersect.mHitIndex[1];
+                    hit_index[2] = intersect.mHitIndex[2];
+                    hit_a = intersect.mHitA;
+                    hit_b = intersect.mHitB;
                 }
             }
         }       
     }
     
+    if (tangent_out != NULL && hit_face != -1)
+    { // only the face that was hit needs tangents, so generate them once the closest hit is known
+        genTangents(hit_face);
+
+        const LLVolumeFace& face = mVolumeFaces[hit_face];
+        *tangent_out = interpolate_at_hit(face.mTangents, hit_index, hit_a, hit_b);
+        if (normal != NULL)
+        { // createTangents() normalizes the face normals
+            *normal = interpolate_at_hit(face.mNormals, hit_index, hit_a, hit_b);
+        }
+    }
     
     return hit_face;
 }
@@ -4755,6 +4774,10 @@ std::ostream& operator<<(std::ostream &s, const LLVolume *volumep)
     return s;
 }
 
+static LLTrace::MemStatHandle sVolumeFaceMemStat("LLVolumeFace");
+// tangents and octrees a face has not needed yet, i.e. what eager generation would have cost
+static LLTrace::MemStatHandle sVolumeFaceDeferredMemStat("LLVolumeFaceDeferred");
+
 LLVolumeFace::LLVolumeFace() : 
     mID(0),
     mTypeMask(0),
@@ -4778,7 +4801,9 @@ LLVolumeFace::LLVolumeFace() :
     mWeightsScrubbed(FALSE),
     mOctree(NULL),
     mOctreeTriangles(NULL),
-    mOptimized(FALSE)
+    mOptimized(FALSE),
+    mMemFootprint(sVolumeFaceMemStat),
+    mDeferredFootprint(sVolumeFaceDeferredMemStat)
 {
     mExtents = (LLVector4a*) ll_aligned_malloc_16(sizeof(LLVector4a)*3);
     mExtents[0].splat(-0.5f);
@@ -4808,7 +4833,9 @@ LLVolumeFace::LLVolumeFace(const LLVolumeFace& src)
 #endif
     mWeightsScrubbed(FALSE),
     mOctree(NULL),
-    mOctreeTriangles(NULL)
+    mOctreeTriangles(NULL),
+    mMemFootprint(sVolumeFaceMemStat),
+    mDeferredFootprint(sVolumeFaceDeferredMemStat)
 {
     mExtents = (LLVector4a*) ll_aligned_malloc_16(sizeof(LLVector4a)*3);
     mCenter = mExtents+2;
@@ -4912,6 +4939,7 @@ LLVolumeFace& LLVolumeFace::operator=(const LLVolumeFace& src)
     }
 
     mOptimized = src.mOptimized;
+    updateMemFootprint();
 
     //delete 
     return *this;
@@ -4950,6 +4978,57 @@ void LLVolumeFace::freeData()
 #endif
 
     destroyOctree();
+    updateMemFootprint();
+}
+
+void LLVolumeFace::updateMemFootprint()
+{
+    size_t bytes = 0;
+    if (mPositions)
+    {
+        // normals and texture coordinates share the position buffer
+        S32 num_verts = llmax(mNumAllocatedVertices, mNumVertices);
+        bytes += sizeof(LLVector4a) * 2 * num_verts + (((num_verts * sizeof(LLVector2)) + 0xF) & ~0xF);
+    }
+    if (mIndices)
+    {
+        bytes += ((mNumIndices * sizeof(U16)) + 0xF) & ~0xF;
+    }
+    size_t tangent_bytes = sizeof(LLVector4a) * mNumVertices;
+    size_t octree_bytes = sizeof(LLVolumeTriangle) * (mNumIndices / 3);
+    size_t deferred = 0;
+    if (mTangents)
+    {
+        bytes += tangent_bytes;
+    }
+    else
+    {
+        deferred += tangent_bytes;
+    }
+    if (mOctree)
+    {
+        bytes += octree_bytes;
+    }
+    else
+    {
+        deferred += octree_bytes;
+    }
+    mDeferredFootprint.setBytes(deferred);
+    if (mWeights)
+    {
+        bytes += sizeof(LLVector4a) * mNumVertices;
+    }
+#if USE_SEPARATE_JOINT_INDICES_AND_WEIGHTS
+    if (mJointIndices)
+    {
+        bytes += sizeof(U8) * 4 * mNumVertices;
+    }
+    if (mJustWeights)
+    {
+        bytes += sizeof(LLVector4a) * mNumVertices;
+    }
+#endif
+    mMemFootprint.setBytes(bytes);
 }
 
 BOOL LLVolumeFace::create(LLVolume* volume, BOOL partial_build)
@@ -5036,6 +5115,7 @@ void LLVolumeFace::remap()
         mNumVertices);
 
     // Allocate new buffers
+    LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
     S32 size = ((mNumIndices * sizeof(U16)) + 0xF) & ~0xF;
     U16* remap_indices = (U16*)ll_aligned_malloc_16(size);
 
@@ -5065,6 +5145,7 @@ void LLVolumeFace::remap()
     mTexCoords = remap_tex_coords;
     mNumVertices = remap_vertices_count;
     mNumAllocatedVertices = remap_vertices_count;
+    updateMemFootprint();
 }
 
 void LLVolumeFace::optimize(F32 angle_cutoff)
@@ -5570,6 +5651,7 @@ bool LLVolumeFace::cacheOptimize()
     //optimize for pre-TnL cache
     
     //allocate space for new buffer
+    LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
     S32 num_verts = mNumVertices;
     S32 size = ((num_verts*sizeof(LLVector2)) + 0xF) & ~0xF;
     LLVector4a* pos = (LLVector4a*) ll_aligned_malloc<64>(sizeof(LLVector4a)*2*num_verts+size);
@@ -5668,6 +5750,7 @@ bool LLVolumeFace::cacheOptimize()
     mTexCoords = tc;
     mWeights = wght;    
     mTangents = binorm;
+    updateMemFootprint();
 
     //std::string result = llformat("ACMR pre/post: %.3f/%.3f  --  %d triangles %d breaks", pre_acmr, post_acmr, mNumIndices/3, breaks);
     //LL_INFOS() << result << LL_ENDL;
@@ -5760,14 +5843,20 @@ void LLVolumeFace::createOctree(F32 scaler, const LLVector4a& center, const LLVe
         LLVolumeOctreeValidate validate;
         validate.traverse(mOctree);
     }
+
+    updateMemFootprint();
 }
 
 void LLVolumeFace::destroyOctree()
 {
-    delete mOctree;
-    mOctree = NULL;
-    delete[] mOctreeTriangles;
-    mOctreeTriangles = NULL;
+    if (mOctree)
+    {
+        delete mOctree;
+        mOctree = NULL;
+        delete[] mOctreeTriangles;
+        mOctreeTriangles = NULL;
+        updateMemFootprint();
+    }
 }
 
 const LLOctreeNode<LLVolumeTriangle, LLVolumeTriangle*>* LLVolumeFace::getOctree() const
@@ -5784,7 +5873,11 @@ void LLVolumeFace::swapData(LLVolumeFace& rhs)
     llswap(rhs.mTexCoords, mTexCoords);
     llswap(rhs.mIndices,mIndices);
     llswap(rhs.mNumVertices, mNumVertices);
+    // goes with mPositions; pushVertex() trusts it when growing the buffer
+    llswap(rhs.mNumAllocatedVertices, mNumAllocatedVertices);
     llswap(rhs.mNumIndices, mNumIndices);
+    updateMemFootprint();
+    rhs.updateMemFootprint();
 }
 
 void    LerpPlanarVertex(LLVolumeFace::VertexData& v0,
@@ -6534,6 +6627,7 @@ void LLVolumeFace::resizeVertices(S32 num_verts)
         //pad texture coordinate block end to allow for QWORD reads
         S32 tc_size = ((num_verts*sizeof(LLVector2)) + 0xF) & ~0xF;
 
+        LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
         mPositions = (LLVector4a*) ll_aligned_malloc<64>(sizeof(LLVector4a)*2*num_verts+tc_size);
         mNormals = mPositions+num_verts;
         mTexCoords = (LLVector2*) (mNormals+num_verts);
@@ -6560,6 +6654,8 @@ void LLVolumeFace::resizeVertices(S32 num_verts)
         mNumAllocatedVertices = 0;
     }
 
+    updateMemFootprint();
+
     // Force update
     mJointRiggingInfoTab.clear();
 }
@@ -6587,6 +6683,7 @@ void LLVolumeFace::pushVertex(const LLVector4a& pos, const LLVector4a& norm, con
 
         LLVector4a* old_buf = mPositions;
 
+        LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
         mPositions = (LLVector4a*) ll_aligned_malloc<64>(new_size);
         mNormals = mPositions+new_verts;
         mTexCoords = (LLVector2*) (mNormals+new_verts);
@@ -6609,7 +6706,7 @@ void LLVolumeFace::pushVertex(const LLVector4a& pos, const LLVector4a& norm, con
         ll_aligned_free<64>(old_buf);
 
         mNumAllocatedVertices = new_verts;
-
+        updateMemFootprint();
     }
 
     mPositions[mNumVertices] = pos;
@@ -6621,25 +6718,30 @@ void LLVolumeFace::pushVertex(const LLVector4a& pos, const LLVector4a& norm, con
 
 void LLVolumeFace::allocateTangents(S32 num_verts)
 {
+    LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
     ll_aligned_free_16(mTangents);
     mTangents = (LLVector4a*) ll_aligned_malloc_16(sizeof(LLVector4a)*num_verts);
+    updateMemFootprint();
 }
 
 void LLVolumeFace::allocateWeights(S32 num_verts)
 {
+    LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
     ll_aligned_free_16(mWeights);
     mWeights = (LLVector4a*)ll_aligned_malloc_16(sizeof(LLVector4a)*num_verts);
-    
+    updateMemFootprint();
 }
 
 void LLVolumeFace::allocateJointIndices(S32 num_verts)
 {
 #if USE_SEPARATE_JOINT_INDICES_AND_WEIGHTS
+    LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
     ll_aligned_free_16(mJointIndices);
     ll_aligned_free_16(mJustWeights);
 
     mJointIndices = (U8*)ll_aligned_malloc_16(sizeof(U8) * 4 * num_verts);    
     mJustWeights = (LLVector4a*)ll_aligned_malloc_16(sizeof(LLVector4a) * num_verts);    
+    updateMemFootprint();
 #endif
 }
 
@@ -6653,6 +6755,7 @@ void LLVolumeFace::resizeIndices(S32 num_indices)
         //pad index block end to allow for QWORD reads
         S32 size = ((num_indices*sizeof(U16)) + 0xF) & ~0xF;
         
+        LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
         mIndices = (U16*) ll_aligned_malloc_16(size);
     }
     else
@@ -6669,6 +6772,7 @@ void LLVolumeFace::resizeIndices(S32 num_indices)
         // Either num_indices is zero or allocation failure
         mNumIndices = 0;
     }
+    updateMemFootprint();
 }
 
 void LLVolumeFace::pushIndex(const U16& idx)
@@ -6679,11 +6783,16 @@ void LLVolumeFace::pushIndex(const U16& idx)
     S32 old_size = ((mNumIndices*2)+0xF) & ~0xF;
     if (new_size != old_size)
     {
+        LLAllocator::ScopedCategory category(sVolumeFaceMemStat);
         mIndices = (U16*) ll_aligned_realloc_16(mIndices, new_size, old_size);
         ll_assert_aligned(mIndices,16);
     }
     
     mIndices[mNumIndices++] = idx;
+    if (new_size != old_size)
+    {
+        updateMemFootprint();
+    }
 }
 
 void LLVolumeFace::fillFromLegacyData(std::vector<LLVolumeFace::VertexData>& v, std::vector<U16>& idx)
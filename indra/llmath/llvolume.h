@@ -59,6 +59,7 @@ class LLVolumeTriangle;
 #include "llfile.h"
 #include "llalignedarray.h"
 #include "llrigginginfo.h"
+#include "lltrace.h"
 
 //============================================================================
 
@@ -989,8 +990,15 @@ public:
     BOOL mOptimized;
 
 private:
+    // Re-claims the vertex, index, tangent, weight and octree buffers against
+    // the LLVolumeFace memory stat after they were (re)allocated.  Tangents and
+    // octrees that have not been built are claimed against LLVolumeFaceDeferred.
+    void updateMemFootprint();
+
     LLOctreeNode<LLVolumeTriangle, LLVolumeTriangle*>* mOctree;
     LLVolumeTriangle* mOctreeTriangles;
+    LLTrace::MemFootprint mMemFootprint;
+    LLTrace::MemFootprint mDeferredFootprint;
 
     BOOL createUnCutCubeCap(LLVolume* volume, BOOL partial_build = FALSE);
     BOOL createCap(LLVolume* volume, BOOL partial_build = FALSE);
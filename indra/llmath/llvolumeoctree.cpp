@@ -102,8 +102,11 @@ LLOctreeTriangleRayIntersect::LLOctreeTriangleRayIntersect(const LLVector4a& sta
      mNormal(normal),
      mTangent(tangent),
      mClosestT(closest_t),
-     mHitFace(false)
+     mHitFace(false),
+     mHitA(0.f),
+     mHitB(0.f)
 {
+    mHitIndex[0] = mHitIndex[1] = mHitIndex[2] = 0;
     mEnd.setAdd(mStart, mDir);
 }
 
@@ -152,6 +155,12 @@ void LLOctreeTriangleRayIntersect::visit(const LLOctreeNode<LLVolumeTriangle, LL
                 U32 idx1 = tri->mIndex[1];
                 U32 idx2 = tri->mIndex[2];
 
+                mHitIndex[0] = tri->mIndex[0];
+                mHitIndex[1] = tri->mIndex[1];
+                mHitIndex[2] = tri->mIndex[2];
+                mHitA = a;
+                mHitB = b;
+
                 if (mTexCoord != NULL)
                 {
                     LLVector2* tc = (LLVector2*) mFace->mTexCoords;
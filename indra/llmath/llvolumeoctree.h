@@ -122,6 +122,9 @@ public:
     LLVector4a* mTangent;
     F32* mClosestT;
     bool mHitFace;
+    U16 mHitIndex[3]; // vertex indices and barycentric coordinates of the closest hit
+    F32 mHitA;
+    F32 mHitB;
 
     LLOctreeTriangleRayIntersect(const LLVector4a& start, const LLVector4a& dir, 
                                    const LLVolumeFace* face, F32* closest_t,
@@ -0,0 +1,141 @@
+/** 
+ * @file llvolume_test.cpp
+ * @brief Tests for LLVolumeFace memory accounting.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../test/lltut.h"
+
+#include "../llvolume.h"
+#include "lltrace.h"
+
+namespace
+{
+    LLTrace::MemStatHandle& mem_stat(const std::string& name)
+    {
+        LLTrace::StatType<LLTrace::MemAccumulator>::ptr_t stat = LLTrace::StatType<LLTrace::MemAccumulator>::getInstance(name);
+        tut::ensure(name + " memory stat is registered", bool(stat));
+        return static_cast<LLTrace::MemStatHandle&>(*stat);
+    }
+
+    // A strip of triangles over num_verts vertices, enough to build an octree on.
+    void fill_face(LLVolumeFace& face, S32 num_verts)
+    {
+        face.resizeVertices(num_verts);
+        for (S32 i = 0; i < num_verts; ++i)
+        {
+            face.mPositions[i].set((F32)(i % 10) * 0.1f - 0.5f, (F32)(i / 10) * 0.1f - 0.5f, 0.f);
+            face.mNormals[i].set(0.f, 0.f, 1.f);
+            face.mTexCoords[i].set(0.f, 0.f);
+        }
+        face.resizeIndices((num_verts - 2) * 3);
+        for (S32 i = 0; i < num_verts - 2; ++i)
+        {
+            face.mIndices[i * 3] = (U16)i;
+            face.mIndices[i * 3 + 1] = (U16)(i + 1);
+            face.mIndices[i * 3 + 2] = (U16)(i + 2);
+        }
+        face.mExtents[0].set(-0.5f, -0.5f, -0.5f);
+        face.mExtents[1].set(0.5f, 0.5f, 0.5f);
+    }
+}
+
+namespace tut
+{
+    struct llvolume_data
+    {
+    };
+    typedef test_group<llvolume_data> llvolume_group;
+    typedef llvolume_group::object llvolume_object;
+    tut::llvolume_group llvolume_test("LLVolume");
+
+    template<> template<>
+    void llvolume_object::test<1>()
+    {
+        set_test_name("LLVolumeFace memory returns to zero after teardown");
+
+        LLTrace::MemStatHandle& faces = mem_stat("LLVolumeFace");
+        LLTrace::MemStatHandle& deferred = mem_stat("LLVolumeFaceDeferred");
+        ensure_equals("no face bytes at start", faces.getLiveBytes(), 0);
+        ensure_equals("no faces at start", faces.getLiveCount(), 0);
+
+        LLVolumeFace* face = new LLVolumeFace();
+        ensure_equals("an empty face is counted", faces.getLiveCount(), 1);
+
+        fill_face(*face, 100);
+        const S64 filled = faces.getLiveBytes();
+        ensure("vertices and indices are claimed", filled > 0);
+        ensure("the tangents not built yet are deferred", deferred.getLiveBytes() > 0);
+
+        face->allocateTangents(100);
+        face->allocateWeights(100);
+        face->createOctree();
+        ensure("tangents, weights and octree are claimed", faces.getLiveBytes() > filled);
+
+        face->destroyOctree();
+        fill_face(*face, 50);
+        ensure("shrinking the face releases bytes", faces.getLiveBytes() < filled);
+
+        const S64 one_face = faces.getLiveBytes();
+        LLVolumeFace* copy = new LLVolumeFace(*face);
+        ensure_equals("a copy is its own face", faces.getLiveCount(), 2);
+        ensure_equals("a copy claims its own buffers", faces.getLiveBytes(), 2 * one_face);
+
+        {
+            LLVolumeFace first;
+            LLVolumeFace second;
+            fill_face(first, 30);
+            fill_face(second, 20);
+            const S64 before_swap = faces.getLiveBytes();
+            first.swapData(second);
+            ensure_equals("swapping buffers keeps the total", faces.getLiveBytes(), before_swap);
+        }
+
+        delete copy;
+        delete face;
+        ensure_equals("no face bytes after teardown", faces.getLiveBytes(), 0);
+        ensure_equals("no faces after teardown", faces.getLiveCount(), 0);
+        ensure_equals("no deferred bytes after teardown", deferred.getLiveBytes(), 0);
+    }
+
+    template<> template<>
+    void llvolume_object::test<2>()
+    {
+        set_test_name("LLVolumeFace stats are empty once every face is gone");
+
+        {
+            LLVolumeFace face;
+            fill_face(face, 64);
+            face.createTangents();
+            LLVolumeFace assigned;
+            assigned = face;
+        }
+
+        ensure_equals("no face bytes left", mem_stat("LLVolumeFace").getLiveBytes(), 0);
+        ensure_equals("no faces left", mem_stat("LLVolumeFace").getLiveCount(), 0);
+        ensure_equals("no deferred bytes left", mem_stat("LLVolumeFaceDeferred").getLiveBytes(), 0);
+    }
+}
@@ -31,6 +31,8 @@ static BOOL sTimeDecodes = FALSE;
 
 static F32 sTimeDecodesSpamThreshold = 0.05f;
 
+static bool sProfileHandlers = false;
+
 //virtual
 LLMessageReader::~LLMessageReader()
 {
@@ -60,3 +62,15 @@ F32 LLMessageReader::getTimeDecodesSpamThreshold()
 {
     return sTimeDecodesSpamThreshold;
 }
+
+//static
+void LLMessageReader::setProfileHandlers(bool b)
+{
+    sProfileHandlers = b;
+}
+
+//static
+bool LLMessageReader::getProfileHandlers()
+{
+    return sProfileHandlers;
+}
@@ -88,6 +88,11 @@ class LLMessageReader
     static BOOL getTimeDecodes();
     static void setTimeDecodesSpamThreshold(F32 seconds);
     static F32 getTimeDecodesSpamThreshold();
+
+    // Per-template handler profiling (call count, handler time, bytes).
+    // Off by default; when off the only cost is one flag test per message.
+    static void setProfileHandlers(bool b);
+    static bool getProfileHandlers();
 };
 
 #endif // LL_LLMESSAGEREADER_H
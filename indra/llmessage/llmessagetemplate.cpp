@@ -45,12 +45,38 @@ void LLMsgVarData::addData(const void *data, S32 size, EMsgVariableType type, S3
     }
     if(size)
     {
-        delete[] mData; // Delete it if it already exists
+        deleteData(); // Delete it if it already exists
         mData = new U8[size];
         htolememcpy(mData, data, mType, size);
     }
 }
 
+void LLMsgVarData::refData(const void *data, S32 size, EMsgVariableType type, S32 data_size)
+{
+#ifdef LL_BIG_ENDIAN
+    // the data has to be swizzled on the way in
+    addData(data, size, type, data_size);
+#else
+    mSize = size;
+    mDataSize = data_size;
+    if ( (type != MVT_VARIABLE) && (type != MVT_FIXED) 
+         && (mType != MVT_VARIABLE) && (mType != MVT_FIXED))
+    {
+        if (mType != type)
+        {
+            LL_WARNS() << "Type mismatch in LLMsgVarData::refData for " << mName
+                    << LL_ENDL;
+        }
+    }
+    if(size)
+    {
+        deleteData();
+        mData = (U8*)data;
+        mOwnsData = false;
+    }
+#endif
+}
+
 void LLMsgData::addDataFast(char *blockname, char *varname, const void *data, S32 size, EMsgVariableType type, S32 data_size)
 {
     // remember that if the blocknumber is > 0 then the number is appended to the name
@@ -36,11 +36,11 @@
 class LLMsgVarData
 {
 public:
-    LLMsgVarData() : mName(NULL), mSize(-1), mDataSize(-1), mData(NULL), mType(MVT_U8)
+    LLMsgVarData() : mName(NULL), mSize(-1), mDataSize(-1), mData(NULL), mOwnsData(true), mType(MVT_U8)
     {
     }
 
-    LLMsgVarData(const char *name, EMsgVariableType type) : mSize(-1), mDataSize(-1), mData(NULL), mType(type)
+    LLMsgVarData(const char *name, EMsgVariableType type) : mSize(-1), mDataSize(-1), mData(NULL), mOwnsData(true), mType(type)
     {
         mName = (char *)name; 
     }
@@ -52,11 +52,18 @@ public:
     
     void deleteData() 
     {
-        delete[] mData;
+        if (mOwnsData)
+        {
+            delete[] mData;
+        }
         mData = NULL;
+        mOwnsData = true;
     }
     
     void addData(const void *indata, S32 size, EMsgVariableType type, S32 data_size = -1);
+    // Like addData(), but refers to indata rather than copying it, where no
+    // byte swapping is needed. The caller keeps indata alive.
+    void refData(const void *indata, S32 size, EMsgVariableType type, S32 data_size = -1);
 
     char *getName() const   { return mName; }
     S32 getSize() const     { return mSize; }
@@ -71,6 +78,7 @@ protected:
     S32                 mDataSize;
 
     U8                  *mData;
+    bool                mOwnsData;
     EMsgVariableType    mType;
 };
 
@@ -103,6 +111,12 @@ public:
         temp->addData(data, size, type, data_size);
     }
 
+    void refData(char *name, const void *data, S32 size, EMsgVariableType type, S32 data_size = -1)
+    {
+        LLMsgVarData* temp = &mMemberVarData[name]; // creates a new entry if one doesn't exist
+        temp->refData(data, size, type, data_size);
+    }
+
     S32                                 mBlockNumber;
     typedef LLIndexedVector<LLMsgVarData, const char *, 8> msg_var_data_map_t;
     msg_var_data_map_t                  mMemberVarData;
@@ -286,6 +300,10 @@ public:
         mTotalDecoded(0),
         mTotalDecodeTime(0.f),
         mMaxDecodeTimePerMsg(0.f),
+        mHandlerCount(0),
+        mHandlerTime(0.0),
+        mHandlerMaxTime(0.0),
+        mHandlerBytes(0),
         mBanFromTrusted(false),
         mBanFromUntrusted(false),
         mHandlerFunc(NULL), 
@@ -388,6 +406,29 @@ public:
         return FALSE;
     }
 
+    // Accumulate one handler invocation while handler profiling is enabled
+    void recordHandlerTime(F64 seconds, S32 bytes)
+    {
+        ++mHandlerCount;
+        mHandlerTime += seconds;
+        if (seconds > mHandlerMaxTime)
+        {
+            mHandlerMaxTime = seconds;
+        }
+        if (bytes > 0)
+        {
+            mHandlerBytes += (U64)bytes;
+        }
+    }
+
+    void resetHandlerProfile()
+    {
+        mHandlerCount = 0;
+        mHandlerTime = 0.0;
+        mHandlerMaxTime = 0.0;
+        mHandlerBytes = 0;
+    }
+
     bool isUdpBanned() const
     {
         return mDeprecation == MD_UDPBLACKLISTED;
@@ -425,6 +466,10 @@ public:
     U32                                     mTotalDecoded;      // Total messages successfully decoded
     F32                                     mTotalDecodeTime;   // Total time successfully decoding messages
     F32                                     mMaxDecodeTimePerMsg;
+    U32                                     mHandlerCount;      // Handler calls recorded while profiling
+    F64                                     mHandlerTime;       // Total seconds spent in the handler function
+    F64                                     mHandlerMaxTime;    // Longest single handler call in seconds
+    U64                                     mHandlerBytes;      // Total size of the messages handled
 
     bool                                    mBanFromTrusted;
     bool                                    mBanFromUntrusted;
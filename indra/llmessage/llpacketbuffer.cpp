@@ -28,13 +28,39 @@
 
 #include "llpacketbuffer.h"
 
+#include <vector>
+
+#if LL_WINDOWS
+    #include <winsock2.h>
+#else
+    #include <netinet/in.h>
+#endif
+
 #include "net.h"
 #include "lltimer.h"
 #include "llhost.h"
+#include "llproxy.h"
+
+static_assert(LLPacketBuffer::RELAY_HEADER_SIZE == SOCKS_HEADER_SIZE, "Packet buffers must have room for the SOCKS relay header");
+
+namespace
+{
+    // Released packet buffers waiting for reuse. Main thread only. Never
+    // destroyed, so buffers released during static destruction are safe.
+    std::vector<void*>& freeBuffers()
+    {
+        static std::vector<void*>* sFreeBuffers = new std::vector<void*>;
+        return *sFreeBuffers;
+    }
+}
 
 ///////////////////////////////////////////////////////////
 
-LLPacketBuffer::LLPacketBuffer(const LLHost &host, const char *datap, const S32 size) : mHost(host)
+LLPacketBuffer::LLPacketBuffer() : mOffset(0), mSize(0)
+{
+}
+
+LLPacketBuffer::LLPacketBuffer(const LLHost &host, const char *datap, const S32 size) : mOffset(0), mHost(host)
 {
     mSize = 0;
     mData[0] = '!';
@@ -54,7 +80,7 @@ LLPacketBuffer::LLPacketBuffer(const LLHost &host, const char *datap, const S32
     
 }
 
-LLPacketBuffer::LLPacketBuffer (S32 hSocket)
+LLPacketBuffer::LLPacketBuffer (S32 hSocket) : mOffset(0)
 {
     init(hSocket);
 }
@@ -69,8 +95,77 @@ LLPacketBuffer::~LLPacketBuffer ()
 
 void LLPacketBuffer::init (S32 hSocket)
 {
+    mOffset = 0;
     mSize = receive_packet(hSocket, mData);
     mHost = ::get_sender();
     mReceivingIF = ::get_receiving_interface();
 }
 
+void LLPacketBuffer::initFromProxy(S32 hSocket)
+{
+    mOffset = 0;
+    mSize = receive_packet(hSocket, mData);
+    mReceivingIF = ::get_receiving_interface();
+
+    if (mSize > SOCKS_HEADER_SIZE)
+    {
+        // *FIX We are assuming ATYP is 0x01 (IPv4), not 0x03 (hostname) or 0x04 (IPv6)
+        proxywrap_t * header = static_cast<proxywrap_t*>(static_cast<void*>(mData));
+        mHost.setAddress(header->addr);
+        mHost.setPort(ntohs(header->port));
+
+        mOffset = SOCKS_HEADER_SIZE;
+        mSize -= SOCKS_HEADER_SIZE; // The unwrapped packet size
+    }
+    else
+    {
+        mSize = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////
+
+// static
+void* LLPacketBuffer::operator new(size_t size)
+{
+    llassert(size == sizeof(LLPacketBuffer));
+    std::vector<void*>& free_buffers = freeBuffers();
+    if (!free_buffers.empty())
+    {
+        void* ptr = free_buffers.back();
+        free_buffers.pop_back();
+        return ptr;
+    }
+    return ::operator new(size);
+}
+
+// static
+void LLPacketBuffer::operator delete(void* ptr)
+{
+    std::vector<void*>& free_buffers = freeBuffers();
+    if (ptr && free_buffers.size() < MAX_POOLED_BUFFERS)
+    {
+        free_buffers.push_back(ptr);
+    }
+    else
+    {
+        ::operator delete(ptr);
+    }
+}
+
+// static
+void LLPacketBuffer::cleanupPool()
+{
+    std::vector<void*>& free_buffers = freeBuffers();
+    for (void* ptr : free_buffers)
+    {
+        ::operator delete(ptr);
+    }
+    free_buffers.clear();
+}
+
+// static
+U32 LLPacketBuffer::getPooledCount()
+{
+    return (U32)freeBuffers().size();
+}
@@ -30,27 +30,57 @@
 
 #include "net.h"        // for NET_BUFFER_SIZE
 #include "llhost.h"
+#include "llpointer.h"
+#include "llrefcount.h"
 
-class LLPacketBuffer
+// One datagram, in or out. Packet buffers are reference counted and
+// recycled through a small free list, so an incoming packet can travel
+// from the socket through LLPacketRing's delay queue and into the message
+// reader without its bytes being copied from buffer to buffer. Like the
+// message system, they are only used on the main thread.
+class LLPacketBuffer : public LLRefCount
 {
 public:
+    typedef LLPointer<LLPacketBuffer> ptr_t;
+
+    enum { MAX_POOLED_BUFFERS = 64 };
+    // Extra room in the buffer for the SOCKS 5 UDP relay header
+    // (SOCKS_HEADER_SIZE in llproxy.h), which arrives ahead of the packet.
+    enum { RELAY_HEADER_SIZE = 10 };
+
+    LLPacketBuffer();                      // empty, for filling in place
     LLPacketBuffer(const LLHost &host, const char *datap, const S32 size);
     LLPacketBuffer(S32 hSocket);           // receive a packet
-    ~LLPacketBuffer();
 
     S32         getSize() const                 { return mSize; }
-    const char  *getData() const                { return mData; }
+    const char  *getData() const                { return mData + mOffset; }
+    char        *getData()                      { return mData + mOffset; }
     LLHost      getHost() const                 { return mHost; }
     LLHost      getReceivingInterface() const   { return mReceivingIF; }
     void init(S32 hSocket);
+    // Receive a packet relayed by the SOCKS 5 UDP proxy. The relay header
+    // is skipped rather than copied out.
+    void initFromProxy(S32 hSocket);
+
+    // For filling in place: getData() has room for getCapacity() bytes.
+    static S32  getCapacity()                   { return NET_BUFFER_SIZE; }
+    void        setSize(S32 size)               { mSize = size; }
+
+    // Free list allocation. The list only grows to the number of packets
+    // in flight at once, and is capped at MAX_POOLED_BUFFERS.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+    static void cleanupPool();
+    static U32  getPooledCount();
 
 protected:
-    char    mData[NET_BUFFER_SIZE];        // packet data       /* Flawfinder : ignore */
+    ~LLPacketBuffer();
+
+    char    mData[NET_BUFFER_SIZE + RELAY_HEADER_SIZE];        // packet data       /* Flawfinder : ignore */
+    S32     mOffset;        // start of the packet within mData
     S32     mSize;          // size of buffer in bytes
     LLHost  mHost;         // source/dest IP and port
     LLHost  mReceivingIF;         // source/dest IP and port
 };
 
 #endif
-
-
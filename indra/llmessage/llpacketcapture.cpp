@@ -0,0 +1,241 @@
+/** 
+ * @file llpacketcapture.cpp
+ * @brief Records incoming circuit packets to a file and plays them back.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llpacketcapture.h"
+
+#include "llerror.h"
+
+namespace
+{
+    const char CAPTURE_MAGIC[8] = { 'L', 'L', 'P', 'C', 'A', 'P', '\0', '\0' };
+    const U32 CAPTURE_VERSION = 1;
+
+    // time, address, port, size
+    const size_t RECORD_HEADER_SIZE = 8 + 4 + 2 + 2;
+
+    template<typename T>
+    U8* put_le(U8* out, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            *out++ = (U8)(value >> (8 * i));
+        }
+        return out;
+    }
+
+    template<typename T>
+    const U8* get_le(const U8* in, T& value)
+    {
+        value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            value |= (T)(*in++) << (8 * i);
+        }
+        return in;
+    }
+}
+
+LLPacketCapture::LLPacketCapture()
+:   mFile(NULL),
+    mRecording(false),
+    mPlaying(false),
+    mSpeed(0.f),
+    mPacketCount(0),
+    mPendingTime(0.0)
+{
+}
+
+LLPacketCapture::~LLPacketCapture()
+{
+    close();
+}
+
+bool LLPacketCapture::startRecording(const std::string& filename)
+{
+    close();
+
+    mFile = LLFile::fopen(filename, "wb");
+    if (!mFile)
+    {
+        LL_WARNS("Messaging") << "Unable to open packet capture " << filename << LL_ENDL;
+        return false;
+    }
+
+    U8 version[4];
+    put_le(version, CAPTURE_VERSION);
+    if (fwrite(CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC), 1, mFile) != 1
+        || fwrite(version, sizeof(version), 1, mFile) != 1)
+    {
+        LL_WARNS("Messaging") << "Unable to write packet capture " << filename << LL_ENDL;
+        close();
+        return false;
+    }
+
+    mRecording = true;
+    mPacketCount = 0;
+    mTimer.reset();
+    LL_INFOS("Messaging") << "Recording received packets to " << filename << LL_ENDL;
+    return true;
+}
+
+void LLPacketCapture::recordPacket(const LLPacketBuffer& packet)
+{
+    if (!mRecording || packet.getSize() <= 0)
+    {
+        return;
+    }
+
+    F64 when = mTimer.getElapsedTimeF64();
+    U64 when_bits;
+    memcpy(&when_bits, &when, sizeof(when_bits));
+
+    U8 header[RECORD_HEADER_SIZE];
+    U8* out = put_le(header, when_bits);
+    out = put_le(out, packet.getHost().getAddress());
+    out = put_le(out, (U16)packet.getHost().getPort());
+    put_le(out, (U16)packet.getSize());
+
+    if (fwrite(header, sizeof(header), 1, mFile) != 1
+        || fwrite(packet.getData(), packet.getSize(), 1, mFile) != 1)
+    {
+        LL_WARNS("Messaging") << "Packet capture write failed, stopping after "
+                              << mPacketCount << " packets" << LL_ENDL;
+        close();
+        return;
+    }
+    ++mPacketCount;
+}
+
+bool LLPacketCapture::startPlayback(const std::string& filename, F32 speed)
+{
+    close();
+
+    mFile = LLFile::fopen(filename, "rb");
+    if (!mFile)
+    {
+        LL_WARNS("Messaging") << "Unable to open packet capture " << filename << LL_ENDL;
+        return false;
+    }
+
+    char magic[sizeof(CAPTURE_MAGIC)];
+    U8 version_bytes[4];
+    U32 version = 0;
+    if (fread(magic, sizeof(magic), 1, mFile) != 1
+        || fread(version_bytes, sizeof(version_bytes), 1, mFile) != 1
+        || memcmp(magic, CAPTURE_MAGIC, sizeof(magic)) != 0)
+    {
+        LL_WARNS("Messaging") << filename << " is not a packet capture" << LL_ENDL;
+        close();
+        return false;
+    }
+    get_le(version_bytes, version);
+    if (version != CAPTURE_VERSION)
+    {
+        LL_WARNS("Messaging") << "Packet capture " << filename << " has unsupported version "
+                              << version << LL_ENDL;
+        close();
+        return false;
+    }
+
+    mPlaying = true;
+    mSpeed = speed;
+    mPacketCount = 0;
+    mTimer.reset();
+    readRecord();
+    LL_INFOS("Messaging") << "Playing back packets from " << filename << LL_ENDL;
+    return true;
+}
+
+bool LLPacketCapture::readRecord()
+{
+    mPending = NULL;
+
+    U8 header[RECORD_HEADER_SIZE];
+    if (fread(header, sizeof(header), 1, mFile) != 1)
+    {
+        return false;
+    }
+
+    U64 when_bits;
+    U32 address;
+    U16 port;
+    U16 size;
+    const U8* in = get_le(header, when_bits);
+    in = get_le(in, address);
+    in = get_le(in, port);
+    get_le(in, size);
+
+    if (size > NET_BUFFER_SIZE)
+    {
+        LL_WARNS("Messaging") << "Corrupt packet capture record of " << size
+                              << " bytes, ending playback" << LL_ENDL;
+        return false;
+    }
+
+    char data[NET_BUFFER_SIZE];
+    if (fread(data, 1, size, mFile) != size)
+    {
+        LL_WARNS("Messaging") << "Truncated packet capture, ending playback" << LL_ENDL;
+        return false;
+    }
+
+    memcpy(&mPendingTime, &when_bits, sizeof(mPendingTime));
+    mPending = new LLPacketBuffer(LLHost(address, port), data, size);
+    return true;
+}
+
+LLPacketBuffer::ptr_t LLPacketCapture::nextPacket()
+{
+    if (!mPlaying || !mPending)
+    {
+        return NULL;
+    }
+
+    if (mSpeed > 0.f && mTimer.getElapsedTimeF64() * mSpeed < mPendingTime)
+    {
+        return NULL;
+    }
+
+    LLPacketBuffer::ptr_t packet = mPending;
+    readRecord();
+    ++mPacketCount;
+    return packet;
+}
+
+void LLPacketCapture::close()
+{
+    if (mFile)
+    {
+        LLFile::close(mFile);
+        mFile = NULL;
+    }
+    mRecording = false;
+    mPlaying = false;
+    mPending = NULL;
+}
@@ -0,0 +1,88 @@
+/** 
+ * @file llpacketcapture.h
+ * @brief Records incoming circuit packets to a file and plays them back.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLPACKETCAPTURE_H
+#define LL_LLPACKETCAPTURE_H
+
+#include "llfile.h"
+#include "llpacketbuffer.h"
+#include "lltimer.h"
+
+// Writes every packet received on the message socket to a file, with the
+// time it arrived and who sent it, and feeds such a file back in place of
+// the socket. LLPacketRing uses it so that a session can be recorded once
+// and replayed through the message system as often as needed, for instance
+// by the viewer's headless benchmark mode.
+//
+// The file starts with an eight byte magic and a version; each record is
+// the arrival time in seconds since recording started (F64), the sender's
+// address (U32) and port (U16), the packet size (U16) and the packet bytes.
+// Values are stored little endian.
+class LLPacketCapture
+{
+public:
+    LLPacketCapture();
+    ~LLPacketCapture();
+
+    // Starts writing received packets to filename, truncating it.
+    bool startRecording(const std::string& filename);
+    void recordPacket(const LLPacketBuffer& packet);
+
+    // Starts reading packets from filename. With a speed of 1 packets are
+    // handed out at the rate they were recorded, 2 twice as fast and so on;
+    // a speed of 0 or less hands them out as fast as they are asked for.
+    bool startPlayback(const std::string& filename, F32 speed);
+
+    // Returns the next packet that is due, or NULL if there is none yet or
+    // the file is exhausted.
+    LLPacketBuffer::ptr_t nextPacket();
+
+    void close();
+
+    bool isRecording() const        { return mRecording; }
+    bool isPlaying() const          { return mPlaying; }
+    bool isPlaybackDone() const     { return mPlaying && !mPending; }
+
+    // Packets written or handed out so far.
+    U32 getPacketCount() const      { return mPacketCount; }
+
+private:
+    bool readRecord();
+
+    LLFILE*                 mFile;
+    bool                    mRecording;
+    bool                    mPlaying;
+    F32                     mSpeed;
+    U32                     mPacketCount;
+    LLTimer                 mTimer;
+
+    // Next packet read from the file and the time it is due.
+    LLPacketBuffer::ptr_t   mPending;
+    F64                     mPendingTime;
+};
+
+#endif // LL_LLPACKETCAPTURE_H
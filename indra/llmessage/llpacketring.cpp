@@ -68,19 +68,13 @@ LLPacketRing::~LLPacketRing ()
 ///////////////////////////////////////////////////////////
 void LLPacketRing::cleanup ()
 {
-    LLPacketBuffer *packetp;
-
     while (!mReceiveQueue.empty())
     {
-        packetp = mReceiveQueue.front();
-        delete packetp;
         mReceiveQueue.pop();
     }
 
     while (!mSendQueue.empty())
     {
-        packetp = mSendQueue.front();
-        delete packetp;
         mSendQueue.pop();
     }
 }
@@ -117,46 +111,51 @@ void LLPacketRing::setOutBandwidth(const F32 bps)
     mOutThrottle.setRate(bps);
 }
 ///////////////////////////////////////////////////////////
-S32 LLPacketRing::receiveFromRing (S32 socket, char *datap)
+LLPacketBuffer::ptr_t LLPacketRing::receiveFromRing (S32 socket)
 {
 
     if (mInThrottle.checkOverflow(0))
     {
         // We don't have enough bandwidth, don't give them a packet.
-        return 0;
+        return NULL;
     }
 
-    LLPacketBuffer *packetp = NULL;
     if (mReceiveQueue.empty())
     {
         // No packets on the queue, don't give them any.
-        return 0;
+        return NULL;
     }
 
-    S32 packet_size = 0;
-    packetp = mReceiveQueue.front();
+    LLPacketBuffer::ptr_t packetp = mReceiveQueue.front();
     mReceiveQueue.pop();
-    packet_size = packetp->getSize();
-    if (packetp->getData() != NULL)
-    {
-        memcpy(datap, packetp->getData(), packet_size); /*Flawfinder: ignore*/
-    }
+    S32 packet_size = packetp->getSize();
+
     // need to set sender IP/port!!
     mLastSender = packetp->getHost();
     mLastReceivingIF = packetp->getReceivingInterface();
-    delete packetp;
 
     this->mInBufferLength -= packet_size;
 
     // Adjust the throttle
     mInThrottle.throttleOverflow(packet_size * 8.f);
-    return packet_size;
+    return packetp;
 }
 
 ///////////////////////////////////////////////////////////
-S32 LLPacketRing::receivePacket (S32 socket, char *datap)
+LLPacketBuffer::ptr_t LLPacketRing::receivePacket (S32 socket)
 {
-    S32 packet_size = 0;
+    LLPacketBuffer::ptr_t packetp;
+
+    if (mCapture.isPlaying())
+    {
+        packetp = mCapture.nextPacket();
+        if (packetp)
+        {
+            mLastSender = packetp->getHost();
+            mLastReceivingIF = packetp->getReceivingInterface();
+        }
+        return packetp;
+    }
 
     // If using the throttle, simulate a limited size input buffer.
     if (mUseInThrottle)
@@ -166,8 +165,7 @@ S32 LLPacketRing::receivePacket (S32 socket, char *datap)
         // push any current net packet (if any) onto delay ring
         while (!done)
         {
-            LLPacketBuffer *packetp;
-            packetp = new LLPacketBuffer(socket);
+            packetp = receiveFromSocket(socket);
 
             if (packetp->getSize())
             {
@@ -181,9 +179,7 @@ S32 LLPacketRing::receivePacket (S32 socket, char *datap)
 
                 if (mPacketsToDrop)
                 {
-                    delete packetp;
                     packetp = NULL;
-                    packet_size = 0;
                     mPacketsToDrop--;
                 }
             }
@@ -196,7 +192,6 @@ S32 LLPacketRing::receivePacket (S32 socket, char *datap)
                 {
                     // Toss it.
                     LL_WARNS() << "Throwing away packet, overflowing buffer" << LL_ENDL;
-                    delete packetp;
                     packetp = NULL;
                 }
                 else if (packetp->getSize())
@@ -206,8 +201,6 @@ S32 LLPacketRing::receivePacket (S32 socket, char *datap)
                 }
                 else
                 {
-                    delete packetp;
-                    packetp = NULL;
                     done = true;
                 }
             }
@@ -219,40 +212,17 @@ S32 LLPacketRing::receivePacket (S32 socket, char *datap)
 
         // Now, grab data off of the receive queue according to our
         // throttled bandwidth settings.
-        packet_size = receiveFromRing(socket, datap);
+        packetp = receiveFromRing(socket);
     }
     else
     {
         // no delay, pull straight from net
-        if (LLProxy::isSOCKSProxyEnabled())
-        {
-            U8 buffer[NET_BUFFER_SIZE + SOCKS_HEADER_SIZE];
-            packet_size = receive_packet(socket, static_cast<char*>(static_cast<void*>(buffer)));
-            
-            if (packet_size > SOCKS_HEADER_SIZE)
-            {
-                // *FIX We are assuming ATYP is 0x01 (IPv4), not 0x03 (hostname) or 0x04 (IPv6)
-                memcpy(datap, buffer + SOCKS_HEADER_SIZE, packet_size - SOCKS_HEADER_SIZE);
-                proxywrap_t * header = static_cast<proxywrap_t*>(static_cast<void*>(buffer));
-                mLastSender.setAddress(header->addr);
-                mLastSender.setPort(ntohs(header->port));
-
-                packet_size -= SOCKS_HEADER_SIZE; // The unwrapped packet size
-            }
-            else
-            {
-                packet_size = 0;
-            }
-        }
-        else
-        {
-            packet_size = receive_packet(socket, datap);
-            mLastSender = ::get_sender();
-        }
+        packetp = receiveFromSocket(socket);
 
-        mLastReceivingIF = ::get_receiving_interface();
+        mLastSender = packetp->getHost();
+        mLastReceivingIF = packetp->getReceivingInterface();
 
-        if (packet_size)  // did we actually get a packet?
+        if (packetp->getSize())  // did we actually get a packet?
         {
             if (mDropPercentage && (ll_frand(100.f) < mDropPercentage))
             {
@@ -261,18 +231,48 @@ S32 LLPacketRing::receivePacket (S32 socket, char *datap)
 
             if (mPacketsToDrop)
             {
-                packet_size = 0;
+                packetp = NULL;
                 mPacketsToDrop--;
             }
         }
+        else
+        {
+            packetp = NULL;
+        }
+    }
+
+    if (packetp && mCapture.isRecording())
+    {
+        mCapture.recordPacket(*packetp);
     }
 
-    return packet_size;
+    return packetp;
+}
+
+LLPacketBuffer::ptr_t LLPacketRing::receiveFromSocket(S32 socket)
+{
+    LLPacketBuffer::ptr_t packetp = new LLPacketBuffer();
+    if (LLProxy::isSOCKSProxyEnabled())
+    {
+        packetp->initFromProxy(socket);
+    }
+    else
+    {
+        packetp->init(socket);
+    }
+    return packetp;
 }
 
 BOOL LLPacketRing::sendPacket(int h_socket, char * send_buffer, S32 buf_size, LLHost host)
 {
     BOOL status = TRUE;
+    if (mCapture.isPlaying())
+    {
+        // Replaying a capture: there is nobody at the other end.
+        mActualBitsOut += buf_size * 8;
+        return TRUE;
+    }
+
     if (!mUseOutThrottle)
     {
         return sendPacketImpl(h_socket, send_buffer, buf_size, host );
@@ -280,7 +280,6 @@ BOOL LLPacketRing::sendPacket(int h_socket, char * send_buffer, S32 buf_size, LL
     else
     {
         mActualBitsOut += buf_size * 8;
-        LLPacketBuffer *packetp = NULL;
         // See if we've got enough throttle to send a packet.
         while (!mOutThrottle.checkOverflow(0.f))
         {
@@ -290,15 +289,14 @@ BOOL LLPacketRing::sendPacket(int h_socket, char * send_buffer, S32 buf_size, LL
             if (!mSendQueue.empty())
             {
                 // Send a packet off of the queue
-                LLPacketBuffer *packetp = mSendQueue.front();
+                LLPacketBuffer::ptr_t packetp = mSendQueue.front();
                 mSendQueue.pop();
 
                 mOutBufferLength -= packetp->getSize();
                 packet_size = packetp->getSize();
 
                 status = sendPacketImpl(h_socket, packetp->getData(), packet_size, packetp->getHost());
-                
-                delete packetp;
+
                 // Update the throttle
                 mOutThrottle.throttleOverflow(packet_size * 8.f);
             }
@@ -334,7 +332,7 @@ BOOL LLPacketRing::sendPacket(int h_socket, char * send_buffer, S32 buf_size, LL
                 LL_INFOS() << "Outbound packet queue " << mOutBufferLength << " bytes" << LL_ENDL;
                 queue_timer.reset();
             }
-            packetp = new LLPacketBuffer(host, send_buffer, buf_size);
+            LLPacketBuffer::ptr_t packetp = new LLPacketBuffer(host, send_buffer, buf_size);
 
             mOutBufferLength += packetp->getSize();
             mSendQueue.push(packetp);
@@ -32,6 +32,7 @@
 
 #include "llhost.h"
 #include "llpacketbuffer.h"
+#include "llpacketcapture.h"
 #include "llproxy.h"
 #include "llthrottle.h"
 #include "net.h"
@@ -50,11 +51,25 @@ public:
     void setUseOutThrottle(const BOOL use_throttle);
     void setInBandwidth(const F32 bps);
     void setOutBandwidth(const F32 bps);
-    S32  receivePacket (S32 socket, char *datap);
-    S32  receiveFromRing (S32 socket, char *datap);
+    // Returns the next packet, or NULL if there is none. The packet is
+    // handed over as received; nothing is copied on the way through.
+    LLPacketBuffer::ptr_t receivePacket (S32 socket);
+    LLPacketBuffer::ptr_t receiveFromRing (S32 socket);
 
     BOOL sendPacket(int h_socket, char * send_buffer, S32 buf_size, LLHost host);
 
+    // Session capture. While recording, every packet handed out by
+    // receivePacket() is also written to the capture file. While replaying,
+    // packets come from the capture file instead of the socket and nothing
+    // is sent.
+    bool startCapture(const std::string& filename)  { return mCapture.startRecording(filename); }
+    bool startReplay(const std::string& filename, F32 speed) { return mCapture.startPlayback(filename, speed); }
+    void stopCapture()                              { mCapture.close(); }
+    bool isCapturing() const                        { return mCapture.isRecording(); }
+    bool isReplaying() const                        { return mCapture.isPlaying(); }
+    bool isReplayDone() const                       { return mCapture.isPlaybackDone(); }
+    U32  getCapturePacketCount() const              { return mCapture.getPacketCount(); }
+
     inline LLHost getLastSender();
     inline LLHost getLastReceivingInterface();
 
@@ -77,13 +92,16 @@ protected:
     F32 mDropPercentage;            // % of packets to drop
     U32 mPacketsToDrop;             // drop next n packets
 
-    std::queue<LLPacketBuffer *> mReceiveQueue;
-    std::queue<LLPacketBuffer *> mSendQueue;
+    std::queue<LLPacketBuffer::ptr_t> mReceiveQueue;
+    std::queue<LLPacketBuffer::ptr_t> mSendQueue;
 
     LLHost mLastSender;
     LLHost mLastReceivingIF;
 
+    LLPacketCapture mCapture;
+
 private:
+    LLPacketBuffer::ptr_t receiveFromSocket(S32 socket);
     BOOL sendPacketImpl(int h_socket, const char * send_buffer, S32 buf_size, LLHost host);
 };
 
@@ -63,6 +63,7 @@ void LLTemplateMessageReader::clearMessage()
     mCurrentRMessageTemplate = NULL;
     delete mCurrentRMessageData;
     mCurrentRMessageData = NULL;
+    mCurrentRPacket = NULL;
 }
 
 void LLTemplateMessageReader::getData(const char *blockname, const char *varname, void *datap, S32 size, S32 blocknum, S32 max_size)
@@ -531,6 +532,8 @@ void LLTemplateMessageReader::logRanOffEndOfPacket( const LLHost& host, const S3
 }
 
 static LLTrace::BlockTimerStatHandle FTM_PROCESS_MESSAGES("Process Messages");
+static LLTrace::CountStatHandle<> sMessageHandlerCalls("messagehandlercalls", "Number of UDP message handler calls profiled");
+static LLTrace::EventStatHandle<F64Seconds> sMessageHandlerTime("messagehandlertime", "Time spent in a single UDP message handler call");
 
 // decode a given message
 BOOL LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender )
@@ -666,7 +669,14 @@ BOOL LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
                     }
                     decode_pos += data_size;
 
-                    cur_data_block->addData(mvci.getName(), &buffer[decode_pos], tsize, mvci.getType());
+                    if (mCurrentRPacket.notNull())
+                    {
+                        cur_data_block->refData(mvci.getName(), &buffer[decode_pos], tsize, mvci.getType());
+                    }
+                    else
+                    {
+                        cur_data_block->addData(mvci.getName(), &buffer[decode_pos], tsize, mvci.getType());
+                    }
                     decode_pos += tsize;
                 }
                 else
@@ -683,6 +693,13 @@ BOOL LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
                         cur_data_block->addData(mvci.getName(), &(data[0]), 
                                                 size, mvci.getType());
                     }
+                    else if (mCurrentRPacket.notNull())
+                    {
+                        cur_data_block->refData(mvci.getName(), 
+                                                &buffer[decode_pos], 
+                                                mvci.getSize(), 
+                                                mvci.getType());
+                    }
                     else
                     {
                         cur_data_block->addData(mvci.getName(), 
@@ -711,11 +728,30 @@ BOOL LLTemplateMessageReader::decodeData(const U8* buffer, const LLHost& sender
             decode_timer.reset();
         }
 
+        // The handler may process other messages (or clear ours), so hold
+        // on to what we need for the profile before calling it.
+        LLMessageTemplate* handled_template = mCurrentRMessageTemplate;
+        const S32 handled_size = mReceiveSize;
+        const bool profile_handler = LLMessageReader::getProfileHandlers();
+        F64 handler_start = 0.0;
+        if (profile_handler)
+        {
+            handler_start = LLTimer::getTotalSeconds().value();
+        }
+
         if( !mCurrentRMessageTemplate->callHandlerFunc(gMessageSystem) )
         {
             LL_WARNS() << "Message from " << sender << " with no handler function received: " << mCurrentRMessageTemplate->mName << LL_ENDL;
         }
 
+        if (profile_handler)
+        {
+            F64 handler_time = LLTimer::getTotalSeconds().value() - handler_start;
+            handled_template->recordHandlerTime(handler_time, handled_size);
+            add(sMessageHandlerCalls, 1);
+            record(sMessageHandlerTime, F64Seconds(handler_time));
+        }
+
         if(LLMessageReader::getTimeDecodes() || gMessageSystem->getTimingCallback())
         {
             F32 decode_time = decode_timer.getElapsedTimeF32();
@@ -791,6 +827,15 @@ BOOL LLTemplateMessageReader::validateMessage(const U8* buffer,
 BOOL LLTemplateMessageReader::readMessage(const U8* buffer, 
                                           const LLHost& sender)
 {
+    mCurrentRPacket = NULL;
+    return decodeData(buffer, sender);
+}
+
+BOOL LLTemplateMessageReader::readMessage(const U8* buffer,
+                                          const LLHost& sender,
+                                          const LLPacketBuffer::ptr_t& packet)
+{
+    mCurrentRPacket = packet;
     return decodeData(buffer, sender);
 }
 
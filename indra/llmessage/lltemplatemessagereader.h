@@ -28,6 +28,7 @@
 #define LL_LLTEMPLATEMESSAGEREADER_H
 
 #include "llmessagereader.h"
+#include "llpacketbuffer.h"
 
 #include <map>
 
@@ -101,6 +102,10 @@ public:
     BOOL validateMessage(const U8* buffer, S32 buffer_size, 
                          const LLHost& sender, bool trusted = false);
     BOOL readMessage(const U8* buffer, const LLHost& sender);
+    // As above, but buffer lies within packet: variable data refers to the
+    // packet instead of being copied out, and the packet is kept until
+    // clearMessage().
+    BOOL readMessage(const U8* buffer, const LLHost& sender, const LLPacketBuffer::ptr_t& packet);
 
     bool isTrusted() const;
     bool isBanned(bool trusted_source) const;
@@ -121,6 +126,7 @@ private:
     S32 mReceiveSize;
     LLMessageTemplate* mCurrentRMessageTemplate;
     LLMsgData* mCurrentRMessageData;
+    LLPacketBuffer::ptr_t mCurrentRPacket;  // owns the data mCurrentRMessageData refers to, if set
     message_template_number_map_t& mMessageNumbers;
 };
 
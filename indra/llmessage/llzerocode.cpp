@@ -0,0 +1,200 @@
+/** 
+ * @file llzerocode.cpp
+ * @brief Run-length coding of zero bytes in template message bodies.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llzerocode.h"
+
+#include <emmintrin.h>
+#if LL_WINDOWS
+#include <intrin.h>
+#endif
+
+namespace
+{
+    const S32 ZERO_RUN_MAX = 255;
+
+    inline U32 lowest_set_bit(U32 mask)
+    {
+#if LL_WINDOWS
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (U32)index;
+#else
+        return (U32)__builtin_ctz(mask);
+#endif
+    }
+}
+
+// static
+const U8* LLZeroCode::findZero(const U8* begin, const U8* end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    while (end - begin >= 16)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)begin);
+        U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero));
+        if (mask)
+        {
+            return begin + lowest_set_bit(mask);
+        }
+        begin += 16;
+    }
+    while (begin < end && *begin)
+    {
+        ++begin;
+    }
+    return begin;
+}
+
+// static
+const U8* LLZeroCode::skipZeroes(const U8* begin, const U8* end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    while (end - begin >= 16)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)begin);
+        U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)) ^ 0xffff;
+        if (mask)
+        {
+            return begin + lowest_set_bit(mask);
+        }
+        begin += 16;
+    }
+    while (begin < end && !*begin)
+    {
+        ++begin;
+    }
+    return begin;
+}
+
+// static
+S32 LLZeroCode::getNetGain(const U8* data, S32 size)
+{
+    const U8* end = data + size;
+    S32 net_gain = 0;
+    while (data < end)
+    {
+        const U8* run_begin = findZero(data, end);
+        if (run_begin == end)
+        {
+            break;
+        }
+        data = skipZeroes(run_begin, end);
+
+        // Each run of up to 255 zeroes is sent as two bytes.
+        S32 run = (S32)(data - run_begin);
+        net_gain += 2 * ((run + ZERO_RUN_MAX - 1) / ZERO_RUN_MAX) - run;
+    }
+    return net_gain;
+}
+
+// static
+S32 LLZeroCode::encode(const U8* data, S32 size, U8* out)
+{
+    const U8* end = data + size;
+    U8* outptr = out;
+    while (data < end)
+    {
+        const U8* run_begin = findZero(data, end);
+        memcpy(outptr, data, run_begin - data);
+        outptr += run_begin - data;
+        if (run_begin == end)
+        {
+            break;
+        }
+        data = skipZeroes(run_begin, end);
+
+        S32 run = (S32)(data - run_begin);
+        for ( ; run >= ZERO_RUN_MAX; run -= ZERO_RUN_MAX)
+        {
+            *outptr++ = 0;
+            *outptr++ = (U8)ZERO_RUN_MAX;
+        }
+        if (run)
+        {
+            *outptr++ = 0;
+            *outptr++ = (U8)run;
+        }
+    }
+    return (S32)(outptr - out);
+}
+
+// static
+S32 LLZeroCode::expand(const U8* data, S32 size, U8* out, S32 out_size)
+{
+    // The bounds checks follow the byte-wise expansion this replaced, so
+    // the same packets are accepted and rejected.
+    const U8* end = data + size;
+    U8* outptr = out;
+    while (data < end)
+    {
+        const U8* run_begin = findZero(data, end);
+        S32 literal = (S32)(run_begin - data);
+        if (literal > out_size - (S32)(outptr - out))
+        {
+            return -1;
+        }
+        memcpy(outptr, data, literal);
+        outptr += literal;
+        if (run_begin == end)
+        {
+            break;
+        }
+        if (outptr - out > out_size - 1)
+        {
+            return -1;
+        }
+        *outptr++ = 0;
+
+        // Further zeroes before the count each stand for 256 more.
+        data = skipZeroes(run_begin + 1, end);
+        S32 wraps = (S32)(data - run_begin) - 1;
+        if (wraps)
+        {
+            if ((outptr - out) + 256 * wraps + 1 > out_size)
+            {
+                return -1;
+            }
+            memset(outptr, 0, 256 * wraps);
+            outptr += 256 * wraps;
+        }
+        if (data == end)
+        {
+            break;
+        }
+
+        S32 run = *data++;
+        if (outptr - out > out_size - run)
+        {
+            return -1;
+        }
+        memset(outptr, 0, run - 1);
+        outptr += run - 1;
+    }
+    return (S32)(outptr - out);
+}
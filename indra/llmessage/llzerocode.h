@@ -0,0 +1,63 @@
+/** 
+ * @file llzerocode.h
+ * @brief Run-length coding of zero bytes in template message bodies.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLZEROCODE_H
+#define LL_LLZEROCODE_H
+
+#include "stdtypes.h"
+
+// Zero coding as used by the template message system. A run of zero
+// bytes is sent as a zero followed by the run length; runs longer than
+// 255 are sent as several runs, and a zero directly following the leading
+// zero adds 256 to the run. Only the message body is coded, so callers
+// pass the data after the packet id field.
+//
+// Messages are scanned sixteen bytes at a time for the zero bytes that
+// start a run, so literal data is copied in blocks instead of byte by byte.
+class LLZeroCode
+{
+public:
+    // Returns how many bytes encode() would add (positive) or save
+    // (negative) for the given data.
+    static S32 getNetGain(const U8* data, S32 size);
+
+    // Encodes size bytes of data into out, which must have room for
+    // size + size / 2 + 1 bytes, and returns the encoded size.
+    static S32 encode(const U8* data, S32 size, U8* out);
+
+    // Expands size bytes of zero coded data into out. Returns the expanded
+    // size, or -1 if the data would not fit in out_size bytes.
+    static S32 expand(const U8* data, S32 size, U8* out, S32 out_size);
+
+    // Returns the first zero byte in [begin, end), or end if there is none.
+    static const U8* findZero(const U8* begin, const U8* end);
+
+    // Returns the first nonzero byte in [begin, end), or end if there is none.
+    static const U8* skipZeroes(const U8* begin, const U8* end);
+};
+
+#endif // LL_LLZEROCODE_H
@@ -70,6 +70,7 @@
 #include "lltransfermanager.h"
 #include "lluuid.h"
 #include "llxfermanager.h"
+#include "llzerocode.h"
 #include "llquaternion.h"
 #include "u64.h"
 #include "v3dmath.h"
@@ -359,6 +360,8 @@ void LLMessageSystem::clearReceiveState()
     mLastReceivingIF.invalidate();
     mMessageReader->clearMessage();
     mLastMessageFromTrustedMessageService = false;
+    mTrueReceivePacket = NULL;
+    mExpandedReceivePacket = NULL;
 }
 
 
@@ -511,9 +514,13 @@ BOOL LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
         S32 acks = 0;
         S32 true_rcv_size = 0;
 
-        U8* buffer = mTrueReceiveBuffer;
+        // Hold our own references: a handler which pumps messages itself
+        // replaces the members before we are done with this packet.
+        LLPacketBuffer::ptr_t packet = mPacketRing.receivePacket(mSocket);
+        mTrueReceivePacket = packet;
+        U8* buffer = packet.notNull() ? (U8*)packet->getData() : NULL;
         
-        mTrueReceiveSize = mPacketRing.receivePacket(mSocket, (char *)mTrueReceiveBuffer);
+        mTrueReceiveSize = packet.notNull() ? packet->getSize() : 0;
         // If you want to dump all received packets into SecondLife.log, uncomment this
         //dumpPacketToLog();
         
@@ -561,6 +568,7 @@ BOOL LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
 
             // process the message as normal
             mIncomingCompressedSize = zeroCodeExpand(&buffer, &receive_size);
+            LLPacketBuffer::ptr_t data_packet = mIncomingCompressedSize ? mExpandedReceivePacket : packet;
             mCurrentRecvPacketID = ntohl(*((U32*)(&buffer[1])));
             host = getSender();
 
@@ -578,7 +586,7 @@ BOOL LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
                 for(S32 i = 0; i < acks; ++i)
                 {
                     true_rcv_size -= sizeof(TPACKETID);
-                    memcpy(&mem_id, &mTrueReceiveBuffer[true_rcv_size], /* Flawfinder: ignore*/
+                    memcpy(&mem_id, packet->getData() + true_rcv_size, /* Flawfinder: ignore*/
                          sizeof(TPACKETID));
                     packet_id = ntohl(mem_id);
                     //LL_INFOS("Messaging") << "got ack: " << packet_id << LL_ENDL;
@@ -688,7 +696,7 @@ BOOL LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
                 
                 // valid_packet = mTemplateMessageReader->readMessage(buffer, host);
                 
-                try { valid_packet = mTemplateMessageReader->readMessage(buffer, host); }
+                try { valid_packet = mTemplateMessageReader->readMessage(buffer, host, data_packet); }
                 catch( nd::exceptions::xran &ex ) { LL_WARNS() << ex.what() << LL_ENDL; }
 
                 // </FS:ND>
@@ -2659,6 +2667,7 @@ void end_messaging_system(bool print_summary)
         delete static_cast<LLMessageSystem*>(gMessageSystem);
         gMessageSystem = NULL;
     }
+    LLPacketBuffer::cleanupPool();
 }
 
 void LLMessageSystem::resetReceiveCounts()
@@ -2767,54 +2776,9 @@ S32 LLMessageSystem::zeroCodeAdjustCurrentSendTotal()
     // TODO: babbage: remove this horror
     mMessageBuilder->setBuilt(FALSE);
 
-    S32 count = mSendSize;
-    
-    S32 net_gain = 0;
-    U8 num_zeroes = 0;
-    
-    U8 *inptr = (U8 *)mSendBuffer;
-
-// skip the packet id field
-
-    for (U32 ii = 0; ii < LL_PACKET_ID_SIZE; ++ii)
-    {
-        count--;
-        inptr++;
-    }
-
-// don't actually build, just test
-
-// sequential zero bytes are encoded as 0 [U8 count] 
-// with 0 0 [count] representing wrap (>256 zeroes)
-
-    while (count--)
-    {
-        if (!(*inptr))   // in a zero count
-        {
-            if (num_zeroes)
-            {
-                if (++num_zeroes > 254)
-                {
-                    num_zeroes = 0;
-                }
-                net_gain--;   // subseqent zeroes save one
-            }
-            else
-            {
-                net_gain++;  // starting a zero count adds one
-                num_zeroes = 1;
-            }
-            inptr++;
-        }
-        else
-        {
-            if (num_zeroes)
-            {
-                num_zeroes = 0;
-            }
-            inptr++;
-        }
-    }
+    // skip the packet id field; don't actually build, just test
+    S32 net_gain = LLZeroCode::getNetGain(mSendBuffer + LL_PACKET_ID_SIZE,
+                                          mSendSize - LL_PACKET_ID_SIZE);
     if (net_gain < 0)
     {
         return net_gain;
@@ -2849,72 +2813,29 @@ S32 LLMessageSystem::zeroCodeExpand(U8** data, S32* data_size)
     
     *data[0] &= (~LL_ZERO_CODE_FLAG);
 
-    S32 count = (*data_size);  
-    
-    U8 *inptr = (U8 *)*data;
-    U8 *outptr = (U8 *)mEncodedRecvBuffer;
-
-// skip the packet id field
+    // Expand into a pooled buffer of our own; the packet itself stays as
+    // received so the appended acks can still be read from it.
+    mExpandedReceivePacket = new LLPacketBuffer();
+    U8 *expanded = (U8 *)mExpandedReceivePacket->getData();
 
-    for (U32 ii = 0; ii < LL_PACKET_ID_SIZE; ++ii)
+    // skip the packet id field
+    memcpy(expanded, *data, LL_PACKET_ID_SIZE);
+    S32 expanded_size = LLZeroCode::expand(*data + LL_PACKET_ID_SIZE, in_size - LL_PACKET_ID_SIZE,
+                                           expanded + LL_PACKET_ID_SIZE, MAX_BUFFER_SIZE - LL_PACKET_ID_SIZE);
+    if (expanded_size < 0)
     {
-        count--;
-        *outptr++ = *inptr++;
+        LL_WARNS("Messaging") << "attempt to write past reasonable encoded buffer size" << LL_ENDL;
+        callExceptionFunc(MX_WROTE_PAST_BUFFER_SIZE);
+        expanded_size = 0;
     }
-
-// reconstruct encoded packet, keeping track of net size gain
-
-// sequential zero bytes are encoded as 0 [U8 count] 
-// with 0 0 [count] representing wrap (>256 zeroes)
-
-    while (count--)
+    else
     {
-        if (outptr > (&mEncodedRecvBuffer[MAX_BUFFER_SIZE-1]))
-        {
-            LL_WARNS("Messaging") << "attempt to write past reasonable encoded buffer size 1" << LL_ENDL;
-            callExceptionFunc(MX_WROTE_PAST_BUFFER_SIZE);
-            outptr = mEncodedRecvBuffer;                    
-            break;
-        }
-        if (!((*outptr++ = *inptr++)))
-        {
-            while (((count--)) && (!(*inptr)))
-            {
-                *outptr++ = *inptr++;
-                if (outptr > (&mEncodedRecvBuffer[MAX_BUFFER_SIZE-256]))
-                {
-                    LL_WARNS("Messaging") << "attempt to write past reasonable encoded buffer size 2" << LL_ENDL;
-                    callExceptionFunc(MX_WROTE_PAST_BUFFER_SIZE);
-                    outptr = mEncodedRecvBuffer;
-                    count = -1;
-                    break;
-                }
-                memset(outptr,0,255);
-                outptr += 255;
-            }
-            
-            if (count < 0)
-            {
-                break;
-            }
-
-            else
-            {
-                if (outptr > (&mEncodedRecvBuffer[MAX_BUFFER_SIZE-(*inptr)]))
-                {
-                    LL_WARNS("Messaging") << "attempt to write past reasonable encoded buffer size 3" << LL_ENDL;
-                    callExceptionFunc(MX_WROTE_PAST_BUFFER_SIZE);
-                    outptr = mEncodedRecvBuffer;                    
-                }
-                memset(outptr,0,(*inptr) - 1);
-                outptr += ((*inptr) - 1);
-                inptr++;
-            }
-        }       
+        expanded_size += LL_PACKET_ID_SIZE;
     }
-    
-    *data = mEncodedRecvBuffer;
-    *data_size = (S32)(outptr - mEncodedRecvBuffer);
+
+    *data = expanded;
+    *data_size = expanded_size;
+    mExpandedReceivePacket->setSize(*data_size);
     mUncompressedBytesIn += *data_size;
 
     return(in_size);
@@ -3348,7 +3269,7 @@ void LLMessageSystem::dumpPacketToLog()
     {
         S32 offset = cur_line_pos * 3;
         snprintf(line_buffer + offset, sizeof(line_buffer) - offset,
-                 "%02x ", mTrueReceiveBuffer[i]);   /* Flawfinder: ignore */
+                 "%02x ", (U8)mTrueReceivePacket->getData()[i]);   /* Flawfinder: ignore */
         cur_line_pos++;
         if (cur_line_pos >= 16)
         {
@@ -3987,6 +3908,69 @@ void LLMessageSystem::setTimeDecodesSpamThreshold( F32 seconds )
     LLMessageReader::setTimeDecodesSpamThreshold(seconds);
 }
 
+//static
+void LLMessageSystem::setProfileHandlers(bool b)
+{
+    LLMessageReader::setProfileHandlers(b);
+}
+
+//static
+bool LLMessageSystem::getProfileHandlers()
+{
+    return LLMessageReader::getProfileHandlers();
+}
+
+void LLMessageSystem::resetHandlerProfile()
+{
+    for (message_template_name_map_t::iterator iter = mMessageTemplates.begin(),
+             end = mMessageTemplates.end();
+         iter != end; ++iter)
+    {
+        iter->second->resetHandlerProfile();
+    }
+}
+
+void LLMessageSystem::getHandlerProfile(handler_profile_vec_t& profile) const
+{
+    profile.clear();
+    for (message_template_name_map_t::const_iterator iter = mMessageTemplates.begin(),
+             end = mMessageTemplates.end();
+         iter != end; ++iter)
+    {
+        const LLMessageTemplate* mt = iter->second;
+        if (mt->mHandlerCount > 0)
+        {
+            HandlerProfile entry;
+            entry.mName = mt->mName;
+            entry.mCount = mt->mHandlerCount;
+            entry.mTotalTime = mt->mHandlerTime;
+            entry.mMaxTime = mt->mHandlerMaxTime;
+            entry.mBytes = mt->mHandlerBytes;
+            profile.push_back(entry);
+        }
+    }
+}
+
+void LLMessageSystem::dumpHandlerProfileCSV(std::ostream& str) const
+{
+    handler_profile_vec_t profile;
+    getHandlerProfile(profile);
+
+    str << "message,count,total_ms,max_ms,avg_ms,bytes" << std::endl;
+    for (handler_profile_vec_t::const_iterator iter = profile.begin(); iter != profile.end(); ++iter)
+    {
+        F64 avg_ms = iter->mTotalTime * 1000.0 / (F64)iter->mCount;
+        str << llformat("%s,%u,%.3f,%.3f,%.4f,%llu",
+                        iter->mName.c_str(),
+                        iter->mCount,
+                        iter->mTotalTime * 1000.0,
+                        iter->mMaxTime * 1000.0,
+                        avg_ms,
+                        (unsigned long long)iter->mBytes)
+            << std::endl;
+    }
+}
+
 LockMessageChecker::LockMessageChecker(LLMessageSystem* msgsystem):
     // for the lifespan of this LockMessageChecker instance, use
     // LLTemplateMessageReader as msgsystem's mMessageReader
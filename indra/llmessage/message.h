@@ -768,6 +768,25 @@ public:
     static void setTimeDecodes(BOOL b);
     static void setTimeDecodesSpamThreshold(F32 seconds); 
 
+    // Per-message handler profiling. Accumulates call count, handler time
+    // and bytes for each template while enabled.
+    struct HandlerProfile
+    {
+        std::string mName;
+        U32         mCount;
+        F64         mTotalTime;     // seconds
+        F64         mMaxTime;       // seconds
+        U64         mBytes;
+    };
+    typedef std::vector<HandlerProfile> handler_profile_vec_t;
+
+    static void setProfileHandlers(bool b);
+    static bool getProfileHandlers();
+    void resetHandlerProfile();
+    // Fills profile with every template that has handled at least one message
+    void getHandlerProfile(handler_profile_vec_t& profile) const;
+    void dumpHandlerProfileCSV(std::ostream& str) const;
+
     // message handlers internal to the message systesm
     //static void processAssignCircuitCode(LLMessageSystem* msg, void**);
     static void processAddCircuitCode(LLMessageSystem* msg, void**);
@@ -859,8 +878,8 @@ private:
 
     LLMessagePollInfo                       *mPollInfop;
 
-    U8  mEncodedRecvBuffer[MAX_BUFFER_SIZE];
-    U8  mTrueReceiveBuffer[MAX_BUFFER_SIZE];
+    LLPacketBuffer::ptr_t mTrueReceivePacket;      // packet as received, acks and all
+    LLPacketBuffer::ptr_t mExpandedReceivePacket;  // zero-code expansion of it, if it was zero coded
     S32 mTrueReceiveSize;
 
     // Must be valid during decode
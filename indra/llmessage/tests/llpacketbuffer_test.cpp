@@ -0,0 +1,321 @@
+/** 
+ * @file llpacketbuffer_test.cpp
+ * @brief LLPacketBuffer pooling tests.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llpacketbuffer.h"
+#include "../llpacketring.h"
+
+#include "lltimer.h"
+
+#include "../test/lltut.h"
+#include "../test/benchmark.h"
+
+namespace
+{
+    void send_to(S32 socket, int port, const char* data, S32 size)
+    {
+        send_packet(socket, data, size, ip_string_to_u32(LOOPBACK_ADDRESS_STRING), port);
+    }
+
+    // Loopback datagrams are normally there at once; allow a moment anyway.
+    LLPacketBuffer::ptr_t receive(LLPacketRing& ring, S32 socket)
+    {
+        for (S32 i = 0; i < 1000; ++i)
+        {
+            LLPacketBuffer::ptr_t packet = ring.receivePacket(socket);
+            if (packet.notNull())
+            {
+                return packet;
+            }
+            ms_sleep(1);
+        }
+        return NULL;
+    }
+
+    std::vector<char> relayed(const char* sender, U16 port, const std::vector<char>& payload)
+    {
+        proxywrap_t header;
+        header.rsv = 0;
+        header.frag = 0;
+        header.atype = ADDRESS_IPV4;
+        header.addr = ip_string_to_u32(sender);
+        header.port = htons(port);
+        std::vector<char> datagram((char*)&header, (char*)&header + SOCKS_HEADER_SIZE);
+        datagram.insert(datagram.end(), payload.begin(), payload.end());
+        return datagram;
+    }
+}
+
+namespace tut
+{
+    struct packetbuffer_data
+    {
+        packetbuffer_data()
+        {
+            LLPacketBuffer::cleanupPool();
+            mPort = NET_USE_OS_ASSIGNED_PORT;
+            mSocket = -1;
+        }
+        ~packetbuffer_data()
+        {
+            if (mSocket != -1)
+            {
+                end_net(mSocket);
+            }
+        }
+
+        void openSocket()
+        {
+            tut::ensure_equals("socket opened", start_net(mSocket, mPort), 0);
+        }
+
+        S32 mSocket;
+        int mPort;
+    };
+    typedef test_group<packetbuffer_data> packetbuffer_test;
+    typedef packetbuffer_test::object packetbuffer_object;
+    tut::packetbuffer_test packetbuffer_testcase("LLPacketBuffer");
+
+    template<> template<>
+    void packetbuffer_object::test<1>()
+    {
+        set_test_name("released buffers are reused");
+        LLPacketBuffer* first = NULL;
+        {
+            LLPacketBuffer::ptr_t packet = new LLPacketBuffer();
+            first = packet.get();
+            ensure_equals("nothing pooled while in use", LLPacketBuffer::getPooledCount(), 0U);
+        }
+        ensure_equals("released buffer pooled", LLPacketBuffer::getPooledCount(), 1U);
+
+        LLPacketBuffer::ptr_t again = new LLPacketBuffer();
+        ensure("pooled buffer handed out again", again.get() == first);
+        ensure_equals("pool drained", LLPacketBuffer::getPooledCount(), 0U);
+        ensure_equals("reused buffer starts empty", again->getSize(), 0);
+    }
+
+    template<> template<>
+    void packetbuffer_object::test<2>()
+    {
+        set_test_name("packet lives as long as any reference");
+        const char payload[] = "\x40\x00\x00\x00\x01\x00\xff\xff";
+        LLPacketBuffer::ptr_t queued = new LLPacketBuffer(LLHost("127.0.0.1", 13000), payload, sizeof(payload));
+        LLPacketBuffer::ptr_t reader = queued;
+        queued = NULL;
+        ensure_equals("still referenced", LLPacketBuffer::getPooledCount(), 0U);
+        ensure_equals("size kept", reader->getSize(), (S32)sizeof(payload));
+        ensure("data kept", !memcmp(reader->getData(), payload, sizeof(payload)));
+        ensure_equals("host kept", reader->getHost(), LLHost("127.0.0.1", 13000));
+        reader = NULL;
+        ensure_equals("returned to pool", LLPacketBuffer::getPooledCount(), 1U);
+    }
+
+    template<> template<>
+    void packetbuffer_object::test<3>()
+    {
+        set_test_name("pool is capped");
+        std::vector<LLPacketBuffer::ptr_t> packets;
+        for (S32 i = 0; i < LLPacketBuffer::MAX_POOLED_BUFFERS + 10; ++i)
+        {
+            packets.push_back(new LLPacketBuffer());
+        }
+        packets.clear();
+        ensure_equals("pool capped", LLPacketBuffer::getPooledCount(), (U32)LLPacketBuffer::MAX_POOLED_BUFFERS);
+        LLPacketBuffer::cleanupPool();
+        ensure_equals("pool emptied", LLPacketBuffer::getPooledCount(), 0U);
+    }
+
+    template<> template<>
+    void packetbuffer_object::test<4>()
+    {
+        set_test_name("filled in place");
+        LLPacketBuffer::ptr_t packet = new LLPacketBuffer();
+        ensure("room for a whole datagram", LLPacketBuffer::getCapacity() >= NET_BUFFER_SIZE);
+        memset(packet->getData(), 0x5a, 100);
+        packet->setSize(100);
+        ensure_equals("size set", packet->getSize(), 100);
+        ensure_equals("data written in place", (U8)packet->getData()[99], (U8)0x5a);
+    }
+
+    template<> template<>
+    void packetbuffer_object::test<5>()
+    {
+        set_test_name("ring hands out the received buffer");
+        openSocket();
+        LLPacketRing ring;
+        ensure("nothing to receive", ring.receivePacket(mSocket).isNull());
+        ensure_equals("empty receive pooled", LLPacketBuffer::getPooledCount(), 1U);
+
+        std::vector<char> payload(1200, 0x21);
+        payload.back() = 0x7e;
+        send_to(mSocket, mPort, payload.data(), (S32)payload.size());
+        LLPacketBuffer::ptr_t packet = receive(ring, mSocket);
+        ensure("received", packet.notNull());
+        ensure_equals("size", packet->getSize(), (S32)payload.size());
+        ensure("data", !memcmp(packet->getData(), payload.data(), payload.size()));
+        ensure_equals("sender port", packet->getHost().getPort(), (U32)mPort);
+        ensure_equals("last sender", ring.getLastSender(), packet->getHost());
+
+        LLPacketBuffer* received = packet.get();
+        packet = NULL;
+        send_to(mSocket, mPort, payload.data(), 10);
+        packet = receive(ring, mSocket);
+        ensure("received again", packet.notNull());
+        ensure("same buffer reused", packet.get() == received);
+        ensure_equals("second size", packet->getSize(), 10);
+    }
+
+    template<> template<>
+    void packetbuffer_object::test<6>()
+    {
+        set_test_name("dropped packets go back to the pool");
+        openSocket();
+        LLPacketRing ring;
+        const char first[] = "first packet";
+        const char second[] = "second packet";
+        ring.dropPackets(1);
+        send_to(mSocket, mPort, first, sizeof(first));
+        ms_sleep(10);
+        ensure("first was dropped", ring.receivePacket(mSocket).isNull());
+        ensure_equals("dropped buffer pooled", LLPacketBuffer::getPooledCount(), 1U);
+
+        send_to(mSocket, mPort, second, sizeof(second));
+        LLPacketBuffer::ptr_t packet = receive(ring, mSocket);
+        ensure("received", packet.notNull());
+        ensure_equals("second kept", std::string(packet->getData()), std::string(second));
+    }
+
+    template<> template<>
+    void packetbuffer_object::test<7>()
+    {
+        set_test_name("throttled packets wait in the ring");
+        openSocket();
+        LLPacketRing ring;
+        ring.setUseInThrottle(TRUE);
+        ring.setInBandwidth(8.f);
+        for (char i = 1; i <= 3; ++i)
+        {
+            std::vector<char> payload(100 * i, i);
+            send_to(mSocket, mPort, payload.data(), (S32)payload.size());
+        }
+        ms_sleep(10);
+
+        // the first packet uses up the bandwidth, the rest wait on the queue
+        LLPacketBuffer::ptr_t packet = ring.receivePacket(mSocket);
+        ensure("first packet", packet.notNull());
+        ensure_equals("first size", packet->getSize(), 100);
+        ensure("held back", ring.receivePacket(mSocket).isNull());
+        ensure_equals("queued buffers still live", LLPacketBuffer::getPooledCount(), 1U);
+        packet = NULL;
+
+        ring.setInBandwidth(1.0e9f);
+        ms_sleep(10);
+        for (char i = 2; i <= 3; ++i)
+        {
+            packet = ring.receivePacket(mSocket);
+            ensure("released from the queue", packet.notNull());
+            ensure_equals("queue order", packet->getSize(), 100 * i);
+            ensure_equals("data", packet->getData()[100 * i - 1], i);
+            ensure_equals("sender", ring.getLastSender(), packet->getHost());
+        }
+        packet = NULL;
+        ensure("queue empty", ring.receivePacket(mSocket).isNull());
+        ensure_equals("all buffers pooled", LLPacketBuffer::getPooledCount(), 4U);
+    }
+
+    template<> template<>
+    void packetbuffer_object::test<8>()
+    {
+        set_test_name("SOCKS relay header skipped in place");
+        openSocket();
+
+        std::vector<char> payload(300, 0x42);
+        std::vector<char> datagram = relayed("10.1.2.3", 13005, payload);
+        send_to(mSocket, mPort, datagram.data(), (S32)datagram.size());
+        ms_sleep(10);
+        LLPacketBuffer::ptr_t packet = new LLPacketBuffer();
+        packet->initFromProxy(mSocket);
+        ensure_equals("unwrapped size", packet->getSize(), (S32)payload.size());
+        ensure_equals("relayed sender", packet->getHost(), LLHost("10.1.2.3", 13005));
+        ensure("data", !memcmp(packet->getData(), payload.data(), payload.size()));
+
+        // the largest datagram the socket reads, header and all
+        payload.assign(NET_BUFFER_SIZE - SOCKS_HEADER_SIZE, 0x43);
+        payload.back() = 0x44;
+        datagram = relayed("10.1.2.4", 13006, payload);
+        send_to(mSocket, mPort, datagram.data(), (S32)datagram.size());
+        ms_sleep(10);
+        packet->initFromProxy(mSocket);
+        ensure_equals("full size", packet->getSize(), (S32)payload.size());
+        ensure_equals("full sender", packet->getHost(), LLHost("10.1.2.4", 13006));
+        ensure_equals("last byte", packet->getData()[payload.size() - 1], (char)0x44);
+
+        // a bare header carries no packet
+        datagram = relayed("10.1.2.3", 13005, std::vector<char>());
+        send_to(mSocket, mPort, datagram.data(), (S32)datagram.size());
+        ms_sleep(10);
+        packet->initFromProxy(mSocket);
+        ensure_equals("nothing relayed", packet->getSize(), 0);
+    }
+
+    template<> template<>
+    void packetbuffer_object::test<9>()
+    {
+        set_test_name("benchmark receiving through the packet ring");
+        skip_unless_benchmarking();
+        openSocket();
+
+        const S32 BATCH = 32;
+        const S32 ROUNDS = 2000;
+        std::vector<char> payload(600, 0x11);
+        for (S32 throttled = 0; throttled < 2; ++throttled)
+        {
+            LLPacketRing ring;
+            ring.setUseInThrottle(throttled);
+            ring.setInBandwidth(1.0e12f);
+            S64 received = 0;
+            F64 receive_seconds = 0.0;
+            for (S32 round = 0; round < ROUNDS; ++round)
+            {
+                for (S32 i = 0; i < BATCH; ++i)
+                {
+                    send_to(mSocket, mPort, payload.data(), (S32)payload.size());
+                }
+                LLTimer timer;
+                while (ring.receivePacket(mSocket).notNull())
+                {
+                    ++received;
+                }
+                receive_seconds += timer.getElapsedTimeF64();
+            }
+            LL_INFOS("Benchmark") << (throttled ? "Through the delay queue: " : "Direct: ") << received << " packets, "
+                                  << receive_seconds * 1.0e9 / llmax(received, (S64)1) << " ns each, "
+                                  << LLPacketBuffer::getPooledCount() << " buffers pooled" << LL_ENDL;
+        }
+    }
+}
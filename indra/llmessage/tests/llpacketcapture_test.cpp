@@ -0,0 +1,161 @@
+/** 
+ * @file llpacketcapture_test.cpp
+ * @brief LLPacketCapture record and playback tests.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llpacketcapture.h"
+
+#include "../test/lltut.h"
+
+namespace tut
+{
+    struct packetcapture_data
+    {
+        packetcapture_data()
+        {
+            mFilename = std::string(LLFile::tmpdir()) + "llpacketcapture_test.cap";
+        }
+        ~packetcapture_data()
+        {
+            LLFile::remove(mFilename, ENOENT);
+        }
+
+        LLPacketBuffer::ptr_t makePacket(const LLHost& host, U8 fill, S32 size)
+        {
+            std::vector<char> data(size, (char)fill);
+            return new LLPacketBuffer(host, data.data(), size);
+        }
+
+        std::string mFilename;
+    };
+    typedef test_group<packetcapture_data> packetcapture_test;
+    typedef packetcapture_test::object packetcapture_object;
+    tut::packetcapture_test packetcapture_testcase("LLPacketCapture");
+
+    template<> template<>
+    void packetcapture_object::test<1>()
+    {
+        set_test_name("recorded packets play back in order");
+        const LLHost sim("10.1.2.3", 13005);
+        const LLHost neighbour("10.1.2.4", 13006);
+        {
+            LLPacketCapture capture;
+            ensure("recording started", capture.startRecording(mFilename));
+            capture.recordPacket(*makePacket(sim, 0x11, 20));
+            capture.recordPacket(*makePacket(neighbour, 0x22, NET_BUFFER_SIZE));
+            capture.recordPacket(*makePacket(sim, 0x33, 1));
+            ensure_equals("packets recorded", capture.getPacketCount(), 3U);
+        }
+
+        LLPacketCapture capture;
+        ensure("playback started", capture.startPlayback(mFilename, 0.f));
+        ensure("not done before the first packet", !capture.isPlaybackDone());
+
+        LLPacketBuffer::ptr_t packet = capture.nextPacket();
+        ensure("first packet", packet.notNull());
+        ensure_equals("first host", packet->getHost(), sim);
+        ensure_equals("first size", packet->getSize(), 20);
+        ensure_equals("first data", (U8)packet->getData()[19], (U8)0x11);
+
+        packet = capture.nextPacket();
+        ensure("second packet", packet.notNull());
+        ensure_equals("second host", packet->getHost(), neighbour);
+        ensure_equals("full sized packet", packet->getSize(), (S32)NET_BUFFER_SIZE);
+        ensure_equals("second data", (U8)packet->getData()[NET_BUFFER_SIZE - 1], (U8)0x22);
+
+        packet = capture.nextPacket();
+        ensure("third packet", packet.notNull());
+        ensure_equals("third size", packet->getSize(), 1);
+        ensure("done", capture.isPlaybackDone());
+        ensure("nothing after the last packet", capture.nextPacket().isNull());
+        ensure_equals("packets played", capture.getPacketCount(), 3U);
+    }
+
+    template<> template<>
+    void packetcapture_object::test<2>()
+    {
+        set_test_name("playback at recorded speed waits for packets");
+        {
+            LLPacketCapture capture;
+            ensure("recording started", capture.startRecording(mFilename));
+            capture.recordPacket(*makePacket(LLHost("10.1.2.3", 13005), 0x11, 20));
+            ms_sleep(300);
+            capture.recordPacket(*makePacket(LLHost("10.1.2.3", 13005), 0x22, 20));
+        }
+
+        LLPacketCapture capture;
+        ensure("playback started", capture.startPlayback(mFilename, 1.f));
+        ensure("first packet is due at once", capture.nextPacket().notNull());
+        ensure("second packet is not due yet", capture.nextPacket().isNull());
+        ms_sleep(400);
+        ensure("second packet is due", capture.nextPacket().notNull());
+        ensure("done", capture.isPlaybackDone());
+    }
+
+    template<> template<>
+    void packetcapture_object::test<3>()
+    {
+        set_test_name("other files are rejected");
+        LLFILE* fp = LLFile::fopen(mFilename, "wb");
+        ensure("test file created", fp != NULL);
+        fputs("not a capture", fp);
+        LLFile::close(fp);
+
+        LLPacketCapture capture;
+        ensure("bad magic rejected", !capture.startPlayback(mFilename, 0.f));
+        ensure("not playing", !capture.isPlaying());
+        ensure("no packets", capture.nextPacket().isNull());
+    }
+
+    template<> template<>
+    void packetcapture_object::test<4>()
+    {
+        set_test_name("truncated capture ends playback");
+        {
+            LLPacketCapture capture;
+            ensure("recording started", capture.startRecording(mFilename));
+            capture.recordPacket(*makePacket(LLHost("10.1.2.3", 13005), 0x11, 20));
+            capture.recordPacket(*makePacket(LLHost("10.1.2.3", 13005), 0x22, 200));
+        }
+        llstat st;
+        ensure("capture written", LLFile::stat(mFilename, &st) == 0);
+        // Cut the last packet short.
+        std::vector<char> bytes(st.st_size);
+        LLFILE* fp = LLFile::fopen(mFilename, "rb");
+        ensure("capture read", fread(bytes.data(), 1, bytes.size(), fp) == bytes.size());
+        LLFile::close(fp);
+        fp = LLFile::fopen(mFilename, "wb");
+        fwrite(bytes.data(), 1, bytes.size() - 50, fp);
+        LLFile::close(fp);
+
+        LLPacketCapture capture;
+        ensure("playback started", capture.startPlayback(mFilename, 0.f));
+        ensure("whole packet played", capture.nextPacket().notNull());
+        ensure("done at the cut", capture.isPlaybackDone());
+        ensure("cut packet dropped", capture.nextPacket().isNull());
+    }
+}
@@ -0,0 +1,293 @@
+/** 
+ * @file llzerocode_test.cpp
+ * @brief LLZeroCode unit tests
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llzerocode.h"
+
+#include "lltimer.h"
+
+#include "../test/lltut.h"
+#include "../test/benchmark.h"
+
+#include <vector>
+
+namespace
+{
+    // The byte at a time coder the message system used before LLZeroCode.
+    S32 reference_encode(const U8* inptr, S32 count, U8* outptr, S32& net_gain)
+    {
+        U8* out = outptr;
+        U8 num_zeroes = 0;
+        net_gain = 0;
+        while (count--)
+        {
+            if (!(*inptr))
+            {
+                if (num_zeroes)
+                {
+                    if (++num_zeroes > 254)
+                    {
+                        *outptr++ = num_zeroes;
+                        num_zeroes = 0;
+                    }
+                    net_gain--;
+                }
+                else
+                {
+                    *outptr++ = 0;
+                    net_gain++;
+                    num_zeroes = 1;
+                }
+                inptr++;
+            }
+            else
+            {
+                if (num_zeroes)
+                {
+                    *outptr++ = num_zeroes;
+                    num_zeroes = 0;
+                }
+                *outptr++ = *inptr++;
+            }
+        }
+        if (num_zeroes)
+        {
+            *outptr++ = num_zeroes;
+        }
+        return (S32)(outptr - out);
+    }
+
+    // ... and its expansion, returning -1 where it reported an overrun.
+    S32 reference_expand(const U8* inptr, S32 count, U8* expanded, S32 max_size)
+    {
+        U8* outptr = expanded;
+        while (count--)
+        {
+            if (outptr > (&expanded[max_size - 1]))
+            {
+                return -1;
+            }
+            if (!((*outptr++ = *inptr++)))
+            {
+                while (((count--)) && (!(*inptr)))
+                {
+                    *outptr++ = *inptr++;
+                    if (outptr > (&expanded[max_size - 256]))
+                    {
+                        return -1;
+                    }
+                    memset(outptr, 0, 255);
+                    outptr += 255;
+                }
+                if (count < 0)
+                {
+                    break;
+                }
+                if (outptr > (&expanded[max_size - (*inptr)]))
+                {
+                    return -1;
+                }
+                memset(outptr, 0, (*inptr) - 1);
+                outptr += ((*inptr) - 1);
+                inptr++;
+            }
+        }
+        return (S32)(outptr - expanded);
+    }
+
+    // Message-like data: literal stretches broken by zero runs of every
+    // length, including ones across the 255 wrap.
+    void fill_random(std::vector<U8>& data, S32 size)
+    {
+        data.clear();
+        while ((S32)data.size() < size)
+        {
+            S32 literal = rand() % 40;
+            for (S32 i = 0; i < literal; ++i)
+            {
+                data.push_back((U8)(rand() % 255 + 1));
+            }
+            S32 zeroes = (rand() % 8) ? rand() % 20 : rand() % 800;
+            data.insert(data.end(), zeroes, 0);
+        }
+        data.resize(size);
+    }
+}
+
+namespace tut
+{
+    struct zerocode_data
+    {
+        zerocode_data()
+        {
+            srand(1234);
+        }
+    };
+    typedef test_group<zerocode_data> zerocode_test;
+    typedef zerocode_test::object zerocode_object;
+    tut::zerocode_test zerocode_testcase("LLZeroCode");
+
+    template<> template<>
+    void zerocode_object::test<1>()
+    {
+        set_test_name("zero runs");
+        const U8 data[] = { 7, 0, 0, 0, 9, 0 };
+        U8 encoded[16];
+        S32 size = LLZeroCode::encode(data, sizeof(data), encoded);
+        const U8 expected[] = { 7, 0, 3, 9, 0, 1 };
+        ensure_equals("encoded size", size, (S32)sizeof(expected));
+        ensure_memory_matches("encoded", encoded, size, expected, sizeof(expected));
+        ensure_equals("net gain", LLZeroCode::getNetGain(data, sizeof(data)), 0);
+
+        U8 expanded[16];
+        ensure_equals("expanded size", LLZeroCode::expand(encoded, size, expanded, sizeof(expanded)), (S32)sizeof(data));
+        ensure_memory_matches("expanded", expanded, sizeof(data), data, sizeof(data));
+
+        // a second zero before the count adds 256
+        const U8 wrapped[] = { 1, 0, 0, 4, 2 };
+        std::vector<U8> out(1024);
+        ensure_equals("wrapped run", LLZeroCode::expand(wrapped, sizeof(wrapped), &out[0], (S32)out.size()), 262);
+        ensure_equals("last byte", out[261], (U8)2);
+    }
+
+    template<> template<>
+    void zerocode_object::test<2>()
+    {
+        set_test_name("random data codes as before");
+        std::vector<U8> data;
+        std::vector<U8> encoded(3 * 8192);
+        std::vector<U8> expected(3 * 8192);
+        for (S32 round = 0; round < 2000; ++round)
+        {
+            fill_random(data, rand() % 4000 + 1);
+            S32 size = (S32)data.size();
+
+            S32 expected_gain = 0;
+            S32 expected_size = reference_encode(&data[0], size, &expected[0], expected_gain);
+            S32 encoded_size = LLZeroCode::encode(&data[0], size, &encoded[0]);
+            ensure_equals("encoded size", encoded_size, expected_size);
+            ensure_memory_matches("encoded", &encoded[0], encoded_size, &expected[0], expected_size);
+            ensure_equals("net gain", LLZeroCode::getNetGain(&data[0], size), expected_gain);
+            ensure_equals("gain is size change", expected_gain, encoded_size - size);
+        }
+    }
+
+    template<> template<>
+    void zerocode_object::test<3>()
+    {
+        set_test_name("random input expands as before");
+        std::vector<U8> data;
+        std::vector<U8> expanded(8192);
+        std::vector<U8> expected(8192);
+        for (S32 round = 0; round < 4000; ++round)
+        {
+            // arbitrary received bytes, with sizes that overrun the buffer
+            fill_random(data, rand() % 600 + 1);
+            if (rand() % 2)
+            {
+                for (S32 i = 0; i < 4; ++i)
+                {
+                    data[rand() % data.size()] = 0;
+                }
+            }
+            S32 max_size = (rand() % 2) ? 8192 : rand() % 2000 + 1;
+
+            S32 expected_size = reference_expand(&data[0], (S32)data.size(), &expected[0], max_size);
+            S32 expanded_size = LLZeroCode::expand(&data[0], (S32)data.size(), &expanded[0], max_size);
+            ensure_equals("expanded size", expanded_size, expected_size);
+            if (expected_size > 0)
+            {
+                ensure_memory_matches("expanded", &expanded[0], expanded_size, &expected[0], expected_size);
+            }
+        }
+    }
+
+    template<> template<>
+    void zerocode_object::test<4>()
+    {
+        set_test_name("round trip");
+        std::vector<U8> data;
+        std::vector<U8> encoded(3 * 8192);
+        std::vector<U8> expanded(8192);
+        for (S32 round = 0; round < 1000; ++round)
+        {
+            fill_random(data, rand() % 4000 + 1);
+            S32 encoded_size = LLZeroCode::encode(&data[0], (S32)data.size(), &encoded[0]);
+            S32 expanded_size = LLZeroCode::expand(&encoded[0], encoded_size, &expanded[0], (S32)expanded.size());
+            ensure_equals("size", expanded_size, (S32)data.size());
+            ensure_memory_matches("data", &expanded[0], expanded_size, &data[0], (S32)data.size());
+        }
+    }
+
+    template<> template<>
+    void zerocode_object::test<5>()
+    {
+        set_test_name("benchmark zero code encode and expand");
+        skip_unless_benchmarking();
+        const S32 PACKETS = 256;
+        const S32 ROUNDS = 200;
+        std::vector<std::vector<U8> > packets(PACKETS);
+        std::vector<std::vector<U8> > encoded(PACKETS);
+        S64 total_bytes = 0;
+        for (S32 i = 0; i < PACKETS; ++i)
+        {
+            fill_random(packets[i], 1200);
+            encoded[i].resize(2 * 1200);
+            encoded[i].resize(LLZeroCode::encode(&packets[i][0], 1200, &encoded[i][0]));
+            total_bytes += 1200;
+        }
+        std::vector<U8> scratch(8192);
+        S32 gain = 0;
+
+        LLTimer timer;
+        for (S32 round = 0; round < ROUNDS; ++round)
+        {
+            for (S32 i = 0; i < PACKETS; ++i)
+            {
+                reference_encode(&packets[i][0], 1200, &scratch[0], gain);
+                reference_expand(&encoded[i][0], (S32)encoded[i].size(), &scratch[0], (S32)scratch.size());
+            }
+        }
+        F64 reference_seconds = timer.getElapsedTimeF64();
+
+        timer.reset();
+        for (S32 round = 0; round < ROUNDS; ++round)
+        {
+            for (S32 i = 0; i < PACKETS; ++i)
+            {
+                LLZeroCode::encode(&packets[i][0], 1200, &scratch[0]);
+                LLZeroCode::expand(&encoded[i][0], (S32)encoded[i].size(), &scratch[0], (S32)scratch.size());
+            }
+        }
+        F64 seconds = timer.getElapsedTimeF64();
+
+        F64 megabytes = (F64)(total_bytes * ROUNDS) / (1024.0 * 1024.0);
+        LL_INFOS("Benchmark") << "zero code encode+expand: " << megabytes / llmax(seconds, 1e-6) << " MB/s, byte at a time "
+                   << megabytes / llmax(reference_seconds, 1e-6) << " MB/s" << LL_ENDL;
+    }
+}
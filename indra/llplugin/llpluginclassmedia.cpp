@@ -105,6 +105,9 @@ void LLPluginClassMedia::reset()
     mRequestedTextureCoordsOpenGL = false;
     mTextureSharedMemorySize = 0;
     mTextureSharedMemoryName.clear();
+    mFrameRing.detach();
+    mFrameRingActive = false;
+    mFrameSeq = 0;
     mDefaultMediaWidth = 0;
     mDefaultMediaHeight = 0;
     mNaturalMediaWidth = 0;
@@ -209,10 +212,15 @@ void LLPluginClassMedia::idle(void)
 
 
         // Size change has been requested but not initiated yet.
-        size_t newsize = mRequestedTextureWidth * mRequestedTextureHeight * mRequestedTextureDepth;
+        // The segment holds two frame buffers plus the frame ring's control block. Buffer 0 sits at the start,
+        // so plugins which don't use the ring keep working unchanged.
+        size_t framesize = LLPluginFrameRing::getFrameSize(mRequestedTextureWidth, mRequestedTextureHeight, mRequestedTextureDepth);
+        size_t newsize = LLPluginFrameRing::getSegmentSize(framesize);
 
-        // Add an extra line for padding, just in case.
-        newsize += mRequestedTextureWidth * mRequestedTextureDepth;
+        // The plugin stops publishing into the old geometry once it has seen the size_change.
+        mFrameRing.detach();
+        mFrameRingActive = false;
+        mFrameSeq = 0;
 
         if(newsize != mTextureSharedMemorySize)
         {
@@ -245,6 +253,15 @@ void LLPluginClassMedia::idle(void)
             }
         }
 
+        if(!mTextureSharedMemoryName.empty())
+        {
+            void *addr = mPlugin->getSharedMemoryAddress(mTextureSharedMemoryName);
+            if (addr)
+            {
+                mFrameRing.attach(addr, framesize, mRequestedMediaWidth, mRequestedMediaHeight, mRequestedTextureDepth, true);
+            }
+        }
+
         // This is our local indicator that a change is in progress.
         mTextureWidth = -1;
         mTextureHeight = -1;
@@ -262,6 +279,7 @@ void LLPluginClassMedia::idle(void)
             message.setValueS32("height", mRequestedMediaHeight);
             message.setValueS32("texture_width", mRequestedTextureWidth);
             message.setValueS32("texture_height", mRequestedTextureHeight);
+            message.setValueBoolean("frame_ring", mFrameRing.isAttached());
             message.setValueReal("background_r", mBackgroundColor.mV[VX]);
             message.setValueReal("background_g", mBackgroundColor.mV[VY]);
             message.setValueReal("background_b", mBackgroundColor.mV[VZ]);
@@ -427,6 +445,27 @@ void LLPluginClassMedia::resetDirty(void)
     mDirtyRect = LLRect::null;
 }
 
+unsigned char* LLPluginClassMedia::acquireFrame(LLPluginFrameRing::rect_list_t* dirty_rects, bool* full)
+{
+    if(!mFrameRingActive || mFrameRing.isFrameAcquired())
+    {
+        return NULL;
+    }
+
+    U32 seq = 0;
+    const U8* frame = mFrameRing.acquireFrame(mFrameSeq, &seq, dirty_rects, full);
+    if(frame)
+    {
+        mFrameSeq = seq;
+    }
+    return (unsigned char*)frame;
+}
+
+void LLPluginClassMedia::releaseFrame()
+{
+    mFrameRing.releaseFrame();
+}
+
 std::string LLPluginClassMedia::translateModifiers(MASK modifiers)
 {
     std::string result;
@@ -1176,6 +1215,10 @@ void LLPluginClassMedia::receivePluginMessage(const LLPluginMessage &message)
             mMediaWidth = message.getValueS32("width");
             mMediaHeight = message.getValueS32("height");
 
+            // Plugins which predate the frame ring don't send this and keep drawing into buffer 0.
+            mFrameRingActive = mFrameRing.isAttached() && message.getValueBoolean("frame_ring");
+            mFrameSeq = 0;
+
             // This invalidates any existing dirty rect.
             resetDirty();
 
@@ -30,6 +30,7 @@
 #define LL_LLPLUGINCLASSMEDIA_H
 
 #include "llgltypes.h"
+#include "llpluginframering.h"
 #include "llpluginprocessparent.h"
 #include "llrect.h"
 #include "llpluginclassmediaowner.h"
@@ -98,6 +99,18 @@ public:
     
     bool getDirty(LLRect *dirty_rect = NULL);
     void resetDirty(void);
+
+    // True if the plugin publishes frames through the double-buffered frame ring rather than drawing straight into getBitsData().
+    bool usesFrameRing() const { return mFrameRingActive; };
+
+    // Takes the newest frame from the frame ring without waiting for the plugin, and fills dirty_rects with what changed since the
+    // frame taken last time. *full is set when the whole frame has to be uploaded.
+    // Returns NULL if no frame is available right now; keep the dirty state and try again on the next update.
+    // The frame stays valid until releaseFrame().
+    unsigned char* acquireFrame(LLPluginFrameRing::rect_list_t* dirty_rects, bool* full);
+    void releaseFrame();
+    // Forces the next acquireFrame() to report a full frame, e.g. after the texture it was copied into has been recreated.
+    void invalidateFrame() { mFrameSeq = 0; };
     
     typedef enum 
     {
@@ -359,6 +372,10 @@ protected:
     
     std::string mTextureSharedMemoryName;
     size_t      mTextureSharedMemorySize;
+
+    LLPluginFrameRing mFrameRing;
+    bool        mFrameRingActive;           // the plugin acknowledged the frame ring in its size_change_response
+    U32         mFrameSeq;                  // sequence number of the last frame taken with acquireFrame()
     
     // True to scale requested media up to the full size of the texture (i.e. next power of two)
     bool        mAutoScaleMedia;
@@ -0,0 +1,394 @@
+/** 
+ * @file llpluginframering.cpp
+ * @brief Double-buffered frame exchange in a plugin shared memory segment.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llpluginframering.h"
+
+#include <algorithm>
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "frame ring needs address-free atomics to live in shared memory");
+
+namespace
+{
+    const U32 FRAME_RING_MAGIC = 0x4c504652; // 'LPFR'
+    const size_t FRAME_RING_ALIGN = 64;
+}
+
+LLPluginFrameRing::LLPluginFrameRing() :
+    mAddress(NULL),
+    mFrameSize(0),
+    mWidth(0),
+    mHeight(0),
+    mDepth(0),
+    mWriting(NO_BUFFER),
+    mLastPublished(NO_BUFFER),
+    mSequence(0),
+    mAcquired(NO_BUFFER)
+{
+}
+
+// static
+size_t LLPluginFrameRing::getFrameSize(S32 texture_width, S32 texture_height, S32 depth)
+{
+    size_t size = (size_t)texture_width * texture_height * depth;
+
+    // Add an extra line for padding, just in case.
+    size += (size_t)texture_width * depth;
+
+    return size;
+}
+
+// static
+size_t LLPluginFrameRing::getBufferStride(size_t frame_size)
+{
+    return (frame_size + FRAME_RING_ALIGN - 1) & ~(FRAME_RING_ALIGN - 1);
+}
+
+// static
+size_t LLPluginFrameRing::getSegmentSize(size_t frame_size)
+{
+    return getBufferStride(frame_size) * NUM_BUFFERS + sizeof(Control);
+}
+
+void LLPluginFrameRing::attach(void* address, size_t frame_size, S32 width, S32 height, S32 depth, bool initialize)
+{
+    mAddress = (U8*)address;
+    mFrameSize = frame_size;
+    mWidth = width;
+    mHeight = height;
+    mDepth = depth;
+    mWriting = NO_BUFFER;
+    mLastPublished = NO_BUFFER;
+    mSequence = 0;
+    mRectHistory.clear();
+    mAcquired = NO_BUFFER;
+
+    if (mAddress && initialize)
+    {
+        Control* control = getControl();
+        control->mMagic = FRAME_RING_MAGIC;
+        control->mPublished = NO_BUFFER;
+        control->mReading = NO_BUFFER;
+        control->mReaderSeq = 0;
+        for (S32 i = 0; i < NUM_BUFFERS; ++i)
+        {
+            control->mSlots[i].mSeq = 0;
+            control->mSlots[i].mBaseSeq = 0;
+            control->mSlots[i].mRectCount = FULL_FRAME;
+        }
+    }
+    else if (mAddress && getControl()->mMagic != FRAME_RING_MAGIC)
+    {
+        LL_WARNS("Plugin") << "Shared memory segment does not hold a frame ring" << LL_ENDL;
+        mAddress = NULL;
+    }
+}
+
+void LLPluginFrameRing::detach()
+{
+    if (mAddress && mAcquired != NO_BUFFER)
+    {
+        releaseFrame();
+    }
+    mAddress = NULL;
+}
+
+LLPluginFrameRing::Control* LLPluginFrameRing::getControl() const
+{
+    return (Control*)(mAddress + getBufferStride(mFrameSize) * NUM_BUFFERS);
+}
+
+U8* LLPluginFrameRing::getBuffer(S32 index) const
+{
+    if (!mAddress || index < 0 || index >= NUM_BUFFERS)
+    {
+        return NULL;
+    }
+    return mAddress + getBufferStride(mFrameSize) * index;
+}
+
+void LLPluginFrameRing::copyRect(S32 from, S32 to, const LLRect& rect)
+{
+    const S32 row_bytes = mWidth * mDepth;
+    const S32 left = llclamp(rect.mLeft, 0, mWidth);
+    const S32 right = llclamp(rect.mRight, left, mWidth);
+    const S32 bottom = llclamp(rect.mBottom, 0, mHeight);
+    const S32 top = llclamp(rect.mTop, bottom, mHeight);
+    const size_t span = (size_t)(right - left) * mDepth;
+    if (!span)
+    {
+        return;
+    }
+
+    const U8* src = getBuffer(from) + (size_t)bottom * row_bytes + (size_t)left * mDepth;
+    U8* dst = getBuffer(to) + (size_t)bottom * row_bytes + (size_t)left * mDepth;
+    for (S32 row = bottom; row < top; ++row)
+    {
+        memcpy(dst, src, span);
+        src += row_bytes;
+        dst += row_bytes;
+    }
+}
+
+U8* LLPluginFrameRing::beginFrame()
+{
+    if (!mAddress)
+    {
+        return NULL;
+    }
+    if (mWriting != NO_BUFFER)
+    {
+        return getBuffer(mWriting);
+    }
+
+    Control* control = getControl();
+
+    // Withdraw the published frame before looking at what the reader holds. A reader which took it before this
+    // point shows up in mReading; one which tries after sees NO_BUFFER, or fails its recheck, and backs off.
+    control->mPublished = NO_BUFFER;
+    const S32 reading = control->mReading;
+
+    if (mLastPublished == NO_BUFFER)
+    {
+        mWriting = 0;
+    }
+    else if (reading == 1 - mLastPublished)
+    {
+        // The reader is still on the older frame; overwrite the newest one in place. It already holds
+        // everything up to the current sequence number.
+        mWriting = mLastPublished;
+    }
+    else
+    {
+        mWriting = 1 - mLastPublished;
+
+        // Bring the older buffer up to the last published frame. When the last frame's rects reach back to it,
+        // only those rects differ; otherwise copy the lot.
+        const Slot& last = control->mSlots[mLastPublished];
+        const Slot& mine = control->mSlots[mWriting];
+        if (mine.mSeq >= last.mBaseSeq && mine.mSeq < last.mSeq && last.mRectCount != FULL_FRAME)
+        {
+            for (U32 i = 0; i < last.mRectCount; ++i)
+            {
+                const S32* r = last.mRects[i];
+                copyRect(mLastPublished, mWriting, LLRect(r[0], r[3], r[2], r[1]));
+            }
+        }
+        else if (mine.mSeq != last.mSeq)
+        {
+            memcpy(getBuffer(mWriting), getBuffer(mLastPublished), mFrameSize);
+        }
+    }
+
+    return getBuffer(mWriting);
+}
+
+U32 LLPluginFrameRing::endFrame(const rect_list_t& dirty_rects)
+{
+    if (!mAddress || mWriting == NO_BUFFER)
+    {
+        return mSequence;
+    }
+
+    Control* control = getControl();
+
+    // Drop the frames the reader already has, and the oldest once there are too many, so a reader which skipped
+    // frames gets everything that changed since the frame it holds.
+    const U32 reader_seq = control->mReaderSeq;
+    while (!mRectHistory.empty()
+           && (mRectHistory.front().mSeq <= reader_seq || mRectHistory.size() >= MAX_RECT_HISTORY))
+    {
+        mRectHistory.pop_front();
+    }
+    mRectHistory.push_back(FrameRects());
+    mRectHistory.back().mSeq = mSequence + 1;
+    mRectHistory.back().mRects = dirty_rects;
+    mergeRects(mRectHistory.back().mRects, MAX_DIRTY_RECTS);
+
+    rect_list_t rects;
+    for (const FrameRects& frame : mRectHistory)
+    {
+        rects.insert(rects.end(), frame.mRects.begin(), frame.mRects.end());
+    }
+    mergeRects(rects, MAX_DIRTY_RECTS);
+
+    Slot& slot = control->mSlots[mWriting];
+    slot.mBaseSeq = mRectHistory.front().mSeq - 1;
+    slot.mRectCount = (U32)rects.size();
+    for (U32 i = 0; i < slot.mRectCount; ++i)
+    {
+        const LLRect& rect = rects[i];
+        slot.mRects[i][0] = rect.mLeft;
+        slot.mRects[i][1] = rect.mBottom;
+        slot.mRects[i][2] = rect.mRight;
+        slot.mRects[i][3] = rect.mTop;
+    }
+    return publish();
+}
+
+U32 LLPluginFrameRing::endFrameFull()
+{
+    if (!mAddress || mWriting == NO_BUFFER)
+    {
+        return mSequence;
+    }
+
+    // Nothing before this frame can be described with rects
+    mRectHistory.clear();
+    getControl()->mSlots[mWriting].mRectCount = FULL_FRAME;
+    return publish();
+}
+
+U32 LLPluginFrameRing::publish()
+{
+    Control* control = getControl();
+    control->mSlots[mWriting].mSeq = ++mSequence;
+    control->mPublished = mWriting;
+    mLastPublished = mWriting;
+    mWriting = NO_BUFFER;
+    return mSequence;
+}
+
+const U8* LLPluginFrameRing::acquireFrame(U32 last_seq, U32* seq, rect_list_t* dirty_rects, bool* full)
+{
+    llassert(mAcquired == NO_BUFFER);
+    if (!mAddress)
+    {
+        return NULL;
+    }
+
+    Control* control = getControl();
+    const S32 index = control->mPublished;
+    if (index == NO_BUFFER)
+    {
+        return NULL;
+    }
+
+    control->mReading = index;
+    if (control->mPublished != index)
+    {
+        // The writer started on a new frame between the two loads and may have picked this buffer.
+        control->mReading = NO_BUFFER;
+        return NULL;
+    }
+    mAcquired = index;
+    control->mReaderSeq = last_seq;
+
+    const Slot& slot = control->mSlots[index];
+    *seq = slot.mSeq;
+    *full = false;
+    dirty_rects->clear();
+    if (*seq == last_seq)
+    {
+        // nothing new
+    }
+    else if (last_seq && last_seq >= slot.mBaseSeq && last_seq < *seq && slot.mRectCount != FULL_FRAME)
+    {
+        for (U32 i = 0; i < slot.mRectCount; ++i)
+        {
+            const S32* r = slot.mRects[i];
+            dirty_rects->push_back(LLRect(r[0], r[3], r[2], r[1]));
+        }
+    }
+    else
+    {
+        *full = true;
+    }
+
+    return getBuffer(index);
+}
+
+void LLPluginFrameRing::releaseFrame()
+{
+    if (mAddress && mAcquired != NO_BUFFER)
+    {
+        getControl()->mReading = NO_BUFFER;
+    }
+    mAcquired = NO_BUFFER;
+}
+
+// static
+void LLPluginFrameRing::mergeRects(rect_list_t& rects, size_t max_rects)
+{
+    max_rects = llmax(max_rects, (size_t)1);
+    if (rects.size() <= max_rects)
+    {
+        return;
+    }
+
+    if (rects.size() > MAX_MERGE_INPUT)
+    {
+        // Sort into row order and fold each run of neighbours into one rect. Tiles along a row merge into strips.
+        std::sort(rects.begin(), rects.end(), [](const LLRect& a, const LLRect& b)
+            {
+                return a.mBottom != b.mBottom ? a.mBottom < b.mBottom : a.mLeft < b.mLeft;
+            });
+        const size_t run = (rects.size() + MAX_MERGE_INPUT - 1) / MAX_MERGE_INPUT;
+        size_t count = 0;
+        for (size_t first = 0; first < rects.size(); first += run)
+        {
+            LLRect merged(rects[first]);
+            const size_t end = llmin(first + run, rects.size());
+            for (size_t i = first + 1; i < end; ++i)
+            {
+                merged.unionWith(rects[i]);
+            }
+            rects[count++] = merged;
+        }
+        rects.resize(count);
+    }
+
+    while (rects.size() > max_rects)
+    {
+        size_t best_a = 0;
+        size_t best_b = 1;
+        S64 best_cost = 0;
+        bool found = false;
+        for (size_t a = 0; a < rects.size(); ++a)
+        {
+            for (size_t b = a + 1; b < rects.size(); ++b)
+            {
+                LLRect merged(rects[a]);
+                merged.unionWith(rects[b]);
+                const S64 cost = (S64)merged.getWidth() * merged.getHeight()
+                    - (S64)rects[a].getWidth() * rects[a].getHeight()
+                    - (S64)rects[b].getWidth() * rects[b].getHeight();
+                if (!found || cost < best_cost)
+                {
+                    found = true;
+                    best_cost = cost;
+                    best_a = a;
+                    best_b = b;
+                }
+            }
+        }
+
+        rects[best_a].unionWith(rects[best_b]);
+        rects.erase(rects.begin() + best_b);
+    }
+}
@@ -0,0 +1,179 @@
+/** 
+ * @file llpluginframering.h
+ * @brief Double-buffered frame exchange in a plugin shared memory segment.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLPLUGINFRAMERING_H
+#define LL_LLPLUGINFRAMERING_H
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include "llrect.h"
+
+/**
+ * @brief LLPluginFrameRing hands video frames from a media plugin to the viewer through one shared memory segment.
+ *
+ * The segment holds two frame buffers followed by a small control block. Buffer 0 starts at offset 0, so a
+ * plugin which knows nothing about the ring can keep drawing into the start of the segment as before.
+ *
+ * The plugin (writer) draws each frame into whichever buffer the viewer is not reading and publishes it together
+ * with a sequence number and the rectangles that changed since the last frame the viewer took. The viewer (reader)
+ * takes the most recently published buffer, uploads only the rectangles that changed since the last frame it
+ * uploaded, then releases it. A viewer which falls a few frames behind the plugin still gets rectangles; it
+ * only uploads the whole frame after a full frame or when it is more than MAX_RECT_HISTORY frames behind. Neither side ever waits for the other: the writer always has a free buffer, and
+ * the reader simply skips an update if it catches the writer in the middle of replacing the only readable one.
+ *
+ * Rectangles are in buffer row space: mBottom is the first row touched and mTop is one past the last, which is
+ * what LLImageGL::setSubImage() expects.
+ */
+class LLPluginFrameRing
+{
+    LOG_CLASS(LLPluginFrameRing);
+public:
+    typedef std::vector<LLRect> rect_list_t;
+
+    enum
+    {
+        NUM_BUFFERS = 2,
+        MAX_DIRTY_RECTS = 16,
+        // Frames of rects the writer keeps for a reader which skips frames
+        MAX_RECT_HISTORY = 8,
+        // Longer lists are folded down in one pass before pairwise merging
+        MAX_MERGE_INPUT = 64,
+        NO_BUFFER = -1
+    };
+
+    LLPluginFrameRing();
+
+    /// Size of one frame buffer for the given texture geometry, including the spare padding row the viewer has
+    /// always allocated.
+    static size_t getFrameSize(S32 texture_width, S32 texture_height, S32 depth);
+    /// Size of a shared memory segment holding the ring for frames of frame_size bytes.
+    static size_t getSegmentSize(size_t frame_size);
+
+    /**
+     * Attaches to a ring in an existing segment of at least getSegmentSize(frame_size) bytes.
+     *
+     * @param[in] width Media width in pixels; rows are width * depth bytes apart, as the viewer uploads them.
+     * @param[in] height Media height in pixels.
+     * @param[in] initialize True on the side which created the segment; resets the control block.
+     */
+    void attach(void* address, size_t frame_size, S32 width, S32 height, S32 depth, bool initialize);
+    void detach();
+    bool isAttached() const { return mAddress != NULL; }
+
+    U8* getBuffer(S32 index) const;
+
+    // Writer (plugin) side.
+
+    /**
+     * Picks the buffer for the next frame and brings it up to date with the last published frame, so the caller
+     * only has to draw what changes. The viewer cannot see this buffer until endFrame().
+     */
+    U8* beginFrame();
+    /// Publishes the buffer returned by beginFrame(). Returns the new frame's sequence number.
+    U32 endFrame(const rect_list_t& dirty_rects);
+    /// Publishes the frame as changed everywhere.
+    U32 endFrameFull();
+    /// Sequence number of the last published frame.
+    U32 getSequence() const { return mSequence; }
+
+    // Reader (viewer) side.
+
+    /**
+     * Takes the most recently published frame without waiting. Returns NULL if nothing is published or the
+     * writer is replacing it right now; try again next update.
+     *
+     * @param[in] last_seq Sequence number of the frame the caller last took, 0 for none.
+     * @param[out] seq Sequence number of the frame taken.
+     * @param[out] dirty_rects Rectangles changed since last_seq. Left empty when nothing changed.
+     *
+     * @return The frame, or NULL. *full is set when the whole frame must be treated as changed.
+     */
+    const U8* acquireFrame(U32 last_seq, U32* seq, rect_list_t* dirty_rects, bool* full);
+    void releaseFrame();
+    bool isFrameAcquired() const { return mAcquired != NO_BUFFER; }
+
+    /**
+     * Merges rects until at most max_rects remain, each time combining the pair whose union adds least area.
+     * Lists longer than MAX_MERGE_INPUT are first cut down by folding runs of neighbouring rects together, since
+     * finding the best pair is quadratic and a tiled page can report hundreds of rects.
+     */
+    static void mergeRects(rect_list_t& rects, size_t max_rects);
+
+private:
+    struct Slot
+    {
+        std::atomic<U32> mSeq;
+        // The rects cover every change after mBaseSeq up to mSeq.
+        U32 mBaseSeq;
+        // FULL_FRAME means every pixel changed since mSeq - 1.
+        U32 mRectCount;
+        S32 mRects[MAX_DIRTY_RECTS][4];
+    };
+
+    struct Control
+    {
+        U32 mMagic;
+        std::atomic<S32> mPublished;
+        std::atomic<S32> mReading;
+        // last_seq the reader passed to its latest acquireFrame()
+        std::atomic<U32> mReaderSeq;
+        Slot mSlots[NUM_BUFFERS];
+    };
+
+    struct FrameRects
+    {
+        U32 mSeq;
+        rect_list_t mRects;
+    };
+
+    static const U32 FULL_FRAME = 0xffffffff;
+
+    static size_t getBufferStride(size_t frame_size);
+    Control* getControl() const;
+    void copyRect(S32 from, S32 to, const LLRect& rect);
+    U32 publish();
+
+    U8* mAddress;
+    size_t mFrameSize;
+    S32 mWidth;
+    S32 mHeight;
+    S32 mDepth;
+
+    // writer state
+    S32 mWriting;
+    S32 mLastPublished;
+    U32 mSequence;
+    // Rects of the frames published since the reader's last frame, oldest first
+    std::deque<FrameRects> mRectHistory;
+
+    // reader state
+    S32 mAcquired;
+};
+
+#endif // LL_LLPLUGINFRAMERING_H
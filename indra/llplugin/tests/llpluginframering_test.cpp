@@ -0,0 +1,347 @@
+/** 
+ * @file llpluginframering_test.cpp
+ * @brief Tests for the plugin frame ring, with a stand-in plugin writing synthetic frames.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llpluginframering.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "../test/lltut.h"
+
+namespace
+{
+    const S32 WIDTH = 256;
+    const S32 HEIGHT = 128;
+    const S32 DEPTH = 4;
+    const S32 BOX_SIZE = 20;
+    const U8 BACKGROUND = 0x40;
+
+    typedef LLPluginFrameRing::rect_list_t rect_list_t;
+
+    // Frame seq shows a box on a plain background; the box moves every frame.
+    LLRect box_rect(U32 seq)
+    {
+        S32 x = (seq * 7) % (WIDTH - BOX_SIZE);
+        S32 y = (seq * 3) % (HEIGHT - BOX_SIZE);
+        return LLRect(x, y + BOX_SIZE, x + BOX_SIZE, y);
+    }
+
+    U8 box_value(U32 seq)
+    {
+        return (U8)(seq & 0xff) | 1;
+    }
+
+    void fill(U8* frame, const LLRect& rect, U8 value)
+    {
+        for (S32 y = rect.mBottom; y < rect.mTop; ++y)
+        {
+            memset(frame + ((size_t)y * WIDTH + rect.mLeft) * DEPTH, value, (size_t)rect.getWidth() * DEPTH);
+        }
+    }
+
+    void render(std::vector<U8>& frame, U32 seq)
+    {
+        frame.assign((size_t)WIDTH * HEIGHT * DEPTH, BACKGROUND);
+        fill(&frame[0], box_rect(seq), box_value(seq));
+    }
+
+    // Stands in for a media plugin: draws each frame into the ring and reports what it touched.
+    struct StandInPlugin
+    {
+        LLPluginFrameRing mRing;
+        U32 mDrawn;
+
+        StandInPlugin() : mDrawn(0) {}
+
+        U32 drawNext(bool full = false)
+        {
+            U8* buffer = mRing.beginFrame();
+            const U32 seq = ++mDrawn;
+            if (seq == 1 || full)
+            {
+                memset(buffer, BACKGROUND, (size_t)WIDTH * HEIGHT * DEPTH);
+                fill(buffer, box_rect(seq), box_value(seq));
+                return mRing.endFrameFull();
+            }
+
+            rect_list_t rects;
+            rects.push_back(box_rect(seq - 1));
+            rects.push_back(box_rect(seq));
+            fill(buffer, rects[0], BACKGROUND);
+            fill(buffer, rects[1], box_value(seq));
+            return mRing.endFrame(rects);
+        }
+    };
+
+    // The viewer side: keeps a texture up to date the way LLViewerMediaImpl does.
+    struct Viewer
+    {
+        LLPluginFrameRing mRing;
+        std::vector<U8> mTexture;
+        U32 mSeq;
+
+        Viewer() : mTexture((size_t)WIDTH * HEIGHT * DEPTH, 0), mSeq(0) {}
+
+        // Returns false if nothing could be acquired.
+        bool update(rect_list_t* rects_out = NULL, bool* full_out = NULL)
+        {
+            U32 seq = 0;
+            rect_list_t rects;
+            bool full = false;
+            const U8* frame = mRing.acquireFrame(mSeq, &seq, &rects, &full);
+            if (!frame)
+            {
+                return false;
+            }
+            if (full)
+            {
+                memcpy(&mTexture[0], frame, mTexture.size());
+            }
+            else
+            {
+                for (const LLRect& rect : rects)
+                {
+                    for (S32 y = rect.mBottom; y < rect.mTop; ++y)
+                    {
+                        const size_t offset = ((size_t)y * WIDTH + rect.mLeft) * DEPTH;
+                        memcpy(&mTexture[offset], frame + offset, (size_t)rect.getWidth() * DEPTH);
+                    }
+                }
+            }
+            mRing.releaseFrame();
+            mSeq = seq;
+            if (rects_out)
+            {
+                *rects_out = rects;
+            }
+            if (full_out)
+            {
+                *full_out = full;
+            }
+            return true;
+        }
+
+        bool shows(U32 seq) const
+        {
+            std::vector<U8> expected;
+            render(expected, seq);
+            return expected == mTexture;
+        }
+    };
+
+    bool covers(const rect_list_t& rects, const LLRect& rect)
+    {
+        for (S32 y = rect.mBottom; y < rect.mTop; ++y)
+        {
+            for (S32 x = rect.mLeft; x < rect.mRight; ++x)
+            {
+                bool found = false;
+                for (const LLRect& r : rects)
+                {
+                    if (x >= r.mLeft && x < r.mRight && y >= r.mBottom && y < r.mTop)
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+namespace tut
+{
+    struct frame_ring_data
+    {
+        std::vector<U8> mSegment;
+        StandInPlugin mPlugin;
+        Viewer mViewer;
+
+        frame_ring_data()
+        {
+            const size_t frame_size = LLPluginFrameRing::getFrameSize(WIDTH, HEIGHT, DEPTH);
+            mSegment.resize(LLPluginFrameRing::getSegmentSize(frame_size), 0);
+            // The viewer creates the segment, the plugin attaches to it
+            mViewer.mRing.attach(&mSegment[0], frame_size, WIDTH, HEIGHT, DEPTH, true);
+            mPlugin.mRing.attach(&mSegment[0], frame_size, WIDTH, HEIGHT, DEPTH, false);
+        }
+    };
+    typedef test_group<frame_ring_data> frame_ring_group;
+    typedef frame_ring_group::object frame_ring_object;
+    tut::frame_ring_group frame_ring_test("LLPluginFrameRing");
+
+    template<> template<>
+    void frame_ring_object::test<1>()
+    {
+        set_test_name("writer and reader sequencing");
+
+        ensure("nothing published yet", !mViewer.update());
+
+        rect_list_t rects;
+        bool full = false;
+        ensure_equals("first frame", mPlugin.drawNext(), 1U);
+        ensure("first frame acquired", mViewer.update(&rects, &full));
+        ensure("first frame is full", full);
+        ensure("first frame contents", mViewer.shows(1));
+
+        for (U32 seq = 2; seq <= 5; ++seq)
+        {
+            ensure_equals("sequence", mPlugin.drawNext(), seq);
+            ensure("frame acquired", mViewer.update(&rects, &full));
+            ensure_equals("reader sequence", mViewer.mSeq, seq);
+            ensure("next frame has rects", !full);
+            ensure("old box covered", covers(rects, box_rect(seq - 1)));
+            ensure("new box covered", covers(rects, box_rect(seq)));
+            ensure("frame contents", mViewer.shows(seq));
+        }
+
+        ensure("same frame again", mViewer.update(&rects, &full));
+        ensure("nothing changed", rects.empty() && !full);
+        ensure_equals("sequence unchanged", mViewer.mSeq, 5U);
+    }
+
+    template<> template<>
+    void frame_ring_object::test<2>()
+    {
+        set_test_name("skipped frames");
+
+        mPlugin.drawNext();
+        mViewer.update();
+
+        // The viewer misses two frames but still gets rects for both.
+        rect_list_t rects;
+        bool full = true;
+        mPlugin.drawNext();
+        mPlugin.drawNext();
+        ensure("frame acquired", mViewer.update(&rects, &full));
+        ensure_equals("latest frame", mViewer.mSeq, 3U);
+        ensure("skipped frames still have rects", !full);
+        ensure("first box covered", covers(rects, box_rect(1)));
+        ensure("skipped box covered", covers(rects, box_rect(2)));
+        ensure("latest box covered", covers(rects, box_rect(3)));
+        ensure("frame contents", mViewer.shows(3));
+
+        // Too far behind: the rects no longer reach back, so the whole frame is sent.
+        for (S32 i = 0; i <= LLPluginFrameRing::MAX_RECT_HISTORY; ++i)
+        {
+            mPlugin.drawNext();
+        }
+        ensure("frame acquired after a long gap", mViewer.update(&rects, &full));
+        ensure("long gap falls back to a full frame", full);
+        ensure("frame contents after a long gap", mViewer.shows(mPlugin.mDrawn));
+
+        // A full frame in between also cannot be described with rects.
+        mPlugin.drawNext(true);
+        mPlugin.drawNext();
+        ensure("frame acquired past a full frame", mViewer.update(&rects, &full));
+        ensure("skipped full frame forces a full frame", full);
+        ensure("frame contents past a full frame", mViewer.shows(mPlugin.mDrawn));
+    }
+
+    template<> template<>
+    void frame_ring_object::test<3>()
+    {
+        set_test_name("rect merging");
+
+        rect_list_t rects;
+        rects.push_back(LLRect(0, 10, 10, 0));
+        rects.push_back(LLRect(10, 10, 20, 0));
+        rects.push_back(LLRect(200, 120, 210, 110));
+        rect_list_t merged(rects);
+        LLPluginFrameRing::mergeRects(merged, 2);
+        ensure_equals("merged count", merged.size(), (size_t)2);
+        for (const LLRect& rect : rects)
+        {
+            ensure("merged rects cover the input", covers(merged, rect));
+        }
+        // The neighbours merge; the far rect stays on its own.
+        ensure("far rect kept", std::find(merged.begin(), merged.end(), rects[2]) != merged.end());
+
+        // A page of tiles, as a CEF paint of the whole view reports it.
+        const S32 TILE = 8;
+        rects.clear();
+        for (S32 y = 0; y + TILE <= HEIGHT; y += TILE)
+        {
+            for (S32 x = 0; x + TILE <= WIDTH; x += TILE)
+            {
+                rects.push_back(LLRect(x, y + TILE, x + TILE, y));
+            }
+        }
+        ensure("many tiles", rects.size() > (size_t)LLPluginFrameRing::MAX_MERGE_INPUT);
+        merged = rects;
+        LLPluginFrameRing::mergeRects(merged, LLPluginFrameRing::MAX_DIRTY_RECTS);
+        ensure("tiles merged", merged.size() <= (size_t)LLPluginFrameRing::MAX_DIRTY_RECTS);
+        ensure("tiles covered", covers(merged, LLRect(0, HEIGHT, WIDTH, 0)));
+    }
+
+    template<> template<>
+    void frame_ring_object::test<4>()
+    {
+        set_test_name("stand-in plugin on its own thread");
+
+        const U32 FRAMES = 2000;
+        std::thread plugin([this, FRAMES]()
+            {
+                while (mPlugin.mDrawn < FRAMES)
+                {
+                    mPlugin.drawNext();
+                    std::this_thread::sleep_for(std::chrono::microseconds(20));
+                }
+            });
+
+        U32 mismatches = 0;
+        U32 checked = 0;
+        while (mViewer.mSeq < FRAMES)
+        {
+            const U32 last = mViewer.mSeq;
+            if (mViewer.update() && mViewer.mSeq != last)
+            {
+                ++checked;
+                if (!mViewer.shows(mViewer.mSeq))
+                {
+                    ++mismatches;
+                }
+            }
+            if (checked % 5 == 0)
+            {
+                // Fall behind now and then
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+        plugin.join();
+
+        ensure("frames checked", checked > 0);
+        ensure_equals("texture matches every frame taken", mismatches, 0U);
+    }
+}
@@ -36,6 +36,7 @@
 #include "llshadermgr.h"
 #include "llglslshader.h"
 #include "llmemory.h"
+#include "llallocator.h"
 
 //Next Highest Power Of Two
 //helper function, returns first number > v that is a power of 2, or v if v is already a power of 2
@@ -120,6 +121,9 @@ bool LLVertexBuffer::sUseStreamDraw = true;
 bool LLVertexBuffer::sUseVAO = false;
 bool LLVertexBuffer::sPreferStreamDraw = false;
 
+// client side copies of vertex and index data, for LLAllocator's heap profile
+static LLTrace::MemStatHandle sVertexBufferMemStat("LLVertexBuffer");
+
 U32 LLVBOPool::genBuffer()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_VERTEX
@@ -196,6 +200,7 @@ U8* LLVBOPool::allocate(U32& name, U32 size, bool for_seed)
             glBufferDataARB(mType, size, 0, mUsage);
             if (mUsage != GL_DYNAMIC_COPY_ARB)
             { //data will be provided by application
+                LLAllocator::ScopedCategory category(sVertexBufferMemStat);
                 ret = (U8*) ll_aligned_malloc<64>(size);
                 if (!ret)
                 {
@@ -1094,6 +1099,7 @@ bool LLVertexBuffer::createGLBuffer(U32 size)
     {
         static int gl_buffer_idx = 0;
         mGLBuffer = ++gl_buffer_idx;
+        LLAllocator::ScopedCategory category(sVertexBufferMemStat);
         mMappedData = (U8*)ll_aligned_malloc_16(size);
         mSize = size;
     }
@@ -1134,6 +1140,7 @@ bool LLVertexBuffer::createGLIndices(U32 size)
     }
     else
     {
+        LLAllocator::ScopedCategory category(sVertexBufferMemStat);
         mMappedIndexData = (U8*)ll_aligned_malloc_16(size);
         static int gl_buffer_idx = 0;
         mGLIndices = ++gl_buffer_idx;
@@ -54,11 +54,13 @@ const F32   CURSOR_FLASH_DELAY = 1.0f;  // in seconds
 const S32   CURSOR_THICKNESS = 2;
 const F32   TRIPLE_CLICK_INTERVAL = 0.3f;   // delay between double and triple click.
 
-LLTextBase::line_info::line_info(S32 index_start, S32 index_end, LLRect rect, S32 line_num) 
+LLTextBase::line_info::line_info(S32 index_start, S32 index_end, LLRect rect, S32 line_num, S32 wrap_width, S32 segment_line) 
 :   mDocIndexStart(index_start), 
     mDocIndexEnd(index_end),
     mRect(rect),
-    mLineNum(line_num)
+    mLineNum(line_num),
+    mWrapWidth(wrap_width),
+    mSegmentLine(segment_line)
 {}
 
 bool LLTextBase::compare_segment_end::operator()(const LLTextSegmentPtr& a, const LLTextSegmentPtr& b) const
@@ -226,6 +228,7 @@ LLTextBase::LLTextBase(const LLTextBase::Params &p)
     mTextSelectedColor(p.text_selected_color),
     mSelectedBGColor(p.bg_selected_color),
     mReflowIndex(S32_MAX),
+    mReflowAfterReshape(false),
     mCursorPos( 0 ),
     mScrollNeeded(FALSE),
     mDesiredXPixel(-1),
@@ -1312,6 +1315,11 @@ void LLTextBase::reshape(S32 width, S32 height, BOOL called_from_parent)
     {
         bool scrolled_to_bottom = mScroller ? mScroller->isAtBottom() : false;
 
+        // if no edit is pending, only the geometry changes and reflow may carry
+        // laid out lines over instead of measuring them again; checked before
+        // updateRects() below asks for the reflow
+        bool layout_clean = (mReflowIndex == S32_MAX) && !LLView::sForceReshape;
+
         LLUICtrl::reshape( width, height, called_from_parent );
 
         if (mScroller && scrolled_to_bottom && mTrackEnd)
@@ -1329,6 +1337,7 @@ void LLTextBase::reshape(S32 width, S32 height, BOOL called_from_parent)
         updateRects();
         
         needsReflow();
+        mReflowAfterReshape = layout_clean;
     }
 }
 
@@ -1687,6 +1696,8 @@ void LLTextBase::reflow()
     
         S32 start_index = mReflowIndex;
         mReflowIndex = S32_MAX;
+        bool reuse_lines = mReflowAfterReshape;
+        mReflowAfterReshape = false;
 
         // shrink document to minimum size (visible portion of text widget)
         // to force inlined widgets with follows set to shrink
@@ -1700,10 +1711,15 @@ void LLTextBase::reflow()
         segment_set_t::iterator seg_iter = mSegments.begin();
         S32 seg_offset = 0;
         S32 line_start_index = 0;
-        const F32 text_available_width = mVisibleTextRect.getWidth() - mHPad;  // reserve room for margin
+        const S32 wrap_width = mVisibleTextRect.getWidth() - mHPad;  // reserve room for margin
+        const F32 text_available_width = (F32)wrap_width;
         F32 remaining_pixels = text_available_width;
         S32 line_count = 0;
 
+        // lines being replaced, kept around when they can be moved instead of measured again
+        line_list_t old_lines;
+        size_t old_line = 0;
+
         // find and erase line info structs starting at start_index and going to end of document
         if (!mLineInfoList.empty())
         {
@@ -1715,12 +1731,20 @@ void LLTextBase::reflow()
                 line_count = iter->mLineNum;
                 cur_top = iter->mRect.mTop;
                 getSegmentAndOffset(iter->mDocIndexStart, &seg_iter, &seg_offset);
+                if (reuse_lines)
+                {
+                    old_lines.assign(iter, mLineInfoList.end());
+                }
                 mLineInfoList.erase(iter, mLineInfoList.end());
             }
         }
+        const S32 first_reflowed_index = line_start_index;
 
         S32 line_height = 0;
         S32 seg_line_offset = line_count + 1;
+        // line_ind of the segment the current line starts in
+        S32 line_start_seg_line = 0;
+        bool new_line = true;
 
         while(seg_iter != mSegments.end())
         {
@@ -1729,6 +1753,48 @@ void LLTextBase::reflow()
             // track maximum height of any segment on this line
             S32 cur_index = segment->getStart() + seg_offset;
 
+            if (new_line)
+            {
+                new_line = false;
+                line_start_seg_line = line_count - seg_line_offset;
+
+                // after a resize, a line that still breaks in the same place keeps its
+                // extent and height, so move it into place without measuring it
+                if (reuse_lines)
+                {
+                    while (old_line < old_lines.size() && old_lines[old_line].mDocIndexStart < line_start_index)
+                    {
+                        ++old_line;
+                    }
+                    if (canReuseLine(old_lines, old_line, line_start_index, line_count, line_start_seg_line, seg_iter, wrap_width))
+                    {
+                        const line_info& old_info = old_lines[old_line];
+                        const line_info& next_info = old_lines[old_line + 1];
+                        S32 text_actual_width = old_info.mRect.getWidth();
+                        S32 text_left = getLeftOffset(text_actual_width);
+                        line_height = old_info.mRect.getHeight();
+                        mLineInfoList.push_back(line_info(
+                                                    line_start_index,
+                                                    old_info.mDocIndexEnd,
+                                                    LLRect(text_left, cur_top, text_left + text_actual_width, cur_top - line_height),
+                                                    line_count,
+                                                    wrap_width,
+                                                    line_start_seg_line));
+
+                        cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
+                        line_height = 0;
+                        // carry on in the state the old layout had at the start of the next line
+                        line_start_index = old_info.mDocIndexEnd;
+                        line_count = next_info.mLineNum;
+                        seg_line_offset = line_count - next_info.mSegmentLine;
+                        getSegmentAndOffset(line_start_index, &seg_iter, &seg_offset);
+                        ++old_line;
+                        new_line = true;
+                        continue;
+                    }
+                }
+            }
+
             // ask segment how many character fit in remaining space
             S32 character_count = segment->getNumChars(getWordWrap() ? llmax(0, ll_round(remaining_pixels)) : S32_MAX,
                                                         seg_offset, 
@@ -1764,12 +1830,15 @@ void LLTextBase::reflow()
                                             line_start_index, 
                                             last_segment_char_on_line, 
                                             line_rect, 
-                                            line_count));
+                                            line_count,
+                                            wrap_width,
+                                            line_start_seg_line));
 
                 line_start_index = segment->getStart() + seg_offset;
                 cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
                 remaining_pixels = text_available_width;
                 line_height = 0;
+                new_line = true;
             }
             // ...just consumed last segment..
             else if (++segment_set_t::iterator(seg_iter) == mSegments.end())
@@ -1778,7 +1847,9 @@ void LLTextBase::reflow()
                                             line_start_index, 
                                             last_segment_char_on_line, 
                                             line_rect, 
-                                            line_count));
+                                            line_count,
+                                            wrap_width,
+                                            line_start_seg_line));
                 cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
                 break;
             }
@@ -1792,11 +1863,14 @@ void LLTextBase::reflow()
                                                 line_start_index, 
                                                 last_segment_char_on_line, 
                                                 line_rect, 
-                                                line_count));
+                                                line_count,
+                                                wrap_width,
+                                                line_start_seg_line));
                     line_start_index = segment->getStart() + seg_offset;
                     cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
                     line_height = 0;
                     remaining_pixels = text_available_width;
+                    new_line = true;
                 }
                 ++seg_iter;
                 seg_offset = 0;
@@ -1809,11 +1883,19 @@ void LLTextBase::reflow()
         }
 
         // calculate visible region for diplaying text
+        S32 first_line_top = mLineInfoList.empty() ? 0 : mLineInfoList.front().mRect.mTop;
+        S32 doc_height = mDocumentView->getRect().getHeight();
         updateRects();
 
-        for (segment_set_t::iterator segment_it = mSegments.begin();
-            segment_it != mSegments.end();
-            ++segment_it)
+        // segments ahead of the reflowed lines only need updating if alignment moved the whole document,
+        // or if resizing the document moved the views that follow its top or bottom edge
+        segment_set_t::iterator segment_it = mSegments.begin();
+        if (!mLineInfoList.empty() && mLineInfoList.front().mRect.mTop == first_line_top && first_reflowed_index > 0
+            && mDocumentView->getRect().getHeight() == doc_height)
+        {
+            segment_it = getSegIterContaining(first_reflowed_index);
+        }
+        for (; segment_it != mSegments.end(); ++segment_it)
         {
             LLTextSegmentPtr segmentp = *segment_it;
             segmentp->updateLayout(*this);
@@ -1857,6 +1939,54 @@ void LLTextBase::reflow()
     updateCursorXPos();
 }
 
+// A line can be carried over from the previous layout when it starts in the same
+// state, its segments still measure the same and it breaks in the same place at the
+// new width.  A line ending in a hard break holds the same text at any width it fits
+// in; a wrapped line only keeps its break if the width shrank but still holds it.
+bool LLTextBase::canReuseLine(const line_list_t& old_lines, size_t line, S32 start, S32 line_num, S32 segment_line, segment_set_t::const_iterator seg_iter, S32 available_width) const
+{
+    // the last line is always measured, it ends wherever the document does
+    if (line + 1 >= old_lines.size())
+    {
+        return false;
+    }
+
+    const line_info& info = old_lines[line];
+    if (info.mDocIndexStart != start
+        || info.mLineNum != line_num
+        || info.mSegmentLine != segment_line)
+    {
+        return false;
+    }
+
+    const bool wrapped = old_lines[line + 1].mLineNum == info.mLineNum;
+    if (mWordWrap && available_width != info.mWrapWidth)
+    {
+        // a wider line could pull in text from the next one
+        if (wrapped && available_width > info.mWrapWidth)
+        {
+            return false;
+        }
+        // segments are handed the remaining width rounded, so keep a pixel to spare
+        if (available_width < info.mWrapWidth && info.mRect.getWidth() >= available_width)
+        {
+            return false;
+        }
+    }
+
+    // a wrapped line also depends on the segment it broke in front of
+    for (; seg_iter != mSegments.end()
+            && ((*seg_iter)->getStart() < info.mDocIndexEnd || (wrapped && (*seg_iter)->getStart() == info.mDocIndexEnd));
+         ++seg_iter)
+    {
+        if (!(*seg_iter)->hasStableLayout())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 LLRect LLTextBase::getTextBoundingRect()
 {
     reflow();
@@ -2521,6 +2651,7 @@ void LLTextBase::needsReflow(S32 index)
 {
     LL_DEBUGS() << "reflow on object " << (void*)this << " index = " << mReflowIndex << ", new index = " << index << LL_ENDL;
     mReflowIndex = llmin(mReflowIndex, index);
+    mReflowAfterReshape = false;
 
 // [SL:KB] - Patch: Control-TextHighlight | Checked: 2013-12-30 (Catznip-3.6)
     mHighlightsDirty = true;
@@ -3471,6 +3602,7 @@ bool LLTextSegment::getDimensions(S32 first_char, S32 num_chars, S32& width, S32
 S32 LLTextSegment::getOffset(S32 segment_local_x_coord, S32 start_offset, S32 num_chars, bool round) const { return 0; }
 S32 LLTextSegment::getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const { return 0; }
 void LLTextSegment::updateLayout(const LLTextBase& editor) {}
+bool LLTextSegment::hasStableLayout() const { return false; }
 F32 LLTextSegment::draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect) { return draw_rect.mLeft; }
 bool LLTextSegment::canEdit() const { return false; }
 void LLTextSegment::unlinkFromDocument(LLTextBase*) {}
@@ -3897,7 +4029,9 @@ LLInlineViewSegment::LLInlineViewSegment(const Params& p, S32 start, S32 end)
     mLeftPad(p.left_pad),
     mRightPad(p.right_pad),
     mTopPad(p.top_pad),
-    mBottomPad(p.bottom_pad)
+    mBottomPad(p.bottom_pad),
+    mLayoutWidth(-1),
+    mLayoutHeight(-1)
 {
 } 
 
@@ -3931,8 +4065,10 @@ bool LLInlineViewSegment::getDimensionsF32(S32 first_char, S32 num_chars, F32& w
     }
     else
     {
-        width = mLeftPad + mRightPad + mView->getRect().getWidth();
-        height = mBottomPad + mTopPad + mView->getRect().getHeight();
+        mLayoutWidth = mView->getRect().getWidth();
+        mLayoutHeight = mView->getRect().getHeight();
+        width = mLeftPad + mRightPad + mLayoutWidth;
+        height = mBottomPad + mTopPad + mLayoutHeight;
     }
 
     return false;
@@ -3963,6 +4099,12 @@ void LLInlineViewSegment::updateLayout(const LLTextBase& editor)
     mView->setOrigin(start_rect.mLeft + mLeftPad, start_rect.mBottom + mBottomPad);
 }
 
+bool LLInlineViewSegment::hasStableLayout() const
+{
+    // views that follow the document edges are resized along with it
+    return mView->getRect().getWidth() == mLayoutWidth && mView->getRect().getHeight() == mLayoutHeight;
+}
+
 F32 LLInlineViewSegment::draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect)
 {
     // return padded width of widget
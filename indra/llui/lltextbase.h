@@ -79,6 +79,9 @@ public:
     */
     virtual S32                 getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
     virtual void                updateLayout(const class LLTextBase& editor);
+    // true if the segment still measures as it did when the text was last laid out, so lines
+    // holding it can be moved rather than measured again when the widget is resized
+    virtual bool                hasStableLayout() const;
     virtual F32                 draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
     virtual bool                canEdit() const;
     virtual void                unlinkFromDocument(class LLTextBase* editor);
@@ -131,6 +134,7 @@ public:
     /*virtual*/ bool                getDimensionsF32(S32 first_char, S32 num_chars, F32& width, S32& height) const;
     /*virtual*/ S32                 getOffset(S32 segment_local_x_coord, S32 start_offset, S32 num_chars, bool round) const;
     /*virtual*/ S32                 getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
+    /*virtual*/ bool                hasStableLayout() const { return true; }
     /*virtual*/ F32                 draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
     /*virtual*/ bool                canEdit() const { return true; }
     /*virtual*/ const LLColor4&     getColor() const                    { return mStyle->getColor(); }
@@ -217,6 +221,7 @@ public:
     /*virtual*/ bool        getDimensionsF32(S32 first_char, S32 num_chars, F32& width, S32& height) const;
     /*virtual*/ S32         getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
     /*virtual*/ void        updateLayout(const class LLTextBase& editor);
+    /*virtual*/ bool        hasStableLayout() const;
     /*virtual*/ F32         draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
     /*virtual*/ bool        canEdit() const { return false; }
     /*virtual*/ void        unlinkFromDocument(class LLTextBase* editor);
@@ -229,6 +234,9 @@ private:
     S32 mBottomPad;
     LLView* mView;
     bool    mForceNewLine;
+    // view size when the segment was last measured
+    mutable S32 mLayoutWidth;
+    mutable S32 mLayoutHeight;
 };
 
 class LLLineBreakTextSegment : public LLTextSegment
@@ -240,6 +248,7 @@ public:
     ~LLLineBreakTextSegment();
     /*virtual*/ bool        getDimensionsF32(S32 first_char, S32 num_chars, F32& width, S32& height) const;
     S32         getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
+    bool        hasStableLayout() const { return true; }
     F32         draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
 
 private:
@@ -253,6 +262,7 @@ public:
     ~LLImageTextSegment();
     /*virtual*/ bool        getDimensionsF32(S32 first_char, S32 num_chars, F32& width, S32& height) const;
     S32         getNumChars(S32 num_pixels, S32 segment_offset, S32 char_offset, S32 max_chars, S32 line_ind) const;
+    bool        hasStableLayout() const { return true; }
     F32         draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
 
     /*virtual*/ BOOL    handleToolTip(S32 x, S32 y, MASK mask);
@@ -535,11 +545,13 @@ protected:
     // List of offsets and segment index of the start of each line.  Always has at least one node (0).
     struct line_info
     {
-        line_info(S32 index_start, S32 index_end, LLRect rect, S32 line_num);
+        line_info(S32 index_start, S32 index_end, LLRect rect, S32 line_num, S32 wrap_width, S32 segment_line);
         S32 mDocIndexStart;
         S32 mDocIndexEnd;
         LLRect mRect;
         S32 mLineNum; // actual line count (ignoring soft newlines due to word wrap)
+        S32 mWrapWidth; // width available when the line was laid out
+        S32 mSegmentLine; // line_ind passed to the segment the line starts in
     };
     typedef std::vector<line_info> line_list_t;
     
@@ -653,6 +665,7 @@ protected:
     std::pair<S32, S32>             getVisibleLines(bool fully_visible = false);
     S32                             getLeftOffset(S32 width);
     void                            reflow();
+    bool                            canReuseLine(const line_list_t& old_lines, size_t line, S32 start, S32 line_num, S32 segment_line, segment_set_t::const_iterator seg_iter, S32 available_width) const;
 
     // cursor
     void                            updateCursorXPos();
@@ -774,6 +787,7 @@ protected:
 
     // transient state
     S32                         mReflowIndex;       // index at which to start reflow.  S32_MAX indicates no reflow needed.
+    bool                        mReflowAfterReshape; // pending reflow is only due to a size change, so laid out lines can be reused
     bool                        mScrollNeeded;      // need to change scroll region because of change to cursor position
     S32                         mScrollIndex;       // index of first character to keep visible in scroll region
 
@@ -0,0 +1,267 @@
+/** 
+ * @file lltextbase_test.cpp
+ * @brief LLTextBase reflow tests
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "lltimer.h"
+
+#include "../lltextbase.h"
+#include "lluictrlfactory.h"
+#include "lldir.h"
+#include "llfontfreetype.h"
+#include "llfontgl.h"
+
+#include "../test/lltut.h"
+#include "../test/benchmark.h"
+
+#include <sstream>
+
+namespace
+{
+    std::string newview_dir()
+    {
+        std::string dir(__FILE__);
+        std::string::size_type slash = dir.find_last_of("/\\");
+        dir = (slash == std::string::npos) ? std::string(".") : dir.substr(0, slash);
+        return dir + "/../../newview";
+    }
+
+    // exposes the line layout reflow() produces
+    class TestTextBase : public LLTextBase
+    {
+    public:
+        TestTextBase(const Params& p)
+        :   LLTextBase(p)
+        {}
+
+        // one line per laid out line: doc range, line number and rect, then where each inline view went
+        std::string layout()
+        {
+            reflow();
+            std::ostringstream out;
+            for (const line_info& line : mLineInfoList)
+            {
+                out << line.mDocIndexStart << "-" << line.mDocIndexEnd << " #" << line.mLineNum << " " << line.mRect << "\n";
+            }
+            for (LLView* view : *getDocumentView()->getChildList())
+            {
+                out << view->getName() << " " << view->getRect() << "\n";
+            }
+            return out.str();
+        }
+
+        S32 getLineCount() const { return (S32)mLineInfoList.size(); }
+    };
+
+    const char* const WORDS[] = { "hello", "there", "how", "is", "everyone", "doing", "tonight", "anyone", "seen",
+                                  "the", "new", "region", "by", "the", "harbour", "lag", "is", "terrible", "again" };
+
+    // a chat message of 1 to 40 words
+    std::string message_text(S32 n)
+    {
+        std::string text;
+        S32 words = 1 + (n * 7919) % 40;
+        for (S32 i = 0; i < words; ++i)
+        {
+            if (i)
+            {
+                text += " ";
+            }
+            text += WORDS[(n + i * 31) % LL_ARRAY_SIZE(WORDS)];
+        }
+        return text;
+    }
+
+    // lays messages out the way LLChatHistory does: a header view that follows the document width and
+    // forces a new line, then the text; every other header leaves room for text beside it
+    void append_chat(TestTextBase* text, S32 first, S32 count)
+    {
+        for (S32 n = first; n < first + count; ++n)
+        {
+            LLView::Params view_params;
+            view_params.name = llformat("header %d", n);
+            view_params.rect = LLRect(0, 18, text->getDocumentView()->getRect().getWidth() - 6 - (n % 2) * 150, 0);
+            view_params.follows.flags = FOLLOWS_LEFT | FOLLOWS_RIGHT | FOLLOWS_TOP;
+            view_params.mouse_opaque = false;
+
+            LLInlineViewSegment::Params widget_params;
+            widget_params.view = LLUICtrlFactory::create<LLView>(view_params);
+            widget_params.force_newline = true;
+            widget_params.left_pad = 2;
+            widget_params.right_pad = 4;
+            widget_params.top_pad = n ? 3 : 0;
+            widget_params.bottom_pad = 1;
+            text->appendWidget(widget_params, llformat("\n[12:%02d] Resident %d: ", n % 60, n % 7), false);
+            text->appendText(message_text(n), false);
+        }
+    }
+}
+
+namespace tut
+{
+    struct textbase_data
+    {
+        textbase_data()
+        {
+            static bool initialized = false;
+            if (!initialized)
+            {
+                // font lookup needs directory support, as in llui_libtest
+                gDirUtilp->initAppDirs("SecondLife", newview_dir());
+                gDirUtilp->setSkinFolder("default", "", "en");
+                LLFontManager::initClass();
+                LLFontGL::initClass(96.f, 1.f, 1.f, gDirUtilp->getAppRODataDir(), "fonts.xml", 0.f, false);
+
+                // widgets need LLUI for focus and popups, but no settings or images here
+                static LLControlGroup settings("textbase_test");
+                LLUI::settings_map_t settings_map;
+                settings_map["config"] = &settings;
+                settings_map["ignores"] = &settings;
+                settings_map["floater"] = &settings;
+                LLUI::initParamSingleton(settings_map, (LLImageProviderInterface*)NULL, (LLUIAudioCallback)NULL, (LLUIAudioCallback)NULL);
+                initialized = true;
+            }
+            mFont = LLFontGL::getFontSansSerif();
+        }
+
+        TestTextBase* createText(S32 width, S32 first, S32 count)
+        {
+            TestTextBase::Params p;
+            p.name = "chat";
+            p.rect = LLRect(0, 400, width, 0);
+            p.font = mFont;
+            p.wrap = true;
+            p.allow_scroll = false;
+            p.read_only = true;
+            p.max_text_length = S32_MAX;
+            p.h_pad = 4;
+            TestTextBase* text = new TestTextBase(p);
+            append_chat(text, first, count);
+            return text;
+        }
+
+        const LLFontGL* mFont;
+    };
+
+    typedef test_group<textbase_data> textbase_test;
+    typedef textbase_test::object textbase_object;
+    tut::textbase_test textbase("LLTextBase");
+
+    template<> template<>
+    void textbase_object::test<1>()
+    {
+        set_test_name("reflow after a resize matches a fresh layout");
+
+        ensure("fonts loaded from " + newview_dir(), mFont && mFont->getLineHeight() > 0);
+
+        // grown one message at a time, laying out after each as the chat window does
+        std::unique_ptr<TestTextBase> text(createText(500, 0, 0));
+        for (S32 n = 0; n < 60; ++n)
+        {
+            append_chat(text.get(), n, 1);
+            text->layout();
+        }
+
+        // narrower and wider, a pixel either way, far below the longest message and back
+        const S32 widths[] = { 420, 419, 420, 300, 640, 641, 250, 180, 500, 499, 900, 500 };
+        for (S32 width : widths)
+        {
+            text->reshape(width, 400);
+            std::string reflowed = text->layout();
+
+            std::unique_ptr<TestTextBase> fresh(createText(width, 0, 60));
+            std::string expected = fresh->layout();
+            ensure_equals(llformat("lines at width %d", width), text->getLineCount(), fresh->getLineCount());
+            ensure_equals(llformat("layout at width %d", width), reflowed, expected);
+        }
+    }
+
+    template<> template<>
+    void textbase_object::test<2>()
+    {
+        set_test_name("text appended after a resize lays out as in a fresh layout");
+
+        std::unique_ptr<TestTextBase> text(createText(500, 0, 40));
+        text->layout();
+        text->reshape(350, 400);
+        text->layout();
+        append_chat(text.get(), 40, 5);
+        std::string appended = text->layout();
+
+        std::unique_ptr<TestTextBase> fresh(createText(350, 0, 45));
+        ensure_equals("layout", appended, fresh->layout());
+    }
+
+    template<> template<>
+    void textbase_object::test<3>()
+    {
+        set_test_name("benchmark resizing a long chat history");
+        skip_unless_benchmarking();
+
+        const S32 MESSAGES = 5000;
+        const S32 STEPS = 20;
+        std::unique_ptr<TestTextBase> text(createText(600, 0, MESSAGES));
+        text->layout();
+
+        // a drag shrinking the window a few pixels per frame, then growing it back
+        LLTimer timer;
+        for (S32 step = 1; step <= STEPS; ++step)
+        {
+            text->reshape(600 - step * 5, 400);
+            text->layout();
+        }
+        F64 shrink_reuse_ms = timer.getElapsedTimeF64() * 1000.0;
+        timer.reset();
+        for (S32 step = STEPS - 1; step >= 0; --step)
+        {
+            text->reshape(600 - step * 5, 400);
+            text->layout();
+        }
+        F64 grow_reuse_ms = timer.getElapsedTimeF64() * 1000.0;
+
+        // the same drag, measuring every line as the layout did before lines were reused
+        LLView::sForceReshape = TRUE;
+        timer.reset();
+        for (S32 step = 1; step <= STEPS; ++step)
+        {
+            text->reshape(600 - step * 5, 400);
+            text->layout();
+        }
+        F64 shrink_full_ms = timer.getElapsedTimeF64() * 1000.0;
+        timer.reset();
+        for (S32 step = STEPS - 1; step >= 0; --step)
+        {
+            text->reshape(600 - step * 5, 400);
+            text->layout();
+        }
+        F64 grow_full_ms = timer.getElapsedTimeF64() * 1000.0;
+        LLView::sForceReshape = FALSE;
+
+        LL_INFOS("Benchmark") << MESSAGES << " messages, " << text->getLineCount() << " lines, " << STEPS << " resizes each way: "
+                              << "shrinking " << shrink_reuse_ms << " ms reusing lines vs " << shrink_full_ms << " ms measuring all, "
+                              << "growing " << grow_reuse_ms << " ms vs " << grow_full_ms << " ms" << LL_ENDL;
+    }
+}
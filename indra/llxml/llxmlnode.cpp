@@ -29,6 +29,7 @@
 
 #include <iostream>
 #include <map>
+#include <mutex>
 
 #include "llxmlnode.h"
 
@@ -42,11 +43,202 @@
 #include "llstring.h"
 #include "lluuid.h"
 #include "lldir.h"
+#include "llmemory.h"
 
 // static
 BOOL LLXMLNode::sStripEscapedStrings = TRUE;
 BOOL LLXMLNode::sStripWhitespaceValues = FALSE;
 
+namespace
+{
+    // Every XUI file, notifications.xml and colors.xml becomes a tree with
+    // one LLXMLNode per element and another per attribute. Handing these out
+    // from 64KB slabs keeps a parsed document in a few contiguous blocks
+    // instead of thousands of small heap allocations. Each slot starts with a
+    // pointer back to its slab, and the slab is freed again once its last
+    // node goes away. Nodes are refcounted across threads, hence the lock.
+    class LLXMLNodeArena
+    {
+    public:
+        enum { SLAB_SIZE = 64 * 1024 };
+
+        LLXMLNodeArena() : mPartial(NULL), mSlabCount(0), mNodeCount(0) {}
+
+        static LLXMLNodeArena& instance()
+        {
+            // never destroyed, nodes may outlive static destruction
+            static LLXMLNodeArena* sArena = new LLXMLNodeArena;
+            return *sArena;
+        }
+
+        void* allocate()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mPartial)
+            {
+                mPartial = newSlab();
+            }
+
+            Slab* slab = mPartial;
+            char* ptr;
+            if (slab->mFree)
+            {
+                ptr = (char*)slab->mFree;
+                slab->mFree = *(void**)ptr;
+            }
+            else
+            {
+                char* slot = (char*)slab + slotOffset(slab->mBumped++);
+                *(Slab**)slot = slab;
+                ptr = slot + SLOT_HEADER;
+            }
+
+            if (++slab->mUsed == slotsPerSlab())
+            {
+                unlink(slab);
+            }
+            ++mNodeCount;
+            return ptr;
+        }
+
+        void release(void* ptr)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            Slab* slab = *(Slab**)((char*)ptr - SLOT_HEADER);
+            if (slab->mUsed == slotsPerSlab())
+            {
+                link(slab);
+            }
+
+            *(void**)ptr = slab->mFree;
+            slab->mFree = ptr;
+            --mNodeCount;
+
+            // keep one empty slab around so a parse/free cycle does not thrash
+            if (--slab->mUsed == 0 && (slab->mPrev || slab->mNext))
+            {
+                unlink(slab);
+                ll_aligned_free_16(slab);
+                --mSlabCount;
+            }
+        }
+
+        U32 getNodeCount()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mNodeCount;
+        }
+
+        size_t getBytes()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mSlabCount * (size_t)SLAB_SIZE;
+        }
+
+    private:
+        struct Slab
+        {
+            Slab*   mPrev;      // neighbours in the list of slabs with free slots
+            Slab*   mNext;
+            void*   mFree;      // released nodes, linked through their first word
+            U32     mBumped;    // slots handed out at least once
+            U32     mUsed;
+        };
+
+        enum { SLOT_HEADER = 16 };     // owning slab, padded to keep nodes 16 byte aligned
+
+        static size_t slotSize()        { return SLOT_HEADER + ((sizeof(LLXMLNode) + 15) & ~(size_t)15); }
+        static size_t slotOffset(U32 i) { return ((sizeof(Slab) + 15) & ~(size_t)15) + i * slotSize(); }
+        static U32 slotsPerSlab()       { return (U32)((SLAB_SIZE - slotOffset(0)) / slotSize()); }
+
+        Slab* newSlab()
+        {
+            Slab* slab = (Slab*)ll_aligned_malloc_16(SLAB_SIZE);
+            if (!slab)
+            {
+                LL_ERRS() << "Out of memory allocating LLXMLNode slab" << LL_ENDL;
+            }
+            slab->mPrev = slab->mNext = NULL;
+            slab->mFree = NULL;
+            slab->mBumped = 0;
+            slab->mUsed = 0;
+            link(slab);
+            ++mSlabCount;
+            return slab;
+        }
+
+        void link(Slab* slab)
+        {
+            slab->mPrev = NULL;
+            slab->mNext = mPartial;
+            if (mPartial)
+            {
+                mPartial->mPrev = slab;
+            }
+            mPartial = slab;
+        }
+
+        void unlink(Slab* slab)
+        {
+            if (slab->mPrev)
+            {
+                slab->mPrev->mNext = slab->mNext;
+            }
+            else
+            {
+                mPartial = slab->mNext;
+            }
+            if (slab->mNext)
+            {
+                slab->mNext->mPrev = slab->mPrev;
+            }
+            slab->mPrev = slab->mNext = NULL;
+        }
+
+        std::mutex mMutex;
+        Slab*   mPartial;       // slabs with at least one free slot
+        U32     mSlabCount;
+        U32     mNodeCount;
+    };
+}
+
+// static
+void* LLXMLNode::operator new(size_t size)
+{
+    if (size != sizeof(LLXMLNode))
+    {
+        return ::operator new(size);
+    }
+    return LLXMLNodeArena::instance().allocate();
+}
+
+// static
+void LLXMLNode::operator delete(void* ptr, size_t size)
+{
+    if (!ptr)
+    {
+        return;
+    }
+    if (size != sizeof(LLXMLNode))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    LLXMLNodeArena::instance().release(ptr);
+}
+
+// static
+U32 LLXMLNode::getArenaNodeCount()
+{
+    return LLXMLNodeArena::instance().getNodeCount();
+}
+
+// static
+size_t LLXMLNode::getArenaBytes()
+{
+    return LLXMLNodeArena::instance().getBytes();
+}
+
 LLXMLNode::LLXMLNode() : 
     mID(""),
     mParser(NULL),
@@ -401,15 +593,15 @@ void XMLCALL StartXMLNode(void *userData,
     U32 pos = 0;
     while (atts[pos] != NULL)
     {
-        std::string attr_name = atts[pos];
+        const char* attr_name = atts[pos];
         std::string attr_value = atts[pos+1];
 
         // Special cases
-        if ('i' == attr_name[0] && "id" == attr_name)
+        if ('i' == attr_name[0] && !strcmp("id", attr_name))
         {
             new_node->mID = attr_value;
         }
-        else if ('v' == attr_name[0] && "version" == attr_name)
+        else if ('v' == attr_name[0] && !strcmp("version", attr_name))
         {
             U32 version_major = 0;
             U32 version_minor = 0;
@@ -419,7 +611,7 @@ void XMLCALL StartXMLNode(void *userData,
                 new_node->mVersionMinor = version_minor;
             }
         }
-        else if (('s' == attr_name[0] && "size" == attr_name) || ('l' == attr_name[0] && "length" == attr_name))
+        else if (('s' == attr_name[0] && !strcmp("size", attr_name)) || ('l' == attr_name[0] && !strcmp("length", attr_name)))
         {
             U32 length;
             if (sscanf(attr_value.c_str(), "%d", &length) > 0)
@@ -427,7 +619,7 @@ void XMLCALL StartXMLNode(void *userData,
                 new_node->mLength = length;
             }
         }
-        else if ('p' == attr_name[0] && "precision" == attr_name)
+        else if ('p' == attr_name[0] && !strcmp("precision", attr_name))
         {
             U32 precision;
             if (sscanf(attr_value.c_str(), "%d", &precision) > 0)
@@ -435,7 +627,7 @@ void XMLCALL StartXMLNode(void *userData,
                 new_node->mPrecision = precision;
             }
         }
-        else if ('t' == attr_name[0] && "type" == attr_name)
+        else if ('t' == attr_name[0] && !strcmp("type", attr_name))
         {
             if ("boolean" == attr_value)
             {
@@ -462,7 +654,7 @@ void XMLCALL StartXMLNode(void *userData,
                 new_node->mType = LLXMLNode::TYPE_NODEREF;
             }
         }
-        else if ('e' == attr_name[0] && "encoding" == attr_name)
+        else if ('e' == attr_name[0] && !strcmp("encoding", attr_name))
         {
             if ("decimal" == attr_value)
             {
@@ -478,11 +670,13 @@ void XMLCALL StartXMLNode(void *userData,
             }*/
         }
 
-        // only one attribute child per description
+        // only one attribute child per description; intern the name once for
+        // both the lookup and the new node
+        LLStringTableEntry* attr_entry = gStringTable.addStringEntry(attr_name);
         LLXMLNodePtr attr_node;
-        if (!new_node->getAttribute(attr_name.c_str(), attr_node, FALSE))
+        if (!new_node->getAttribute(attr_entry, attr_node, FALSE))
         {
-            attr_node = new LLXMLNode(attr_name.c_str(), TRUE);
+            attr_node = new LLXMLNode(attr_entry, TRUE);
             attr_node->setLineNumber(XML_GetCurrentLineNumber(*new_node_ptr->mParser));
         }
         attr_node->setValue(attr_value);
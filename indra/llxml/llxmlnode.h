@@ -117,6 +117,14 @@ protected:
     ~LLXMLNode();
 
 public:
+    // Nodes are carved out of shared 64KB slabs rather than allocated one by
+    // one, see LLXMLNodeArena in llxmlnode.cpp.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+    // Node slots currently in use and slab bytes held, for tests and stats
+    static U32 getArenaNodeCount();
+    static size_t getArenaBytes();
+
     LLXMLNode();
     LLXMLNode(const char* name, BOOL is_attribute);
     LLXMLNode(LLStringTableEntry* name, BOOL is_attribute);
@@ -35,6 +35,8 @@
 #include "v4math.h"
 #include "llquaternion.h"
 #include "lluuid.h"
+#include "llfile.h"
+#include "llmd5.h"
 
 //////////////////////////////////////////////////////////////
 // LLXmlTree
@@ -113,6 +115,284 @@ void LLXmlTree::dumpNode( LLXmlTreeNode* node, const std::string& prefix )
     }
 }
 
+namespace
+{
+    const char XML_TREE_BINARY_MAGIC[] = "LLXMLBIN";
+    const U32 XML_TREE_BINARY_VERSION = 1;
+    const S32 XML_TREE_BINARY_MAX_DEPTH = 256;
+
+    bool read_file(const std::string& path, std::string& contents)
+    {
+        LLFILE* file = LLFile::fopen(path, "rb");       /* Flawfinder: ignore */
+        if (!file)
+        {
+            return false;
+        }
+        fseek(file, 0L, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0L, SEEK_SET);
+        bool success = size > 0;
+        if (success)
+        {
+            contents.resize(size);
+            success = fread(&contents[0], 1, size, file) == (size_t)size;
+        }
+        fclose(file);
+        return success;
+    }
+
+    void write_u32(std::string& out, U32 value)
+    {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    bool read_u32(const char*& cur, const char* end, U32& value)
+    {
+        if (end - cur < (S32)sizeof(value))
+        {
+            return false;
+        }
+        memcpy(&value, cur, sizeof(value));
+        cur += sizeof(value);
+        return true;
+    }
+
+    // Strings are stored once in a table and referenced by index from the
+    // node records.
+    class BinaryStringTable
+    {
+    public:
+        U32 index(const std::string& str)
+        {
+            std::map<std::string, U32>::iterator iter = mIndices.find(str);
+            if (iter != mIndices.end())
+            {
+                return iter->second;
+            }
+            U32 idx = (U32)mStrings.size();
+            mIndices[str] = idx;
+            mStrings.push_back(str);
+            return idx;
+        }
+
+        void write(std::string& out) const
+        {
+            write_u32(out, (U32)mStrings.size());
+            for (const std::string& str : mStrings)
+            {
+                write_u32(out, (U32)str.size());
+                out.append(str);
+            }
+        }
+
+    private:
+        std::map<std::string, U32> mIndices;
+        std::vector<std::string> mStrings;
+    };
+}
+
+// static
+std::string LLXmlTree::getDigest(const std::string& contents)
+{
+    LLMD5 md5;
+    if (!contents.empty())
+    {
+        md5.update(reinterpret_cast<const unsigned char*>(contents.data()), (U32)contents.size());
+    }
+    md5.finalize();
+    char digest[33];        /* Flawfinder: ignore */
+    md5.hex_digest(digest);
+    return std::string(digest);
+}
+
+BOOL LLXmlTree::parseFileCached(const std::string &path, const std::string &cache_path, BOOL keep_contents)
+{
+    std::string contents;
+    if (!read_file(path, contents))
+    {
+        // let the normal parse report the problem
+        return parseFile(path, keep_contents);
+    }
+
+    std::string digest = getDigest(contents);
+    if (loadBinary(cache_path, digest, keep_contents))
+    {
+        return TRUE;
+    }
+
+    if (!parseString(contents, keep_contents))
+    {
+        return FALSE;
+    }
+
+    if (!saveBinary(cache_path, digest, keep_contents))
+    {
+        LL_WARNS() << "Unable to write XML cache " << cache_path << LL_ENDL;
+    }
+    return TRUE;
+}
+
+BOOL LLXmlTree::saveBinary(const std::string &path, const std::string &source_digest, BOOL keep_contents)
+{
+    if (!mRoot)
+    {
+        return FALSE;
+    }
+
+    BinaryStringTable strings;
+    std::string nodes;
+
+    // pre-order walk; each record is followed by its children
+    std::vector<LLXmlTreeNode*> stack(1, mRoot);
+    while (!stack.empty())
+    {
+        LLXmlTreeNode* node = stack.back();
+        stack.pop_back();
+
+        write_u32(nodes, strings.index(node->mName));
+        write_u32(nodes, strings.index(node->mContents));
+        write_u32(nodes, (U32)node->mAttributes.size());
+        for (const auto& attr : node->mAttributes)
+        {
+            write_u32(nodes, strings.index(*attr.first));
+            write_u32(nodes, strings.index(attr.second));
+        }
+        write_u32(nodes, (U32)node->mChildren.size());
+        stack.insert(stack.end(), node->mChildren.rbegin(), node->mChildren.rend());
+    }
+
+    std::string out(XML_TREE_BINARY_MAGIC, sizeof(XML_TREE_BINARY_MAGIC) - 1);
+    write_u32(out, XML_TREE_BINARY_VERSION);
+    write_u32(out, keep_contents ? 1 : 0);
+    write_u32(out, (U32)source_digest.size());
+    out.append(source_digest);
+    strings.write(out);
+    out.append(nodes);
+
+    // write to a temporary and rename, so a reader never sees a partial file
+    std::string tmp_path = path + ".tmp";
+    LLFILE* file = LLFile::fopen(tmp_path, "wb");       /* Flawfinder: ignore */
+    if (!file)
+    {
+        return FALSE;
+    }
+    bool success = fwrite(out.data(), 1, out.size(), file) == out.size();
+    fclose(file);
+    if (success)
+    {
+        // rename does not replace an existing file on Windows
+        LLFile::remove(path, ENOENT);
+    }
+    if (!success || LLFile::rename(tmp_path, path) != 0)
+    {
+        LLFile::remove(tmp_path);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+BOOL LLXmlTree::loadBinary(const std::string &path, const std::string &source_digest, BOOL keep_contents)
+{
+    std::string data;
+    if (!read_file(path, data))
+    {
+        return FALSE;
+    }
+
+    const char* cur = data.data();
+    const char* end = cur + data.size();
+
+    const size_t magic_len = sizeof(XML_TREE_BINARY_MAGIC) - 1;
+    if (data.size() < magic_len || memcmp(cur, XML_TREE_BINARY_MAGIC, magic_len) != 0)
+    {
+        return FALSE;
+    }
+    cur += magic_len;
+
+    U32 version = 0, keep = 0, digest_len = 0;
+    if (!read_u32(cur, end, version) || version != XML_TREE_BINARY_VERSION
+        || !read_u32(cur, end, keep) || keep != (keep_contents ? 1U : 0U)
+        || !read_u32(cur, end, digest_len) || (size_t)(end - cur) < digest_len
+        || source_digest.compare(0, std::string::npos, cur, digest_len) != 0)
+    {
+        return FALSE;
+    }
+    cur += digest_len;
+
+    U32 num_strings = 0;
+    if (!read_u32(cur, end, num_strings) || num_strings > (U32)(end - cur))
+    {
+        return FALSE;
+    }
+    std::vector<std::string> strings(num_strings);
+    for (U32 i = 0; i < num_strings; ++i)
+    {
+        U32 len = 0;
+        if (!read_u32(cur, end, len) || (U32)(end - cur) < len)
+        {
+            return FALSE;
+        }
+        strings[i].assign(cur, len);
+        cur += len;
+    }
+
+    delete mRoot;
+    mRoot = readBinaryNode(cur, end, strings, NULL, 0);
+    if (!mRoot || cur != end)
+    {
+        LL_WARNS() << "Discarding corrupt XML cache " << path << LL_ENDL;
+        delete mRoot;
+        mRoot = NULL;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+LLXmlTreeNode* LLXmlTree::readBinaryNode(const char*& cur, const char* end, const std::vector<std::string>& strings, LLXmlTreeNode* parent, S32 depth)
+{
+    U32 name = 0, contents = 0, num_attributes = 0;
+    if (depth > XML_TREE_BINARY_MAX_DEPTH
+        || !read_u32(cur, end, name) || name >= strings.size()
+        || !read_u32(cur, end, contents) || contents >= strings.size()
+        || !read_u32(cur, end, num_attributes))
+    {
+        return NULL;
+    }
+
+    LLXmlTreeNode* node = new LLXmlTreeNode(strings[name], parent, this);
+    node->mContents = strings[contents];
+
+    for (U32 i = 0; i < num_attributes; ++i)
+    {
+        U32 key = 0, value = 0;
+        if (!read_u32(cur, end, key) || key >= strings.size()
+            || !read_u32(cur, end, value) || value >= strings.size())
+        {
+            delete node;
+            return NULL;
+        }
+        node->addAttribute(strings[key], strings[value]);
+    }
+
+    U32 num_children = 0;
+    if (!read_u32(cur, end, num_children))
+    {
+        delete node;
+        return NULL;
+    }
+    for (U32 i = 0; i < num_children; ++i)
+    {
+        LLXmlTreeNode* child = readBinaryNode(cur, end, strings, node, depth + 1);
+        if (!child)
+        {
+            delete node;
+            return NULL;
+        }
+        node->addChild(child);
+    }
+    return node;
+}
+
 //////////////////////////////////////////////////////////////
 // LLXmlTreeNode
 
@@ -125,14 +405,11 @@ LLXmlTreeNode::LLXmlTreeNode( const std::string& name, LLXmlTreeNode* parent, LL
 
 LLXmlTreeNode::~LLXmlTreeNode()
 {
-    attribute_map_t::iterator iter;
-    for (iter=mAttributes.begin(); iter != mAttributes.end(); iter++)
-        delete iter->second;
-        for(LLXmlTreeNode* node : mChildren)
-        {
-            delete node;
-        }
-        mChildren.clear();
+    for(LLXmlTreeNode* node : mChildren)
+    {
+        delete node;
+    }
+    mChildren.clear();
 }
  
 void LLXmlTreeNode::dump( const std::string& prefix )
@@ -146,8 +423,8 @@ void LLXmlTreeNode::dump( const std::string& prefix )
     for (iter=mAttributes.begin(); iter != mAttributes.end(); iter++)
     {
         LLStdStringHandle key = iter->first;
-        const std::string* value = iter->second;
-        LL_CONT << prefix << " " << key << "=" << (value->empty() ? "NULL" : *value);
+        const std::string& value = iter->second;
+        LL_CONT << prefix << " " << key << "=" << (value.empty() ? "NULL" : value);
     }
     LL_CONT << LL_ENDL;
 } 
@@ -162,8 +439,7 @@ BOOL LLXmlTreeNode::hasAttribute(const std::string& name)
 void LLXmlTreeNode::addAttribute(const std::string& name, const std::string& value)
 {
     LLStdStringHandle canonical_name = LLXmlTree::sAttributeKeys.addString( name );
-    const std::string *newstr = new std::string(value);
-    mAttributes[canonical_name] = newstr; // insert + copy
+    mAttributes[canonical_name] = value;
 }
 
 LLXmlTreeNode*  LLXmlTreeNode::getFirstChild()
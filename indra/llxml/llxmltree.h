@@ -30,6 +30,7 @@
 
 #include <map>
 #include <list>
+#include <vector>
 #include "llstring.h"
 #include "llxmlparser.h"
 #include "llstringtable.h"
@@ -58,11 +59,23 @@ public:
     virtual BOOL    parseFile(const std::string &path, BOOL keep_contents = TRUE);
     virtual BOOL    parseString(const std::string &string, BOOL keep_contents = TRUE);
 
+    // Like parseFile(), but loads the tree from a binary copy at cache_path
+    // when that copy was written from identical source.  A missing or stale
+    // copy is rewritten after a normal parse.
+    BOOL            parseFileCached(const std::string &path, const std::string &cache_path, BOOL keep_contents = TRUE);
+
+    // Compact binary form of the parsed tree, tagged with a digest of the
+    // source document.  loadBinary() fails if the tag does not match.
+    BOOL            saveBinary(const std::string &path, const std::string &source_digest, BOOL keep_contents);
+    BOOL            loadBinary(const std::string &path, const std::string &source_digest, BOOL keep_contents);
+
     LLXmlTreeNode*  getRoot() { return mRoot; }
 
     void            dump();
     void            dumpNode( LLXmlTreeNode* node, const std::string& prefix );
 
+    static std::string  getDigest(const std::string& contents);
+
     static LLStdStringHandle addAttributeString( const std::string& name)
     {
         return sAttributeKeys.addString( name );
@@ -72,6 +85,9 @@ public:
     // global
     static LLStdStringTable sAttributeKeys;
     
+protected:
+    LLXmlTreeNode*  readBinaryNode(const char*& cur, const char* end, const std::vector<std::string>& strings, LLXmlTreeNode* parent, S32 depth);
+
 protected:
     LLXmlTreeNode* mRoot;
 
@@ -160,7 +176,7 @@ protected:
     const std::string* getAttribute( LLStdStringHandle name)
     {
         attribute_map_t::iterator iter = mAttributes.find(name);
-        return (iter == mAttributes.end()) ? 0 : iter->second;
+        return (iter == mAttributes.end()) ? 0 : &iter->second;
     }
 
 private:
@@ -171,7 +187,8 @@ private:
     void            dump( const std::string& prefix );
 
 protected:
-    typedef std::map<LLStdStringHandle, const std::string*> attribute_map_t;
+    // values live in the map nodes, no separate allocation per attribute
+    typedef std::map<LLStdStringHandle, std::string> attribute_map_t;
     attribute_map_t                     mAttributes;
 
 private:
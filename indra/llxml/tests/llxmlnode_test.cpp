@@ -0,0 +1,165 @@
+/** 
+ * @file llxmlnode_test.cpp
+ * @brief LLXMLNode arena and XUI parse benchmark
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "lldiriterator.h"
+#include "lltimer.h"
+
+#include "../llxmlnode.h"
+#include "../llxmltree.h"
+
+#include "../test/lltut.h"
+#include "../test/benchmark.h"
+
+namespace
+{
+    LLXMLNodePtr parse(const std::string& text)
+    {
+        std::vector<U8> buffer(text.begin(), text.end());
+        LLXMLNodePtr root;
+        LLXMLNode::parseBuffer(buffer.data(), (U32)buffer.size(), root, NULL);
+        return root;
+    }
+
+    std::string xui_dir()
+    {
+        std::string dir(__FILE__);
+        std::string::size_type slash = dir.find_last_of("/\\");
+        dir = (slash == std::string::npos) ? std::string(".") : dir.substr(0, slash);
+        return dir + "/../../newview/skins/default/xui/en/";
+    }
+}
+
+namespace tut
+{
+    struct xmlnode_data
+    {
+    };
+
+    typedef test_group<xmlnode_data> xmlnode_test;
+    typedef xmlnode_test::object xmlnode_object;
+    tut::xmlnode_test xmlnode("LLXMLNode");
+
+    template<> template<>
+    void xmlnode_object::test<1>()
+    {
+        set_test_name("nodes come from the arena and go back to it");
+
+        U32 baseline = LLXMLNode::getArenaNodeCount();
+        {
+            LLXMLNodePtr root = parse("<panel name=\"top\" width=\"10\"><button name=\"ok\"/></panel>");
+            ensure("parsed", root.notNull());
+            // panel, name, width, button, name; the parser's file node is gone
+            ensure_equals("live nodes", LLXMLNode::getArenaNodeCount(), baseline + 5);
+            ensure("slab held", LLXMLNode::getArenaBytes() > 0);
+
+            std::string name;
+            ensure("panel name", root->getAttributeString("name", name));
+            ensure_equals(name, "top");
+            S32 width = 0;
+            ensure("panel width", root->getAttributeS32("width", width));
+            ensure_equals(width, 10);
+
+            LLXMLNodePtr child = root->getFirstChild();
+            ensure("button", child.notNull() && child->hasName("button"));
+            ensure("button name", child->getAttributeString("name", name));
+            ensure_equals(name, "ok");
+        }
+        ensure_equals("all released", LLXMLNode::getArenaNodeCount(), baseline);
+    }
+
+    template<> template<>
+    void xmlnode_object::test<2>()
+    {
+        set_test_name("slabs are reused and returned");
+
+        U32 baseline = LLXMLNode::getArenaNodeCount();
+        std::string text("<list>");
+        for (S32 i = 0; i < 5000; ++i)
+        {
+            text += "<item value=\"1\"/>";
+        }
+        text += "</list>";
+
+        size_t peak = 0;
+        for (S32 pass = 0; pass < 3; ++pass)
+        {
+            LLXMLNodePtr root = parse(text);
+            ensure("parsed", root.notNull());
+            ensure_equals("live nodes", LLXMLNode::getArenaNodeCount(), baseline + 1 + 5000 * 2);
+            if (pass == 0)
+            {
+                peak = LLXMLNode::getArenaBytes();
+            }
+            ensure_equals("no growth on reparse", LLXMLNode::getArenaBytes(), peak);
+        }
+        ensure_equals("all released", LLXMLNode::getArenaNodeCount(), baseline);
+        ensure("slabs freed", LLXMLNode::getArenaBytes() < peak);
+    }
+
+    template<> template<>
+    void xmlnode_object::test<3>()
+    {
+        set_test_name("benchmark parsing skins/default/xui/en with LLXMLNode and LLXmlTree");
+        skip_unless_benchmarking();
+
+        std::string dir = xui_dir();
+        std::vector<std::string> files;
+        LLDirIterator iter(dir, "*.xml");
+        std::string name;
+        while (iter.next(name))
+        {
+            files.push_back(dir + name);
+        }
+        ensure("XUI files found at " + dir, ! files.empty());
+
+        U32 baseline = LLXMLNode::getArenaNodeCount();
+        LLTimer timer;
+        size_t peak_bytes = 0;
+        for (const std::string& file : files)
+        {
+            LLXMLNodePtr root;
+            ensure("LLXMLNode parsed " + file, LLXMLNode::parseFile(file, root, NULL));
+            ensure("LLXMLNode root for " + file, root.notNull() && root->getFirstChild().notNull());
+            peak_bytes = llmax(peak_bytes, LLXMLNode::getArenaBytes());
+        }
+        F64 node_ms = timer.getElapsedTimeF64() * 1000.0;
+        ensure_equals("all released", LLXMLNode::getArenaNodeCount(), baseline);
+
+        timer.reset();
+        for (const std::string& file : files)
+        {
+            LLXmlTree tree;
+            ensure("LLXmlTree parsed " + file, tree.parseFile(file, TRUE));
+            ensure("LLXmlTree root for " + file, tree.getRoot() != NULL);
+        }
+        F64 tree_ms = timer.getElapsedTimeF64() * 1000.0;
+
+        LL_INFOS("Benchmark") << "Parsed " << files.size() << " XUI files: LLXMLNode " << node_ms
+                              << " ms (peak arena " << peak_bytes / 1024 << " KB), LLXmlTree " << tree_ms << " ms" << LL_ENDL;
+    }
+}
@@ -0,0 +1,158 @@
+/** 
+ * @file llxmltree_test.cpp
+ * @brief LLXmlTree binary cache tests
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "llfile.h"
+#include "lluuid.h"
+#include "stringize.h"
+
+#include "../llxmltree.h"
+
+#include "../test/lltut.h"
+
+namespace tut
+{
+    struct xmltree_data
+    {
+        std::string mTestDir;
+        std::string mSourceFile;
+        std::string mCacheFile;
+
+        xmltree_data()
+        {
+            LLUUID random;
+            random.generate();
+            mTestDir = STRINGIZE(LLFile::tmpdir() << "llxmltree-test-" << random << "/");
+            mSourceFile = mTestDir + "tree.xml";
+            mCacheFile = mTestDir + "tree.xml.bin";
+            LLFile::mkdir(mTestDir);
+        }
+
+        ~xmltree_data()
+        {
+            LLFile::remove(mSourceFile);
+            LLFile::remove(mCacheFile);
+            LLFile::rmdir(mTestDir);
+        }
+
+        void writeSource(const std::string& contents)
+        {
+            LLFILE* file = LLFile::fopen(mSourceFile, "wb");
+            fwrite(contents.data(), 1, contents.size(), file);
+            fclose(file);
+        }
+    };
+
+    typedef test_group<xmltree_data> xmltree_test;
+    typedef xmltree_test::object xmltree_object;
+    tut::xmltree_test xmltree("LLXmlTree");
+
+    const std::string TEST_DOCUMENT =
+        "<root version=\"2.0\">\n"
+        "  <bone name=\"mPelvis\" pos=\"0 0 1\">\n"
+        "    <bone name=\"mTorso\" pos=\"0 0 0.5\"/>\n"
+        "  </bone>\n"
+        "  <param id=\"33\" name=\"height\">some text</param>\n"
+        "</root>\n";
+
+    // a cached tree matches the parsed one
+    template<> template<>
+    void xmltree_object::test<1>()
+    {
+        writeSource(TEST_DOCUMENT);
+
+        LLXmlTree first;
+        ensure("parse with empty cache", first.parseFileCached(mSourceFile, mCacheFile, TRUE));
+        ensure("cache written", LLFile::isfile(mCacheFile));
+
+        LLXmlTree cached;
+        ensure("cache loads", cached.loadBinary(mCacheFile, LLXmlTree::getDigest(TEST_DOCUMENT), TRUE));
+
+        LLXmlTreeNode* root = cached.getRoot();
+        ensure("root", root && root->hasName("root"));
+        std::string version;
+        ensure("root attribute", root->getAttributeString("version", version));
+        ensure_equals("root attribute value", version, "2.0");
+
+        LLXmlTreeNode* pelvis = root->getChildByName("bone");
+        ensure("named child lookup", pelvis != NULL);
+        ensure_equals("child count", pelvis->getChildCount(), 1);
+        LLXmlTreeNode* torso = pelvis->getFirstChild();
+        std::string name;
+        ensure("nested attribute", torso && torso->getAttributeString("name", name));
+        ensure_equals("nested attribute value", name, "mTorso");
+        ensure("parent link", torso->getParent() == pelvis);
+
+        LLXmlTreeNode* param = root->getChildByName("param");
+        ensure_equals("contents kept", param->getContents(), "some text");
+    }
+
+    // a stale or mismatched cache is rejected and rewritten
+    template<> template<>
+    void xmltree_object::test<2>()
+    {
+        writeSource(TEST_DOCUMENT);
+        LLXmlTree first;
+        ensure("parse", first.parseFileCached(mSourceFile, mCacheFile, TRUE));
+
+        LLXmlTree tree;
+        ensure("wrong digest rejected", !tree.loadBinary(mCacheFile, LLXmlTree::getDigest("other"), TRUE));
+        ensure("keep_contents mismatch rejected", !tree.loadBinary(mCacheFile, LLXmlTree::getDigest(TEST_DOCUMENT), FALSE));
+
+        std::string changed = TEST_DOCUMENT;
+        LLStringUtil::replaceString(changed, "2.0", "3.0");
+        writeSource(changed);
+
+        LLXmlTree reparsed;
+        ensure("parse after change", reparsed.parseFileCached(mSourceFile, mCacheFile, TRUE));
+        std::string version;
+        reparsed.getRoot()->getAttributeString("version", version);
+        ensure_equals("changed source is used", version, "3.0");
+        ensure("cache rewritten", tree.loadBinary(mCacheFile, LLXmlTree::getDigest(changed), TRUE));
+    }
+
+    // a truncated cache is rejected
+    template<> template<>
+    void xmltree_object::test<3>()
+    {
+        writeSource(TEST_DOCUMENT);
+        LLXmlTree first;
+        ensure("parse", first.parseFileCached(mSourceFile, mCacheFile, TRUE));
+
+        LLFILE* file = LLFile::fopen(mCacheFile, "rb");
+        char buffer[4096];
+        size_t len = fread(buffer, 1, sizeof(buffer), file);
+        fclose(file);
+        file = LLFile::fopen(mCacheFile, "wb");
+        fwrite(buffer, 1, len - 5, file);
+        fclose(file);
+
+        LLXmlTree tree;
+        ensure("truncated cache rejected", !tree.loadBinary(mCacheFile, LLXmlTree::getDigest(TEST_DOCUMENT), TRUE));
+        ensure("no partial tree", tree.getRoot() == NULL);
+    }
+}
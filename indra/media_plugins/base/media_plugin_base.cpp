@@ -154,6 +154,157 @@ void MediaPluginBase::setDirty(int left, int top, int right, int bottom)
     sendMessage(message);
 }
 
+/**
+ * Attaches to the double-buffered frame ring in the texture segment, if the viewer offered one.
+ * 
+ * @param[in] size_change The "size_change" message from the viewer
+ * @param[in] address Address of the texture segment named in the message
+ *
+ * @return True if frames will be published through the ring
+ *
+ */
+bool MediaPluginBase::attachFrameRing(const LLPluginMessage &size_change, void *address)
+{
+    mFrameRing.detach();
+
+    if(address && size_change.getValueBoolean("frame_ring"))
+    {
+        S32 texture_width = size_change.getValueS32("texture_width");
+        S32 texture_height = size_change.getValueS32("texture_height");
+        size_t frame_size = LLPluginFrameRing::getFrameSize(texture_width, texture_height, mDepth);
+        mFrameRing.attach(address, frame_size, size_change.getValueS32("width"), size_change.getValueS32("height"), mDepth, false);
+    }
+
+    return mFrameRing.isAttached();
+}
+
+/**
+ * Returns the buffer to draw the next frame into.
+ * 
+ * With a frame ring this is whichever buffer the viewer isn't reading, already holding the last published
+ * frame. Without one it is mPixels.
+ *
+ */
+unsigned char* MediaPluginBase::beginFrame()
+{
+    if(mFrameRing.isAttached())
+    {
+        return mFrameRing.beginFrame();
+    }
+    return mPixels;
+}
+
+/**
+ * Publishes the frame started by beginFrame() and notifies the viewer.
+ * 
+ * @param[in] dirty_rects Rects changed since the previous frame, in buffer rows (mBottom is the first row)
+ *
+ */
+void MediaPluginBase::endFrame(const LLPluginFrameRing::rect_list_t &dirty_rects)
+{
+    if(mFrameRing.isAttached())
+    {
+        mFrameRing.endFrame(dirty_rects);
+    }
+
+    if(!dirty_rects.empty())
+    {
+        LLRect bounds = dirty_rects[0];
+        for(size_t i = 1; i < dirty_rects.size(); ++i)
+        {
+            bounds.unionWith(dirty_rects[i]);
+        }
+        setDirty(bounds.mLeft, bounds.mTop, bounds.mRight, bounds.mBottom);
+    }
+}
+
+/**
+ * Copies a complete mWidth x mHeight frame into a frame buffer, writing only the tiles which differ, and
+ * appends the changed areas to dirty_rects. Useful for sources which only ever hand over whole frames.
+ * 
+ * @param[out] frame Buffer from beginFrame()
+ * @param[in] pixels Complete new frame, rows mWidth * mDepth bytes apart
+ * @param[out] dirty_rects Changed areas, in buffer rows
+ *
+ */
+void MediaPluginBase::copyChangedTiles(unsigned char *frame, const unsigned char *pixels, LLPluginFrameRing::rect_list_t &dirty_rects)
+{
+    const int TILE_SIZE = 64;
+    const size_t row_bytes = (size_t)mWidth * mDepth;
+
+    // Indices into dirty_rects of the rects which reached the bottom of the previous band of tiles, so tall
+    // changes come out as one rect rather than a stack of them.
+    std::vector<size_t> open_rects;
+    std::vector<size_t> still_open;
+
+    for(int y0 = 0; y0 < mHeight; y0 += TILE_SIZE)
+    {
+        const int y1 = llmin(y0 + TILE_SIZE, mHeight);
+        const size_t band_start = dirty_rects.size();
+
+        for(int x0 = 0; x0 < mWidth; x0 += TILE_SIZE)
+        {
+            const int x1 = llmin(x0 + TILE_SIZE, mWidth);
+            const size_t offset = (size_t)x0 * mDepth;
+            const size_t span = (size_t)(x1 - x0) * mDepth;
+
+            int y = y0;
+            while(y < y1 && !memcmp(frame + y * row_bytes + offset, pixels + y * row_bytes + offset, span))
+            {
+                ++y;
+            }
+            if(y == y1)
+            {
+                continue;
+            }
+
+            for(; y < y1; ++y)
+            {
+                memcpy(frame + y * row_bytes + offset, pixels + y * row_bytes + offset, span);
+            }
+
+            if(dirty_rects.size() > band_start && dirty_rects.back().mRight == x0)
+            {
+                dirty_rects.back().mRight = x1;
+            }
+            else
+            {
+                dirty_rects.push_back(LLRect(x0, y1, x1, y0));
+            }
+        }
+
+        // Fold this band's spans into matching rects from the band above.
+        still_open.clear();
+        size_t keep = band_start;
+        for(size_t i = band_start; i < dirty_rects.size(); ++i)
+        {
+            const LLRect span = dirty_rects[i];
+            size_t target = keep;
+            for(size_t j = 0; j < open_rects.size(); ++j)
+            {
+                const LLRect &above = dirty_rects[open_rects[j]];
+                if(above.mLeft == span.mLeft && above.mRight == span.mRight)
+                {
+                    target = open_rects[j];
+                    break;
+                }
+            }
+
+            if(target == keep)
+            {
+                dirty_rects[keep++] = span;
+            }
+            else
+            {
+                dirty_rects[target].mTop = y1;
+            }
+            still_open.push_back(target);
+        }
+        dirty_rects.resize(keep);
+        open_rects.swap(still_open);
+    }
+}
+
 /**
  * Sends "media_status" message to plugin loader shell ("loading", "playing", "paused", etc.)
  * 
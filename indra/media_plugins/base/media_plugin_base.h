@@ -28,6 +28,7 @@
 
 #include "linden_common.h"
 
+#include "llpluginframering.h"
 #include "llplugininstance.h"
 #include "llpluginmessage.h"
 #include "llpluginmessageclasses.h"
@@ -77,6 +78,15 @@ protected:
     /// Note: The quicktime plugin overrides this to add current time and duration to the message.
     virtual void setDirty(int left, int top, int right, int bottom);
 
+   /** Attaches to the viewer's frame ring if the size_change message offered one. Reply with "frame_ring" set to the result. */
+    bool attachFrameRing(const LLPluginMessage &size_change, void *address);
+   /** Returns the buffer to draw the next frame into. With a frame ring it already holds the previous frame. */
+    unsigned char* beginFrame();
+   /** Publishes the frame started by beginFrame() and tells the viewer which rects (in buffer rows) changed. */
+    void endFrame(const LLPluginFrameRing::rect_list_t &dirty_rects);
+   /** Copies a whole new frame into a frame buffer, writing only the tiles which changed, and collects the changed rects. */
+    void copyChangedTiles(unsigned char *frame, const unsigned char *pixels, LLPluginFrameRing::rect_list_t &dirty_rects);
+
    /** Map of shared memory names to shared memory. */
     typedef std::map<std::string, SharedSegmentInfo> SharedSegmentMap;
 
@@ -105,6 +115,8 @@ protected:
     EStatus mStatus;
    /** Map of shared memory segments. */
     SharedSegmentMap mSharedSegments;
+   /** Double-buffered frame exchange in the texture segment, when the viewer supports it. */
+    LLPluginFrameRing mFrameRing;
 
 };
 
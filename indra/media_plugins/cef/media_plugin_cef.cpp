@@ -185,13 +185,26 @@ void MediaPluginCEF::onPageChangedCallback(const unsigned char* pixels, int x, i
     {
         if (mWidth == width && mHeight == height)
         {
-            memcpy(mPixels, pixels, mWidth * mHeight * mDepth);
+            // Dullahan only hands over whole frames; with the frame ring, diff against the last one so the
+            // viewer only uploads what changed.
+            LLPluginFrameRing::rect_list_t dirty_rects;
+            unsigned char* frame = beginFrame();
+            if (mFrameRing.isAttached())
+            {
+                copyChangedTiles(frame, pixels, dirty_rects);
+            }
+            else
+            {
+                memcpy(frame, pixels, mWidth * mHeight * mDepth);
+                dirty_rects.push_back(LLRect(0, mHeight, mWidth, 0));
+            }
+            endFrame(dirty_rects);
         }
         else
         {
             mCEFLib->setSize(mWidth, mHeight);
+            setDirty(0, 0, mWidth, mHeight);
         }
-        setDirty(0, 0, mWidth, mHeight);
     }
 }
 
@@ -580,6 +593,7 @@ void MediaPluginCEF::receiveMessage(const char* message_string)
                     {
                         mPixels = NULL;
                         mTextureSegmentName.clear();
+                        mFrameRing.detach();
                     }
                     mSharedSegments.erase(iter);
                 }
@@ -761,6 +775,7 @@ void MediaPluginCEF::receiveMessage(const char* message_string)
                 S32 height = message_in.getValueS32("height");
                 S32 texture_width = message_in.getValueS32("texture_width");
                 S32 texture_height = message_in.getValueS32("texture_height");
+                bool frame_ring = false;
 
                 if (!name.empty())
                 {
@@ -775,6 +790,8 @@ void MediaPluginCEF::receiveMessage(const char* message_string)
                         mTextureWidth = texture_width;
                         mTextureHeight = texture_height;
 
+                        frame_ring = attachFrameRing(message_in, mPixels);
+
                         mCEFLib->setSize(mWidth, mHeight);
                     };
                 };
@@ -785,6 +802,7 @@ void MediaPluginCEF::receiveMessage(const char* message_string)
                 message.setValueS32("height", height);
                 message.setValueS32("texture_width", texture_width);
                 message.setValueS32("texture_height", texture_height);
+                message.setValueBoolean("frame_ring", frame_ring);
                 sendMessage(message);
 
             }
@@ -154,6 +154,7 @@ void mediaPluginExample::receiveMessage(const char* message_string)
                         // This is the currently active pixel buffer.  Make sure we stop drawing to it.
                         mPixels = NULL;
                         mTextureSegmentName.clear();
+                        mFrameRing.detach();
                     }
                     mSharedSegments.erase(iter);
                 }
@@ -195,6 +196,7 @@ void mediaPluginExample::receiveMessage(const char* message_string)
                 S32 height = message_in.getValueS32("height");
                 S32 texture_width = message_in.getValueS32("texture_width");
                 S32 texture_height = message_in.getValueS32("texture_height");
+                bool frame_ring = false;
 
                 if (!name.empty())
                 {
@@ -208,6 +210,8 @@ void mediaPluginExample::receiveMessage(const char* message_string)
 
                         mTextureWidth = texture_width;
                         mTextureHeight = texture_height;
+
+                        frame_ring = attachFrameRing(message_in, mPixels);
                     };
                 };
 
@@ -217,6 +221,7 @@ void mediaPluginExample::receiveMessage(const char* message_string)
                 message.setValueS32("height", height);
                 message.setValueS32("texture_width", texture_width);
                 message.setValueS32("texture_height", texture_height);
+                message.setValueBoolean("frame_ring", frame_ring);
                 sendMessage(message);
 
                 mFirstTime = true;
@@ -286,6 +291,7 @@ void mediaPluginExample::update(F64 milliseconds)
         mFirstTime = false;
     };
 
+    bool redraw_all = false;
     if (time(NULL) > mLastUpdateTime + 3)
     {
         const int num_squares = rand() % 20 + 4;
@@ -329,12 +335,33 @@ void mediaPluginExample::update(F64 milliseconds)
         };
 
         time(&mLastUpdateTime);
+        redraw_all = true;
     };
 
-    memcpy(mPixels, mBackgroundPixels, mWidth * mHeight * mDepth);
+    // The frame buffer still holds the previous frame (in the frame ring, the one published last), so only the
+    // blocks need redrawing: put the background back where each one was, then draw them all where they are now.
+    unsigned char* frame = beginFrame();
+    if (!frame)
+        return;
+
+    LLPluginFrameRing::rect_list_t dirty_rects;
+    if (redraw_all)
+    {
+        memcpy(frame, mBackgroundPixels, mWidth * mHeight * mDepth);
+        dirty_rects.push_back(LLRect(0, mHeight, mWidth, 0));
+    }
 
     for (int n = 0; n < ENumObjects; ++n)
     {
+        LLRect block(mXpos[n], mYpos[n] + mBlockSize[n], mXpos[n] + mBlockSize[n], mYpos[n]);
+        if (!redraw_all)
+        {
+            for (int y = block.mBottom; y < block.mTop; ++y)
+            {
+                memcpy(frame + (block.mLeft + y * mWidth) * mDepth, mBackgroundPixels + (block.mLeft + y * mWidth) * mDepth, mBlockSize[n] * mDepth);
+            };
+        };
+
         if (rand() % 50 == 0)
         {
             mXInc[n] = 0;
@@ -355,18 +382,28 @@ void mediaPluginExample::update(F64 milliseconds)
         mXpos[n] += mXInc[n];
         mYpos[n] += mYInc[n];
 
+        if (!redraw_all)
+        {
+            // One rect covering where the block was and where it is now.
+            block.unionWith(LLRect(mXpos[n], mYpos[n] + mBlockSize[n], mXpos[n] + mBlockSize[n], mYpos[n]));
+            dirty_rects.push_back(block);
+        };
+    };
+
+    for (int n = 0; n < ENumObjects; ++n)
+    {
         for (int y = 0; y < mBlockSize[n]; ++y)
         {
             for (int x = 0; x < mBlockSize[n]; ++x)
             {
-                mPixels[(mXpos[n] + x) * mDepth + (mYpos[n] + y) * mDepth * mWidth + 0] = mColorR[n];
-                mPixels[(mXpos[n] + x) * mDepth + (mYpos[n] + y) * mDepth * mWidth + 1] = mColorG[n];
-                mPixels[(mXpos[n] + x) * mDepth + (mYpos[n] + y) * mDepth * mWidth + 2] = mColorB[n];
+                frame[(mXpos[n] + x) * mDepth + (mYpos[n] + y) * mDepth * mWidth + 0] = mColorR[n];
+                frame[(mXpos[n] + x) * mDepth + (mYpos[n] + y) * mDepth * mWidth + 1] = mColorG[n];
+                frame[(mXpos[n] + x) * mDepth + (mYpos[n] + y) * mDepth * mWidth + 2] = mColorB[n];
             };
         };
     };
 
-    setDirty(0, 0, mWidth, mHeight);
+    endFrame(dirty_rects);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,8 @@
 #include "llviewerprecompiledheaders.h"
 #include "animationexplorer.h"
 
+#include "fsobjectpropertiesbroker.h"
+
 #include "indra_constants.h"        // for MASK_ALT etc.
 #include "message.h"                // for gMessageSystem
 //#include "stdenums.h"             // for ADD_TOP
@@ -403,23 +405,7 @@ void AnimationExplorer::addAnimation(const LLUUID& id, const LLUUID& played_by,
                     // remember which object names we already requested
                     mRequestedIDs.push_back(played_by);
 
-                    LLMessageSystem* msg = gMessageSystem;
-                    
-                    msg->newMessageFast(_PREHASH_ObjectSelect);
-                    msg->nextBlockFast(_PREHASH_AgentData);
-                    msg->addUUIDFast(_PREHASH_AgentID, gAgentID);
-                    msg->addUUIDFast(_PREHASH_SessionID, gAgentSessionID);
-                    msg->nextBlockFast(_PREHASH_ObjectData);
-                    msg->addU32Fast(_PREHASH_ObjectLocalID, vo->getLocalID());
-                    msg->sendReliable(gAgentAvatarp->getRegion()->getHost());
-
-                    msg->newMessageFast(_PREHASH_ObjectDeselect);
-                    msg->nextBlockFast(_PREHASH_AgentData);
-                    msg->addUUIDFast(_PREHASH_AgentID, gAgentID);
-                    msg->addUUIDFast(_PREHASH_SessionID, gAgentSessionID);
-                    msg->nextBlockFast(_PREHASH_ObjectData);
-                    msg->addU32Fast(_PREHASH_ObjectLocalID, vo->getLocalID());
-                    msg->sendReliable(gAgentAvatarp->getRegion()->getHost());
+                    FSObjectPropertiesBroker::instance().requestProperties(played_by);
                 }
             }
             else
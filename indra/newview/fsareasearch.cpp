@@ -29,6 +29,7 @@
 
 #include "fsareasearch.h"
 
+#include "fsobjectpropertiesbroker.h"
 #include "llavatarnamecache.h"
 #include "llscrolllistctrl.h"
 #include "lllineeditor.h"
@@ -598,20 +599,19 @@ void FSAreaSearch::processRequestQueue()
             return;
         }
 
-        std::vector<U32> request_list;
+        uuid_vec_t request_list;
         bool need_continue = false;
 
         for (auto& object_it : mObjectDetails)
         {
             if (object_it.second.request == FSObjectProperties::NEED && object_it.second.region_handle == region_handle)
             {
-                request_list.push_back(object_it.second.local_id);
+                request_list.push_back(object_it.first);
                 object_it.second.request = FSObjectProperties::SENT;
                 mRegionRequests[region_handle]++;
                 if (mRegionRequests[region_handle] >= ((MAX_OBJECTS_PER_PACKET * 3) - 3))
                 {
-                    requestObjectProperties(request_list, true, regionp);
-                    requestObjectProperties(request_list, false, regionp);
+                    requestObjectProperties(request_list);
                     mRequestNeedsSent = true;
                     need_continue = true;
                     break;
@@ -626,55 +626,20 @@ void FSAreaSearch::processRequestQueue()
 
         if (!request_list.empty())
         {
-            requestObjectProperties(request_list, true, regionp);
-            requestObjectProperties(request_list, false, regionp);
+            requestObjectProperties(request_list);
         }
     }
 }
 
-void FSAreaSearch::requestObjectProperties(const std::vector<U32>& request_list, bool select, LLViewerRegion* regionp)
+void FSAreaSearch::requestObjectProperties(const uuid_vec_t& request_list)
 {
-    bool start_new_message = true;
-    S32 select_count = 0;
-    LLMessageSystem* msg = gMessageSystem;
-
+    // The broker packs these with requests from other consumers and paces them per region
+    FSObjectPropertiesBroker& broker = FSObjectPropertiesBroker::instance();
     for (const auto& id : request_list)
     {
-        if (start_new_message)
-        {
-            if (select)
-            {
-                msg->newMessageFast(_PREHASH_ObjectSelect);
-            }
-            else
-            {
-                msg->newMessageFast(_PREHASH_ObjectDeselect);
-            }
-            msg->nextBlockFast(_PREHASH_AgentData);
-            msg->addUUIDFast(_PREHASH_AgentID, gAgentID);
-            msg->addUUIDFast(_PREHASH_SessionID, gAgentSessionID);
-            select_count++;
-            start_new_message = false;
-        }
-
-        msg->nextBlockFast(_PREHASH_ObjectData);
-        msg->addU32Fast(_PREHASH_ObjectLocalID, id);
-        select_count++;
-
-        if (msg->isSendFull(NULL) || select_count >= MAX_OBJECTS_PER_PACKET)
-        {
-            LL_DEBUGS("FSAreaSearch") << "Sent one full " << (select ? "ObjectSelect" : "ObjectDeselect") << " message with " << select_count << " object data blocks." << LL_ENDL;
-            msg->sendReliable(regionp->getHost());
-            select_count = 0;
-            start_new_message = true;
-        }
-    }
-
-    if (!start_new_message)
-    {
-        LL_DEBUGS("FSAreaSearch") << "Sent one partcial " << (select ? "ObjectSelect" : "ObjectDeselect") << " message with " << select_count << " object data blocks." << LL_ENDL;
-        msg->sendReliable(regionp->getHost());
+        broker.requestProperties(id);
     }
+    LL_DEBUGS("FSAreaSearch") << "Queued " << request_list.size() << " property requests." << LL_ENDL;
 }
 
 void FSAreaSearch::processObjectProperties(LLMessageSystem* msg)
@@ -170,7 +170,7 @@ public:
     bool isActive() { return mActive; }
 
 private:
-    void requestObjectProperties(const std::vector< U32 >& request_list, bool select, LLViewerRegion* regionp);
+    void requestObjectProperties(const uuid_vec_t& request_list);
     void matchObject(FSObjectProperties& details, LLViewerObject* objectp);
     void getNameFromUUID(const LLUUID& id, std::string& name, bool group, bool& name_requested);
 
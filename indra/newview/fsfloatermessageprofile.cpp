@@ -0,0 +1,141 @@
+/** 
+ * @file fsfloatermessageprofile.cpp
+ * @brief Per-message UDP handler profile
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fsfloatermessageprofile.h"
+
+#include "llbutton.h"
+#include "llfilepicker.h"
+#include "llscrolllistctrl.h"
+#include "llviewermenufile.h"
+#include "message.h"
+
+#include <fstream>
+
+static const F32 REFRESH_INTERVAL = 1.f;
+
+FSFloaterMessageProfile::FSFloaterMessageProfile(const LLSD& key)
+    : LLFloater(key),
+    mResultList(nullptr)
+{
+}
+
+BOOL FSFloaterMessageProfile::postBuild()
+{
+    mResultList = getChild<LLScrollListCtrl>("result_list");
+    mResultList->sortByColumn("total_ms", FALSE);
+
+    getChild<LLButton>("reset_btn")->setCommitCallback(boost::bind(&FSFloaterMessageProfile::onClickReset, this));
+    getChild<LLButton>("save_btn")->setCommitCallback(boost::bind(&FSFloaterMessageProfile::onClickSave, this));
+
+    return TRUE;
+}
+
+void FSFloaterMessageProfile::onOpen(const LLSD& key)
+{
+    refreshList();
+}
+
+void FSFloaterMessageProfile::draw()
+{
+    if (mRefreshTimer.getElapsedTimeF32() > REFRESH_INTERVAL)
+    {
+        refreshList();
+    }
+
+    LLFloater::draw();
+}
+
+void FSFloaterMessageProfile::refreshList()
+{
+    mRefreshTimer.reset();
+    if (!gMessageSystem || !mResultList)
+    {
+        return;
+    }
+
+    LLMessageSystem::handler_profile_vec_t profile;
+    gMessageSystem->getHandlerProfile(profile);
+
+    const std::string selected = mResultList->getSelectedValue().asString();
+    const S32 scroll_pos = mResultList->getScrollPos();
+
+    mResultList->deleteAllItems();
+    for (const LLMessageSystem::HandlerProfile& entry : profile)
+    {
+        LLScrollListItem::Params item;
+        item.value = entry.mName;
+        item.columns.add().column("message").value(entry.mName);
+        item.columns.add().column("count").value((S32)entry.mCount);
+        item.columns.add().column("total_ms").value(llformat("%.2f", entry.mTotalTime * 1000.0));
+        item.columns.add().column("max_ms").value(llformat("%.3f", entry.mMaxTime * 1000.0));
+        item.columns.add().column("avg_ms").value(llformat("%.4f", entry.mTotalTime * 1000.0 / (F64)entry.mCount));
+        item.columns.add().column("bytes").value(LLSD::Integer(llmin(entry.mBytes, (U64)S32_MAX)));
+        mResultList->addRow(item);
+    }
+
+    mResultList->updateSort();
+    if (!selected.empty())
+    {
+        mResultList->selectByValue(selected);
+    }
+    mResultList->setScrollPos(scroll_pos);
+}
+
+void FSFloaterMessageProfile::onClickReset()
+{
+    if (gMessageSystem)
+    {
+        gMessageSystem->resetHandlerProfile();
+    }
+    refreshList();
+}
+
+void FSFloaterMessageProfile::onClickSave()
+{
+    (new LLFilePickerReplyThread(boost::bind(&FSFloaterMessageProfile::onSaveCallback, this, _1),
+        LLFilePicker::FFSAVE_CSV, "message_handler_profile.csv"))->getFile();
+}
+
+void FSFloaterMessageProfile::onSaveCallback(const std::vector<std::string>& filenames)
+{
+    if (filenames.empty() || !gMessageSystem)
+    {
+        return;
+    }
+
+    llofstream file(filenames[0].c_str());
+    if (!file.is_open())
+    {
+        LL_WARNS() << "Unable to write message handler profile to " << filenames[0] << LL_ENDL;
+        return;
+    }
+
+    gMessageSystem->dumpHandlerProfileCSV(file);
+    file.close();
+}
@@ -0,0 +1,58 @@
+/** 
+ * @file fsfloatermessageprofile.h
+ * @brief Per-message UDP handler profile
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_FLOATERMESSAGEPROFILE_H
+#define FS_FLOATERMESSAGEPROFILE_H
+
+#include "llfloater.h"
+#include "llframetimer.h"
+
+class LLScrollListCtrl;
+
+// Shows the per-template handler profile collected by LLMessageSystem
+// while FSProfileMessageHandlers is enabled.
+class FSFloaterMessageProfile : public LLFloater
+{
+public:
+    FSFloaterMessageProfile(const LLSD& key);
+    virtual ~FSFloaterMessageProfile() = default;
+
+    /*virtual*/ BOOL postBuild();
+    /*virtual*/ void onOpen(const LLSD& key);
+    /*virtual*/ void draw();
+
+private:
+    void refreshList();
+    void onClickReset();
+    void onClickSave();
+    void onSaveCallback(const std::vector<std::string>& filenames);
+
+    LLScrollListCtrl*   mResultList;
+    LLFrameTimer        mRefreshTimer;
+};
+
+#endif // FS_FLOATERMESSAGEPROFILE_H
@@ -0,0 +1,181 @@
+/** 
+ * @file fsframespikerecorder.cpp
+ * @brief Rolling per-frame timer capture with spike snapshots
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fsframespikerecorder.h"
+
+#include "llappviewer.h"
+#include "lldate.h"
+#include "lldir.h"
+#include "llfasttimer.h"
+#include "llmemory.h"
+#include "llsdserialize.h"
+#include "lltracerecording.h"
+#include "llviewercontrol.h"
+#include "llviewerstats.h"
+
+extern S32 gFullObjectUpdates;
+extern S32 gTerseObjectUpdates;
+
+// Don't flood the logs folder while the viewer is stuck in a slow patch
+static const F64 MIN_SNAPSHOT_INTERVAL = 10.0;
+static const U32 MAX_SNAPSHOTS_PER_SESSION = 25;
+// Timers below this self time are left out of the ring
+static const F32 MIN_TIMER_MS = 0.05f;
+
+FSFrameSpikeRecorder::FSFrameSpikeRecorder()
+:   mKnownTimerCount(0),
+    mLastFullObjectUpdates(gFullObjectUpdates),
+    mLastTerseObjectUpdates(gTerseObjectUpdates),
+    mLastSnapshotTime(0.0),
+    mNumSnapshots(0)
+{
+}
+
+void FSFrameSpikeRecorder::refreshTimerList()
+{
+    mTimers.clear();
+    for (auto& timer : LLTrace::BlockTimerStatHandle::instance_snapshot())
+    {
+        mTimers.push_back(static_cast<LLTrace::BlockTimerStatHandle*>(&timer));
+    }
+    mKnownTimerCount = LLTrace::BlockTimerStatHandle::instanceCount();
+    // Indices in the ring refer to the old list
+    mFrames.clear();
+}
+
+void FSFrameSpikeRecorder::recordFrame(LLTrace::Recording& last_frame)
+{
+    static LLCachedControl<F32> threshold_ms(gSavedSettings, "FSFrameSpikeThreshold");
+    static LLCachedControl<U32> history(gSavedSettings, "FSFrameSpikeHistory");
+
+    if (threshold_ms <= 0.f || history == 0)
+    {
+        if (!mFrames.empty())
+        {
+            mFrames.clear();
+        }
+        return;
+    }
+
+    if (LLTrace::BlockTimerStatHandle::instanceCount() != mKnownTimerCount)
+    {
+        refreshTimerList();
+    }
+
+    // Recycle the oldest sample to keep its timer vector allocation
+    FrameSample sample;
+    while (mFrames.size() >= history)
+    {
+        sample = std::move(mFrames.front());
+        mFrames.pop_front();
+    }
+
+    sample.mFrameNumber = gFrameCount;
+    sample.mFrameTimeMS = (F32)F64Milliseconds(last_frame.getDuration()).value();
+
+    S32 object_updates = (gFullObjectUpdates - mLastFullObjectUpdates) + (gTerseObjectUpdates - mLastTerseObjectUpdates);
+    mLastFullObjectUpdates = gFullObjectUpdates;
+    mLastTerseObjectUpdates = gTerseObjectUpdates;
+    sample.mObjectUpdates = (U32)llmax(object_updates, 0);
+    sample.mTexturesDecoded = (U32)last_frame.getSum(LLStatViewer::TEXTURES_DECODED);
+    sample.mPacketsIn = (U32)last_frame.getSum(LLStatViewer::PACKETS_IN);
+    sample.mMemoryKB = LLMemory::getAllocatedMemKB().value();
+
+    sample.mTimerTimes.clear();
+    for (U32 i = 0; i < mTimers.size(); ++i)
+    {
+        F32 self_ms = (F32)F64Milliseconds(last_frame.getSum(mTimers[i]->selfTime())).value();
+        if (self_ms >= MIN_TIMER_MS)
+        {
+            sample.mTimerTimes.push_back(std::make_pair(i, self_ms));
+        }
+    }
+
+    mFrames.push_back(std::move(sample));
+
+    const FrameSample& newest = mFrames.back();
+    if (newest.mFrameTimeMS > threshold_ms
+        && mNumSnapshots < MAX_SNAPSHOTS_PER_SESSION
+        && (mNumSnapshots == 0 || LLTimer::getTotalSeconds().value() - mLastSnapshotTime > MIN_SNAPSHOT_INTERVAL))
+    {
+        writeSnapshot(newest);
+    }
+}
+
+void FSFrameSpikeRecorder::writeSnapshot(const FrameSample& spike)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    mLastSnapshotTime = LLTimer::getTotalSeconds().value();
+    ++mNumSnapshots;
+
+    static LLCachedControl<F32> threshold_ms(gSavedSettings, "FSFrameSpikeThreshold");
+
+    LLSD snapshot;
+    snapshot["version"] = 1;
+    snapshot["threshold_ms"] = (F32)threshold_ms;
+    snapshot["spike_frame"] = (LLSD::Integer)spike.mFrameNumber;
+    snapshot["spike_ms"] = spike.mFrameTimeMS;
+    snapshot["date"] = LLDate::now();
+
+    LLSD& frames = snapshot["frames"];
+    for (const FrameSample& sample : mFrames)
+    {
+        LLSD frame;
+        frame["frame"] = (LLSD::Integer)sample.mFrameNumber;
+        frame["ms"] = sample.mFrameTimeMS;
+        frame["object_updates"] = (LLSD::Integer)sample.mObjectUpdates;
+        frame["textures_decoded"] = (LLSD::Integer)sample.mTexturesDecoded;
+        frame["packets_in"] = (LLSD::Integer)sample.mPacketsIn;
+        frame["memory_kb"] = (LLSD::Integer)sample.mMemoryKB;
+
+        LLSD timers = LLSD::emptyMap();
+        for (const auto& timer_time : sample.mTimerTimes)
+        {
+            timers[mTimers[timer_time.first]->getName()] = timer_time.second;
+        }
+        frame["timers"] = timers;
+        frames.append(frame);
+    }
+
+    std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS,
+        "frame_spike_" + LLDate::now().toHTTPDateString("%Y%m%d_%H%M%S") + llformat("_%u.llsd", spike.mFrameNumber));
+
+    llofstream out_file(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!out_file.is_open())
+    {
+        LL_WARNS() << "Unable to write frame spike snapshot " << filename << LL_ENDL;
+        return;
+    }
+    LLSDSerialize::toXML(snapshot, out_file);
+    out_file.close();
+
+    LL_INFOS() << "Frame " << spike.mFrameNumber << " took " << spike.mFrameTimeMS << " ms, wrote "
+        << mFrames.size() << " frames to " << filename << LL_ENDL;
+}
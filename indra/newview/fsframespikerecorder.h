@@ -0,0 +1,90 @@
+/** 
+ * @file fsframespikerecorder.h
+ * @brief Rolling per-frame timer capture with spike snapshots
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_FRAMESPIKERECORDER_H
+#define FS_FRAMESPIKERECORDER_H
+
+#include "llsingleton.h"
+
+#include <deque>
+
+namespace LLTrace
+{
+    class BlockTimerStatHandle;
+    class Recording;
+}
+
+// Keeps the last FSFrameSpikeHistory frames of block timer self times and a
+// few key counters in memory. Whenever a frame takes longer than
+// FSFrameSpikeThreshold milliseconds the whole ring is written to the logs
+// folder as frame_spike_*.llsd, so a one-off hitch can be looked at later
+// without a profiler attached. scripts/metrics/frame_spike_summary.py
+// summarises those files.
+class FSFrameSpikeRecorder
+    : public LLSingleton<FSFrameSpikeRecorder>
+{
+    LOG_CLASS(FSFrameSpikeRecorder);
+
+    LLSINGLETON(FSFrameSpikeRecorder);
+    virtual ~FSFrameSpikeRecorder() = default;
+
+public:
+    // Called once per frame with the recording of the frame that just ended
+    void recordFrame(LLTrace::Recording& last_frame);
+
+    U32 getNumSnapshots() const { return mNumSnapshots; }
+
+private:
+    struct FrameSample
+    {
+        U32 mFrameNumber;
+        F32 mFrameTimeMS;
+        U32 mObjectUpdates;
+        U32 mTexturesDecoded;
+        U32 mPacketsIn;
+        U32 mMemoryKB;
+        // index into mTimers, self time in ms
+        std::vector<std::pair<U32, F32> > mTimerTimes;
+    };
+
+    void refreshTimerList();
+    void writeSnapshot(const FrameSample& spike);
+
+    typedef std::deque<FrameSample> sample_ring_t;
+    sample_ring_t mFrames;
+
+    std::vector<LLTrace::BlockTimerStatHandle*> mTimers;
+    S32 mKnownTimerCount;
+
+    S32 mLastFullObjectUpdates;
+    S32 mLastTerseObjectUpdates;
+
+    F64 mLastSnapshotTime;
+    U32 mNumSnapshots;
+};
+
+#endif // FS_FRAMESPIKERECORDER_H
@@ -0,0 +1,331 @@
+/** 
+ * @file fsobjectpropertiesbroker.cpp
+ * @brief Shared, throttled ObjectProperties and ObjectPropertiesFamily requests
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fsobjectpropertiesbroker.h"
+
+#include "llagent.h"
+#include "llcallbacklist.h"
+#include "llframetimer.h"
+#include "llviewercontrol.h"
+#include "llviewerobject.h"
+#include "llviewerobjectlist.h"
+#include "llviewerregion.h"
+#include "llworld.h"
+#include "message.h"
+
+static const S32 MAX_OBJECTS_PER_PACKET = 255;
+static const F64 REQUEST_TIMEOUT = 30.0;            // seconds before an unanswered request may be sent again
+static const F32 SELECT_HEADER_BITS = 8.f * 48.f;   // packet header and AgentData block
+static const F32 SELECT_OBJECT_BITS = 8.f * 4.f;    // one ObjectLocalID
+static const F32 FAMILY_REQUEST_BITS = 8.f * 68.f;
+// Most a region's throttle can save up while nothing is queued, same as LLThrottle's lookahead
+static const F32 MAX_BURST_SECONDS = 0.25f;
+
+FSObjectPropertiesBroker::RegionQueue::RegionQueue()
+:   mThrottle((F32)gSavedSettings.getU32("FSObjectPropertiesRequestBPS"))
+{
+}
+
+FSObjectPropertiesBroker::FSObjectPropertiesBroker()
+{
+    gIdleCallbacks.addFunction(onIdle, this);
+}
+
+FSObjectPropertiesBroker::~FSObjectPropertiesBroker()
+{
+    gIdleCallbacks.deleteFunction(onIdle, this);
+}
+
+bool FSObjectPropertiesBroker::requestProperties(const LLUUID& object_id)
+{
+    if (mPropertiesQueued.count(object_id) || mPropertiesInFlight.count(object_id))
+    {
+        return false;
+    }
+
+    LLViewerObject* objectp = gObjectList.findObject(object_id);
+    if (!objectp || objectp->isDead() || !objectp->getRegion())
+    {
+        return false;
+    }
+
+    mRegionQueues[objectp->getRegion()->getHandle()].mProperties.push_back(object_id);
+    mPropertiesQueued.insert(object_id);
+    return true;
+}
+
+bool FSObjectPropertiesBroker::requestPropertiesFamily(const LLUUID& object_id, U32 request_flags)
+{
+    family_request_t request(object_id, request_flags);
+    if (mFamilyQueued.count(request) || mFamilyInFlight.count(request))
+    {
+        return false;
+    }
+
+    LLViewerObject* objectp = gObjectList.findObject(object_id);
+    if (!objectp || objectp->isDead() || !objectp->getRegion())
+    {
+        return false;
+    }
+
+    mRegionQueues[objectp->getRegion()->getHandle()].mFamily.push_back(request);
+    mFamilyQueued.insert(request);
+    return true;
+}
+
+bool FSObjectPropertiesBroker::isPending(const LLUUID& object_id) const
+{
+    return mPropertiesQueued.count(object_id) || mPropertiesInFlight.count(object_id);
+}
+
+S32 FSObjectPropertiesBroker::getNumQueued() const
+{
+    return (S32)(mPropertiesQueued.size() + mFamilyQueued.size());
+}
+
+void FSObjectPropertiesBroker::processObjectProperties(LLMessageSystem* msg)
+{
+    S32 count = msg->getNumberOfBlocksFast(_PREHASH_ObjectData);
+    for (S32 i = 0; i < count; ++i)
+    {
+        LLUUID object_id;
+        msg->getUUIDFast(_PREHASH_ObjectData, _PREHASH_ObjectID, object_id, i);
+        if (mPropertiesInFlight.erase(object_id))
+        {
+            mPropertiesReceivedSignal(object_id);
+        }
+    }
+}
+
+void FSObjectPropertiesBroker::processObjectPropertiesFamily(LLMessageSystem* msg)
+{
+    U32 request_flags;
+    LLUUID object_id;
+    msg->getU32Fast(_PREHASH_ObjectData, _PREHASH_RequestFlags, request_flags);
+    msg->getUUIDFast(_PREHASH_ObjectData, _PREHASH_ObjectID, object_id);
+    if (mFamilyInFlight.erase(family_request_t(object_id, request_flags)))
+    {
+        mFamilyReceivedSignal(object_id, request_flags);
+    }
+}
+
+// static
+void FSObjectPropertiesBroker::onIdle(void* user_data)
+{
+    FSObjectPropertiesBroker* self = (FSObjectPropertiesBroker*)user_data;
+    self->sendRequests();
+}
+
+void FSObjectPropertiesBroker::sendRequests()
+{
+    const F64 now = LLFrameTimer::getElapsedSeconds();
+    expireRequests(now);
+
+    if (mRegionQueues.empty())
+    {
+        return;
+    }
+
+    for (region_queue_map_t::iterator iter = mRegionQueues.begin(); iter != mRegionQueues.end(); )
+    {
+        RegionQueue& queue = iter->second;
+        LLViewerRegion* regionp = LLWorld::getInstance()->getRegionFromHandle(iter->first);
+        if (!regionp)
+        {
+            // Region went away, its objects with it
+            for (const LLUUID& id : queue.mProperties)
+            {
+                mPropertiesQueued.erase(id);
+            }
+            for (const family_request_t& request : queue.mFamily)
+            {
+                mFamilyQueued.erase(request);
+            }
+            iter = mRegionQueues.erase(iter);
+            continue;
+        }
+
+        // Hover tips are waiting on family requests, serve them first
+        sendFamilyRequests(regionp, queue, now);
+        sendPropertiesRequests(regionp, queue, now);
+
+        // The queue stays while the region is around, even when empty, so
+        // its throttle keeps pacing the next burst of requests
+        ++iter;
+    }
+}
+
+void FSObjectPropertiesBroker::sendPropertiesRequests(LLViewerRegion* regionp, RegionQueue& queue, F64 now)
+{
+    while (!queue.mProperties.empty())
+    {
+        // Both the select and the deselect count against the throttle. An
+        // idle throttle only allows a short burst; when it is that full at
+        // least one object goes out, however low the rate.
+        const F32 max_available = queue.mThrottle.getRate() * MAX_BURST_SECONDS;
+        const F32 available = llmin(queue.mThrottle.getAvailable(), max_available);
+        S32 budget = (S32)((available * 0.5f - SELECT_HEADER_BITS) / SELECT_OBJECT_BITS);
+        if (available >= max_available)
+        {
+            budget = llmax(budget, 1);
+        }
+        if (budget <= 0)
+        {
+            return;
+        }
+        budget = llmin(budget, MAX_OBJECTS_PER_PACKET);
+
+        std::vector<U32> select_ids;
+        std::vector<U32> deselect_ids;
+        while (!queue.mProperties.empty() && (S32)select_ids.size() < budget)
+        {
+            LLUUID object_id = queue.mProperties.front();
+            queue.mProperties.pop_front();
+            mPropertiesQueued.erase(object_id);
+
+            LLViewerObject* objectp = gObjectList.findObject(object_id);
+            if (!objectp || objectp->isDead() || objectp->getRegion() != regionp)
+            {
+                // Gone, or moved to another region since it was queued
+                continue;
+            }
+
+            select_ids.push_back(objectp->getLocalID());
+            if (!objectp->isSelected())
+            {
+                // Don't drop the user's own selection on the sim
+                deselect_ids.push_back(objectp->getLocalID());
+            }
+            mPropertiesInFlight[object_id] = now + REQUEST_TIMEOUT;
+        }
+
+        if (select_ids.empty())
+        {
+            continue;
+        }
+
+        sendSelect(regionp, select_ids, true);
+        sendSelect(regionp, deselect_ids, false);
+        queue.mThrottle.throttleOverflow(2.f * SELECT_HEADER_BITS + (select_ids.size() + deselect_ids.size()) * SELECT_OBJECT_BITS);
+    }
+}
+
+void FSObjectPropertiesBroker::sendFamilyRequests(LLViewerRegion* regionp, RegionQueue& queue, F64 now)
+{
+    LLMessageSystem* msg = gMessageSystem;
+    while (!queue.mFamily.empty() && !queue.mThrottle.checkOverflow(FAMILY_REQUEST_BITS))
+    {
+        family_request_t request = queue.mFamily.front();
+        queue.mFamily.pop_front();
+        mFamilyQueued.erase(request);
+
+        LLViewerObject* objectp = gObjectList.findObject(request.first);
+        if (!objectp || objectp->isDead() || objectp->getRegion() != regionp)
+        {
+            continue;
+        }
+
+        // The message carries a single object, no packing possible
+        msg->newMessageFast(_PREHASH_RequestObjectPropertiesFamily);
+        msg->nextBlockFast(_PREHASH_AgentData);
+        msg->addUUIDFast(_PREHASH_AgentID, gAgent.getID());
+        msg->addUUIDFast(_PREHASH_SessionID, gAgent.getSessionID());
+        msg->nextBlockFast(_PREHASH_ObjectData);
+        msg->addU32Fast(_PREHASH_RequestFlags, request.second);
+        msg->addUUIDFast(_PREHASH_ObjectID, request.first);
+        msg->sendReliable(regionp->getHost());
+
+        queue.mThrottle.throttleOverflow(FAMILY_REQUEST_BITS);
+        mFamilyInFlight[request] = now + REQUEST_TIMEOUT;
+    }
+}
+
+void FSObjectPropertiesBroker::sendSelect(LLViewerRegion* regionp, const std::vector<U32>& local_ids, bool select)
+{
+    if (local_ids.empty())
+    {
+        return;
+    }
+
+    LLMessageSystem* msg = gMessageSystem;
+    bool start_new_message = true;
+    for (U32 local_id : local_ids)
+    {
+        if (start_new_message)
+        {
+            msg->newMessageFast(select ? _PREHASH_ObjectSelect : _PREHASH_ObjectDeselect);
+            msg->nextBlockFast(_PREHASH_AgentData);
+            msg->addUUIDFast(_PREHASH_AgentID, gAgent.getID());
+            msg->addUUIDFast(_PREHASH_SessionID, gAgent.getSessionID());
+            start_new_message = false;
+        }
+
+        msg->nextBlockFast(_PREHASH_ObjectData);
+        msg->addU32Fast(_PREHASH_ObjectLocalID, local_id);
+
+        if (msg->isSendFull(NULL))
+        {
+            msg->sendReliable(regionp->getHost());
+            start_new_message = true;
+        }
+    }
+
+    if (!start_new_message)
+    {
+        msg->sendReliable(regionp->getHost());
+    }
+}
+
+void FSObjectPropertiesBroker::expireRequests(F64 now)
+{
+    for (std::map<LLUUID, F64>::iterator iter = mPropertiesInFlight.begin(); iter != mPropertiesInFlight.end(); )
+    {
+        if (iter->second <= now)
+        {
+            LL_DEBUGS("ObjectProperties") << "No properties received for " << iter->first << LL_ENDL;
+            iter = mPropertiesInFlight.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    for (std::map<family_request_t, F64>::iterator iter = mFamilyInFlight.begin(); iter != mFamilyInFlight.end(); )
+    {
+        if (iter->second <= now)
+        {
+            iter = mFamilyInFlight.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/** 
+ * @file fsobjectpropertiesbroker.h
+ * @brief Shared, throttled ObjectProperties and ObjectPropertiesFamily requests
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_OBJECTPROPERTIESBROKER_H
+#define FS_OBJECTPROPERTIESBROKER_H
+
+#include "llsingleton.h"
+#include "llthrottle.h"
+#include "lluuid.h"
+
+#include <boost/signals2.hpp>
+#include <deque>
+
+class LLMessageSystem;
+class LLViewerObject;
+class LLViewerRegion;
+
+// Area search, permission tracking, animation explorer and hover tips all
+// need object properties the viewer does not have yet. Instead of each of them
+// sending its own ObjectSelect/ObjectDeselect or RequestObjectPropertiesFamily
+// messages, requests are queued here per region, deduplicated while a reply is
+// outstanding, packed into as few messages as possible and paced by a throttle
+// per region. Replies still reach every consumer through the usual message
+// handlers; listeners can also subscribe to the callbacks below.
+class FSObjectPropertiesBroker
+    : public LLSingleton<FSObjectPropertiesBroker>
+{
+    LOG_CLASS(FSObjectPropertiesBroker);
+
+    LLSINGLETON(FSObjectPropertiesBroker);
+    virtual ~FSObjectPropertiesBroker();
+
+public:
+    // Request ObjectProperties through a transient select. Returns false if a
+    // request for the object is already queued or waiting for its reply.
+    bool requestProperties(const LLUUID& object_id);
+
+    // Request ObjectPropertiesFamily. Requests with different flags are
+    // separate, since consumers tell the replies apart by their flags.
+    bool requestPropertiesFamily(const LLUUID& object_id, U32 request_flags = 0);
+
+    bool isPending(const LLUUID& object_id) const;
+
+    void processObjectProperties(LLMessageSystem* msg);
+    void processObjectPropertiesFamily(LLMessageSystem* msg);
+
+    typedef boost::signals2::signal<void(const LLUUID& object_id)> properties_received_signal_t;
+    boost::signals2::connection setPropertiesReceivedCallback(const properties_received_signal_t::slot_type& cb)
+    {
+        return mPropertiesReceivedSignal.connect(cb);
+    }
+
+    typedef boost::signals2::signal<void(const LLUUID& object_id, U32 request_flags)> family_received_signal_t;
+    boost::signals2::connection setFamilyReceivedCallback(const family_received_signal_t::slot_type& cb)
+    {
+        return mFamilyReceivedSignal.connect(cb);
+    }
+
+    S32 getNumQueued() const;
+    S32 getNumInFlight() const { return (S32)(mPropertiesInFlight.size() + mFamilyInFlight.size()); }
+
+private:
+    typedef std::pair<LLUUID, U32> family_request_t;
+
+    // Kept until the region goes away, so the throttle paces every burst
+    struct RegionQueue
+    {
+        RegionQueue();
+
+        std::deque<LLUUID>              mProperties;
+        std::deque<family_request_t>    mFamily;
+        LLThrottle                      mThrottle;
+    };
+    typedef std::map<U64, RegionQueue> region_queue_map_t;
+
+    static void onIdle(void* user_data);
+    void sendRequests();
+    void sendPropertiesRequests(LLViewerRegion* regionp, RegionQueue& queue, F64 now);
+    void sendFamilyRequests(LLViewerRegion* regionp, RegionQueue& queue, F64 now);
+    void sendSelect(LLViewerRegion* regionp, const std::vector<U32>& local_ids, bool select);
+    void expireRequests(F64 now);
+
+    region_queue_map_t                  mRegionQueues;  // by region handle
+    uuid_set_t                          mPropertiesQueued;
+    std::set<family_request_t>          mFamilyQueued;
+    std::map<LLUUID, F64>               mPropertiesInFlight; // object id -> time the request expires
+    std::map<family_request_t, F64>     mFamilyInFlight;
+
+    properties_received_signal_t        mPropertiesReceivedSignal;
+    family_received_signal_t            mFamilyReceivedSignal;
+};
+
+#endif // FS_OBJECTPROPERTIESBROKER_H
@@ -0,0 +1,334 @@
+/** 
+ * @file fsstatsrecorder.cpp
+ * @brief Per-frame binary recording of LLTrace stats
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "fsstatsrecorder.h"
+
+#include "llappviewer.h"
+#include "lldate.h"
+#include "lldir.h"
+#include "llfasttimer.h"
+#include "lltracerecording.h"
+#include "llviewercontrol.h"
+#include "threadpool.h"
+
+#include <boost/tokenizer.hpp>
+
+#ifdef LL_USESYSTEMLIBS
+#include <zlib.h>
+#else
+#include "zlib-ng/zlib.h"
+#endif
+
+static const char STATS_FILE_MAGIC[8] = { 'F', 'S', 'S', 'T', 'A', 'T', 'S', 0 };
+static const U32 STATS_FILE_VERSION = 1;
+static const U32 STATS_BLOCK_FRAMES = 256;
+static const U8 CHUNK_COLUMNS = 'C';
+static const U8 CHUNK_BLOCK = 'B';
+
+typedef std::vector<U8> stats_buffer_t;
+
+// All supported viewer platforms are little endian, so values are copied
+// out as they are laid out in memory.
+template<typename T>
+static void append_value(stats_buffer_t& buffer, const T& value)
+{
+    const U8* bytes = (const U8*)&value;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static void append_values(stats_buffer_t& buffer, const T* values, U32 count)
+{
+    const U8* bytes = (const U8*)values;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T) * count);
+}
+
+static void append_string(stats_buffer_t& buffer, const std::string& str)
+{
+    U16 length = (U16)llmin(str.size(), (size_t)U16_MAX);
+    append_value(buffer, length);
+    buffer.insert(buffer.end(), str.begin(), str.begin() + length);
+}
+
+static void append_chunk_header(stats_buffer_t& buffer, U8 type, U32 size)
+{
+    append_value(buffer, type);
+    append_value(buffer, size);
+}
+
+static S32 get_stat_count()
+{
+    return LLTrace::StatType<LLTrace::CountAccumulator>::instanceCount()
+        + LLTrace::StatType<LLTrace::SampleAccumulator>::instanceCount()
+        + LLTrace::StatType<LLTrace::EventAccumulator>::instanceCount()
+        + LLTrace::StatType<LLTrace::MemAccumulator>::instanceCount()
+        + LLTrace::StatType<LLTrace::TimeBlockAccumulator>::instanceCount();
+}
+
+FSStatsRecorder::FSStatsRecorder()
+:   mWriter(NULL),
+    mKnownStatCount(0),
+    mBlockFrames(0),
+    mStartTime(0.0),
+    mTotalFrames(0)
+{
+}
+
+FSStatsRecorder::~FSStatsRecorder()
+{
+    stop();
+}
+
+void FSStatsRecorder::cleanupSingleton()
+{
+    stop();
+}
+
+bool FSStatsRecorder::start()
+{
+    mFilename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS,
+        "stats_" + LLDate::now().toHTTPDateString("%Y%m%d_%H%M%S") + ".fsstats");
+
+    mFile = std::make_shared<llofstream>(mFilename.c_str(), std::ios::out | std::ios::binary);
+    if (!mFile->is_open())
+    {
+        LL_WARNS() << "Unable to write stats recording " << mFilename << LL_ENDL;
+        mFile.reset();
+        return false;
+    }
+
+    stats_buffer_t header;
+    header.insert(header.end(), STATS_FILE_MAGIC, STATS_FILE_MAGIC + sizeof(STATS_FILE_MAGIC));
+    append_value(header, STATS_FILE_VERSION);
+    mFile->write((const char*)&header[0], header.size());
+
+    mWriter = new LL::ThreadPool("StatsRecorder", 1);
+    mWriter->start();
+
+    mStartTime = LLTimer::getTotalSeconds().value();
+    mTotalFrames = 0;
+    mBlockFrames = 0;
+    refreshColumns();
+
+    LL_INFOS() << "Recording stats to " << mFilename << LL_ENDL;
+    return true;
+}
+
+void FSStatsRecorder::stop()
+{
+    if (!mFile)
+    {
+        return;
+    }
+
+    flushBlock();
+
+    // Closing the pool lets the writer finish the queued blocks first
+    mWriter->close();
+    delete mWriter;
+    mWriter = NULL;
+
+    mFile->close();
+    mFile.reset();
+    mColumns.clear();
+
+    LL_INFOS() << "Recorded " << mTotalFrames << " frames to " << mFilename << LL_ENDL;
+}
+
+void FSStatsRecorder::refreshColumns()
+{
+    static LLCachedControl<std::string> timer_names(gSavedSettings, "FSStatsRecordingTimers");
+
+    flushBlock();
+
+    mColumns.clear();
+    for (auto& stat : LLTrace::StatType<LLTrace::CountAccumulator>::instance_snapshot())
+    {
+        mColumns.push_back({ &stat, COLUMN_COUNT });
+    }
+    for (auto& stat : LLTrace::StatType<LLTrace::SampleAccumulator>::instance_snapshot())
+    {
+        mColumns.push_back({ &stat, COLUMN_SAMPLE });
+    }
+    for (auto& stat : LLTrace::StatType<LLTrace::EventAccumulator>::instance_snapshot())
+    {
+        mColumns.push_back({ &stat, COLUMN_EVENT });
+    }
+    for (auto& stat : LLTrace::StatType<LLTrace::MemAccumulator>::instance_snapshot())
+    {
+        mColumns.push_back({ &stat, COLUMN_MEMORY });
+    }
+
+    typedef boost::tokenizer<boost::char_separator<char> > tokenizer_t;
+    std::string names = timer_names;
+    tokenizer_t tokens(names, boost::char_separator<char>(","));
+    for (std::string name : tokens)
+    {
+        LLStringUtil::trim(name);
+        LLTrace::StatType<LLTrace::TimeBlockAccumulator>* timer = LLTrace::StatType<LLTrace::TimeBlockAccumulator>::getInstance(name).get();
+        if (timer)
+        {
+            mColumns.push_back({ timer, COLUMN_TIMER });
+        }
+    }
+    mKnownStatCount = get_stat_count();
+
+    mValues.resize(mColumns.size() * STATS_BLOCK_FRAMES);
+    mFrameNumbers.resize(STATS_BLOCK_FRAMES);
+    mFrameTimes.resize(STATS_BLOCK_FRAMES);
+    mFrameMS.resize(STATS_BLOCK_FRAMES);
+
+    stats_buffer_t payload;
+    append_value(payload, (U32)mColumns.size());
+    for (const Column& column : mColumns)
+    {
+        append_value(payload, column.mKind);
+        append_string(payload, column.mStat->getName());
+        append_string(payload, column.mKind == COLUMN_TIMER ? std::string("ms") : std::string(column.mStat->getUnitLabel()));
+    }
+
+    auto chunk = std::make_shared<stats_buffer_t>();
+    append_chunk_header(*chunk, CHUNK_COLUMNS, (U32)payload.size());
+    chunk->insert(chunk->end(), payload.begin(), payload.end());
+
+    std::shared_ptr<llofstream> file = mFile;
+    mWriter->getQueue().post([file, chunk]()
+        {
+            file->write((const char*)&(*chunk)[0], chunk->size());
+        });
+}
+
+void FSStatsRecorder::recordFrame(LLTrace::Recording& last_frame)
+{
+    static LLCachedControl<bool> recording(gSavedSettings, "FSStatsRecording");
+
+    if (recording != isRecording())
+    {
+        if (!recording)
+        {
+            stop();
+            return;
+        }
+        if (!start())
+        {
+            gSavedSettings.setBOOL("FSStatsRecording", FALSE);
+            return;
+        }
+    }
+    if (!recording)
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED;
+
+    if (get_stat_count() != mKnownStatCount)
+    {
+        refreshColumns();
+    }
+
+    mFrameNumbers[mBlockFrames] = gFrameCount;
+    mFrameTimes[mBlockFrames] = LLTimer::getTotalSeconds().value() - mStartTime;
+    mFrameMS[mBlockFrames] = (F32)F64Milliseconds(last_frame.getDuration()).value();
+
+    F32* value = mValues.data() + mBlockFrames;
+    for (const Column& column : mColumns)
+    {
+        F64 v = 0.0;
+        switch (column.mKind)
+        {
+        case COLUMN_COUNT:
+            v = last_frame.getSum(*static_cast<const LLTrace::StatType<LLTrace::CountAccumulator>*>(column.mStat));
+            break;
+        case COLUMN_SAMPLE:
+            v = last_frame.getLastValue(*static_cast<const LLTrace::StatType<LLTrace::SampleAccumulator>*>(column.mStat));
+            break;
+        case COLUMN_EVENT:
+            v = last_frame.getMean(*static_cast<const LLTrace::StatType<LLTrace::EventAccumulator>*>(column.mStat));
+            break;
+        case COLUMN_MEMORY:
+            v = last_frame.getLastValue(*static_cast<const LLTrace::StatType<LLTrace::MemAccumulator>*>(column.mStat)).value();
+            break;
+        case COLUMN_TIMER:
+            v = F64Milliseconds(last_frame.getSum(*static_cast<const LLTrace::StatType<LLTrace::TimeBlockAccumulator>*>(column.mStat))).value();
+            break;
+        }
+        *value = (F32)v;
+        value += STATS_BLOCK_FRAMES;
+    }
+
+    ++mTotalFrames;
+    if (++mBlockFrames == STATS_BLOCK_FRAMES)
+    {
+        flushBlock();
+    }
+}
+
+void FSStatsRecorder::flushBlock()
+{
+    if (!mBlockFrames || !mFile)
+    {
+        mBlockFrames = 0;
+        return;
+    }
+
+    // Pack the filled part of each column back to back
+    auto raw = std::make_shared<stats_buffer_t>();
+    raw->reserve(mBlockFrames * (sizeof(U32) + sizeof(F64) + sizeof(F32) * (mColumns.size() + 1)));
+    append_values(*raw, &mFrameNumbers[0], mBlockFrames);
+    append_values(*raw, &mFrameTimes[0], mBlockFrames);
+    append_values(*raw, &mFrameMS[0], mBlockFrames);
+    for (U32 i = 0; i < mColumns.size(); ++i)
+    {
+        append_values(*raw, &mValues[i * STATS_BLOCK_FRAMES], mBlockFrames);
+    }
+    U32 frames = mBlockFrames;
+    mBlockFrames = 0;
+
+    std::shared_ptr<llofstream> file = mFile;
+    mWriter->getQueue().post([file, raw, frames]()
+        {
+            uLongf compressed_size = compressBound((uLong)raw->size());
+            stats_buffer_t chunk(1 + 4 + 4 + 4 + compressed_size);
+            if (compress2(&chunk[13], &compressed_size, &(*raw)[0], (uLong)raw->size(), Z_BEST_SPEED) != Z_OK)
+            {
+                LL_WARNS() << "Unable to compress stats block, dropping " << frames << " frames" << LL_ENDL;
+                return;
+            }
+            chunk.resize(13 + compressed_size);
+
+            U32 payload_size = (U32)(8 + compressed_size);
+            U32 raw_size = (U32)raw->size();
+            chunk[0] = CHUNK_BLOCK;
+            memcpy(&chunk[1], &payload_size, 4);
+            memcpy(&chunk[5], &frames, 4);
+            memcpy(&chunk[9], &raw_size, 4);
+            file->write((const char*)&chunk[0], chunk.size());
+        });
+}
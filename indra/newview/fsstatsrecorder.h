@@ -0,0 +1,119 @@
+/** 
+ * @file fsstatsrecorder.h
+ * @brief Per-frame binary recording of LLTrace stats
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef FS_STATSRECORDER_H
+#define FS_STATSRECORDER_H
+
+#include "llfile.h"
+#include "llsingleton.h"
+
+#include <memory>
+
+namespace LL
+{
+    class ThreadPool;
+}
+
+namespace LLTrace
+{
+    class Recording;
+    class StatBase;
+}
+
+// While FSStatsRecording is on, samples every LLTrace count, sample, event
+// and memory stat plus the block timers named in FSStatsRecordingTimers once
+// per frame and appends them to logs/stats_*.fsstats. Values are gathered a
+// column per stat and written in blocks of STATS_BLOCK_FRAMES frames, each
+// zlib compressed on a writer thread so the frame loop only pays for the
+// lookups. scripts/metrics/stats_recording_conv.py turns a recording into
+// CSV for comparing builds over the same session.
+//
+// File layout, all little endian:
+//   "FSSTATS" 0, U32 version
+//   then chunks of U8 type, U32 payload size, payload:
+//   'C' columns: U32 count, then per column U8 kind, U16 name length, name,
+//       U16 unit length, unit. Applies to the blocks that follow it; a new
+//       one is written when stats are registered mid-session.
+//   'B' block: U32 frames, U32 raw size, then the zlib compressed columns:
+//       U32 frame number[frames], F64 seconds since start[frames],
+//       F32 frame ms[frames], then F32 value[frames] for each column.
+class FSStatsRecorder
+    : public LLSingleton<FSStatsRecorder>
+{
+    LOG_CLASS(FSStatsRecorder);
+
+    LLSINGLETON(FSStatsRecorder);
+    virtual ~FSStatsRecorder();
+
+public:
+    enum EColumnKind
+    {
+        COLUMN_COUNT = 0,   // sum over the frame
+        COLUMN_SAMPLE,      // last sampled value
+        COLUMN_EVENT,       // mean of the frame's events, NaN if there were none
+        COLUMN_MEMORY,      // last value in KB
+        COLUMN_TIMER        // total time in ms, children included
+    };
+
+    // Called once per frame with the recording of the frame that just ended
+    void recordFrame(LLTrace::Recording& last_frame);
+
+    bool isRecording() const { return (bool)mFile; }
+
+    /*virtual*/ void cleanupSingleton();
+
+private:
+    struct Column
+    {
+        const LLTrace::StatBase* mStat;
+        U8 mKind;
+    };
+
+    bool start();
+    void stop();
+    void refreshColumns();
+    void flushBlock();
+
+    std::shared_ptr<llofstream> mFile;
+    LL::ThreadPool* mWriter;
+    std::string mFilename;
+
+    std::vector<Column> mColumns;
+    S32 mKnownStatCount;
+
+    // column major, STATS_BLOCK_FRAMES values per column
+    std::vector<U32> mFrameNumbers;
+    std::vector<F64> mFrameTimes;
+    std::vector<F32> mFrameMS;
+    std::vector<F32> mValues;
+    U32 mBlockFrames;
+
+    F64 mStartTime;
+    U32 mTotalFrames;
+};
+
+#endif // FS_STATSRECORDER_H
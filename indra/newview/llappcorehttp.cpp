@@ -459,6 +459,53 @@ void LLAppCoreHttp::refreshSettings(bool initial)
                     mHttpClasses[app_policy].mPipelined = to_pipeline;
                 }
             }
+
+            // HTTP/2 multiplexing for the CDN-served classes
+            static const std::string http2_streams("FSHttp2Streams");
+            if (init_data[i].mPipelined && gSavedSettings.controlExists(http2_streams))
+            {
+                const long streams(gSavedSettings.getU32(http2_streams));
+                if (streams)
+                {
+                    LLCore::HttpHandle handle;
+                    handle = mRequest->setPolicyOption(LLCore::HttpRequest::PO_HTTP2_STREAMS,
+                                                       mHttpClasses[app_policy].mPolicy,
+                                                       streams,
+                                                       LLCore::HttpHandler::ptr_t());
+                    if (LLCORE_HTTP_HANDLE_INVALID == handle)
+                    {
+                        status = mRequest->getStatus();
+                        LL_WARNS("Init") << "Unable to set " << init_data[i].mUsage
+                                         << " HTTP/2 streams.  Reason:  " << status.toString()
+                                         << LL_ENDL;
+                    }
+                    else
+                    {
+                        LL_INFOS("Init") << "HTTP/2 multiplexing enabled for " << init_data[i].mUsage
+                                         << ", " << streams << " streams per connection" << LL_ENDL;
+                    }
+                }
+            }
+
+            // Adaptive concurrency, the class limit becomes a ceiling
+            static const std::string adaptive_concurrency("FSHttpAdaptiveConcurrency");
+            if (init_data[i].mPipelined
+                && gSavedSettings.controlExists(adaptive_concurrency)
+                && gSavedSettings.getBOOL(adaptive_concurrency))
+            {
+                LLCore::HttpHandle handle;
+                handle = mRequest->setPolicyOption(LLCore::HttpRequest::PO_ADAPTIVE_CONCURRENCY,
+                                                   mHttpClasses[app_policy].mPolicy,
+                                                   1L,
+                                                   LLCore::HttpHandler::ptr_t());
+                if (LLCORE_HTTP_HANDLE_INVALID == handle)
+                {
+                    status = mRequest->getStatus();
+                    LL_WARNS("Init") << "Unable to set " << init_data[i].mUsage
+                                     << " adaptive concurrency.  Reason:  " << status.toString()
+                                     << LL_ENDL;
+                }
+            }
         }
         
         // Get target connection concurrency value
@@ -952,8 +952,8 @@ bool LLAppViewer::init()
         LLError::setFatalFunction([rc](const std::string&){ _exit(rc); });
     }
 
-    // <FS:Ansariel> Get rid of unused LLAllocator
-    //mAlloc.setProfilingEnabled(gSavedSettings.getBOOL("MemProfiling"));
+    LLAllocator::setSampleInterval(gSavedSettings.getU32("MemProfilingSampleInterval"));
+    mAlloc.setProfilingEnabled(gSavedSettings.getBOOL("MemProfiling"));
 
     // Initialize the non-LLCurl libcurl library.  Should be called
     // before consumers (LLTextureFetch).
@@ -208,8 +208,7 @@ public:
     // *NOTE:Mani Fix this for login abstraction!!
     void handleLoginComplete();
 
-    // <FS:Ansariel> Get rid of unused LLAllocator
-    //LLAllocator & getAllocator() { return mAlloc; }
+    LLAllocator & getAllocator() { return mAlloc; }
 
     // On LoginCompleted callback
     typedef boost::signals2::signal<void (void)> login_completed_signal_t;
@@ -350,8 +349,7 @@ private:
     bool mAgentRegionLastAlive;
     LLUUID mAgentRegionLastID;
 
-    // <FS:Ansariel> Get rid of unused LLAllocator
-    //LLAllocator mAlloc;
+    LLAllocator mAlloc;
 
     // llcorehttp library init/shutdown helper
     LLAppCoreHttp mAppCoreHttp;
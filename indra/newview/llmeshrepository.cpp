@@ -46,6 +46,7 @@
 #include "llmath.h"
 #include "llnotificationsutil.h"
 #include "llsd.h"
+#include "llsdutil.h"
 #include "llsdutil_math.h"
 #include "llsdserialize.h"
 #include "llthread.h"
@@ -261,6 +262,7 @@
 //     mLODReqQ                 mMutex        ro.repo.none [5], rw.repo.mMutex, rw.any.mMutex
 //     mUnavailableQ            mMutex        rw.repo.none [0], ro.main.none [5], rw.main.mMutex
 //     mLoadedQ                 mMutex        rw.repo.mMutex, ro.main.none [5], rw.main.mMutex
+//     mTangentMeshes           mMutex        rw.main.mMutex, rw.repo.mMutex
 //     mPendingLOD              mMutex        rw.repo.mMutex, rw.any.mMutex
 //     mGetMeshCapability       mMutex        rw.main.mMutex, ro.repo.mMutex (was:  [0])
 //     mGetMesh2Capability      mMutex        rw.main.mMutex, ro.repo.mMutex (was:  [0])
@@ -408,6 +410,8 @@ U32 LLMeshRepository::sMaxLockHoldoffs = 0;
     
 LLDeadmanTimer LLMeshRepository::sQuiescentTimer(15.0, false);  // true -> gather cpu metrics
 
+static LLTrace::MemStatHandle sMeshRepoMemStat("LLMeshRepository");
+
 namespace {
     // The NoOpDeletor is used when passing certain objects (generally the LLMeshUploadThread) 
     // in a smart pointer below for passage into the LLCore::Http libararies.  
@@ -856,8 +860,10 @@ LLMeshRepoThread::LLMeshRepoThread()
   mHttpLegacyPolicyClass(LLCore::HttpRequest::DEFAULT_POLICY_ID), // <FS:Ansariel> [UDP Assets]
   mHttpLargePolicyClass(LLCore::HttpRequest::DEFAULT_POLICY_ID),
   mLegacyGetMeshVersion(0), // <FS:Ansariel> [UDP Assets]
-  mHttpPriority(0)
+  mHttpPriority(0),
+  mHeaderFootprint(sMeshRepoMemStat)
 {
+    mHeaderFootprint.setCount(0);
     LLAppCoreHttp & app_core_http(LLAppViewer::instance()->getAppCoreHttp());
 
     mMutex = new LLMutex();
@@ -1992,7 +1998,11 @@ EMeshProcessingResult LLMeshRepoThread::headerReceived(const LLVolumeParams& mes
         {
             LLMutexLock lock(mHeaderMutex);
             mMeshHeaderSize[mesh_id] = header_size;
-            mMeshHeader[mesh_id] = header;
+            LLSD& entry = mMeshHeader[mesh_id];
+            size_t footprint = mHeaderFootprint.getBytes() - llsd_footprint(entry);
+            entry = header;
+            mHeaderFootprint.setBytes(footprint + llsd_footprint(entry));
+            mHeaderFootprint.setCount(mMeshHeader.size());
             LLMeshRepository::sCacheBytesHeaders += header_size;
         }
 
@@ -2043,6 +2053,20 @@ EMeshProcessingResult LLMeshRepoThread::lodReceived(const LLVolumeParams& mesh_p
     {
         if (volume->getNumFaces() > 0)
         {
+            bool gen_tangents = false;
+            {
+                LLMutexLock lock(mMutex);
+                gen_tangents = mTangentMeshes.erase(std::make_pair(mesh_params.getSculptID(), lod)) > 0;
+            }
+
+            if (gen_tangents)
+            { // nobody else sees this volume yet, so build the tangents here instead of on the main thread at first draw
+                for (S32 i = 0; i < volume->getNumVolumeFaces(); ++i)
+                {
+                    volume->genTangents(i);
+                }
+            }
+
             LoadedMesh mesh(volume, mesh_params, lod);
             {
                 LLMutexLock lock(mMutex);
@@ -3634,8 +3658,12 @@ LLMeshRepository::LLMeshRepository()
   mDecompThread(NULL),
   mMeshThreadCount(0),
   mLegacyGetMeshVersion(0), // <FS:Ansariel> [UDP Assets]
-  mThread(NULL)
+  mThread(NULL),
+  mSkinFootprint(sMeshRepoMemStat),
+  mDecompFootprint(sMeshRepoMemStat)
 {
+    mSkinFootprint.setCount(0);
+    mDecompFootprint.setCount(0);
 
 }
 
@@ -3766,6 +3794,12 @@ S32 LLMeshRepository::loadMesh(LLVOVolume* vobj, const LLVolumeParams& mesh_para
         }
     }
 
+    if (vobj->needsTangents())
+    { // cleared when this LOD is processed, see notifyMeshLoaded() and notifyMeshUnavailable()
+        LLMutexLock lock(mThread->mMutex);
+        mThread->mTangentMeshes.insert(std::make_pair(mesh_params.getSculptID(), detail));
+    }
+
     //do a quick search to see if we can't display something while we wait for this mesh to load
     LLVolume* volume = vobj->getVolume();
 
@@ -4126,7 +4160,11 @@ void LLMeshRepository::notifyLoadedMeshes()
 
 void LLMeshRepository::notifySkinInfoReceived(LLMeshSkinInfo& info)
 {
-    mSkinMap[info.mMeshID] = info;
+    LLMeshSkinInfo& entry = mSkinMap[info.mMeshID];
+    size_t footprint = mSkinFootprint.getBytes() - entry.sizeBytes();
+    entry = info;
+    mSkinFootprint.setBytes(footprint + entry.sizeBytes());
+    mSkinFootprint.setCount(mSkinMap.size());
     // Alternative: We can get skin size from header
     sCacheBytesSkins += info.sizeBytes();
 
@@ -4153,12 +4191,16 @@ void LLMeshRepository::notifyDecompositionReceived(LLModel::Decomposition* decom
         mDecompositionMap[decomp->mMeshID] = decomp;
         mLoadingDecompositions.erase(decomp->mMeshID);
         sCacheBytesDecomps += decomp->sizeBytes();
+        mDecompFootprint.setBytes(mDecompFootprint.getBytes() + decomp->sizeBytes());
+        mDecompFootprint.setCount(mDecompositionMap.size());
     }
     else
     { //merge decomp with existing entry
+        size_t footprint = mDecompFootprint.getBytes() - iter->second->sizeBytes();
         sCacheBytesDecomps -= iter->second->sizeBytes();
         iter->second->merge(decomp);
         sCacheBytesDecomps += iter->second->sizeBytes();
+        mDecompFootprint.setBytes(footprint + iter->second->sizeBytes());
 
         mLoadingDecompositions.erase(decomp->mMeshID);
         delete decomp;
@@ -4208,6 +4250,11 @@ void LLMeshRepository::notifyMeshLoaded(const LLVolumeParams& mesh_params, LLVol
         
         mLoadingMeshes[detail].erase(mesh_params);
     }
+
+    { // lodReceived() normally consumed it, but a request made while the LOD was being decoded adds it back
+        LLMutexLock lock(mThread->mMutex);
+        mThread->mTangentMeshes.erase(std::make_pair(mesh_params.getSculptID(), detail));
+    }
 }
 
 void LLMeshRepository::notifyMeshUnavailable(const LLVolumeParams& mesh_params, S32 lod)
@@ -4237,6 +4284,11 @@ void LLMeshRepository::notifyMeshUnavailable(const LLVolumeParams& mesh_params,
         
         mLoadingMeshes[lod].erase(mesh_params);
     }
+
+    { // no LOD to build tangents for
+        LLMutexLock lock(mThread->mMutex);
+        mThread->mTangentMeshes.erase(std::make_pair(mesh_params.getSculptID(), lod));
+    }
 }
 
 S32 LLMeshRepository::getActualMeshLOD(const LLVolumeParams& mesh_params, S32 lod)
@@ -34,6 +34,7 @@
 #include "llviewertexture.h"
 #include "llvolume.h"
 #include "lldeadmantimer.h"
+#include "lltrace.h"
 #include "httpcommon.h"
 #include "httprequest.h"
 #include "httpoptions.h"
@@ -215,6 +216,9 @@ public:
     
     std::map<LLUUID, U32> mMeshHeaderSize;
 
+    // approximate heap held by mMeshHeader, guarded by mHeaderMutex
+    LLTrace::MemFootprint mHeaderFootprint;
+
     class HeaderRequest : public RequestStats
     { 
     public:
@@ -309,6 +313,10 @@ public:
     //queue of successfully loaded meshes
     std::queue<LoadedMesh> mLoadedQ;
 
+    //mesh LODs requested for a bump or normal mapped face, their tangents are generated on this thread
+    typedef std::set<std::pair<LLUUID, S32> > tangent_lod_set_t;
+    tangent_lod_set_t mTangentMeshes;
+
     //map of pending header requests and currently desired LODs
     typedef std::map<LLVolumeParams, std::vector<S32> > pending_lod_map;
     pending_lod_map mPendingLOD;
@@ -647,6 +655,10 @@ public:
     typedef std::map<LLUUID, LLModel::Decomposition*> decomposition_map;
     decomposition_map mDecompositionMap;
 
+    // approximate heap held by mSkinMap and mDecompositionMap (main thread only)
+    LLTrace::MemFootprint mSkinFootprint;
+    LLTrace::MemFootprint mDecompFootprint;
+
     LLMutex*                    mMeshMutex;
     
     std::vector<LLMeshRepoThread::LODRequest> mPendingRequests;
@@ -0,0 +1,129 @@
+/** 
+ * @file llregionhandoff.cpp
+ * @brief Tracks objects handed off between neighbouring regions.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llregionhandoff.h"
+
+const F64 LLRegionHandoffTracker::DEFAULT_GRACE_PERIOD = 1.0;
+const F32 LLRegionHandoffTracker::EDGE_MARGIN = 4.f;
+const F32 LLRegionHandoffTracker::LOOKAHEAD_TIME = 0.5f;
+const F32 LLRegionHandoffTracker::MIN_SPEED = 0.5f;
+
+LLRegionHandoffTracker::LLRegionHandoffTracker(F64 grace_period)
+:   mGracePeriod(grace_period),
+    mNumHandoffs(0),
+    mNumExpired(0)
+{
+}
+
+bool LLRegionHandoffTracker::isCrossing(const LLVector3& pos_region, const LLVector3& velocity, F32 region_width) const
+{
+    if (velocity.magVecSquared() < MIN_SPEED * MIN_SPEED)
+    {
+        return false;
+    }
+
+    // Where the object is heading, with some slack for objects which stopped
+    // just past the edge before the old region let go of them.
+    LLVector3 predicted = pos_region + velocity * LOOKAHEAD_TIME;
+    for (S32 axis = VX; axis <= VY; ++axis)
+    {
+        F32 pos = pos_region.mV[axis];
+        F32 next = predicted.mV[axis];
+        if ((velocity.mV[axis] < 0.f && (pos < EDGE_MARGIN || next < 0.f)) ||
+            (velocity.mV[axis] > 0.f && (pos > region_width - EDGE_MARGIN || next >= region_width)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+LLRegionHandoffTracker::EKillAction LLRegionHandoffTracker::onKill(const LLUUID& id, U64 from_handle, U64 object_handle,
+                                                                  const LLVector3& mover_pos, const LLVector3& mover_velocity,
+                                                                  F32 region_width, F64 now)
+{
+    if (object_handle != from_handle)
+    {
+        // The object moved to the neighbour along with its parent before the
+        // old region let go of it. The new region owns it now.
+        return KILL_STALE;
+    }
+
+    if (!isCrossing(mover_pos, mover_velocity, region_width))
+    {
+        return KILL_NOW;
+    }
+
+    deferKill(id, from_handle, now);
+    return KILL_DEFERRED;
+}
+
+void LLRegionHandoffTracker::deferKill(const LLUUID& id, U64 from_handle, F64 now)
+{
+    PendingKill& pending = mPending[id];
+    pending.mFromHandle = from_handle;
+    pending.mExpires = now + mGracePeriod;
+}
+
+bool LLRegionHandoffTracker::claim(const LLUUID& id, U64 region_handle)
+{
+    pending_map_t::iterator iter = mPending.find(id);
+    if (iter == mPending.end() || iter->second.mFromHandle == region_handle)
+    {
+        // Either nothing pending, or the region which killed the object
+        // still talks about it: keep waiting for the neighbour.
+        return false;
+    }
+
+    mPending.erase(iter);
+    mNumHandoffs++;
+    return true;
+}
+
+void LLRegionHandoffTracker::cancel(const LLUUID& id)
+{
+    mPending.erase(id);
+}
+
+void LLRegionHandoffTracker::expire(F64 now, uuid_vec_t& expired)
+{
+    for (pending_map_t::iterator iter = mPending.begin(); iter != mPending.end(); )
+    {
+        if (iter->second.mExpires <= now)
+        {
+            expired.push_back(iter->first);
+            iter = mPending.erase(iter);
+            mNumExpired++;
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
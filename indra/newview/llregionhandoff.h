@@ -0,0 +1,110 @@
+/** 
+ * @file llregionhandoff.h
+ * @brief Tracks objects handed off between neighbouring regions.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLREGIONHANDOFF_H
+#define LL_LLREGIONHANDOFF_H
+
+#include "lluuid.h"
+#include "v3math.h"
+
+#include <map>
+
+// When a moving object (vehicle, avatar and everything riding on or attached
+// to it) crosses a region boundary, the old region sends KillObject while the
+// new region sends a full update, in no guaranteed order. If the kill is
+// processed first the object and its drawable are destroyed and rebuilt from
+// scratch a moment later.
+//
+// LLRegionHandoffTracker decides which kills are likely to be a crossing and
+// holds them for a short grace period. An update from another region within
+// that period claims the object, which then keeps its LLViewerObject and
+// LLDrawable; otherwise the kill is carried out when the period expires.
+class LLRegionHandoffTracker
+{
+public:
+    static const F64 DEFAULT_GRACE_PERIOD;  // seconds a deferred kill is held
+    static const F32 EDGE_MARGIN;           // meters from the edge that count as crossing
+    static const F32 LOOKAHEAD_TIME;        // seconds of extrapolated motion considered
+    static const F32 MIN_SPEED;             // slower objects are never deferred
+
+    enum EKillAction
+    {
+        KILL_NOW,       // not a crossing, the object goes
+        KILL_DEFERRED,  // held until a neighbour claims the object or the grace period ends
+        KILL_STALE      // the object already belongs to another region, ignore the kill
+    };
+
+    LLRegionHandoffTracker(F64 grace_period = DEFAULT_GRACE_PERIOD);
+
+    // The region with from_handle killed id, which currently belongs to the
+    // region with object_handle. mover_pos (region local) and mover_velocity
+    // are those of the object's topmost parent, since a linkset moves with its
+    // root and passengers and attachments move with what they sit on.
+    EKillAction onKill(const LLUUID& id, U64 from_handle, U64 object_handle,
+                       const LLVector3& mover_pos, const LLVector3& mover_velocity,
+                       F32 region_width, F64 now);
+
+    // Is an object at pos_region (region local) moving with velocity about to
+    // leave a region of the given width?
+    bool isCrossing(const LLVector3& pos_region, const LLVector3& velocity, F32 region_width) const;
+
+    // Hold the kill of id sent by the region with from_handle.
+    void deferKill(const LLUUID& id, U64 from_handle, F64 now);
+
+    // An update for id arrived from the region with region_handle. Returns true
+    // if this completes a pending handoff, in which case the deferred kill is dropped.
+    bool claim(const LLUUID& id, U64 region_handle);
+
+    // Forget id without counting it as a handoff, e.g. when it was killed for another reason.
+    void cancel(const LLUUID& id);
+
+    bool isPending(const LLUUID& id) const { return mPending.find(id) != mPending.end(); }
+    S32  getNumPending() const { return (S32)mPending.size(); }
+
+    // Collect the ids whose grace period ran out; their kill should proceed.
+    void expire(F64 now, uuid_vec_t& expired);
+
+    void setGracePeriod(F64 grace_period) { mGracePeriod = grace_period; }
+
+    U32 getNumHandoffs() const { return mNumHandoffs; }
+    U32 getNumExpired() const  { return mNumExpired; }
+
+private:
+    struct PendingKill
+    {
+        U64 mFromHandle;
+        F64 mExpires;
+    };
+    typedef std::map<LLUUID, PendingKill> pending_map_t;
+
+    pending_map_t mPending;
+    F64           mGracePeriod;
+    U32           mNumHandoffs;
+    U32           mNumExpired;
+};
+
+#endif // LL_LLREGIONHANDOFF_H
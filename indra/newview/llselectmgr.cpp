@@ -107,6 +107,7 @@
 #include "llworld.h"
 // </FS:CR> Aurora Sim
 #include "fsareasearch.h"
+#include "fsobjectpropertiesbroker.h"
 #include "llglheaders.h"
 #include "llinventoryobserver.h"
 #include "fscommon.h"
@@ -5650,18 +5651,9 @@ void LLSelectMgr::sendListToRegions(LLObjectSelectionHandle selected_handle,
 
 void LLSelectMgr::requestObjectPropertiesFamily(LLViewerObject* object)
 {
-    LLMessageSystem* msg = gMessageSystem;
-
-    msg->newMessageFast(_PREHASH_RequestObjectPropertiesFamily);
-    msg->nextBlockFast(_PREHASH_AgentData);
-    msg->addUUIDFast(_PREHASH_AgentID, gAgent.getID());
-    msg->addUUIDFast(_PREHASH_SessionID, gAgent.getSessionID());
-    msg->nextBlockFast(_PREHASH_ObjectData);
-    msg->addU32Fast(_PREHASH_RequestFlags, 0x0 );
-    msg->addUUIDFast(_PREHASH_ObjectID, object->mID );
-
-    LLViewerRegion* regionp = object->getRegion();
-    msg->sendReliable( regionp->getHost() );
+    // Hovering asks for the same objects over and over, the broker drops
+    // requests that are still waiting for their reply.
+    FSObjectPropertiesBroker::instance().requestPropertiesFamily(object->mID, 0x0);
 }
 
 
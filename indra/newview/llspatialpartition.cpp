@@ -1455,6 +1455,47 @@ S32 LLSpatialPartition::cull(LLCamera &camera, bool do_occlusion)
     return 0;
 }
 
+void LLSpatialPartition::cullRebound()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_SPATIAL;
+#if LL_OCTREE_PARANOIA_CHECK
+    ((LLSpatialGroup*)mOctree->getListener(0))->checkStates();
+#endif
+    LLSpatialGroup* group = (LLSpatialGroup*) mOctree->getListener(0);
+    group->rebound();
+
+#if LL_OCTREE_PARANOIA_CHECK
+    ((LLSpatialGroup*)mOctree->getListener(0))->validate();
+#endif
+}
+
+void LLSpatialPartition::cullFrustum(LLCamera& camera, const OctreeNode* node, S32 res, bool descend, LLViewerOctreeCull::cull_visit_list_t& visits)
+{
+    // same culler choice as cull()
+    if (LLPipeline::sShadowRender)
+    {
+        LLOctreeCullShadow culler(&camera);
+        culler.gather(node, res, descend, visits);
+    }
+    else if (mInfiniteFarClip || !LLPipeline::sUseFarClip)
+    {
+        LLOctreeCullNoFarClip culler(&camera);
+        culler.gather(node, res, descend, visits);
+    }
+    else
+    {
+        LLOctreeCull culler(&camera);
+        culler.gather(node, res, descend, visits);
+    }
+}
+
+bool LLSpatialPartition::cullReplay(LLCamera& camera, const LLViewerOctreeCull::cull_visit_list_t& visits)
+{
+    // the cullers above only differ in their frustum checks, which were done by cullFrustum()
+    LLOctreeCull culler(&camera);
+    return culler.replay(visits);
+}
+
 void pushVerts(LLDrawInfo* params, U32 mask)
 {
     LLRenderPass::applyModelMatrix(*params);
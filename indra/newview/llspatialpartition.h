@@ -414,6 +414,13 @@ public:
     BOOL visibleObjectsInFrustum(LLCamera& camera);
     /*virtual*/ S32 cull(LLCamera &camera, bool do_occlusion=false); // Cull on arbitrary frustum
     S32 cull(LLCamera &camera, std::vector<LLDrawable *>* results, BOOL for_select); // Cull on arbitrary frustum
+
+    // cull(camera) in pieces so several partitions can be culled at once, see LLPipeline::cullPartitions().
+    // cullRebound() and cullReplay() run on the main thread, cullFrustum() only reads the octree and may
+    // run on any thread once the tree has been rebound.
+    void cullRebound();
+    void cullFrustum(LLCamera& camera, const OctreeNode* node, S32 res, bool descend, LLViewerOctreeCull::cull_visit_list_t& visits);
+    bool cullReplay(LLCamera& camera, const LLViewerOctreeCull::cull_visit_list_t& visits);
     
     BOOL isVisible(const LLVector3& v);
     bool isHUDPartition() ;
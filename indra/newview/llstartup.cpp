@@ -2137,6 +2137,7 @@ bool idle_startup()
             gMessageSystem->setTimeDecodes( TRUE );             // Time the decode of each msg
             gMessageSystem->setTimeDecodesSpamThreshold( 0.05f );  // Spam if a single msg takes over 50ms to decode
         #endif
+        LLMessageSystem::setProfileHandlers(gSavedSettings.getBOOL("FSProfileMessageHandlers"));
         display_startup();
 
         gXferManager->registerCallbacks(gMessageSystem);
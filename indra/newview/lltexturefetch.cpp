@@ -42,6 +42,7 @@
 
 #include "llagent.h"
 #include "lltexturecache.h"
+#include "lltexturefetchrange.h"
 #include "llviewercontrol.h"
 #include "llviewertexturelist.h"
 #include "llviewertexture.h"
@@ -547,6 +548,19 @@ private:
             mFetcher->mHttpSemaphore--;
             llassert_always(mFetcher->mHttpSemaphore >= 0);
         }
+
+    // True when an HTTP range is in flight or has arrived, and what it
+    // brings would go to the cache.  Such data is worth finishing with
+    // even after a delete has been requested.
+    //
+    // Threads:  Ttf
+    // Locks:  Mw
+    bool canSalvageHttpData() const
+        {
+            return mState == WAIT_HTTP_REQ
+                && mWriteToCacheState != NOT_WRITE
+                && (mHttpActive || (mLoaded && mRequestedSize > 0));
+        }
     
 private:
     enum e_request_state // mSentRequest
@@ -651,11 +665,15 @@ private:
     U32                     mHttpReplySize,             // Actual received data size
                             mHttpReplyOffset;           // Actual received data offset
     bool                    mHttpHasResource;           // Counts against Fetcher's mHttpSemaphore
+    bool                    mSalvaging;                 // Finishing an HTTP range for the cache after delete was requested
 
     // State history
     U32                     mCacheReadCount,
                             mCacheWriteCount,
-                            mResourceWaitCount;         // Requests entering WAIT_HTTP_RESOURCE2
+                            mResourceWaitCount,         // Requests entering WAIT_HTTP_RESOURCE2
+                            mCoalescedCount,            // Adjacent ranges fetched without an intervening decode
+                            mWastedBytes,               // Bytes received over HTTP and thrown away
+                            mSalvagedBytes;             // Bytes kept for the cache after delete was requested
 };
 
 //////////////////////////////////////////////////////////////////////////////
@@ -969,9 +987,13 @@ LLTextureFetchWorker::LLTextureFetchWorker(LLTextureFetch* fetcher,
       mHttpReplySize(0U),
       mHttpReplyOffset(0U),
       mHttpHasResource(false),
+      mSalvaging(false),
       mCacheReadCount(0U),
       mCacheWriteCount(0U),
       mResourceWaitCount(0U),
+      mCoalescedCount(0U),
+      mWastedBytes(0U),
+      mSalvagedBytes(0U),
       mFetchRetryPolicy(10.0,3600.0,2.0,10)
 {
     mCanUseNET = mUrl.empty() ;
@@ -1027,6 +1049,7 @@ LLTextureFetchWorker::~LLTextureFetchWorker()
     mFetcher->removeFromHTTPQueue(mID, (S32Bytes)0);
     mFetcher->removeHttpWaiter(mID);
     mFetcher->updateStateStats(mCacheReadCount, mCacheWriteCount, mResourceWaitCount);
+    mFetcher->updateRangeStats(mCoalescedCount, mWastedBytes, mSalvagedBytes);
 }
 
 // Locks:  Mw
@@ -1173,7 +1196,19 @@ bool LLTextureFetchWorker::doWork(S32 param)
     {
         if (mState < DECODE_IMAGE)
         {
-            return true; // abort
+            if (mFetcher->isQuitting() || ! canSalvageHttpData())
+            {
+                if (mHttpBufferArray)
+                {
+                    mWastedBytes += mHttpBufferArray->size();
+                }
+                return true; // abort
+            }
+            // Nobody wants the texture any more but the range we asked
+            // for is (or will shortly be) here.  Carry on through decode
+            // and cache write so that the next fetch resumes from it
+            // rather than downloading it again.
+            mSalvaging = true;
         }
     }
 
@@ -1604,24 +1639,8 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 }
             }
         }
-        mRequestedSize = mDesiredSize;
         mRequestedDiscard = mDesiredDiscard;
-        mRequestedSize -= cur_size;
-        mRequestedOffset = cur_size;
-        if (mRequestedOffset)
-        {
-            // Texture fetching often issues 'speculative' loads that
-            // start beyond the end of the actual asset.  Some cache/web
-            // systems, e.g. Varnish, will respond to this not with a
-            // 416 but with a 200 and the entire asset in the response
-            // body.  By ensuring that we always have a partially
-            // satisfiable Range request, we avoid that hit to the network.
-            // We just have to deal with the overlapping data which is made
-            // somewhat harder by the fact that grid services don't necessarily
-            // return the Content-Range header on 206 responses.  *Sigh*
-            mRequestedOffset -= 1;
-            mRequestedSize += 1;
-        }
+        LLTextureFetchRange::request(cur_size, mDesiredSize, mRequestedOffset, mRequestedSize);
         mHttpHandle = LLCORE_HTTP_HANDLE_INVALID;
 
         if (mUrl.empty())
@@ -1777,10 +1796,21 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 return true; // failed
             }
             
+            // If the desired discard dropped while this range was in flight,
+            // the next range starts where this one ends.  Ask for it straight
+            // away rather than decoding and caching this part on its own; the
+            // two then go through a single decode and a single cache write.
+            static LLCachedControl<bool> disable_range_req(gSavedSettings, "HttpRangeRequestsDisable", false);
+            const bool coalesce_range = ! disable_range_req
+                                        && ! mHaveAllData
+                                        && ! getFlags(LLWorkerClass::WCF_DELETE_REQUESTED)
+                                        && LLTextureFetchRange::coalesce(cur_size, mRequestedSize, mDesiredSize,
+                                                                         mRequestedDiscard, mDesiredDiscard);
+
             // Clear the url since we're done with the fetch
             // Note: mUrl is used to check is fetching is required so failure to clear it will force an http fetch
             // next time the texture is requested, even if the data have already been fetched.
-            if(mWriteToCacheState != NOT_WRITE && mFTType != FTT_SERVER_BAKE)
+            if(mWriteToCacheState != NOT_WRITE && mFTType != FTT_SERVER_BAKE && ! coalesce_range)
             {
                 // Why do we want to keep url if NOT_WRITE - is this a proxy for map tiles?
                 mUrl.clear();
@@ -1808,18 +1838,18 @@ bool LLTextureFetchWorker::doWork(S32 param)
             llassert_always(append_size == mRequestedSize);
             if (mHttpReplyOffset && mHttpReplyOffset != cur_size)
             {
-                // In case of a partial response, our offset may
-                // not be trivially contiguous with the data we have.
                 // Get back into alignment.
-                if ( (mHttpReplyOffset > cur_size) || (cur_size > mHttpReplyOffset + append_size))
+                src_offset = LLTextureFetchRange::overlap(cur_size, mHttpReplyOffset, append_size);
+                if (src_offset < 0)
                 {
                     LL_WARNS(LOG_TXT) << "Partial HTTP response produces break in image data for texture "
                                       << mID << ".  Aborting load."  << LL_ENDL;
+                    mWastedBytes += append_size;
                     setState(DONE);
                     releaseHttpSemaphore();
                     return true;
                 }
-                src_offset = cur_size - mHttpReplyOffset;
+                mWastedBytes += LLTextureFetchRange::wasted(cur_size, mRequestedOffset, src_offset);
                 append_size -= src_offset;
                 total_size -= src_offset;
                 mRequestedSize -= src_offset;           // Make requested values reflect useful part
@@ -1830,6 +1860,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
             if (!buffer)
             {
                 // abort. If we have no space for packet, we have not enough space to decode image
+                mWastedBytes += append_size;
                 setState(DONE);
                 LL_WARNS(LOG_TXT) << mID << " abort: out of memory" << LL_ENDL;
                 releaseHttpSemaphore();
@@ -1878,12 +1909,25 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 LL_WARNS(LOG_TXT) << mID << " mLoadedDiscard is " << mLoadedDiscard
                                   << ", should be >=0" << LL_ENDL;
             }
-            setState(DECODE_IMAGE);
             if (mWriteToCacheState != NOT_WRITE)
             {
                 mWriteToCacheState = SHOULD_WRITE ;
             }
+            if (getFlags(LLWorkerClass::WCF_DELETE_REQUESTED))
+            {
+                mSalvagedBytes += append_size;
+            }
             setPriority(LLWorkerThread::PRIORITY_HIGH | mWorkPriority);
+            if (coalesce_range)
+            {
+                LL_DEBUGS(LOG_TXT) << mID << ": Coalescing. Have: " << total_size
+                                   << " Desired Discard: " << mDesiredDiscard << " Desired Size: " << mDesiredSize << LL_ENDL;
+                ++mCoalescedCount;
+                // Still holding the HTTP resource, which SEND_HTTP_REQ expects.
+                setState(SEND_HTTP_REQ);
+                return false;
+            }
+            setState(DECODE_IMAGE);
             releaseHttpSemaphore();
             return false;
         }
@@ -2280,6 +2324,13 @@ bool LLTextureFetchWorker::deleteOK()
         }
     }
 
+    if (haveWork() && ! mFetcher->isQuitting() &&
+        // a range being salvaged for the cache, see doWork(), until it is written
+        (canSalvageHttpData() || (mSalvaging && mState > WAIT_HTTP_REQ && mState <= WAIT_ON_WRITE)))
+    {
+        delete_ok = false;
+    }
+
     if ((haveWork() &&
          // not ok to delete from these states
          ((mState >= WRITE_TO_CACHE && mState <= WAIT_ON_WRITE))))
@@ -2436,6 +2487,11 @@ S32 LLTextureFetchWorker::callbackHttpGet(LLCore::HttpResponse * response,
                 }
                 mHaveAllData = TRUE;
                 llassert_always(mDecodeHandle == 0);
+                if (mFormattedImage.notNull())
+                {
+                    // the response repeats everything we already had
+                    mWastedBytes += mFormattedImage->getDataSize();
+                }
                 mFormattedImage = NULL; // discard any previous data we had
             }
             else if (data_size < mRequestedSize)
@@ -2448,6 +2504,10 @@ S32 LLTextureFetchWorker::callbackHttpGet(LLCore::HttpResponse * response,
                 LL_WARNS(LOG_TXT) << "data_size = " << data_size << " > requested: " << mRequestedSize << LL_ENDL;
                 mHaveAllData = TRUE;
                 llassert_always(mDecodeHandle == 0);
+                if (mFormattedImage.notNull())
+                {
+                    mWastedBytes += mFormattedImage->getDataSize();
+                }
                 mFormattedImage = NULL; // discard any previous data we had
             }
         }
@@ -2639,6 +2699,9 @@ LLTextureFetch::LLTextureFetch(LLTextureCache* cache, LLImageDecodeThread* image
       mTotalCacheReadCount(0U),
       mTotalCacheWriteCount(0U),
       mTotalResourceWaitCount(0U),
+      mTotalCoalescedCount(0U),
+      mTotalWastedBytes(0U),
+      mTotalSalvagedBytes(0U),
       mFetchDebugger(NULL),
       mFetchSource(LLTextureFetch::FROM_ALL),
       mOriginFetchSource(LLTextureFetch::FROM_ALL),
@@ -3281,6 +3344,9 @@ void LLTextureFetch::endThread()
                       << ", CacheWrites:  " << mTotalCacheWriteCount
                       << ", ResWaits:  " << mTotalResourceWaitCount
                       << ", TotalHTTPReq:  " << getTotalNumHTTPRequests()
+                      << ", Coalesced:  " << mTotalCoalescedCount
+                      << ", WastedBytes:  " << mTotalWastedBytes
+                      << ", SalvagedBytes:  " << mTotalSalvagedBytes
                       << LL_ENDL;
 
     mTextureInfo.stopRecording();
@@ -3993,6 +4059,17 @@ void LLTextureFetch::updateStateStats(U32 cache_read, U32 cache_write, U32 res_w
 }                                                                       // -Mfq
 
 
+// Threads:  T*
+void LLTextureFetch::updateRangeStats(U32 coalesced, U32 wasted_bytes, U32 salvaged_bytes)
+{
+    LLMutexLock lock(&mQueueMutex);                                     // +Mfq
+
+    mTotalCoalescedCount += coalesced;
+    mTotalWastedBytes += wasted_bytes;
+    mTotalSalvagedBytes += salvaged_bytes;
+}                                                                       // -Mfq
+
+
 // Threads:  T*
 void LLTextureFetch::getStateStats(U32 * cache_read, U32 * cache_write, U32 * res_wait)
 {
@@ -4010,6 +4087,17 @@ void LLTextureFetch::getStateStats(U32 * cache_read, U32 * cache_write, U32 * re
     *res_wait = ret3;
 }
 
+
+// Threads:  T*
+void LLTextureFetch::getRangeStats(U32 * coalesced, U64 * wasted_bytes, U64 * salvaged_bytes)
+{
+    LLMutexLock lock(&mQueueMutex);                                     // +Mfq
+
+    *coalesced = mTotalCoalescedCount;
+    *wasted_bytes = mTotalWastedBytes;
+    *salvaged_bytes = mTotalSalvagedBytes;
+}                                                                       // -Mfq
+
 //////////////////////////////////////////////////////////////////////////////
 
 // cross-thread command methods
@@ -224,6 +224,16 @@ public:
     // Threads:  T*
     void getStateStats(U32 * cache_read, U32 * cache_write, U32 * res_wait);
 
+    // Add given counts to the global totals for HTTP range handling
+    // Threads:  T*
+    void updateRangeStats(U32 coalesced, U32 wasted_bytes, U32 salvaged_bytes);
+
+    // Return the global HTTP range totals: requests that followed on
+    // from an adjacent range, bytes received but thrown away, and bytes
+    // kept for the cache after their request was deleted
+    // Threads:  T*
+    void getRangeStats(U32 * coalesced, U64 * wasted_bytes, U64 * salvaged_bytes);
+
     // ----------------------------------
     
 protected:
@@ -390,6 +400,9 @@ private:
     U32 mTotalCacheReadCount;                                           // Mfq
     U32 mTotalCacheWriteCount;                                          // Mfq
     U32 mTotalResourceWaitCount;                                        // Mfq
+    U32 mTotalCoalescedCount;                                           // Mfq
+    U64 mTotalWastedBytes;                                              // Mfq
+    U64 mTotalSalvagedBytes;                                            // Mfq
     
 public:
     // A probabilistically-correct indicator that the current
@@ -0,0 +1,79 @@
+/** 
+ * @file lltexturefetchrange.cpp
+ * @brief Byte range arithmetic for textures fetched over HTTP in pieces.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "lltexturefetchrange.h"
+
+void LLTextureFetchRange::request(S32 have_size, S32 desired_size, S32& offset, S32& size)
+{
+    offset = have_size;
+    size = desired_size - have_size;
+    if (offset)
+    {
+        // Texture fetching often issues 'speculative' loads that
+        // start beyond the end of the actual asset.  Some cache/web
+        // systems, e.g. Varnish, will respond to this not with a
+        // 416 but with a 200 and the entire asset in the response
+        // body.  By ensuring that we always have a partially
+        // satisfiable Range request, we avoid that hit to the network.
+        // We just have to deal with the overlapping data which is made
+        // somewhat harder by the fact that grid services don't necessarily
+        // return the Content-Range header on 206 responses.  *Sigh*
+        offset -= 1;
+        size += 1;
+    }
+}
+
+S32 LLTextureFetchRange::overlap(S32 have_size, U32 reply_offset, S32 reply_size)
+{
+    if (! reply_offset || reply_offset == (U32)have_size)
+    {
+        return 0;
+    }
+    // In case of a partial response, our offset may
+    // not be trivially contiguous with the data we have.
+    if (reply_offset > (U32)have_size || (U32)have_size > reply_offset + reply_size)
+    {
+        return -1;
+    }
+    return have_size - (S32)reply_offset;
+}
+
+S32 LLTextureFetchRange::wasted(S32 have_size, S32 requested_offset, S32 overlap)
+{
+    // The overlap request() asks for on purpose is not waste
+    return llmax(0, overlap - (have_size - requested_offset));
+}
+
+bool LLTextureFetchRange::coalesce(S32 have_size, S32 received_size, S32 desired_size,
+                                   S32 requested_discard, S32 desired_discard)
+{
+    return received_size > 0
+        && desired_discard < requested_discard
+        && desired_size > have_size + received_size;
+}
@@ -0,0 +1,62 @@
+/** 
+ * @file lltexturefetchrange.h
+ * @brief Byte range arithmetic for textures fetched over HTTP in pieces.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTEXTUREFETCHRANGE_H
+#define LL_LLTEXTUREFETCHRANGE_H
+
+// LLTextureFetchWorker downloads a J2C stream a range at a time, first the
+// bytes for a coarse discard level and then more as the desired discard
+// drops, and resumes from whatever LLTextureCache already holds. These are
+// the calculations it makes about those ranges, kept apart from the worker's
+// state machine so they can be tested on their own.
+namespace LLTextureFetchRange
+{
+    // The Range request for a texture of which have_size bytes are already
+    // held and desired_size are wanted. The request starts one byte before
+    // the end of the held data, see the .cpp.
+    void request(S32 have_size, S32 desired_size, S32& offset, S32& size);
+
+    // A partial reply of reply_size bytes starting at reply_offset arrived
+    // while have_size bytes were held. Returns how many of its leading bytes
+    // were already held, or -1 if it starts past the held data and would
+    // leave a gap, or ends before the held data. A reply_offset of 0 means
+    // the reply starts at the held data.
+    S32 overlap(S32 have_size, U32 reply_offset, S32 reply_size);
+
+    // Bytes of that overlap which were not asked for, i.e. received twice
+    // because the server answered from before requested_offset.
+    S32 wasted(S32 have_size, S32 requested_offset, S32 overlap);
+
+    // Once received_size more bytes have been appended to have_size, should
+    // the next range be fetched straight away rather than decoding what is
+    // held first? True when the desired discard dropped below the requested
+    // one while the range was in flight, so more data is wanted anyway.
+    bool coalesce(S32 have_size, S32 received_size, S32 desired_size,
+                  S32 requested_discard, S32 desired_discard);
+}
+
+#endif // LL_LLTEXTUREFETCHRANGE_H
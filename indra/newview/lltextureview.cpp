@@ -680,10 +680,13 @@ void LLGLTexMemBar::draw()
 
     U32 cache_read(0U), cache_write(0U), res_wait(0U);
     LLAppViewer::getTextureFetch()->getStateStats(&cache_read, &cache_write, &res_wait);
+    U32 coalesced(0U);
+    U64 wasted_bytes(0U), salvaged_bytes(0U);
+    LLAppViewer::getTextureFetch()->getRangeStats(&coalesced, &wasted_bytes, &salvaged_bytes);
     
     // <FS:Ansariel> Fast cache stats
     //text = llformat("Net Tot Tex: %.1f MB Tot Obj: %.1f MB #Objs/#Cached: %d/%d Tot Htp: %d Cread: %u Cwrite: %u Rwait: %u",
-    text = llformat("Net Tot Tex: %.1f MB Tot Obj: %.1f MB #Objs/#Cached: %d/%d Tot Htp: %d Cread: %u Cwrite: %u Rwait: %u FCread: %u",
+    text = llformat("Net Tot Tex: %.1f MB Tot Obj: %.1f MB #Objs/#Cached: %d/%d Tot Htp: %d Cread: %u Cwrite: %u Rwait: %u FCread: %u Coal: %u Waste: %.2f MB Salv: %.2f MB",
     // </FS:Ansariel>
                     total_texture_downloaded.valueInUnits<LLUnits::Megabytes>(),
                     total_object_downloaded.valueInUnits<LLUnits::Megabytes>(),
@@ -695,8 +698,11 @@ void LLGLTexMemBar::draw()
                     // <FS:Ansariel> Fast cache stats
                     //res_wait);
                     res_wait,
-                    LLViewerTextureList::sNumFastCacheReads);
+                    LLViewerTextureList::sNumFastCacheReads,
                     // </FS:Ansariel>
+                    coalesced,
+                    F32(wasted_bytes) / (1024.f * 1024.f),
+                    F32(salvaged_bytes) / (1024.f * 1024.f));
 
     LLFontGL::getFontMonospace()->renderUTF8(text, 0, 0, v_offset + line_height*5,
                                              text_color, LLFontGL::LEFT, LLFontGL::TOP);
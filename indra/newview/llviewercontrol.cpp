@@ -69,6 +69,7 @@
 #include "llkeyboard.h"
 #include "llerrorcontrol.h"
 #include "llappviewer.h"
+#include "lldir.h"
 #include "llvosurfacepatch.h"
 #include "llvowlsky.h"
 #include "llrender.h"
@@ -113,6 +114,7 @@
 #include "NACLantispam.h"
 #include "nd/ndlogthrottle.h"
 #include "fsperfstats.h"
+#include "message.h"
 // <FS:Zi> Run Prio 0 default bento pose in the background to fix splayed hands, open mouths, etc.
 #include "llanimationstates.h"
 
@@ -334,6 +336,26 @@ static bool handleReleaseGLBufferChanged(const LLSD& newvalue)
     return true;
 }
 
+static bool handleMemProfilingChanged(const LLSD& newvalue)
+{
+    LLAllocator& allocator = LLAppViewer::instance()->getAllocator();
+    if (!newvalue.asBoolean() && allocator.isProfiling())
+    {
+        // switching off discards the samples, so save them first
+        std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, llformat("heap_profile_%u.heap", (U32)time(NULL)));
+        allocator.dumpProfile(filename);
+        LLAllocator::logCategoryUsage();
+    }
+    allocator.setProfilingEnabled(newvalue.asBoolean());
+    return true;
+}
+
+static bool handleMemProfilingSampleIntervalChanged(const LLSD& newvalue)
+{
+    LLAllocator::setSampleInterval((size_t)newvalue.asInteger());
+    return true;
+}
+
 static bool handleLUTBufferChanged(const LLSD& newvalue)
 {
     if (gPipeline.isInit())
@@ -1137,6 +1159,11 @@ void handleFPSTuningStrategyChanged(const LLSD& newValue)
 }
 // </FS:Beq>
 
+static void handleProfileMessageHandlersChanged(const LLSD& newvalue)
+{
+    LLMessageSystem::setProfileHandlers(newvalue.asBoolean());
+}
+
 // <FS:Ansariel> FIRE-6809: Quickly moving the bandwidth slider has no effect
 void handleBandwidthChanged(const LLSD& newValue)
 {
@@ -1189,6 +1216,8 @@ void settings_setup_listeners()
 {
     setting_setup_signal_listener(gSavedSettings, "FirstPersonAvatarVisible", handleRenderAvatarMouselookChanged);
     setting_setup_signal_listener(gSavedSettings, "RenderFarClip", handleRenderFarClipChanged);
+    setting_setup_signal_listener(gSavedSettings, "MemProfiling", handleMemProfilingChanged);
+    setting_setup_signal_listener(gSavedSettings, "MemProfilingSampleInterval", handleMemProfilingSampleIntervalChanged);
     setting_setup_signal_listener(gSavedSettings, "RenderTerrainDetail", handleTerrainDetailChanged);
     setting_setup_signal_listener(gSavedSettings, "OctreeStaticObjectSizeFactor", handleRepartition);
     setting_setup_signal_listener(gSavedSettings, "OctreeDistanceFactor", handleRepartition);
@@ -1445,6 +1474,8 @@ void settings_setup_listeners()
     setting_setup_signal_listener(gSavedSettings, "FSTuningFPSStrategy", handleFPSTuningStrategyChanged);
     // </FS:Beq>
 
+    setting_setup_signal_listener(gSavedSettings, "FSProfileMessageHandlers", handleProfileMessageHandlersChanged);
+
     // <FS:Zi> Handle IME text input getting enabled or disabled
 #if LL_SDL2
     gSavedSettings.getControl("SDL2IMEEnabled")->getSignal()->connect(boost::bind(&handleSDL2IMEEnabledChanged, _2));
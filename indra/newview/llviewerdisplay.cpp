@@ -256,6 +256,7 @@ void display_stats()
         U32Megabytes memory = gMemoryAllocated;
         LL_INFOS() << "MEMORY: " << memory << LL_ENDL;
         LLMemory::logMemoryInfo(TRUE) ;
+        LLTrace::log_mem_stats();
         gRecentMemoryTime.reset();
     }
     F32 asset_storage_log_freq = gSavedSettings.getF32("AssetStorageLogFrequency");
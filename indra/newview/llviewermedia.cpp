@@ -2956,6 +2956,10 @@ void LLViewerMediaImpl::update()
                     media_tex->getGLTexture()->mActiveThread = LLThread::currentID();
 #endif
                     mTextureUpdatePending = false;
+                    if (mMediaSource)
+                    {
+                        mMediaSource->releaseFrame();
+                    }
                     media_tex->unref();
                     unref();
                 });
@@ -2963,6 +2967,7 @@ void LLViewerMediaImpl::update()
         else
         {
             doMediaTexUpdate(media_tex, data, data_width, data_height, x_pos, y_pos, width, height, false); // otherwise, update on main thread
+            mMediaSource->releaseFrame();
         }
     }
 }
@@ -2987,7 +2992,14 @@ bool LLViewerMediaImpl::preMediaTexUpdate(LLViewerMediaTexture*& media_tex, U8*&
             // Since we're updating this texture, we know it's playing.  Tell the texture to do its replacement magic so it gets rendered.
             media_tex->setPlaying(TRUE);
 
-            if (mMediaSource->getDirty(&dirty_rect))
+            if (mMediaSource->usesFrameRing())
+            {
+                if (mMediaSource->getDirty())
+                {
+                    retval = preFrameRingUpdate(media_tex, data, data_width, data_height, x_pos, y_pos, width, height);
+                }
+            }
+            else if (mMediaSource->getDirty(&dirty_rect))
             {
                 // Constrain the dirty rect to be inside the texture
                 x_pos = llmax(dirty_rect.mLeft, 0);
@@ -3016,6 +3028,59 @@ bool LLViewerMediaImpl::preMediaTexUpdate(LLViewerMediaTexture*& media_tex, U8*&
     return retval;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Takes the newest frame from the plugin's frame ring. Small changes are copied rect by rect into the existing
+// texture right here; anything bigger is handed back for the usual whole-frame upload, which must call
+// releaseFrame() on the media source once it has finished with data.
+bool LLViewerMediaImpl::preFrameRingUpdate(LLViewerMediaTexture* media_tex, U8*& data, S32& data_width, S32& data_height, S32& x_pos, S32& y_pos, S32& width, S32& height)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_MEDIA;
+
+    LLPluginFrameRing::rect_list_t dirty_rects;
+    bool full = false;
+    data = mMediaSource->acquireFrame(&dirty_rects, &full);
+    if (!data)
+    {
+        // The plugin is writing the only readable frame right now. Leave the dirty state alone and pick it up next time.
+        return false;
+    }
+    mMediaSource->resetDirty();
+
+    data_width = mMediaSource->getWidth();
+    data_height = mMediaSource->getHeight();
+    S32 media_width = llmin(mMediaSource->getTextureWidth(), data_width);
+    S32 media_height = llmin(mMediaSource->getTextureHeight(), data_height);
+
+    S64 dirty_area = 0;
+    for (LLRect& rect : dirty_rects)
+    {
+        rect.intersectWith(LLRect(0, media_height, media_width, 0));
+        if (rect.getWidth() > 0 && rect.getHeight() > 0)
+        {
+            dirty_area += (S64)rect.getWidth() * rect.getHeight();
+        }
+    }
+
+    if (!full && dirty_area * 2 < (S64)media_width * media_height)
+    {
+        for (const LLRect& rect : dirty_rects)
+        {
+            if (rect.getWidth() > 0 && rect.getHeight() > 0)
+            {
+                media_tex->setSubImage(data, data_width, data_height, rect.mLeft, rect.mBottom, rect.getWidth(), rect.getHeight());
+            }
+        }
+        mMediaSource->releaseFrame();
+        return false;
+    }
+
+    x_pos = 0;
+    y_pos = 0;
+    width = media_width;
+    height = media_height;
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 void LLViewerMediaImpl::doMediaTexUpdate(LLViewerMediaTexture* media_tex, U8* data, S32 data_width, S32 data_height, S32 x_pos, S32 y_pos, S32 width, S32 height, bool sync)
 {
@@ -3112,6 +3177,9 @@ LLViewerMediaTexture* LLViewerMediaImpl::updateMediaImage()
 //      media_tex->mIsMediaTexture = true;
         mNeedsNewTexture = false;
 
+        // The new texture holds none of the frames uploaded so far.
+        mMediaSource->invalidateFrame();
+
         // If the amount of the texture being drawn by the media goes down in either width or height,
         // recreate the texture to avoid leaving parts of the old image behind.
         mTextureUsedWidth = mMediaSource->getWidth();
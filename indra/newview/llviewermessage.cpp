@@ -147,6 +147,7 @@
 #include "fskeywords.h" // <FS:PP> FIRE-10178: Keyword Alerts in group IM do not work unless the group is in the foreground
 #include "fslslbridge.h"
 #include "fsmoneytracker.h"
+#include "fsobjectpropertiesbroker.h"
 #include "llattachmentsmgr.h"
 #include "lleconomy.h"
 #include "llfloaterbump.h"
@@ -4711,6 +4712,16 @@ void process_kill_object(LLMessageSystem *mesgsys, void **user_data)
                 }
                 // </FS:Ansariel>
 
+                // Objects moving into a neighbouring region are handed off rather than rebuilt
+                if (gObjectList.deferKillForHandoff(objectp, regionp))
+                {
+                    if (delete_object)
+                    {
+                        regionp->killCacheEntry(local_id);
+                    }
+                    continue;
+                }
+
                 // Display green bubble on kill
                 if ( gShowObjectUpdates )
                 {
@@ -4739,6 +4750,7 @@ void process_kill_object(LLMessageSystem *mesgsys, void **user_data)
 void process_object_properties(LLMessageSystem *msg, void**user_data)
 {
     // Send the result to the corresponding requesters.
+    FSObjectPropertiesBroker::instance().processObjectProperties(msg);
     LLSelectMgr::processObjectProperties(msg, user_data);
     
     FSAreaSearch* area_search_floater = LLFloaterReg::findTypedInstance<FSAreaSearch>("area_search");
@@ -4761,6 +4773,7 @@ void process_object_properties(LLMessageSystem *msg, void**user_data)
 void process_object_properties_family(LLMessageSystem *msg, void**user_data)
 {
     // Send the result to the corresponding requesters.
+    FSObjectPropertiesBroker::instance().processObjectPropertiesFamily(msg);
     LLSelectMgr::processObjectPropertiesFamily(msg, user_data);
 
     if (NACLAntiSpamRegistry::instanceExists())
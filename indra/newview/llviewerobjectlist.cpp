@@ -383,20 +383,9 @@ LLViewerObject* LLViewerObjectList::processObjectUpdateFromCache(LLVOCacheEntry*
         if(!objectp->isDead() && (objectp->mLocalID != entry->getLocalID() ||
             objectp->getRegion() != regionp))
         {
-            removeFromLocalIDTable(objectp);
-            setUUIDAndLocal(fullid, entry->getLocalID(),
-                            regionp->getHost().getAddress(),
-                            regionp->getHost().getPort());
-                
-            if (objectp->mLocalID != entry->getLocalID())
-            {   // Update local ID in object with the one sent from the region
-                objectp->mLocalID = entry->getLocalID();
-            }
-            
-            if (objectp->getRegion() != regionp)
-            {   // Object changed region, so update it
-                objectp->updateRegion(regionp); // for LLVOAvatar
-            }
+            handoffObject(objectp, entry->getLocalID(), regionp,
+                          regionp->getHost().getAddress(),
+                          regionp->getHost().getPort());
         }
         else
         {
@@ -640,21 +629,14 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
             //          << ", regionp " << (U32) regionp << ", object region " << (U32) objectp->getRegion()
             //          << LL_ENDL;
             //}
-            removeFromLocalIDTable(objectp);
-            setUUIDAndLocal(fullid,
-                            local_id,
-                            gMessageSystem->getSenderIP(),
-                            gMessageSystem->getSenderPort());
-            
-            if (objectp->mLocalID != local_id)
-            {   // Update local ID in object with the one sent from the region
-                objectp->mLocalID = local_id;
-            }
-            
-            if (objectp->getRegion() != regionp)
-            {   // Object changed region, so update it
-                objectp->updateRegion(regionp); // for LLVOAvatar
-            }
+            handoffObject(objectp, local_id, regionp,
+                          gMessageSystem->getSenderIP(),
+                          gMessageSystem->getSenderPort());
+        }
+        else if (objectp && mHandoffTracker.getNumPending())
+        {
+            // The object was already moved to this region along with its parent.
+            mHandoffTracker.claim(objectp->getID(), regionp->getHandle());
         }
 
         if (!objectp)
@@ -1008,6 +990,23 @@ void LLViewerObjectList::update(LLAgent &agent)
     
     LLViewerObject *objectp = NULL; 
 
+    // Carry out kills held for region crossings that no neighbour picked up in time
+    if (mHandoffTracker.getNumPending())
+    {
+        uuid_vec_t expired;
+        mHandoffTracker.expire(frame_time, expired);
+        for (uuid_vec_t::iterator iter = expired.begin(); iter != expired.end(); ++iter)
+        {
+            objectp = findObject(*iter);
+            if (objectp)
+            {
+                killObject(objectp);
+                LLSelectMgr::getInstance()->removeObjectFromSelections(*iter);
+            }
+        }
+        objectp = NULL;
+    }
+
     // Make a copy of the list in case something in idleUpdate() messes with it
     static std::vector<LLViewerObject*> idle_list;
 
@@ -1472,6 +1471,8 @@ void LLViewerObjectList::clearDebugText()
 void LLViewerObjectList::cleanupReferences(LLViewerObject *objectp)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    mHandoffTracker.cancel(objectp->mID);
+
     // <FS:Beq> FIRE-30694 DeadObject Spam - handle new_dead_object properly and closer to source
     // bool new_dead_object = true;
     if (mDeadObjects.find(objectp->mID) != mDeadObjects.end())
@@ -2418,6 +2419,60 @@ LLViewerObject *LLViewerObjectList::createObject(const LLPCode pcode, LLViewerRe
     return objectp;
 }
 
+bool LLViewerObjectList::deferKillForHandoff(LLViewerObject* objectp, LLViewerRegion* from_regionp)
+{
+    static LLCachedControl<F32> handoff_time(gSavedSettings, "RegionCrossingHandoffTime");
+    if (handoff_time <= 0.f || !objectp || objectp->isDead() || !objectp->getRegion() || !from_regionp)
+    {
+        return false;
+    }
+
+    LLViewerObject* mover = objectp;
+    while (mover->getParent())
+    {
+        mover = (LLViewerObject*)mover->getParent();
+    }
+
+    mHandoffTracker.setGracePeriod(handoff_time);
+    LLRegionHandoffTracker::EKillAction action =
+        mHandoffTracker.onKill(objectp->getID(), from_regionp->getHandle(), objectp->getRegion()->getHandle(),
+                               mover->getPositionRegion(), mover->getVelocity(), from_regionp->getWidth(),
+                               LLFrameTimer::getElapsedSeconds());
+
+    if (action == LLRegionHandoffTracker::KILL_DEFERRED)
+    {
+        LL_DEBUGS("ObjectUpdate") << "Deferred kill of " << objectp->getID() << " from " << from_regionp->getName()
+                                  << " pending handoff" << LL_ENDL;
+    }
+    else if (action == LLRegionHandoffTracker::KILL_STALE)
+    {
+        LL_DEBUGS("ObjectUpdate") << "Ignored kill of " << objectp->getID() << " from " << from_regionp->getName()
+                                  << ", it already moved to " << objectp->getRegion()->getName() << LL_ENDL;
+    }
+    return action != LLRegionHandoffTracker::KILL_NOW;
+}
+
+void LLViewerObjectList::handoffObject(LLViewerObject* objectp, U32 local_id, LLViewerRegion* regionp, U32 ip, U32 port)
+{
+    removeFromLocalIDTable(objectp);
+    setUUIDAndLocal(objectp->getID(), local_id, ip, port);
+
+    if (objectp->mLocalID != local_id)
+    {   // Update local ID in object with the one sent from the region
+        objectp->mLocalID = local_id;
+    }
+
+    if (objectp->getRegion() != regionp)
+    {   // Object changed region, so update it
+        objectp->updateRegion(regionp); // for LLVOAvatar
+    }
+
+    if (mHandoffTracker.claim(objectp->getID(), regionp->getHandle()))
+    {
+        LL_DEBUGS("ObjectUpdate") << "Handed off " << objectp->getID() << " to " << regionp->getName() << LL_ENDL;
+    }
+}
+
 LLViewerObject *LLViewerObjectList::replaceObject(const LLUUID &id, const LLPCode pcode, LLViewerRegion *regionp)
 {
     LLViewerObject *old_instance = findObject(id);
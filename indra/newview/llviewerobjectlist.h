@@ -36,6 +36,7 @@
 
 // project includes
 #include "llviewerobject.h"
+#include "llregionhandoff.h"
 #include "lleventcoro.h"
 #include "llcoros.h"
 
@@ -77,6 +78,14 @@ public:
     BOOL killObject(LLViewerObject *objectp);
     void killAnimatedObjects();
 
+    // Region crossings: hold a kill from from_regionp if objectp is moving into a neighbour,
+    // so that it can be handed off to the new region instead of being rebuilt, and ignore
+    // it if objectp already moved there. Returns false if the kill should go ahead.
+    bool deferKillForHandoff(LLViewerObject* objectp, LLViewerRegion* from_regionp);
+    // Move objectp to the local id tables of regionp, keeping the object and its drawable.
+    void handoffObject(LLViewerObject* objectp, U32 local_id, LLViewerRegion* regionp, U32 ip, U32 port);
+    const LLRegionHandoffTracker& getHandoffTracker() const { return mHandoffTracker; }
+
     void killObjects(LLViewerRegion *regionp); // Kill all objects owned by a particular region.
     void killAllObjects();
     void removeDrawable(LLDrawable* drawablep);
@@ -250,6 +259,8 @@ protected:
 
     std::set<LLViewerObject *> mSelectPickList;
 
+    LLRegionHandoffTracker mHandoffTracker;
+
     friend class LLViewerObject;
 
 private:
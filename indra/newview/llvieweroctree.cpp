@@ -1386,6 +1386,81 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
     }
 }
     
+void LLViewerOctreeCull::gather(const OctreeNode* n, S32 res, bool descend, cull_visit_list_t& visits)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    mRes = res;
+    gatherBranch(n, descend, visits);
+    mRes = 0;
+}
+
+//mirrors traverse() so mRes is handed down and reset exactly as it is there
+void LLViewerOctreeCull::gatherBranch(const OctreeNode* n, bool descend, cull_visit_list_t& visits)
+{
+    LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) n->getListener(0);
+
+    bool inside = mRes == 2 || 
+        (mRes && group->hasState(LLViewerOctreeGroup::SKIP_FRUSTUM_CHECK));
+    if (!inside)
+    {
+        mRes = frustumCheck(group);
+    }
+
+    U32 index = (U32) visits.size();
+    visits.push_back(CullVisit());
+    visits[index].mGroup = group;
+    visits[index].mRes = mRes;
+    visits[index].mCheckObjects = mRes && checkObjects(n, group);
+
+    if (mRes && descend)
+    {
+        for (U32 i = 0; i < n->getChildCount(); i++)
+        {
+            gatherBranch(n->getChild(i), true, visits);
+        }
+    }
+
+    visits[index].mEnd = (U32) visits.size();
+
+    if (!inside)
+    {
+        mRes = 0;
+    }
+}
+
+//earlyFail() skipping a branch can leave mRes different from what gather() handed to the next
+//sibling, but that only matters for SKIP_FRUSTUM_CHECK groups, which never have siblings
+bool LLViewerOctreeCull::replay(const cull_visit_list_t& visits)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    bool first_visible = true;
+    U32 i = 0;
+    while (i < visits.size())
+    {
+        const CullVisit& v = visits[i];
+        if (earlyFail(v.mGroup) || !v.mRes)
+        {
+            if (i == 0)
+            {
+                first_visible = false;
+            }
+            i = v.mEnd;
+            continue;
+        }
+
+        mRes = v.mRes;
+        preprocess(v.mGroup);
+        if (v.mCheckObjects)
+        {
+            processGroup(v.mGroup);
+        }
+        ++i;
+    }
+
+    mRes = 0;
+    return first_visible;
+}
+
 //------------------------------------------
 //agent space group culling
 S32 LLViewerOctreeCull::AABBInFrustumNoFarClipGroupBounds(const LLViewerOctreeGroup* group)
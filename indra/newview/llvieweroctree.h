@@ -373,6 +373,26 @@ public:
     
     virtual void traverse(const OctreeNode* n);
 
+    //one group reached by traverse(), as recorded by gather()
+    struct CullVisit
+    {
+        LLViewerOctreeGroup* mGroup;
+        U32  mEnd;          //index one past the last visit of this group's branch
+        S32  mRes;          //frustum result while visiting this group, 0 if it is outside
+        bool mCheckObjects; //result of checkObjects() for this group
+    };
+    typedef std::vector<CullVisit> cull_visit_list_t;
+
+    //frustum half of traverse(): records every group traverse() could reach below n in traversal
+    //order without calling earlyFail() or visit().  Only reads the octree, so separate branches
+    //of a rebound tree may be gathered on worker threads.  res is the frustum result handed down
+    //by the parent of n, and if descend is false only n itself is recorded.
+    void gather(const OctreeNode* n, S32 res, bool descend, cull_visit_list_t& visits);
+
+    //play gathered visits back on the main thread, doing the earlyFail(), preprocess() and
+    //processGroup() work traverse() would have done.  Returns false if the first group was culled.
+    bool replay(const cull_visit_list_t& visits);
+
 protected:
     virtual bool earlyFail(LLViewerOctreeGroup* group); 
     
@@ -404,6 +424,9 @@ protected:
     virtual void preprocess(LLViewerOctreeGroup* group);
     virtual void processGroup(LLViewerOctreeGroup* group);
     virtual void visit(const OctreeNode* branch);
+
+private:
+    void gatherBranch(const OctreeNode* n, bool descend, cull_visit_list_t& visits);
     
 protected:
     LLCamera *mCamera;
@@ -653,6 +653,7 @@ LLViewerRegion::LLViewerRegion(const U64 &handle,
     mDead(FALSE),
     mLastVisitedEntry(NULL),
     mInvisibilityCheckHistory(-1),
+    mLastCompressedEntryID(0),
     mPaused(FALSE),
     mRegionCacheHitCount(0),
     mRegionCacheMissCount(0),
@@ -1235,11 +1236,41 @@ void LLViewerRegion::killCacheEntry(U32 local_id)
     killCacheEntry(getCacheEntry(local_id));
 }
 
+//the entry's data could not be restored (see LLVOCacheEntry::decompress()).
+//take it out of the cache structures and ask the simulator for the full object.
+void LLViewerRegion::discardCacheEntry(LLVOCacheEntry* entry)
+{
+    entry->setValid(TRUE); //killCacheEntry() skips invalid entries
+    killCacheEntry(entry);
+    addCacheMiss(entry->getLocalID(), CACHE_MISS_TYPE_FULL);
+}
+
 U32 LLViewerRegion::getNumOfActiveCachedObjects() const
 {
     return  mImpl->mActiveSet.size();
 }
 
+void LLViewerRegion::getCacheMemoryInfo(S32& raw_bytes, S32& compressed_bytes, S32& num_compressed) const
+{
+    raw_bytes = 0;
+    compressed_bytes = 0;
+    num_compressed = 0;
+
+    for(LLVOCacheEntry::vocache_entry_map_t::const_iterator iter = mImpl->mCacheMap.begin(); iter != mImpl->mCacheMap.end(); ++iter)
+    {
+        const LLVOCacheEntry* entry = iter->second;
+        if(entry->isCompressed())
+        {
+            compressed_bytes += entry->getResidentSize();
+            num_compressed++;
+        }
+        else
+        {
+            raw_bytes += entry->getResidentSize();
+        }
+    }
+}
+
 void LLViewerRegion::addActiveCacheEntry(LLVOCacheEntry* entry)
 {
     if(!entry || mDead)
@@ -1442,7 +1473,7 @@ void LLViewerRegion::updateVisibleEntries(F32 max_time)
             //set a large number to force to load this object.
             vo_entry->setSceneContribution(LARGE_SCENE_CONTRIBUTION);
             
-            mImpl->mWaitingList.insert(vo_entry);
+            mImpl->mWaitingList.push_back(vo_entry);
             ++iter;
         }
         else
@@ -1471,6 +1502,13 @@ void LLViewerRegion::updateVisibleEntries(F32 max_time)
             continue;
         }
 
+        //skip the whole group if even its closest, largest entry is below the threshold
+        F32 max_contribution = ((LLVOCacheGroup*)group.get())->getMaxSceneContribution(local_origin, dist_threshold);
+        if(max_contribution >= 0.f && max_contribution <= projection_threshold)
+        {
+            continue;
+        }
+
         for (LLViewerOctreeGroup::element_iter i = group->getDataBegin(); i != group->getDataEnd(); ++i)
         {
             if((*i)->hasVOCacheEntry())
@@ -1490,7 +1528,7 @@ void LLViewerRegion::updateVisibleEntries(F32 max_time)
                 vo_entry->calcSceneContribution(local_origin, needs_update, last_update, dist_threshold);
                 if(vo_entry->getSceneContribution() > projection_threshold)
                 {
-                    mImpl->mWaitingList.insert(vo_entry);           
+                    mImpl->mWaitingList.push_back(vo_entry);
                 }
             }
         }
@@ -1520,9 +1558,29 @@ void LLViewerRegion::createVisibleObjects(F32 max_time)
     S32 throttle = sNewObjectCreationThrottle;
     BOOL has_new_obj = FALSE;
     LLTimer update_timer;   
-    for(LLVOCacheEntry::vocache_entry_priority_list_t::iterator iter = mImpl->mWaitingList.begin();
-        iter != mImpl->mWaitingList.end(); ++iter)
+
+    //only the first throttle entries are sure to be created, order just those and
+    //sort the rest if there is time left once they are done.
+    LLVOCacheEntry::vocache_entry_priority_list_t& waiting_list = mImpl->mWaitingList;
+    LLVOCacheEntry::vocache_entry_priority_list_t::iterator sorted_end = waiting_list.end();
+    if(throttle > 0 && (size_t)throttle < waiting_list.size())
+    {
+        sorted_end = waiting_list.begin() + throttle;
+        std::partial_sort(waiting_list.begin(), sorted_end, waiting_list.end(), LLVOCacheEntry::CompareVOCacheEntry());
+    }
+    else
+    {
+        std::sort(waiting_list.begin(), waiting_list.end(), LLVOCacheEntry::CompareVOCacheEntry());
+    }
+
+    for(LLVOCacheEntry::vocache_entry_priority_list_t::iterator iter = waiting_list.begin();
+        iter != waiting_list.end(); ++iter)
     {
+        if(iter == sorted_end)
+        {
+            std::sort(sorted_end, waiting_list.end(), LLVOCacheEntry::CompareVOCacheEntry());
+        }
+
         LLVOCacheEntry* vo_entry = *iter;       
 
         if(vo_entry->getState() < LLVOCacheEntry::WAITING)
@@ -1666,6 +1724,9 @@ void LLViewerRegion::idleUpdate(F32 max_update_time)
     max_time = max_update_time - update_timer.getElapsedTimeF32();  
 
     createVisibleObjects(max_time);
+    max_time = max_update_time - update_timer.getElapsedTimeF32();  
+
+    compressInvisibleEntries(max_time);
 
     mImpl->mWaitingList.clear();
     mImpl->mVisibleGroups.clear();
@@ -1805,6 +1866,45 @@ void LLViewerRegion::killInvisibleObjects(F32 max_time)
     return;
 }
 
+//entries far beyond the draw distance are kept compressed until they are needed again,
+//LLVOCacheEntry::getDP() restores them when they come back into the interest radius.
+void LLViewerRegion::compressInvisibleEntries(F32 max_time)
+{
+    static LLCachedControl<F32> compression_radius_factor(gSavedSettings, "ObjectCacheCompressionRadiusFactor");
+    if(compression_radius_factor <= 0.f || mImpl->mCacheMap.empty() || max_time <= 0.f)
+    {
+        return;
+    }
+
+    LLTimer update_timer;
+    LLVector4a local_origin;
+    local_origin.load3((LLViewerCamera::getInstance()->getOrigin() - getOriginAgent()).mV);
+    const F32 dist_threshold = llmax((F32)compression_radius_factor, 1.f) * gAgentCamera.mDrawDistance;
+
+    const S32 MAX_UPDATE = 64;
+    S32 update_counter = llmin(MAX_UPDATE, (S32)mImpl->mCacheMap.size());
+    LLVOCacheEntry::vocache_entry_map_t::iterator iter = mImpl->mCacheMap.upper_bound(mLastCompressedEntryID);
+    for(; update_counter > 0; --update_counter, ++iter)
+    {
+        if(iter == mImpl->mCacheMap.end())
+        {
+            iter = mImpl->mCacheMap.begin();
+        }
+
+        LLVOCacheEntry* entry = iter->second;
+        mLastCompressedEntryID = iter->first;
+        if(entry->isCompressible(local_origin, dist_threshold))
+        {
+            entry->compress();
+        }
+
+        if(max_time < update_timer.getElapsedTimeF32()) //time out
+        {
+            break;
+        }
+    }
+}
+
 void LLViewerRegion::killObject(LLVOCacheEntry* entry, std::vector<LLDrawable*>& delete_list)
 {
     //kill the object.
@@ -2606,11 +2706,18 @@ void LLViewerRegion::decodeBoundingInfo(LLVOCacheEntry* entry)
             }
         }
 
+        LLDataPackerBinaryBuffer* dp = entry->getDP();
+        if(!dp)
+        {
+            discardCacheEntry(entry);
+            return;
+        }
+
         addActiveCacheEntry(entry);
 
         //set parent id
         U32 parent_id = 0;
-        LLViewerObject::unpackParentID(entry->getDP(), parent_id);
+        LLViewerObject::unpackParentID(dp, parent_id);
         if(parent_id != entry->getParentID())
         {               
             entry->setParentID(parent_id);
@@ -2623,6 +2730,14 @@ void LLViewerRegion::decodeBoundingInfo(LLVOCacheEntry* entry)
     
     //must not be active.
     llassert_always(!entry->isState(LLVOCacheEntry::ACTIVE));
+
+    LLDataPackerBinaryBuffer* dp = entry->getDP();
+    if(!dp)
+    {
+        discardCacheEntry(entry);
+        return;
+    }
+
     removeFromVOCacheTree(entry); //remove from cache octree if it is in.
 
     LLVector3 pos;
@@ -2630,7 +2745,7 @@ void LLViewerRegion::decodeBoundingInfo(LLVOCacheEntry* entry)
     LLQuaternion rot;
 
     //decode spatial info and parent info
-    U32 parent_id = LLViewerObject::extractSpatialExtents(entry->getDP(), pos, scale, rot);
+    U32 parent_id = LLViewerObject::extractSpatialExtents(dp, pos, scale, rot);
     
     U32 old_parent_id = entry->getParentID();
     bool same_old_parent = false;
@@ -2755,7 +2870,7 @@ LLViewerRegion::eCacheUpdateResult LLViewerRegion::cacheFullUpdate(LLDataPackerB
         entry->setValid();
 
         // we've seen this object before
-        if (entry->getCRC() == crc)
+        if (entry->getCRC() == crc && entry->hasData())
         {
             LL_DEBUGS("AnimatedObjects") << " got dupe for local_id " << local_id << LL_ENDL;
             dumpStack("AnimatedObjectsStack");
@@ -2881,7 +2996,7 @@ bool LLViewerRegion::probeCache(U32 local_id, U32 crc, U32 flags, U8 &cache_miss
     if (entry)
     {
         // we've seen this object before
-        if (entry->getCRC() == crc)
+        if (entry->getCRC() == crc && entry->hasData())
         {
             // Record a hit
             mRegionCacheHitCount++;
@@ -3008,7 +3123,12 @@ void LLViewerRegion::dumpCache()
         change_bin[changes]++;
     }
 
+    S32 raw_bytes, compressed_bytes, num_compressed;
+    getCacheMemoryInfo(raw_bytes, compressed_bytes, num_compressed);
+
     LL_INFOS() << "Count " << mImpl->mCacheMap.size() << LL_ENDL;
+    LL_INFOS() << "Resident bytes " << raw_bytes + compressed_bytes << " (raw " << raw_bytes
+        << ", compressed " << compressed_bytes << " in " << num_compressed << " entries)" << LL_ENDL;
     for (i = 0; i < BINS; i++)
     {
         LL_INFOS() << "Hits " << i << " " << hit_bin[i] << LL_ENDL;
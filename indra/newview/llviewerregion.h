@@ -402,6 +402,8 @@ public:
 
     U32 getNumOfVisibleGroups() const;
     U32 getNumOfActiveCachedObjects() const;
+    //update data held in memory by the cache entries of this region.
+    void getCacheMemoryInfo(S32& raw_bytes, S32& compressed_bytes, S32& num_compressed) const;
     LLSpatialPartition* getSpatialPartition(U32 type);
     LLVOCachePartition* getVOCachePartition();
 
@@ -436,7 +438,9 @@ private:
     void killObject(LLVOCacheEntry* entry, std::vector<LLDrawable*>& delete_list); //adds entry into list if it is safe to move into cache
     void removeFromVOCacheTree(LLVOCacheEntry* entry);
     void killCacheEntry(LLVOCacheEntry* entry, bool for_rendering = false); //physically delete the cache entry 
+    void discardCacheEntry(LLVOCacheEntry* entry); //drop an entry whose data is lost and request the object again
     void killInvisibleObjects(F32 max_time);
+    void compressInvisibleEntries(F32 max_time); //pack far away inactive entries into compact storage
     void createVisibleObjects(F32 max_time);
     void updateVisibleEntries(F32 max_time); //update visible entries
 
@@ -548,6 +552,7 @@ private:
     
     LLVOCacheEntry* mLastVisitedEntry;
     U32             mInvisibilityCheckHistory;  
+    U32             mLastCompressedEntryID; //local id where the last compression sweep stopped
 
     // Information for Homestead / CR-53
     S32 mClassID;
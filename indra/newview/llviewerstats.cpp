@@ -52,6 +52,7 @@
 #include "lldebugview.h"
 #include "llfasttimerview.h"
 #include "llviewerregion.h"
+#include "llvocache.h"
 #include "llvoavatar.h"
 #include "llvoavatarself.h"
 #include "llworld.h"
@@ -64,6 +65,8 @@
 #include "llvoicevivox.h"
 #include "llinventorymodel.h"
 #include "lluiusage.h"
+#include "fsframespikerecorder.h"
+#include "fsstatsrecorder.h"
 
 namespace LLStatViewer
 {
@@ -91,7 +94,8 @@ LLTrace::CountStatHandle<>  FPS("FPS", "Frames rendered"),
                             FRAMETIME_DOUBLED("frametimedoubled", "Ratio of frames 2x longer than previous"),
                             TEX_BAKES("texbakes", "Number of times avatar textures have been baked"),
                             TEX_REBAKES("texrebakes", "Number of times avatar textures have been forced to rebake"),
-                            NUM_NEW_OBJECTS("numnewobjectsstat", "Number of objects in scene that were not previously in cache");
+                            NUM_NEW_OBJECTS("numnewobjectsstat", "Number of objects in scene that were not previously in cache"),
+                            TEXTURES_DECODED("texturesdecoded", "Fetched textures handed to the main thread for creation");
 
 LLTrace::CountStatHandle<LLUnit<F64, LLUnits::Kilotriangles> > 
                             TRIANGLES_DRAWN("trianglesdrawnstat");
@@ -153,7 +157,10 @@ LLTrace::SampleStatHandle<> FPS_SAMPLE("fpssample"),
                             SHADER_OBJECTS("shaderobjects", "Object Shaders"),
                             DRAW_DISTANCE("drawdistance", "Draw Distance"),
                             WINDOW_WIDTH("windowwidth", "Window width"),
-                            WINDOW_HEIGHT("windowheight", "Window height");
+                            WINDOW_HEIGHT("windowheight", "Window height"),
+                            TEXTURE_FETCH_REQUESTS("texturefetchrequests", "Textures being fetched"),
+                            TEXTURE_FETCH_HTTP("texturefetchhttp", "Texture HTTP requests in flight"),
+                            MESH_REQUESTS_ACTIVE("meshrequestsactive", "Mesh header and LOD requests in flight");
 
 LLTrace::SampleStatHandle<LLUnit<F32, LLUnits::Percent> > 
                             PACKETS_LOST_PERCENT("packetslostpercentstat");
@@ -166,7 +173,10 @@ LLTrace::SampleStatHandle<F64Megabytes >    GL_TEX_MEM("gltexmemstat"),
                                                             RAW_MEM("rawmemstat"),
                                                             FORMATTED_MEM("formattedmemstat");
 LLTrace::SampleStatHandle<F64Kilobytes >    DELTA_BANDWIDTH("deltabandwidth", "Increase/Decrease in bandwidth based on packet loss"),
-                                                            MAX_BANDWIDTH("maxbandwidth", "Max bandwidth setting");
+                                                            MAX_BANDWIDTH("maxbandwidth", "Max bandwidth setting"),
+                                                            OBJECT_CACHE_RAW_MEM("objectcacherawmem", "Uncompressed object cache entries held in memory"),
+                                                            OBJECT_CACHE_COMPRESSED_MEM("objectcachecompressedmem", "Compressed object cache entries held in memory"),
+                                                            PROCESS_MEM("processmem", "Memory allocated by the viewer process");
 
     
 SimMeasurement<F64Milliseconds >    SIM_FRAME_TIME("simframemsec", "", LL_SIM_STAT_FRAMEMS),
@@ -351,12 +361,24 @@ void update_statistics()
 
     LLTrace::Recording& last_frame_recording = LLTrace::get_frame_recording().getLastRecording();
 
+    FSFrameSpikeRecorder::instance().recordFrame(last_frame_recording);
+    FSStatsRecorder::instance().recordFrame(last_frame_recording);
+
     record(LLStatViewer::TRIANGLES_DRAWN_PER_FRAME, last_frame_recording.getSum(LLStatViewer::TRIANGLES_DRAWN));
 
     sample(LLStatViewer::ENABLE_VBO,      (F64)gSavedSettings.getBOOL("RenderVBOEnable"));
     sample(LLStatViewer::LIGHTING_DETAIL, (F64)gPipeline.getLightingDetail());
     sample(LLStatViewer::DRAW_DISTANCE,   (F64)gSavedSettings.getF32("RenderFarClip"));
     sample(LLStatViewer::CHAT_BUBBLES,    gSavedSettings.getBOOL("UseChatBubbles"));
+    sample(LLStatViewer::OBJECT_CACHE_RAW_MEM, F64Bytes(LLVOCacheEntry::sRawBytes));
+    sample(LLStatViewer::OBJECT_CACHE_COMPRESSED_MEM, F64Bytes(LLVOCacheEntry::sCompressedBytes));
+    sample(LLStatViewer::PROCESS_MEM, LLMemory::getAllocatedMemKB());
+    if (LLAppViewer::getTextureFetch())
+    {
+        sample(LLStatViewer::TEXTURE_FETCH_REQUESTS, LLAppViewer::getTextureFetch()->getNumRequests());
+        sample(LLStatViewer::TEXTURE_FETCH_HTTP, LLAppViewer::getTextureFetch()->getNumHTTPRequests());
+    }
+    sample(LLStatViewer::MESH_REQUESTS_ACTIVE, LLMeshRepoThread::sActiveHeaderRequests + LLMeshRepoThread::sActiveLODRequests);
 
     typedef LLTrace::StatType<LLTrace::TimeBlockAccumulator>::instance_tracker_t stat_type_t;
 
@@ -138,7 +138,8 @@ extern LLTrace::CountStatHandle<>           FPS,
                                             FRAMETIME_DOUBLED,
                                             TEX_BAKES,
                                             TEX_REBAKES,
-                                            NUM_NEW_OBJECTS;
+                                            NUM_NEW_OBJECTS,
+                                            TEXTURES_DECODED;
 
 extern LLTrace::CountStatHandle<LLUnit<F64, LLUnits::Kilotriangles> > TRIANGLES_DRAWN;
 
@@ -192,7 +193,10 @@ extern LLTrace::SampleStatHandle<>      FPS_SAMPLE,
                                         SHADER_OBJECTS,
                                         DRAW_DISTANCE,
                                         WINDOW_WIDTH,
-                                        WINDOW_HEIGHT;
+                                        WINDOW_HEIGHT,
+                                        TEXTURE_FETCH_REQUESTS,
+                                        TEXTURE_FETCH_HTTP,
+                                        MESH_REQUESTS_ACTIVE;
 
 extern LLTrace::SampleStatHandle<LLUnit<F32, LLUnits::Percent> > PACKETS_LOST_PERCENT;
 
@@ -201,7 +205,10 @@ extern LLTrace::SampleStatHandle<F64Megabytes > GL_TEX_MEM,
                                                                     RAW_MEM,
                                                                     FORMATTED_MEM;
 extern LLTrace::SampleStatHandle<F64Kilobytes > DELTA_BANDWIDTH,
-                                                                    MAX_BANDWIDTH;
+                                                                    MAX_BANDWIDTH,
+                                                                    OBJECT_CACHE_RAW_MEM,
+                                                                    OBJECT_CACHE_COMPRESSED_MEM,
+                                                                    PROCESS_MEM;
 extern SimMeasurement<F64Milliseconds > SIM_FRAME_TIME,
                                                             SIM_NET_TIME,
                                                             SIM_OTHER_TIME,
@@ -58,6 +58,7 @@
 #include "llvovolume.h"
 #include "llviewermedia.h"
 #include "lltexturecache.h"
+#include "llviewerstats.h"
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "llmimetypes.h"
@@ -2320,6 +2321,7 @@ bool LLViewerFetchedTexture::updateFetch()
                 {
                     mIsRawImageValid = TRUE;
                     addToCreateTexture();
+                    add(LLStatViewer::TEXTURES_DECODED, 1);
                 }
 
                 if (mBoostLevel == LLGLTexture::BOOST_ICON)
@@ -35,6 +35,11 @@
 #include "pipeline.h"
 #include "llagentcamera.h"
 #include "llmemory.h"
+#ifdef LL_USESYSTEMLIBS
+#include <zlib.h>
+#else
+#include "zlib-ng/zlib.h"
+#endif
 
 //static variables
 U32 LLVOCacheEntry::sMinFrameRange = 0;
@@ -42,6 +47,10 @@ F32 LLVOCacheEntry::sNearRadius = 1.0f;
 F32 LLVOCacheEntry::sRearFarRadius = 1.0f;
 F32 LLVOCacheEntry::sFrontPixelThreshold = 1.0f;
 F32 LLVOCacheEntry::sRearPixelThreshold = 1.0f;
+S64 LLVOCacheEntry::sRawBytes = 0;
+S64 LLVOCacheEntry::sCompressedBytes = 0;
+S32 LLVOCacheEntry::sNumCompressed = 0;
+static LLTrace::MemStatHandle sVOCacheEntryMemStat("LLVOCacheEntry");
 BOOL LLVOCachePartition::sNeedsOcclusionCheck = FALSE;
 
 const S32 ENTRY_HEADER_SIZE = 6 * sizeof(S32);
@@ -74,11 +83,17 @@ LLVOCacheEntry::LLVOCacheEntry(U32 local_id, U32 crc, LLDataPackerBinaryBuffer &
     mSceneContrib(0.f),
     mValid(TRUE),
     mParentID(0),
-    mBSphereRadius(-1.0f)
+    mBSphereRadius(-1.0f),
+    mCompressedBuffer(NULL),
+    mCompressedSize(0),
+    mRawSize(0),
+    mMemFootprint(sVOCacheEntryMemStat)
 {
     mBuffer = new U8[dp.getBufferSize()];
     mDP.assignBuffer(mBuffer, dp.getBufferSize());
     mDP = dp;
+    sRawBytes += mDP.getBufferSize();
+    updateMemFootprint();
 }
 
 LLVOCacheEntry::LLVOCacheEntry()
@@ -94,9 +109,14 @@ LLVOCacheEntry::LLVOCacheEntry()
     mSceneContrib(0.f),
     mValid(TRUE),
     mParentID(0),
-    mBSphereRadius(-1.0f)
+    mBSphereRadius(-1.0f),
+    mCompressedBuffer(NULL),
+    mCompressedSize(0),
+    mRawSize(0),
+    mMemFootprint(sVOCacheEntryMemStat)
 {
     mDP.assignBuffer(mBuffer, 0);
+    updateMemFootprint();
 }
 
 LLVOCacheEntry::LLVOCacheEntry(LLAPRFile* apr_file)
@@ -107,7 +127,11 @@ LLVOCacheEntry::LLVOCacheEntry(LLAPRFile* apr_file)
     mSceneContrib(0.f),
     mValid(FALSE),
     mParentID(0),
-    mBSphereRadius(-1.0f)
+    mBSphereRadius(-1.0f),
+    mCompressedBuffer(NULL),
+    mCompressedSize(0),
+    mRawSize(0),
+    mMemFootprint(sVOCacheEntryMemStat)
 {
     S32 size = -1;
     BOOL success;
@@ -143,6 +167,7 @@ LLVOCacheEntry::LLVOCacheEntry(LLAPRFile* apr_file)
         if(success)
         {
             mDP.assignBuffer(mBuffer, size);
+            sRawBytes += size;
         }
         else
         {
@@ -162,11 +187,14 @@ LLVOCacheEntry::LLVOCacheEntry(LLAPRFile* apr_file)
         mEntry = NULL;
         mState = INACTIVE;
     }
+    updateMemFootprint();
 }
 
 LLVOCacheEntry::~LLVOCacheEntry()
 {
+    sRawBytes -= mDP.getBufferSize();
     mDP.freeBuffer();
+    freeCompressedBuffer();
 }
 
 void LLVOCacheEntry::updateEntry(U32 crc, LLDataPackerBinaryBuffer &dp)
@@ -177,12 +205,16 @@ void LLVOCacheEntry::updateEntry(U32 crc, LLDataPackerBinaryBuffer &dp)
         mCRCChangeCount++;
     }
 
+    sRawBytes -= mDP.getBufferSize();
     mDP.freeBuffer();
+    freeCompressedBuffer();
 
     llassert_always(dp.getBufferSize() > 0);
     mBuffer = new U8[dp.getBufferSize()];
     mDP.assignBuffer(mBuffer, dp.getBufferSize());
     mDP = dp;
+    sRawBytes += mDP.getBufferSize();
+    updateMemFootprint();
 }
 
 void LLVOCacheEntry::setParentID(U32 id) 
@@ -213,7 +245,7 @@ void LLVOCacheEntry::removeAllChildren()
 //virtual 
 void LLVOCacheEntry::setOctreeEntry(LLViewerOctreeEntry* entry)
 {
-    if(!entry && mDP.getBufferSize() > 0)
+    if(!entry && getDP())
     {
         LLUUID fullid;
         LLViewerObject::unpackUUID(&mDP, fullid, "ID");
@@ -310,6 +342,11 @@ LLVOCacheEntry* LLVOCacheEntry::getChild()
 
 LLDataPackerBinaryBuffer *LLVOCacheEntry::getDP()
 {
+    if (isCompressed() && !decompress())
+    {
+        return NULL;
+    }
+
     if (mDP.getBufferSize() == 0)
     {
         //LL_INFOS() << "Not getting cache entry, invalid!" << LL_ENDL;
@@ -324,6 +361,118 @@ void LLVOCacheEntry::recordHit()
     mHitCount++;
 }
 
+//an inactive root entry whose bounding sphere lies entirely beyond dist_threshold
+//from the camera is not going to be instantiated any time soon.
+bool LLVOCacheEntry::isCompressible(const LLVector4a& local_camera_origin, F32 dist_threshold)
+{
+    if(isCompressed() || !mDP.getBufferSize() || !isState(INACTIVE) || !getEntry())
+    {
+        return false;
+    }
+
+    LLVector4a lookAt;
+    lookAt.setSub(getPositionGroup(), local_camera_origin);
+    dist_threshold += getBinRadius();
+
+    return lookAt.dot3(lookAt).getF32() > dist_threshold * dist_threshold;
+}
+
+bool LLVOCacheEntry::compress()
+{
+    if(isCompressed() || mDP.getBufferSize() <= 0)
+    {
+        return false;
+    }
+
+    const S32 raw_size = mDP.getBufferSize();
+    uLongf compressed_size = compressBound(raw_size);
+    U8* scratch = new(std::nothrow) U8[compressed_size];
+    if(!scratch)
+    {
+        return false;
+    }
+
+    if(compress2(scratch, &compressed_size, mBuffer, raw_size, Z_BEST_SPEED) != Z_OK || (S32)compressed_size >= raw_size)
+    {
+        //not worth it, keep the raw data.
+        delete[] scratch;
+        return false;
+    }
+
+    //copy into an exactly sized block so the slack of compressBound() is not kept around.
+    mCompressedBuffer = new(std::nothrow) U8[compressed_size];
+    if(!mCompressedBuffer)
+    {
+        delete[] scratch;
+        return false;
+    }
+    memcpy(mCompressedBuffer, scratch, compressed_size);
+    delete[] scratch;
+
+    mCompressedSize = compressed_size;
+    mRawSize = raw_size;
+    sRawBytes -= raw_size;
+    sCompressedBytes += mCompressedSize;
+    sNumCompressed++;
+
+    mDP.freeBuffer();
+    mBuffer = NULL;
+    updateMemFootprint();
+
+    return true;
+}
+
+bool LLVOCacheEntry::decompress()
+{
+    if(!isCompressed())
+    {
+        return true;
+    }
+
+    U8* buffer = new(std::nothrow) U8[mRawSize];
+    if(!buffer)
+    {
+        return false;
+    }
+
+    uLongf raw_size = mRawSize;
+    if(uncompress(buffer, &raw_size, mCompressedBuffer, mCompressedSize) != Z_OK || (S32)raw_size != mRawSize)
+    {
+        LL_WARNS() << "Failed to decompress cache entry " << mLocalID << ", invalidating it." << LL_ENDL;
+        delete[] buffer;
+        freeCompressedBuffer();
+        updateMemFootprint();
+        setValid(FALSE);
+        return false;
+    }
+
+    mBuffer = buffer;
+    mDP.assignBuffer(mBuffer, mRawSize);
+    sRawBytes += mRawSize;
+    freeCompressedBuffer();
+    updateMemFootprint();
+
+    return true;
+}
+
+void LLVOCacheEntry::freeCompressedBuffer()
+{
+    if(mCompressedBuffer)
+    {
+        sCompressedBytes -= mCompressedSize;
+        sNumCompressed--;
+        delete[] mCompressedBuffer;
+        mCompressedBuffer = NULL;
+    }
+    mCompressedSize = 0;
+    mRawSize = 0;
+}
+
+void LLVOCacheEntry::updateMemFootprint()
+{
+    mMemFootprint.setBytes(sizeof(LLVOCacheEntry) + getResidentSize());
+}
+
 
 void LLVOCacheEntry::dump() const
 {
@@ -337,7 +486,7 @@ void LLVOCacheEntry::dump() const
 
 S32 LLVOCacheEntry::writeToBuffer(U8 *data_buffer) const
 {
-    S32 size = mDP.getBufferSize();
+    S32 size = getRawSize();
 
     if (size > MAX_ENTRY_BODY_SIZE)
     {
@@ -351,7 +500,20 @@ S32 LLVOCacheEntry::writeToBuffer(U8 *data_buffer) const
     memcpy(data_buffer + (3 * sizeof(U32)), &mDupeCount, sizeof(S32));
     memcpy(data_buffer + (4 * sizeof(U32)), &mCRCChangeCount, sizeof(S32));
     memcpy(data_buffer + (5 * sizeof(U32)), &size, sizeof(S32));
-    memcpy(data_buffer + ENTRY_HEADER_SIZE, (void*)mBuffer, size);
+    if(isCompressed())
+    {
+        //inflate straight into the output, the entry itself stays compressed.
+        uLongf raw_size = size;
+        if(uncompress(data_buffer + ENTRY_HEADER_SIZE, &raw_size, mCompressedBuffer, mCompressedSize) != Z_OK || (S32)raw_size != size)
+        {
+            LL_WARNS() << "Failed to decompress cache entry " << mLocalID << LL_ENDL;
+            return 0;
+        }
+    }
+    else
+    {
+        memcpy(data_buffer + ENTRY_HEADER_SIZE, (void*)mBuffer, size);
+    }
 
     return ENTRY_HEADER_SIZE + size;
 }
@@ -532,6 +694,7 @@ void LLVOCacheEntry::setBoundingInfo(const LLVector3& pos, const LLVector3& scal
     {
         setBinRadius(llmin(size.getLength3().getF32() * 4.f, 256.f));
     }
+    dirtyGroupBounds();
 }
 
 //make the parent bounding box to include all children
@@ -593,6 +756,19 @@ void LLVOCacheEntry::updateParentBoundingInfo(const LLVOCacheEntry* child)
     size.setSub(newMax, newMin);
     size.mul(0.5f);
     setBinRadius(llmin(size.getLength3().getF32() * 4.f, 256.f));
+    dirtyGroupBounds();
+}
+
+//bounds changed in place while in the cache tree, the group bounds and radius are stale.
+void LLVOCacheEntry::dirtyGroupBounds()
+{
+    if(hasState(IN_VO_TREE) && getGroup())
+    {
+        LLVOCacheGroup* group = (LLVOCacheGroup*)getGroup();
+        group->dirtyMaxBinRadius();
+        group->unbound();
+        group->setState(LLViewerOctreeGroup::OBJECT_DIRTY);
+    }
 }
 //-------------------------------------------------------------------
 //LLVOCachePartition
@@ -622,6 +798,62 @@ void LLVOCacheGroup::handleChildAddition(const OctreeNode* parent, OctreeNode* c
     ((LLViewerOctreeGroup*)child->getListener(0))->unbound();
 }
 
+//virtual
+void LLVOCacheGroup::handleInsertion(const TreeNode* node, LLViewerOctreeEntry* obj)
+{
+    if(mMaxBinRadius >= 0.f)
+    {
+        mMaxBinRadius = llmax(mMaxBinRadius, obj->getBinRadius());
+    }
+    LLOcclusionCullingGroup::handleInsertion(node, obj);
+}
+
+//virtual
+void LLVOCacheGroup::handleRemoval(const TreeNode* node, LLViewerOctreeEntry* obj)
+{
+    dirtyMaxBinRadius();
+    LLOcclusionCullingGroup::handleRemoval(node, obj); //may destroy this group
+}
+
+//Scene contribution is (bin radius)^2 / (distance - near radius), so no entry
+//in this group can beat the largest bin radius over the closest point of the
+//group's object bounds.
+F32 LLVOCacheGroup::getMaxSceneContribution(const LLVector4a& camera_origin, F32 max_dist)
+{
+    if(isDirty() || hasState(OBJECT_DIRTY) || !getOctreeNode() || isEmpty())
+    {
+        return -1.f;
+    }
+
+    if(mMaxBinRadius < 0.f)
+    {
+        mMaxBinRadius = 0.f;
+        for(element_iter i = getDataBegin(); i != getDataEnd(); ++i)
+        {
+            mMaxBinRadius = llmax(mMaxBinRadius, (*i)->getBinRadius());
+        }
+    }
+
+    //distance from the camera to the closest point of the object bounds
+    LLVector4a closest;
+    closest.setMax(camera_origin, mObjectExtents[0]);
+    closest.setMin(closest, mObjectExtents[1]);
+    closest.sub(camera_origin);
+    F32 distance = closest.getLength3().getF32();
+
+    if(distance >= max_dist + mMaxBinRadius)
+    {
+        return 0.f; //every entry is out of draw distance
+    }
+
+    distance -= LLVOCacheEntry::sNearRadius;
+    if(distance <= 0.f)
+    {
+        return -1.f; //may hold nearby objects, check them one by one
+    }
+    return (mMaxBinRadius * mMaxBinRadius) / distance;
+}
+
 LLVOCachePartition::LLVOCachePartition(LLViewerRegion* regionp)
 {
     mLODPeriod = 16;
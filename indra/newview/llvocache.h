@@ -107,7 +107,7 @@ public:
 
     void dump() const;
     S32 writeToBuffer(U8 *data_buffer) const;
-    LLDataPackerBinaryBuffer *getDP();
+    LLDataPackerBinaryBuffer *getDP(); //decompresses the entry on demand.
     void recordHit();
     void recordDupe() { mDupeCount++; }
     
@@ -133,16 +133,28 @@ public:
     void setUpdateFlags(U32 flags) {mUpdateFlags = flags;}
     U32  getUpdateFlags() const    {return mUpdateFlags;}
 
+    //compact storage for entries far outside of the interest radius.
+    bool isCompressible(const LLVector4a& local_camera_origin, F32 dist_threshold);
+    bool compress();   //deflate the raw update data and release the raw buffer.
+    bool decompress(); //restore the raw update data.
+    bool isCompressed() const {return mCompressedBuffer != NULL;}
+    bool hasData() const {return isCompressed() || mDP.getBufferSize() > 0;} //false once a failed decompress() dropped the data
+    S32  getRawSize() const   {return isCompressed() ? mRawSize : mDP.getBufferSize();}
+    S32  getResidentSize() const {return isCompressed() ? mCompressedSize : mDP.getBufferSize();}
+
     static void updateDebugSettings();
     static F32  getSquaredPixelThreshold(bool is_front);
 
 private:
     void updateParentBoundingInfo(const LLVOCacheEntry* child); 
+    void dirtyGroupBounds();
+    void freeCompressedBuffer();
+    void updateMemFootprint();
 
 public:
     typedef std::map<U32, LLPointer<LLVOCacheEntry> >      vocache_entry_map_t;
     typedef std::set<LLVOCacheEntry*>                      vocache_entry_set_t;
-    typedef std::set<LLVOCacheEntry*, CompareVOCacheEntry> vocache_entry_priority_list_t;   
+    typedef std::vector<LLVOCacheEntry*>                   vocache_entry_priority_list_t; //sorted with CompareVOCacheEntry when used
 
     S32                         mLastCameraUpdated;
 protected:
@@ -155,6 +167,10 @@ protected:
     S32                         mCRCChangeCount;
     LLDataPackerBinaryBuffer    mDP;
     U8                          *mBuffer;
+    U8                          *mCompressedBuffer; //deflated update data, set only when mDP holds no buffer.
+    S32                         mCompressedSize;
+    S32                         mRawSize; //size of the update data before compression.
+    LLTrace::MemFootprint       mMemFootprint;
 
     F32                         mSceneContrib; //projected scene contributuion of this object.
     U32                         mState; //high 16 bits reserved for special use.
@@ -171,18 +187,35 @@ public:
     static F32                  sRearFarRadius;
     static F32                  sFrontPixelThreshold;
     static F32                  sRearPixelThreshold;
+
+    //update data held in memory by all cache entries.
+    static S64                  sRawBytes;        //uncompressed entries
+    static S64                  sCompressedBytes; //compressed entries
+    static S32                  sNumCompressed;
 };
 
 class LLVOCacheGroup : public LLOcclusionCullingGroup
 {
 public:
-    LLVOCacheGroup(OctreeNode* node, LLViewerOctreePartition* part) : LLOcclusionCullingGroup(node, part){} 
+    LLVOCacheGroup(OctreeNode* node, LLViewerOctreePartition* part) : LLOcclusionCullingGroup(node, part), mMaxBinRadius(-1.f){} 
 
     //virtual
     void handleChildAddition(const OctreeNode* parent, OctreeNode* child);
+    //virtual
+    void handleInsertion(const TreeNode* node, LLViewerOctreeEntry* obj);
+    //virtual
+    void handleRemoval(const TreeNode* node, LLViewerOctreeEntry* obj);
+
+    //upper bound of LLVOCacheEntry::calcSceneContribution() over all entries in this group.
+    //returns a negative number if the group bounds are not up to date.
+    F32 getMaxSceneContribution(const LLVector4a& camera_origin, F32 max_dist);
+    void dirtyMaxBinRadius() {mMaxBinRadius = -1.f;}
 
 protected:
     virtual ~LLVOCacheGroup();
+
+private:
+    F32 mMaxBinRadius; //largest bin radius of the entries in this group, negative if unknown.
 };
 
 class LLVOCachePartition : public LLViewerOctreePartition
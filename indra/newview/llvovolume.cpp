@@ -3861,6 +3861,27 @@ BOOL LLVOVolume::isRiggedMesh() const
     return isMesh() && getSkinInfo();
 }
 
+bool LLVOVolume::needsTangents() const
+{
+    for (U8 i = 0; i < getNumTEs(); ++i)
+    {
+        const LLTextureEntry* te = getTE(i);
+        if (!te)
+        {
+            continue;
+        }
+
+        const LLMaterialPtr mat = te->getMaterialParams();
+        if (te->getBumpmap() ||
+            te->getTexGen() != LLTextureEntry::TEX_GEN_DEFAULT ||
+            (mat.notNull() && mat->getNormalID().notNull()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 //----------------------------------------------------------------------------
 U32 LLVOVolume::getExtendedMeshFlags() const
 {
@@ -4938,8 +4959,21 @@ BOOL LLVOVolume::lineSegmentIntersect(const LLVector4a& start, const LLVector4a&
             // This calculates the bounding box of the skinned mesh from scratch. It's actually quite expensive, but not nearly as expensive as building a full octree.
             // rebuild_face_octrees = false because an octree for this face will be built later only if needed for narrow phase picking.
             updateRiggedVolume(true, i, false);
+
+            // <FS:ND> Create a debug log for octree insertions if requested.
+            static LLCachedControl<bool> debugOctree(gSavedSettings,"FSCreateOctreeLog");
+            bool _debugOT( debugOctree && !transform );
+            if( _debugOT )
+                nd::octree::debug::gOctreeDebug += 1;
+            // </FS:ND>
+
             face_hit = volume->lineSegmentIntersect(local_start, local_end, i,
                                                     &p, &tc, &n, &tn);
+
+            // <FS:ND> Reset octree log
+            if( _debugOT )
+                nd::octree::debug::gOctreeDebug -= 1;
+            // </FS:ND>
             
             if (face_hit >= 0 && mDrawable->getNumFaces() > face_hit)
             {
@@ -5256,20 +5290,9 @@ void LLRiggedVolume::update(const LLMeshSkinInfo* skin, LLVOAvatar* avatar, cons
 
             if (rebuild_face_octrees)
             {
+                // the skinned positions moved, drop the face octree and let
+                // LLVolume::lineSegmentIntersect() rebuild it if the face is ever picked
                 dst_face.destroyOctree();
-                // <FS:ND> Create a debug log for octree insertions if requested.
-                static LLCachedControl<bool> debugOctree(gSavedSettings,"FSCreateOctreeLog");
-                bool _debugOT( debugOctree );
-                if( _debugOT )
-                    nd::octree::debug::gOctreeDebug += 1;
-                // </FS:ND>
-
-                dst_face.createOctree();
-
-                // <FS:ND> Reset octree log
-                if( _debugOT )
-                    nd::octree::debug::gOctreeDebug -= 1;
-                // </FS:ND>
             }
         }
     }
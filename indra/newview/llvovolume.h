@@ -296,6 +296,8 @@ public:
     virtual BOOL isMesh() const;
     virtual BOOL isRiggedMesh() const;
     virtual BOOL hasLightTexture() const;
+    // true if any face is bump or normal mapped or uses planar texgen
+    bool needsTangents() const;
 
     
     BOOL isVolumeGlobal() const;
@@ -43,6 +43,8 @@
 
 #include "permissionstracker.h"
 
+#include "fsobjectpropertiesbroker.h"
+
 #define PERMISSION_ENTRY_EXPIRY_TIME    3600.0
 
 PermissionsTracker::PermissionsTracker()
@@ -77,23 +79,7 @@ void PermissionsTracker::addPermissionsEntry(const LLUUID& source_id, Permission
             mRequestedIDs.push_back(source_id);
 
             // send a request out to get this object's details
-            LLMessageSystem* msg = gMessageSystem;
-
-            msg->newMessageFast(_PREHASH_ObjectSelect);
-            msg->nextBlockFast(_PREHASH_AgentData);
-            msg->addUUIDFast(_PREHASH_AgentID, gAgentID);
-            msg->addUUIDFast(_PREHASH_SessionID, gAgentSessionID);
-            msg->nextBlockFast(_PREHASH_ObjectData);
-            msg->addU32Fast(_PREHASH_ObjectLocalID, vo->getLocalID());
-            msg->sendReliable(gAgentAvatarp->getRegion()->getHost());
-
-            msg->newMessageFast(_PREHASH_ObjectDeselect);
-            msg->nextBlockFast(_PREHASH_AgentData);
-            msg->addUUIDFast(_PREHASH_AgentID, gAgentID);
-            msg->addUUIDFast(_PREHASH_SessionID, gAgentSessionID);
-            msg->nextBlockFast(_PREHASH_ObjectData);
-            msg->addU32Fast(_PREHASH_ObjectLocalID, vo->getLocalID());
-            msg->sendReliable(gAgentAvatarp->getRegion()->getHost());
+            FSObjectPropertiesBroker::instance().requestProperties(source_id);
         }
     }
 
@@ -125,6 +125,11 @@
 
 #include "llenvironment.h"
 #include "llsettingsvo.h"
+#include "threadpool.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
 
 #ifdef _DEBUG
 // Debug indices is disabled for now for debug performance - djs 4/24/02
@@ -435,7 +440,8 @@ LLPipeline::LLPipeline() :
     mLightMovingMask(0),
     mLightingDetail(0),
     mScreenWidth(0),
-    mScreenHeight(0)
+    mScreenHeight(0),
+    mCullThreadPool(NULL)
 {
     mNoiseMap = 0;
     mTrueNoiseMap = 0;
@@ -468,6 +474,14 @@ void LLPipeline::init()
     gOctreeMinSize = gSavedSettings.getF32("OctreeMinimumNodeSize");
     sDynamicLOD = gSavedSettings.getBOOL("RenderDynamicLOD");
     sRenderBump = gSavedSettings.getBOOL("RenderObjectBump");
+
+    U32 cull_threads = gSavedSettings.getU32("RenderCullThreads");
+    if (cull_threads && !mCullThreadPool)
+    {
+        mCullThreadPool = new LL::ThreadPool("SpatialCull", cull_threads);
+        mCullThreadPool->start();
+    }
+
     sUseTriStrips = gSavedSettings.getBOOL("RenderUseTriStrips");
     LLVertexBuffer::sUseStreamDraw = gSavedSettings.getBOOL("RenderUseStreamVBO");
     // <FS:Ansariel> Vertex Array Objects are required in OpenGL core profile
@@ -753,6 +767,14 @@ void LLPipeline::cleanup()
     mMovedBridge.clear();
     mShiftList.clear();
 
+    if (mCullThreadPool)
+    {
+        mCullThreadPool->close();
+        delete mCullThreadPool;
+        mCullThreadPool = NULL;
+    }
+    mCullBranches.clear();
+
     mInitialized = false;
 
     // <FS:Ansariel> FIRE-16829: Visual Artifacts with ALM enabled on AMD graphics
@@ -2566,31 +2588,7 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, LLPlane* pla
         mCubeVB->setBuffer(LLVertexBuffer::MAP_VERTEX);
     }
     
-    for (LLWorld::region_list_t::const_iterator iter = world.getRegionList().begin(); // <FS:Ansariel> Factor out instance() call
-            iter != world.getRegionList().end(); ++iter)
-    {
-        LLViewerRegion* region = *iter;
-
-        for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
-        {
-            LLSpatialPartition* part = region->getSpatialPartition(i);
-            if (part)
-            {
-                if (!hud_attachments ? LLViewerRegion::PARTITION_BRIDGE == i || hasRenderType(part->mDrawableType) : hasRenderType(part->mDrawableType))
-                {
-                    part->cull(camera);
-                }
-            }
-        }
-
-        //scan the VO Cache tree
-        LLVOCachePartition* vo_part = region->getVOCachePartition();
-        if(vo_part)
-        {
-            bool do_occlusion_cull = can_use_occlusion && use_occlusion && !gUseWireframe;
-            vo_part->cull(camera, do_occlusion_cull);
-        }
-    }
+    cullPartitions(camera, hud_attachments, can_use_occlusion && use_occlusion && !gUseWireframe);
 
     if (bound_shader)
     {
@@ -2657,6 +2655,187 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, LLPlane* pla
     }
 }
 
+namespace
+{
+    // branches shared by the main thread and the cull workers, each index is claimed by whoever gets to it first
+    struct CullJobs
+    {
+        std::atomic<U32> mNext { 0 };
+        std::atomic<U32> mDone { 0 };
+        U32 mCount = 0;
+        std::function<void (U32)> mGather;
+
+        void run()
+        {
+            for (U32 i = mNext++; i < mCount; i = mNext++)
+            {
+                mGather(i);
+                mDone++;
+            }
+        }
+    };
+}
+
+void LLPipeline::cullPartitions(LLCamera& camera, bool hud_attachments, bool do_occlusion_cull)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+    const LLWorld::region_list_t& regions = LLWorld::getInstance()->getRegionList();
+
+    if (!mCullThreadPool)
+    {
+        for (LLWorld::region_list_t::const_iterator iter = regions.begin(); iter != regions.end(); ++iter)
+        {
+            LLViewerRegion* region = *iter;
+
+            for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+            {
+                LLSpatialPartition* part = region->getSpatialPartition(i);
+                if (part)
+                {
+                    if (!hud_attachments ? LLViewerRegion::PARTITION_BRIDGE == i || hasRenderType(part->mDrawableType) : hasRenderType(part->mDrawableType))
+                    {
+                        part->cull(camera);
+                    }
+                }
+            }
+
+            //scan the VO Cache tree
+            LLVOCachePartition* vo_part = region->getVOCachePartition();
+            if(vo_part)
+            {
+                vo_part->cull(camera, do_occlusion_cull);
+            }
+        }
+        return;
+    }
+
+    // Lay out everything the loop above would cull, in the same order.  Each partition is split into
+    // its root, gathered here, and one branch per root child for the workers.
+    U32 count = 0;
+    U32 gather_count = 0;
+    auto next_branch = [this, &count]() -> CullBranch&
+    {
+        if (count == mCullBranches.size())
+        {
+            mCullBranches.emplace_back();
+        }
+        CullBranch& branch = mCullBranches[count++];
+        branch.mPartition = NULL;
+        branch.mCachePartition = NULL;
+        branch.mNode = NULL;
+        branch.mRes = 0;
+        branch.mDescend = false;
+        branch.mChildren = 0;
+        branch.mVisits.clear();
+        return branch;
+    };
+
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_PIPELINE("cull - roots");
+        for (LLWorld::region_list_t::const_iterator iter = regions.begin(); iter != regions.end(); ++iter)
+        {
+            LLViewerRegion* region = *iter;
+
+            for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+            {
+                LLSpatialPartition* part = region->getSpatialPartition(i);
+                if (part)
+                {
+                    if (!hud_attachments ? LLViewerRegion::PARTITION_BRIDGE == i || hasRenderType(part->mDrawableType) : hasRenderType(part->mDrawableType))
+                    {
+                        part->cullRebound();
+
+                        U32 root_index = count;
+                        CullBranch& root = next_branch();
+                        root.mPartition = part;
+                        root.mNode = part->mOctree;
+                        part->cullFrustum(camera, root.mNode, 0, false, root.mVisits);
+
+                        S32 res = root.mVisits.front().mRes;
+                        if (res)
+                        {
+                            for (U32 c = 0; c < part->mOctree->getChildCount(); c++)
+                            {
+                                CullBranch& branch = next_branch();
+                                branch.mPartition = part;
+                                branch.mNode = part->mOctree->getChild(c);
+                                branch.mRes = res;
+                                branch.mDescend = true;
+                                gather_count++;
+                            }
+                            mCullBranches[root_index].mChildren = count - root_index - 1;
+                        }
+                    }
+                }
+            }
+
+            LLVOCachePartition* vo_part = region->getVOCachePartition();
+            if (vo_part)
+            {
+                next_branch().mCachePartition = vo_part;
+            }
+        }
+    }
+
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_PIPELINE("cull - frustum");
+        std::shared_ptr<CullJobs> jobs = std::make_shared<CullJobs>();
+        jobs->mCount = count;
+        CullBranch* branches = mCullBranches.data();
+        jobs->mGather = [branches, &camera](U32 i)
+        {
+            CullBranch& branch = branches[i];
+            if (branch.mDescend)
+            {
+                branch.mPartition->cullFrustum(camera, branch.mNode, branch.mRes, true, branch.mVisits);
+            }
+        };
+
+        // the main thread takes its share too, so a busy or closed pool only costs the parallelism
+        if (gather_count > 1)
+        {
+            size_t workers = llmin(mCullThreadPool->getWidth(), (size_t) gather_count - 1);
+            for (size_t i = 0; i < workers; ++i)
+            {
+                mCullThreadPool->getQueue().postIfOpen([jobs]() { jobs->run(); });
+            }
+        }
+
+        jobs->run();
+        while (jobs->mDone < count)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_PIPELINE("cull - replay");
+        // occlusion and visibility updates stay on this thread, in the order of the serial loop
+        U32 i = 0;
+        while (i < count)
+        {
+            CullBranch& branch = mCullBranches[i];
+            if (branch.mCachePartition)
+            {
+                //scan the VO Cache tree
+                branch.mCachePartition->cull(camera, do_occlusion_cull);
+                ++i;
+                continue;
+            }
+
+            U32 end = i + 1 + branch.mChildren;
+            if (branch.mPartition->cullReplay(camera, branch.mVisits))
+            {
+                for (U32 j = i + 1; j < end; ++j)
+                {
+                    branch.mPartition->cullReplay(camera, mCullBranches[j].mVisits);
+                }
+            }
+            i = end;
+        }
+    }
+}
+
 void LLPipeline::markNotCulled(LLSpatialGroup* group, LLCamera& camera)
 {
     if (group->isEmpty())
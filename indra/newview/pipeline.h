@@ -50,6 +50,12 @@ class LLVOAvatar;
 class LLVOPartGroup;
 class LLGLSLShader;
 class LLDrawPoolAlpha;
+class LLVOCachePartition;
+
+namespace LL
+{
+    class ThreadPool;
+}
 
 typedef enum e_avatar_skinning_method
 {
@@ -241,6 +247,7 @@ public:
     bool getVisibleExtents(LLCamera& camera, LLVector3 &min, LLVector3& max);
     bool getVisiblePointCloud(LLCamera& camera, LLVector3 &min, LLVector3& max, std::vector<LLVector3>& fp, LLVector3 light_dir = LLVector3(0,0,0));
     void updateCull(LLCamera& camera, LLCullResult& result, LLPlane* plane = NULL, bool hud_attachments = false);  //if water_clip is 0, ignore water plane, 1, cull to above plane, -1, cull to below plane; different because SL-11614
+    void cullPartitions(LLCamera& camera, bool hud_attachments, bool do_occlusion_cull);
     void createObjects(F32 max_dtime);
     void createObject(LLViewerObject* vobj);
     void processPartitionQ();
@@ -756,6 +763,23 @@ protected:
     LLDrawable::drawable_vector_t mMovedBridge;
     LLDrawable::drawable_vector_t   mShiftList;
 
+    /////////////////////////////////////////////
+    //
+    // Concurrent partition culling, see cullPartitions()
+    //
+    struct CullBranch
+    {
+        LLSpatialPartition*     mPartition;
+        LLVOCachePartition*     mCachePartition;    // set instead of mPartition for a VO cache partition
+        const OctreeNode*       mNode;
+        S32                     mRes;               // frustum result handed down to mNode
+        bool                    mDescend;           // false for a partition root, which is gathered alone
+        U32                     mChildren;          // number of branches following a partition root
+        LLViewerOctreeCull::cull_visit_list_t mVisits;
+    };
+    std::vector<CullBranch> mCullBranches;          // never shrunk, so visit lists keep their capacity
+    LL::ThreadPool*         mCullThreadPool;
+
     /////////////////////////////////////////////
     //
     //
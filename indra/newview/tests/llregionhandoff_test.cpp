@@ -0,0 +1,264 @@
+/** 
+ * @file llregionhandoff_test.cpp
+ * @brief LLRegionHandoffTracker tests
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../llregionhandoff.h"
+// Tut header
+#include "../test/lltut.h"
+
+#include <map>
+
+// -------------------------------------------------------------------------------------------
+// Replay harness
+// Message sequences captured while driving a vehicle across a region boundary are
+// replayed against a minimal model of LLViewerObjectList: objects are created on the
+// first update from any region and moved on updates from another region. Kills and
+// claims go through the same LLRegionHandoffTracker calls as LLViewerObjectList, and the
+// object is killed when onKill() says KILL_NOW or when a deferred kill expires.
+// -------------------------------------------------------------------------------------------
+namespace
+{
+    const F32 REGION_WIDTH = 256.f;
+    const U64 REGION_WEST = 0x000F4000000F4000ULL;
+    const U64 REGION_EAST = 0x000F4100000F4000ULL;
+
+    enum EMessage
+    {
+        MSG_UPDATE,
+        MSG_KILL,
+        MSG_IDLE
+    };
+
+    struct CapturedMessage
+    {
+        F64         mTime;
+        EMessage    mType;
+        U64         mRegion;
+        S32         mObject;
+        LLVector3   mPosition;  // region local, from the last update seen by the viewer
+        LLVector3   mVelocity;
+    };
+
+    struct ObjectModel
+    {
+        ObjectModel() : mRegion(0), mAlive(false) {}
+        U64         mRegion;
+        bool        mAlive;
+        LLVector3   mPosition;
+        LLVector3   mVelocity;
+    };
+
+    struct ReplayResult
+    {
+        ReplayResult() : mCreated(0), mKilled(0) {}
+        S32 mCreated;
+        S32 mKilled;
+    };
+}
+
+namespace tut
+{
+    struct regionhandoff_test
+    {
+        regionhandoff_test() : mLastKillAction(LLRegionHandoffTracker::KILL_NOW) {}
+
+        LLRegionHandoffTracker mTracker;
+        LLRegionHandoffTracker::EKillAction mLastKillAction;
+        std::map<S32, ObjectModel> mObjects;
+
+        LLUUID idFor(S32 object)
+        {
+            LLUUID id;
+            id.mData[0] = (U8)(object + 1);
+            return id;
+        }
+
+        ReplayResult replay(const CapturedMessage* messages, S32 count)
+        {
+            ReplayResult result;
+            for (S32 i = 0; i < count; ++i)
+            {
+                const CapturedMessage& msg = messages[i];
+                ObjectModel& object = mObjects[msg.mObject];
+                const LLUUID id = idFor(msg.mObject);
+
+                if (msg.mType == MSG_UPDATE)
+                {
+                    if (!object.mAlive)
+                    {
+                        object.mAlive = true;
+                        result.mCreated++;
+                    }
+                    else if (object.mRegion != msg.mRegion)
+                    {
+                        mTracker.claim(id, msg.mRegion);
+                    }
+                    object.mRegion = msg.mRegion;
+                    object.mPosition = msg.mPosition;
+                    object.mVelocity = msg.mVelocity;
+                }
+                else if (msg.mType == MSG_KILL && object.mAlive)
+                {
+                    mLastKillAction = mTracker.onKill(id, msg.mRegion, object.mRegion,
+                                                      object.mPosition, object.mVelocity,
+                                                      REGION_WIDTH, msg.mTime);
+                    if (mLastKillAction == LLRegionHandoffTracker::KILL_NOW)
+                    {
+                        object.mAlive = false;
+                        result.mKilled++;
+                    }
+                }
+
+                uuid_vec_t expired;
+                mTracker.expire(msg.mTime, expired);
+                for (uuid_vec_t::iterator iter = expired.begin(); iter != expired.end(); ++iter)
+                {
+                    for (std::map<S32, ObjectModel>::iterator obj = mObjects.begin(); obj != mObjects.end(); ++obj)
+                    {
+                        if (idFor(obj->first) == *iter && obj->second.mAlive)
+                        {
+                            obj->second.mAlive = false;
+                            result.mKilled++;
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+    };
+
+    typedef test_group<regionhandoff_test> regionhandoff_t;
+    typedef regionhandoff_t::object regionhandoff_object_t;
+    tut::regionhandoff_t tut_regionhandoff("LLRegionHandoffTracker");
+
+    // isCrossing() only accepts moving objects heading out of the region
+    template<> template<>
+    void regionhandoff_object_t::test<1>()
+    {
+        ensure("stationary object near the edge", !mTracker.isCrossing(LLVector3(255.f, 128.f, 20.f), LLVector3::zero, REGION_WIDTH));
+        ensure("moving away from the edge", !mTracker.isCrossing(LLVector3(255.f, 128.f, 20.f), LLVector3(-10.f, 0.f, 0.f), REGION_WIDTH));
+        ensure("moving in the middle of the region", !mTracker.isCrossing(LLVector3(128.f, 128.f, 20.f), LLVector3(10.f, 0.f, 0.f), REGION_WIDTH));
+        ensure("about to leave east", mTracker.isCrossing(LLVector3(254.f, 128.f, 20.f), LLVector3(10.f, 0.f, 0.f), REGION_WIDTH));
+        ensure("already past the south edge", mTracker.isCrossing(LLVector3(128.f, -0.5f, 20.f), LLVector3(0.f, -3.f, 0.f), REGION_WIDTH));
+        ensure("fast enough to leave west", mTracker.isCrossing(LLVector3(10.f, 128.f, 20.f), LLVector3(-30.f, 0.f, 0.f), REGION_WIDTH));
+    }
+
+    // Vehicle with a passenger and an attachment, kill from the old region arrives first
+    template<> template<>
+    void regionhandoff_object_t::test<2>()
+    {
+        const LLVector3 vel(12.f, 0.f, 0.f);
+        const CapturedMessage messages[] =
+        {
+            { 0.00, MSG_UPDATE, REGION_WEST, 0, LLVector3(250.f, 128.f, 22.f), vel },
+            { 0.00, MSG_UPDATE, REGION_WEST, 1, LLVector3(250.f, 128.f, 23.f), vel },
+            { 0.00, MSG_UPDATE, REGION_WEST, 2, LLVector3(250.f, 128.f, 24.f), vel },
+            { 0.40, MSG_UPDATE, REGION_WEST, 0, LLVector3(254.8f, 128.f, 22.f), vel },
+            { 0.45, MSG_KILL,   REGION_WEST, 2, LLVector3(254.8f, 128.f, 24.f), vel },
+            { 0.45, MSG_KILL,   REGION_WEST, 1, LLVector3(254.8f, 128.f, 23.f), vel },
+            { 0.45, MSG_KILL,   REGION_WEST, 0, LLVector3(254.8f, 128.f, 22.f), vel },
+            { 0.60, MSG_UPDATE, REGION_EAST, 0, LLVector3(1.f, 128.f, 22.f), vel },
+            { 0.62, MSG_UPDATE, REGION_EAST, 1, LLVector3(1.f, 128.f, 23.f), vel },
+            { 0.65, MSG_UPDATE, REGION_EAST, 2, LLVector3(1.f, 128.f, 24.f), vel },
+            { 3.00, MSG_IDLE,   REGION_EAST, 0, LLVector3::zero, LLVector3::zero },
+        };
+        ReplayResult result = replay(messages, LL_ARRAY_SIZE(messages));
+
+        ensure_equals("objects created once", result.mCreated, 3);
+        ensure_equals("no object killed", result.mKilled, 0);
+        ensure_equals("all handed off", mTracker.getNumHandoffs(), (U32)3);
+        ensure_equals("nothing pending", mTracker.getNumPending(), 0);
+    }
+
+    // Update from the new region arrives first, the late kill is ignored as stale
+    template<> template<>
+    void regionhandoff_object_t::test<3>()
+    {
+        const LLVector3 vel(0.f, -8.f, 0.f);
+        const CapturedMessage messages[] =
+        {
+            { 0.00, MSG_UPDATE, REGION_EAST, 0, LLVector3(30.f, 2.f, 22.f), vel },
+            { 0.30, MSG_UPDATE, REGION_WEST, 0, LLVector3(30.f, 255.f, 22.f), vel },
+            { 0.35, MSG_KILL,   REGION_EAST, 0, LLVector3(30.f, 0.f, 22.f), vel },
+        };
+        ReplayResult result = replay(messages, LL_ARRAY_SIZE(messages));
+        ensure_equals("kill is stale", mLastKillAction, LLRegionHandoffTracker::KILL_STALE);
+        ensure_equals("nothing deferred", mTracker.getNumPending(), 0);
+
+        const CapturedMessage later[] =
+        {
+            { 3.00, MSG_IDLE,   REGION_WEST, 0, LLVector3::zero, LLVector3::zero },
+        };
+        ReplayResult late_result = replay(later, LL_ARRAY_SIZE(later));
+
+        ensure_equals("created once", result.mCreated, 1);
+        ensure_equals("not killed", result.mKilled + late_result.mKilled, 0);
+        ensure_equals("nothing expired", mTracker.getNumExpired(), (U32)0);
+    }
+
+    // Vehicle derezzed right at the border: the kill goes through after the grace period
+    template<> template<>
+    void regionhandoff_object_t::test<4>()
+    {
+        const LLVector3 vel(12.f, 0.f, 0.f);
+        const CapturedMessage messages[] =
+        {
+            { 0.00, MSG_UPDATE, REGION_WEST, 0, LLVector3(254.f, 128.f, 22.f), vel },
+            { 0.10, MSG_KILL,   REGION_WEST, 0, LLVector3(254.f, 128.f, 22.f), vel },
+            { 0.50, MSG_UPDATE, REGION_WEST, 0, LLVector3(254.f, 128.f, 22.f), vel },
+            { 0.90, MSG_IDLE,   REGION_WEST, 0, LLVector3::zero, LLVector3::zero },
+        };
+        ReplayResult result = replay(messages, 3);
+        ensure("still pending within the grace period", mTracker.isPending(idFor(0)));
+        ensure_equals("update from the killing region is no handoff", mTracker.getNumHandoffs(), (U32)0);
+
+        const CapturedMessage late[] =
+        {
+            { 1.20, MSG_IDLE,   REGION_WEST, 0, LLVector3::zero, LLVector3::zero },
+        };
+        result = replay(late, 1);
+        ensure_equals("killed after expiry", result.mKilled, 1);
+        ensure_equals("expired", mTracker.getNumExpired(), (U32)1);
+    }
+
+    // A parked object at the border is killed immediately
+    template<> template<>
+    void regionhandoff_object_t::test<5>()
+    {
+        const CapturedMessage messages[] =
+        {
+            { 0.00, MSG_UPDATE, REGION_WEST, 0, LLVector3(255.5f, 128.f, 22.f), LLVector3::zero },
+            { 0.10, MSG_KILL,   REGION_WEST, 0, LLVector3(255.5f, 128.f, 22.f), LLVector3::zero },
+        };
+        ReplayResult result = replay(messages, LL_ARRAY_SIZE(messages));
+        ensure_equals("kill not held", mLastKillAction, LLRegionHandoffTracker::KILL_NOW);
+        ensure_equals("killed", result.mKilled, 1);
+        ensure_equals("nothing pending", mTracker.getNumPending(), 0);
+    }
+}
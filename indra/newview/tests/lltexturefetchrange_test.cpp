@@ -0,0 +1,207 @@
+/** 
+ * @file lltexturefetchrange_test.cpp
+ * @brief LLTextureFetchRange tests against a stand-in range server
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * 
+ * The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "../llviewerprecompiledheaders.h"
+// Class to test
+#include "../lltexturefetchrange.h"
+// Tut header
+#include "../test/lltut.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------
+// Stand-in range server
+// Serves one asset and logs every Range it is asked for. The client below drives it the
+// way LLTextureFetchWorker drives the HTTP library: request() picks the range, overlap()
+// and wasted() line the reply up with the data already held.
+// -------------------------------------------------------------------------------------------
+namespace
+{
+    typedef std::pair<S32, S32> range_t;    // offset, size
+
+    enum EReply
+    {
+        REPLY_CONTENT_RANGE,    // 206 with a Content-Range header
+        REPLY_NO_HEADER,        // 206 with the header scrubbed, the worker assumes what it asked for
+        REPLY_EARLY             // 206 starting EARLY_BYTES before the requested offset
+    };
+    const S32 EARLY_BYTES = 100;
+
+    struct RangeServer
+    {
+        RangeServer(S32 size) : mReply(REPLY_CONTENT_RANGE)
+        {
+            for (S32 i = 0; i < size; ++i)
+            {
+                mAsset += (char)('a' + (i * 7) % 26);
+            }
+        }
+
+        std::string serve(S32 offset, S32 size, U32& reply_offset)
+        {
+            mLog.push_back(range_t(offset, size));
+            S32 start = offset;
+            if (mReply == REPLY_EARLY)
+            {
+                start = llmax(0, offset - EARLY_BYTES);
+            }
+            reply_offset = (mReply == REPLY_NO_HEADER) ? offset : start;
+            return mAsset.substr(start, offset + size - start);
+        }
+
+        std::string mAsset;
+        EReply mReply;
+        std::vector<range_t> mLog;
+    };
+
+    struct RangeClient
+    {
+        RangeClient() : mWasted(0) {}
+
+        // One HTTP range towards desired_size; false if the reply could not be used
+        bool fetch(RangeServer& server, S32 desired_size)
+        {
+            S32 offset = 0, size = 0;
+            LLTextureFetchRange::request((S32)mHeld.size(), desired_size, offset, size);
+            U32 reply_offset = 0;
+            std::string body = server.serve(offset, size, reply_offset);
+            S32 skip = LLTextureFetchRange::overlap((S32)mHeld.size(), reply_offset, (S32)body.size());
+            if (skip < 0)
+            {
+                return false;
+            }
+            mWasted += LLTextureFetchRange::wasted((S32)mHeld.size(), offset, skip);
+            mHeld.append(body, skip, std::string::npos);
+            return true;
+        }
+
+        std::string mHeld;      // what the worker and LLTextureCache hold
+        S32 mWasted;
+    };
+}
+
+namespace tut
+{
+    struct texturefetchrange_test
+    {
+        texturefetchrange_test() : mServer(8192) {}
+
+        RangeServer mServer;
+        RangeClient mClient;
+    };
+
+    typedef test_group<texturefetchrange_test> texturefetchrange_t;
+    typedef texturefetchrange_t::object texturefetchrange_object_t;
+    tut::texturefetchrange_t tut_texturefetchrange("LLTextureFetchRange");
+
+    // Successive discard levels ask for adjacent ranges overlapping by one byte
+    template<> template<>
+    void texturefetchrange_object_t::test<1>()
+    {
+        ensure("first range", mClient.fetch(mServer, 600));
+        ensure("second range", mClient.fetch(mServer, 2000));
+        ensure("third range", mClient.fetch(mServer, 5000));
+
+        ensure_equals("requests", mServer.mLog.size(), (size_t)3);
+        ensure("first from the start", mServer.mLog[0] == range_t(0, 600));
+        ensure("second from the last byte held", mServer.mLog[1] == range_t(599, 1401));
+        ensure("third from the last byte held", mServer.mLog[2] == range_t(1999, 3001));
+        ensure("data assembled", mClient.mHeld == mServer.mAsset.substr(0, 5000));
+        ensure_equals("intended overlap is not waste", mClient.mWasted, 0);
+    }
+
+    // Without a Content-Range header the reply is taken to be what was asked for
+    template<> template<>
+    void texturefetchrange_object_t::test<2>()
+    {
+        mServer.mReply = REPLY_NO_HEADER;
+        ensure("first range", mClient.fetch(mServer, 1000));
+        ensure("second range", mClient.fetch(mServer, 3000));
+        ensure("data assembled", mClient.mHeld == mServer.mAsset.substr(0, 3000));
+        ensure_equals("no waste", mClient.mWasted, 0);
+    }
+
+    // After a cancel the next fetch resumes from what the cache holds
+    template<> template<>
+    void texturefetchrange_object_t::test<3>()
+    {
+        mClient.mHeld = mServer.mAsset.substr(0, 1000);
+        ensure("resumed range", mClient.fetch(mServer, 3000));
+
+        ensure_equals("one request", mServer.mLog.size(), (size_t)1);
+        ensure("starts at the cached data", mServer.mLog[0] == range_t(999, 2001));
+        ensure("data assembled", mClient.mHeld == mServer.mAsset.substr(0, 3000));
+    }
+
+    // A reply from before the requested offset is lined up, the extra bytes count as waste
+    template<> template<>
+    void texturefetchrange_object_t::test<4>()
+    {
+        ensure("first range", mClient.fetch(mServer, 1000));
+        mServer.mReply = REPLY_EARLY;
+        ensure("early range", mClient.fetch(mServer, 3000));
+        ensure("data assembled", mClient.mHeld == mServer.mAsset.substr(0, 3000));
+        ensure_equals("bytes before the requested offset", mClient.mWasted, EARLY_BYTES);
+    }
+
+    // Replies which do not join the held data are refused
+    template<> template<>
+    void texturefetchrange_object_t::test<5>()
+    {
+        ensure_equals("starts where the held data ends", LLTextureFetchRange::overlap(1000, 1000, 500), 0);
+        ensure_equals("no Content-Range", LLTextureFetchRange::overlap(1000, 0, 500), 0);
+        ensure_equals("one byte overlap", LLTextureFetchRange::overlap(1000, 999, 501), 1);
+        ensure_equals("gap after the held data", LLTextureFetchRange::overlap(1000, 1200, 500), -1);
+        ensure_equals("ends before the held data", LLTextureFetchRange::overlap(1000, 100, 500), -1);
+    }
+
+    // A range whose discard was overtaken while in flight is followed by the next one
+    // without decoding in between
+    template<> template<>
+    void texturefetchrange_object_t::test<6>()
+    {
+        ensure("discard dropped, more wanted", LLTextureFetchRange::coalesce(0, 600, 2000, 5, 3));
+        ensure("discard unchanged", !LLTextureFetchRange::coalesce(0, 600, 600, 5, 5));
+        ensure("already have what is wanted", !LLTextureFetchRange::coalesce(1400, 600, 2000, 5, 3));
+        ensure("nothing received", !LLTextureFetchRange::coalesce(600, 0, 2000, 5, 3));
+
+        // Discard 5 is in flight when the desired discard drops to 3 and then to 1;
+        // each range is followed straight away by the next and only the last is decoded
+        ensure("discard 5", mClient.fetch(mServer, 600));
+        ensure("on to discard 3", LLTextureFetchRange::coalesce(0, 600, 2000, 5, 3));
+        ensure("discard 3", mClient.fetch(mServer, 2000));
+        ensure("on to discard 1", LLTextureFetchRange::coalesce(600, 1401, 5000, 3, 1));
+        ensure("discard 1", mClient.fetch(mServer, 5000));
+        ensure("then decode", !LLTextureFetchRange::coalesce(2000, 3001, 5000, 1, 1));
+
+        ensure_equals("requests", mServer.mLog.size(), (size_t)3);
+        ensure("data assembled", mClient.mHeld == mServer.mAsset.substr(0, 5000));
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file   benchmark.h
+ * @brief  Keep timing loops out of the default unit test run.
+ * 
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix Firestorm Viewer Source Code
+ * Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_BENCHMARK_H)
+#define LL_BENCHMARK_H
+
+#include <stdlib.h>                 // getenv()
+#include <tut/tut.hpp>
+
+/**
+ * Unit tests run as a side effect of every build, so a test that spends
+ * seconds timing a hot path slows down everyone's build and clutters its
+ * output. Start such a test with:
+ *
+ * @code
+ * skip_unless_benchmarking();
+ * @endcode
+ *
+ * It is then skipped unless the environment variable LL_BENCHMARKS is set.
+ * Report timings with LL_INFOS("Benchmark") rather than std::cout; run with
+ * LOGTEST=INFO to see them.
+ */
+inline void skip_unless_benchmarking()
+{
+    if (! getenv("LL_BENCHMARKS"))
+    {
+        tut::skip("benchmark: set LL_BENCHMARKS to run");
+    }
+}
+
+#endif /* ! defined(LL_BENCHMARK_H) */
@@ -42,14 +42,18 @@
 // std headers
 #include <iostream>
 #include <typeinfo>
+#include <vector>
 // external library headers
 #include <boost/bind.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/assign/list_of.hpp>
 // other Linden headers
 #include "tests/listener.h"             // must PRECEDE lltut.h
 #include "lltut.h"
+#include "benchmark.h"
 #include "catch_and_store_what_in.h"
+#include "lltimer.h"
 #include "stringize.h"
 
 using boost::assign::list_of;
@@ -509,4 +513,121 @@ void events_object::test<11>()
     heaptest.post(2);
 }
 
+template<> template<>
+void events_object::test<12>()
+{
+    set_test_name("listener changes during post()");
+    LLEventStream pump("changes", true);
+    std::string calls;
+    auto record = [&pump, &calls](const std::string& name,
+                                  const LLEventPump::NameList& after=LLEventPump::empty)
+    {
+        return pump.listen(name,
+                           [&calls, name](const LLSD&){ calls += name; return false; },
+                           after);
+    };
+    LLBoundListener b(record("b"));
+    LLBoundListener d;
+    pump.listen("a", [&](const LLSD&)
+                {
+                    calls += "a";
+                    // disconnecting a listener later in this post() skips
+                    // it; one added now is only called from the next post()
+                    b.disconnect();
+                    if (! d.connected())
+                    {
+                        d = record("d", make<LLEventPump::NameList>(list_of("c")));
+                    }
+                    return false;
+                },
+                LLEventPump::empty, make<LLEventPump::NameList>(list_of("b")));
+    record("c", make<LLEventPump::NameList>(list_of("b")));
+    pump.post(LLSD());
+    ensure_equals("disconnected listener skipped, new one deferred", calls, "ac");
+
+    calls.clear();
+    {
+        LLEventPump::Blocker block(pump.getListener("c"));
+        pump.post(LLSD());
+    }
+    ensure_equals("blocked listener skipped", calls, "ad");
+
+    calls.clear();
+    pump.listen("stop", [](const LLSD&){ return true; },
+                make<LLEventPump::NameList>(list_of("a")),
+                make<LLEventPump::NameList>(list_of("c")));
+    ensure("handled", pump.post(LLSD()));
+    ensure_equals("stopped when handled", calls, "a");
+}
+
+template<> template<>
+void events_object::test<13>()
+{
+    set_test_name("benchmark 5M posts to 4 listeners");
+    skip_unless_benchmarking();
+    static const U32 COUNT(5000000);
+    LLEventStream pump("benchmark", true);
+    S32 sum(0);
+    auto add = [&sum](const LLSD& event){ sum += event.asInteger(); return false; };
+
+    // the same listeners on a bare LLStandardSignal, for comparison
+    LLStandardSignal signal;
+    std::vector<LLTempBoundListener> connections;
+    for (S32 i(0); i < 4; ++i)
+    {
+        pump.listen(STRINGIZE("add" << i), add);
+        connections.emplace_back(signal.connect(F32(i), add));
+    }
+
+    const LLSD event(1);
+    F64 start(LLTimer::getTotalSeconds());
+    for (U32 i(0); i < COUNT; ++i)
+    {
+        signal(event);
+    }
+    const F64 signalled(LLTimer::getTotalSeconds() - start);
+
+    start = LLTimer::getTotalSeconds();
+    for (U32 i(0); i < COUNT; ++i)
+    {
+        pump.post(event);
+    }
+    const F64 posted(LLTimer::getTotalSeconds() - start);
+
+    LL_INFOS("Benchmark") << COUNT << " events: "
+                          << signalled << "s through LLStandardSignal, "
+                          << posted << "s through LLEventStream" << LL_ENDL;
+
+    ensure_equals("every listener saw every event", sum, S32(COUNT * 8));
+}
+
+template<> template<>
+void events_object::test<14>()
+{
+    set_test_name("disconnect destroys the listener");
+    LLEventStream pump("release", true);
+    boost::shared_ptr<int> state(new int(17));
+    boost::weak_ptr<int> watch(state);
+    LLBoundListener conn(pump.listen("owner", [state](const LLSD&){ return false; }));
+    state.reset();
+    ensure("listener holds its state", ! watch.expired());
+    conn.disconnect();
+    ensure("state destroyed at disconnect", watch.expired());
+
+    // a listener disconnecting itself survives until its call returns
+    state.reset(new int(17));
+    watch = state;
+    bool intact(false);
+    conn = pump.listen("self", [state, &conn, &intact](const LLSD&)
+                       {
+                           conn.disconnect();
+                           intact = (*state == 17);
+                           return false;
+                       });
+    state.reset();
+    pump.post(LLSD());
+    ensure("state intact during the call", intact);
+    ensure("state destroyed after the call", watch.expired());
+}
+
 } // namespace tut
@@ -32,14 +32,19 @@
 #include "llapr.h"
 #include "llmessagetemplate.h"
 #include "llmath.h"
+#include "llpacketbuffer.h"
 #include "llquaternion.h"
 #include "lltemplatemessagebuilder.h"
 #include "lltemplatemessagereader.h"
+#include "lltimer.h"
 #include "message_prehash.h"
 #include "u64.h"
 #include "v3dmath.h"
 #include "v3math.h"
 #include "v4math.h"
+#include "benchmark.h"
+
+#include <algorithm>
 
 namespace tut
 {   
@@ -116,6 +121,47 @@ namespace tut
             return reader;
         }
 
+        /** Takes ownership of builder; builds into a pooled packet */
+        static LLPacketBuffer::ptr_t buildPacket(
+            LLMessageTemplate& messageTemplate,
+            LLTemplateMessageBuilder* builder)
+        {
+            numberMap[1] = &messageTemplate;
+            LLPacketBuffer::ptr_t packet = new LLPacketBuffer();
+            U8* buffer = (U8*)packet->getData();
+            memset(buffer, 0, LL_PACKET_ID_SIZE);
+            packet->setSize(builder->buildMessage(buffer, LLPacketBuffer::getCapacity(), 0));
+            delete builder;
+            return packet;
+        }
+
+        /** Builds a message with a string in block Test0 and a U32 in Test1 */
+        static LLPacketBuffer::ptr_t buildStringAndU32(
+            LLMessageTemplate& messageTemplate,
+            const std::string& str,
+            U32 value)
+        {
+            messageTemplate.addBlock(defaultBlock(MVT_VARIABLE, 1, MBT_SINGLE));
+            messageTemplate.addBlock(createBlock(const_cast<char*>(_PREHASH_Test1), MVT_U32, 4, MBT_SINGLE));
+            LLTemplateMessageBuilder* builder = defaultBuilder(messageTemplate);
+            builder->addString(_PREHASH_Test0, str.c_str());
+            builder->nextBlock(_PREHASH_Test1);
+            builder->addU32(_PREHASH_Test0, value);
+            return buildPacket(messageTemplate, builder);
+        }
+
+        static void ignoreMessage(LLMessageSystem*, void**)
+        {
+        }
+
+        /** Points at the first occurrence of what in the packet */
+        static char* find(LLPacketBuffer::ptr_t& packet, const char* what, S32 size)
+        {
+            char* begin = packet->getData();
+            char* end = begin + packet->getSize();
+            char* found = std::search(begin, end, what, what + size);
+            return (found == end) ? NULL : found;
+        }
     };
     
     typedef test_group<LLTemplateMessageBuilderTestData>    LLTemplateMessageBuilderTestGroup;
@@ -967,5 +1013,121 @@ namespace tut
         ensure_equals("Ensure unchanged buffer ", strlen(outBuffer), 0);
         delete reader;
     }
-}
 
+    template<> template<>
+    void LLTemplateMessageBuilderTestObject::test<46>()
+        // reading from a packet refers to its bytes
+    {
+        LLPacketBuffer::cleanupPool();
+        LLMessageTemplate messageTemplate = defaultTemplate();
+        const U32 inValue = 0x01234567;
+        LLPacketBuffer::ptr_t packet = buildStringAndU32(messageTemplate, "packet", inValue);
+        const U8* buffer = (const U8*)packet->getData();
+        LLTemplateMessageReader* reader = new LLTemplateMessageReader(numberMap);
+        ensure("valid", reader->validateMessage(buffer, packet->getSize(), LLHost()));
+        ensure("read", reader->readMessage(buffer, LLHost(), packet));
+
+        // change the packet under the reader
+        char* str = find(packet, "packet", 6);
+        ensure("string in packet", str != NULL);
+        str[0] = 'P';
+        char* value = find(packet, (const char*)&inValue, 4);
+        ensure("U32 in packet", value != NULL);
+        value[0] = 0x68;
+
+        char outString[MAX_STRING];
+        reader->getString(_PREHASH_Test0, _PREHASH_Test0, MAX_STRING, outString);
+        ensure_equals("Ensure string refers to packet", std::string(outString), std::string("Packet"));
+        U32 outValue = 0;
+        reader->getU32(_PREHASH_Test1, _PREHASH_Test0, outValue);
+        ensure_equals("Ensure U32 refers to packet", outValue, (U32)0x01234568);
+
+        // the reader keeps the packet until the message is cleared
+        packet = NULL;
+        ensure_equals("Ensure packet held", LLPacketBuffer::getPooledCount(), 0U);
+        reader->getString(_PREHASH_Test0, _PREHASH_Test0, MAX_STRING, outString);
+        ensure_equals("Ensure string still readable", std::string(outString), std::string("Packet"));
+        reader->clearMessage();
+        ensure_equals("Ensure packet released", LLPacketBuffer::getPooledCount(), 1U);
+        delete reader;
+    }
+
+    template<> template<>
+    void LLTemplateMessageBuilderTestObject::test<47>()
+        // reading without a packet copies
+    {
+        LLMessageTemplate messageTemplate = defaultTemplate();
+        const U32 inValue = 0x01234567;
+        LLPacketBuffer::ptr_t packet = buildStringAndU32(messageTemplate, "buffer", inValue);
+        const U8* buffer = (const U8*)packet->getData();
+        LLTemplateMessageReader* reader = new LLTemplateMessageReader(numberMap);
+        ensure("valid", reader->validateMessage(buffer, packet->getSize(), LLHost()));
+        ensure("read", reader->readMessage(buffer, LLHost()));
+
+        find(packet, "buffer", 6)[0] = 'B';
+        find(packet, (const char*)&inValue, 4)[0] = 0x68;
+
+        char outString[MAX_STRING];
+        reader->getString(_PREHASH_Test0, _PREHASH_Test0, MAX_STRING, outString);
+        ensure_equals("Ensure string copied", std::string(outString), std::string("buffer"));
+        U32 outValue = 0;
+        reader->getU32(_PREHASH_Test1, _PREHASH_Test0, outValue);
+        ensure_equals("Ensure U32 copied", outValue, inValue);
+        delete reader;
+    }
+
+    template<> template<>
+    void LLTemplateMessageBuilderTestObject::test<48>()
+        // benchmark decoding by copy and by reference
+    {
+        skip_unless_benchmarking();
+
+        // an update-like message: 20 repeats of a block of mixed fields
+        LLMessageTemplate messageTemplate = defaultTemplate();
+        LLMessageBlock* block = new LLMessageBlock(const_cast<char*>(_PREHASH_Test0), MBT_VARIABLE);
+        block->addVariable(const_cast<char*>(_PREHASH_Test0), MVT_U32, 4);
+        block->addVariable(const_cast<char*>(_PREHASH_Test1), MVT_LLUUID, 16);
+        block->addVariable(const_cast<char*>(_PREHASH_Test2), MVT_VARIABLE, 2);
+        messageTemplate.addBlock(block);
+        messageTemplate.setHandlerFunc(ignoreMessage, NULL);
+
+        nameMap[_PREHASH_TestMessage] = &messageTemplate;
+        LLTemplateMessageBuilder* builder = new LLTemplateMessageBuilder(nameMap);
+        builder->newMessage(_PREHASH_TestMessage);
+        std::vector<U8> blob(72, 0x5a);
+        for (S32 i = 0; i < 20; ++i)
+        {
+            builder->nextBlock(_PREHASH_Test0);
+            builder->addU32(_PREHASH_Test0, i);
+            builder->addUUID(_PREHASH_Test1, LLUUID::generateNewID());
+            builder->addBinaryData(_PREHASH_Test2, &blob[0], (S32)blob.size());
+        }
+        LLPacketBuffer::ptr_t packet = buildPacket(messageTemplate, builder);
+        const U8* buffer = (const U8*)packet->getData();
+
+        const S32 READS = 100000;
+        LLTemplateMessageReader reader(numberMap);
+        F64 seconds[2];
+        for (S32 by_ref = 0; by_ref < 2; ++by_ref)
+        {
+            LLTimer timer;
+            for (S32 i = 0; i < READS; ++i)
+            {
+                reader.validateMessage(buffer, packet->getSize(), LLHost());
+                if (by_ref)
+                {
+                    reader.readMessage(buffer, LLHost(), packet);
+                }
+                else
+                {
+                    reader.readMessage(buffer, LLHost());
+                }
+                reader.clearMessage();
+            }
+            seconds[by_ref] = timer.getElapsedTimeF64();
+        }
+        LL_INFOS("Benchmark") << "Decoded a " << packet->getSize() << " byte message " << READS << " times: copying "
+                              << seconds[0] * 1.0e9 / READS << " ns each, referring to the packet "
+                              << seconds[1] * 1.0e9 / READS << " ns each" << LL_ENDL;
+    }
+}
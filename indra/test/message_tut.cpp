@@ -31,7 +31,9 @@
 #include "llhttpconstants.h"
 #include "llapr.h"
 #include "llmessageconfig.h"
+#include "llpacketbuffer.h"
 #include "llsdserialize.h"
+#include "llzerocode.h"
 #include "message.h"
 #include "message_prehash.h"
 
@@ -48,6 +50,20 @@ namespace
         virtual void extendedResult(S32 code, const LLSD& result, const LLSD& headers) { }
         S32 mStatus;
     };
+
+    // A zero coded packet: header, encoded body, then the appended acks.
+    LLPacketBuffer::ptr_t zeroCodedPacket(const std::vector<U8>& body, const std::vector<U8>& acks, S32& size_without_acks)
+    {
+        LLPacketBuffer::ptr_t packet = new LLPacketBuffer();
+        U8* data = (U8*)packet->getData();
+        memset(data, 0, LL_PACKET_ID_SIZE);
+        data[0] = LL_ZERO_CODE_FLAG | LL_ACK_FLAG;
+        data[4] = 42;
+        size_without_acks = LL_PACKET_ID_SIZE + LLZeroCode::encode(&body[0], (S32)body.size(), data + LL_PACKET_ID_SIZE);
+        memcpy(data + size_without_acks, &acks[0], acks.size());
+        packet->setSize(size_without_acks + (S32)acks.size());
+        return packet;
+    }
 }
 
 namespace tut
@@ -143,5 +159,59 @@ namespace tut
         gMessageSystem->dispatch(name, message, response);
         ensure_equals(response->mStatus, HTTP_NOT_FOUND);
     }
-}
 
+    template<> template<>
+    void LLMessageSystemTestObject::test<2>()
+        // zero coded packets expand into a buffer of their own
+    {
+        std::vector<U8> body(400, 0);
+        for (S32 i = 0; i < (S32)body.size(); i += 7)
+        {
+            body[i] = (U8)(i + 1);
+        }
+        std::vector<U8> acks;
+        acks.push_back(0xaa);
+        acks.push_back(0xbb);
+        acks.push_back(1);
+        S32 size = 0;
+        LLPacketBuffer::ptr_t packet = zeroCodedPacket(body, acks, size);
+        const S32 wire_size = size;
+
+        U8* data = (U8*)packet->getData();
+        ensure_equals("compressed size", gMessageSystem->zeroCodeExpand(&data, &size), wire_size);
+        ensure("expanded elsewhere", data != (U8*)packet->getData());
+        ensure_equals("expanded size", size, (S32)(LL_PACKET_ID_SIZE + body.size()));
+        ensure_equals("zero code flag cleared", data[0], (U8)LL_ACK_FLAG);
+        ensure_equals("packet id kept", data[4], (U8)42);
+        ensure("body", !memcmp(data + LL_PACKET_ID_SIZE, &body[0], body.size()));
+        ensure("acks still in the packet", !memcmp(packet->getData() + wire_size, &acks[0], acks.size()));
+
+        // plain packets are left where they are
+        data = (U8*)packet->getData();
+        size = wire_size;
+        ensure_equals("not zero coded", gMessageSystem->zeroCodeExpand(&data, &size), 0);
+        ensure("not moved", data == (U8*)packet->getData());
+        ensure_equals("size unchanged", size, wire_size);
+    }
+
+    template<> template<>
+    void LLMessageSystemTestObject::test<3>()
+        // zero code expansion is bounded by the packet buffer
+    {
+        std::vector<U8> acks(1, 0);
+        std::vector<U8> body(MAX_BUFFER_SIZE - LL_PACKET_ID_SIZE, 0);
+        body.back() = 1;
+        S32 size = 0;
+        LLPacketBuffer::ptr_t packet = zeroCodedPacket(body, acks, size);
+        U8* data = (U8*)packet->getData();
+        gMessageSystem->zeroCodeExpand(&data, &size);
+        ensure_equals("expanded to the limit", size, MAX_BUFFER_SIZE);
+        ensure_equals("last byte", data[MAX_BUFFER_SIZE - 1], (U8)1);
+
+        body.push_back(1);
+        packet = zeroCodedPacket(body, acks, size);
+        data = (U8*)packet->getData();
+        gMessageSystem->zeroCodeExpand(&data, &size);
+        ensure_equals("overrun discarded", size, 0);
+    }
+}
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""\
+
+Summarise frame_spike_*.llsd snapshots written by the viewer when a frame
+exceeds FSFrameSpikeThreshold. For each spike the timers with the most self
+time in the spike frame are compared against their average over the frames
+leading up to it, so the timers that actually grew stand out.
+
+$LicenseInfo:firstyear=2026&license=viewerlgpl$
+Phoenix Firestorm Viewer Source Code
+Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation;
+version 2.1 of the License only.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+http://www.firestormviewer.org
+$/LicenseInfo$
+"""
+
+import argparse
+import glob
+import os
+from collections import Counter, defaultdict
+from llbase import llsd
+
+COUNTERS = ("object_updates", "textures_decoded", "packets_in", "memory_kb")
+
+def load_snapshot(path):
+    with open(path, "rb") as f:
+        return llsd.parse(f.read())
+
+def spike_frame(snapshot):
+    frames = snapshot["frames"]
+    for frame in frames:
+        if frame["frame"] == snapshot["spike_frame"]:
+            return frame
+    return max(frames, key=lambda f: f["ms"])
+
+def baseline(frames, spike):
+    """Average timer self times and counters over the frames before the spike."""
+    before = [f for f in frames if f["frame"] < spike["frame"]]
+    if not before:
+        return {}, {}, 0.0
+    timers = defaultdict(float)
+    counters = defaultdict(float)
+    for frame in before:
+        for name, ms in frame.get("timers", {}).items():
+            timers[name] += ms
+        for key in COUNTERS:
+            counters[key] += frame.get(key, 0)
+    n = float(len(before))
+    avg_ms = sum(f["ms"] for f in before) / n
+    return ({k: v / n for k, v in timers.items()},
+            {k: v / n for k, v in counters.items()},
+            avg_ms)
+
+def summarise(path, snapshot, top):
+    spike = spike_frame(snapshot)
+    avg_timers, avg_counters, avg_ms = baseline(snapshot["frames"], spike)
+
+    print("=========================")
+    print(os.path.basename(path))
+    print("  frame %d: %.1f ms (recent average %.1f ms, %d frames captured)" %
+          (spike["frame"], spike["ms"], avg_ms, len(snapshot["frames"])))
+    for key in COUNTERS:
+        print("  %-18s %10d   avg %10.1f" % (key, spike.get(key, 0), avg_counters.get(key, 0.0)))
+
+    timers = spike.get("timers", {})
+    growth = sorted(timers.items(), key=lambda kv: kv[1] - avg_timers.get(kv[0], 0.0), reverse=True)
+    print("  %-40s %10s %10s %10s" % ("timer (self time)", "spike ms", "avg ms", "delta"))
+    for name, ms in growth[:top]:
+        avg = avg_timers.get(name, 0.0)
+        print("  %-40s %10.2f %10.2f %+10.2f" % (name, ms, avg, ms - avg))
+    return growth[0][0] if growth else None
+
+def main():
+    parser = argparse.ArgumentParser(description="summarise viewer frame spike snapshots")
+    parser.add_argument("paths", nargs="+", help="snapshot files or directories containing frame_spike_*.llsd")
+    parser.add_argument("--top", type=int, default=10, help="timers to list per spike")
+    args = parser.parse_args()
+
+    files = []
+    for path in args.paths:
+        if os.path.isdir(path):
+            files.extend(sorted(glob.glob(os.path.join(path, "frame_spike_*.llsd"))))
+        else:
+            files.append(path)
+
+    culprits = Counter()
+    for path in files:
+        try:
+            snapshot = load_snapshot(path)
+        except Exception as e:
+            print("skipping", path, e)
+            continue
+        culprit = summarise(path, snapshot, args.top)
+        if culprit:
+            culprits[culprit] += 1
+
+    if len(files) > 1:
+        print("=========================")
+        print("Largest growth across %d spikes:" % len(files))
+        for name, count in culprits.most_common(args.top):
+            print("  %-40s %d" % (name, count))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""\
+
+Convert stats_*.fsstats recordings written by the viewer while FSStatsRecording
+is enabled into CSV. The default wide layout has one row per frame and one
+column per stat; --long writes one row per frame and stat, which suits
+dataframe tools and Parquet conversion better for large recordings.
+
+$LicenseInfo:firstyear=2026&license=viewerlgpl$
+Phoenix Firestorm Viewer Source Code
+Copyright (C) 2026, The Phoenix Firestorm Project, Inc.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation;
+version 2.1 of the License only.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+The Phoenix Firestorm Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+http://www.firestormviewer.org
+$/LicenseInfo$
+"""
+
+import argparse
+import csv
+import math
+import struct
+import sys
+import zlib
+
+MAGIC = b"FSSTATS\0"
+KINDS = ("count", "sample", "event", "memory", "timer")
+
+def read_string(data, offset):
+    (length,) = struct.unpack_from("<H", data, offset)
+    offset += 2
+    return data[offset:offset + length].decode("utf-8", "replace"), offset + length
+
+def parse_columns(payload):
+    (count,) = struct.unpack_from("<I", payload, 0)
+    offset = 4
+    columns = []
+    for _ in range(count):
+        kind = payload[offset]
+        name, offset = read_string(payload, offset + 1)
+        unit, offset = read_string(payload, offset)
+        columns.append((name, unit, KINDS[kind] if kind < len(KINDS) else str(kind)))
+    return columns
+
+def read_recording(path):
+    """Yield (columns, frames) per block, frames being lists of
+    (frame, seconds, frame_ms, values)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        raise ValueError("%s is not a stats recording" % path)
+    (version,) = struct.unpack_from("<I", data, 8)
+    if version != 1:
+        raise ValueError("%s has unsupported version %d" % (path, version))
+
+    offset = 12
+    columns = []
+    while offset + 5 <= len(data):
+        chunk_type = data[offset:offset + 1]
+        (size,) = struct.unpack_from("<I", data, offset + 1)
+        payload = data[offset + 5:offset + 5 + size]
+        offset += 5 + size
+        if len(payload) < size:
+            print("warning: %s is truncated" % path, file=sys.stderr)
+            break
+        if chunk_type == b"C":
+            columns = parse_columns(payload)
+        elif chunk_type == b"B":
+            frames, raw_size = struct.unpack_from("<II", payload, 0)
+            raw = zlib.decompress(payload[8:])
+            if len(raw) != raw_size:
+                raise ValueError("%s has a corrupt block" % path)
+            numbers = struct.unpack_from("<%dI" % frames, raw, 0)
+            pos = 4 * frames
+            seconds = struct.unpack_from("<%dd" % frames, raw, pos)
+            pos += 8 * frames
+            frame_ms = struct.unpack_from("<%df" % frames, raw, pos)
+            pos += 4 * frames
+            values = []
+            for _ in columns:
+                values.append(struct.unpack_from("<%df" % frames, raw, pos))
+                pos += 4 * frames
+            yield columns, [(numbers[i], seconds[i], frame_ms[i], [v[i] for v in values])
+                            for i in range(frames)]
+
+def column_key(column):
+    # Stats of different kinds may share a name (e.g. "Frame")
+    name, _, kind = column
+    return (kind, name)
+
+def column_label(column, shared_names):
+    name, unit, kind = column
+    if name in shared_names:
+        name = "%s:%s" % (kind, name)
+    return "%s (%s)" % (name, unit) if unit else name
+
+def format_value(value):
+    return "" if math.isnan(value) else repr(value)
+
+def main():
+    parser = argparse.ArgumentParser(description="convert viewer stats recordings to CSV")
+    parser.add_argument("infilename", help="stats_*.fsstats recording to read")
+    parser.add_argument("outfilename", nargs="?", help="CSV file to create (default: standard output)")
+    parser.add_argument("--stats", help="comma separated stat names to keep (default: all)")
+    parser.add_argument("--long", action="store_true", help="write frame, seconds, stat, kind, unit, value rows")
+    parser.add_argument("--list", action="store_true", help="list the recorded stats and exit")
+    args = parser.parse_args()
+
+    wanted = set(s.strip() for s in args.stats.split(",")) if args.stats else None
+    blocks = list(read_recording(args.infilename))
+
+    # Stats registered mid-session start a new column table, so the wide
+    # layout uses every column seen, in order of first appearance.
+    labels = []
+    known = {}
+    for columns, _ in blocks:
+        for column in columns:
+            key = column_key(column)
+            if key not in known and (wanted is None or column[0] in wanted):
+                known[key] = len(labels)
+                labels.append(column)
+    seen_names = set()
+    shared_names = set()
+    for name, _, _ in labels:
+        (shared_names if name in seen_names else seen_names).add(name)
+
+    if args.list:
+        for name, unit, kind in labels:
+            print("%-40s %-8s %s" % (name, kind, unit))
+        return
+
+    out = open(args.outfilename, "w", newline="") if args.outfilename else sys.stdout
+    writer = csv.writer(out)
+    frame_count = 0
+    if args.long:
+        writer.writerow(["frame", "seconds", "stat", "kind", "unit", "value"])
+        for columns, frames in blocks:
+            for number, seconds, frame_ms, values in frames:
+                writer.writerow([number, repr(seconds), "frame_ms", "timer", "ms", repr(frame_ms)])
+                for column, value in zip(columns, values):
+                    if column_key(column) in known and not math.isnan(value):
+                        writer.writerow([number, repr(seconds), column[0], column[2], column[1], repr(value)])
+                frame_count += 1
+    else:
+        writer.writerow(["frame", "seconds", "frame_ms"] + [column_label(c, shared_names) for c in labels])
+        for columns, frames in blocks:
+            slots = [known.get(column_key(column)) for column in columns]
+            for number, seconds, frame_ms, values in frames:
+                row = [""] * len(labels)
+                for slot, value in zip(slots, values):
+                    if slot is not None:
+                        row[slot] = format_value(value)
+                writer.writerow([number, repr(seconds), repr(frame_ms)] + row)
+                frame_count += 1
+    if out is not sys.stdout:
+        out.close()
+        print("Wrote %d frames, %d stats to %s" % (frame_count, len(labels), args.outfilename))
+
+if __name__ == "__main__":
+    main()